@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+/**
+   @file arrow_eigensolve.h
+
+   @brief Host eigensolver for the real symmetric restart matrices of
+   the thick restarted Lanczos method: a diagonal leading block whose
+   entries are coupled to a single arrow row, followed by a
+   tridiagonal tail.  The tail is diagonalized by recursive
+   divide-and-conquer, which leaves a symmetric arrowhead that is
+   solved in O(n^2) from the secular equation, with the arrow vector
+   recomputed from the eigenvalues (Gu and Eisenstat) so that the
+   eigenvectors are numerically orthogonal.  The top level keeps the
+   arrowhead in factored form, so that eigenvalues and any linear
+   functional of the eigenvectors are available in O(n^2), and only
+   the eigenvectors that are requested are formed.  Root finding,
+   eigenvector formation and the back transformations are
+   multithreaded with OpenMP.
+ */
+
+namespace quda
+{
+
+  class ArrowEigensolver
+  {
+    struct Merge;
+    std::unique_ptr<Merge> merge;
+
+  public:
+    ArrowEigensolver();
+    ~ArrowEigensolver();
+
+    /**
+       @brief Compute the eigendecomposition of the n x n symmetric
+       matrix A with A(i,i) = diag[i], arrow entries A(i,arrow_pos) =
+       A(arrow_pos,i) = off[i] for i < arrow_pos, and sub-diagonal
+       entries A(i,i+1) = A(i+1,i) = off[i] for arrow_pos <= i < n-1.
+       With arrow_pos = 0 the matrix is tridiagonal.
+       @param[in] diag Diagonal of the matrix (length n)
+       @param[in] off Arrow and sub-diagonal entries (length n-1)
+       @param[in] n Dimension of the matrix
+       @param[in] arrow_pos Position of the arrow row
+     */
+    void compute(const double *diag, const double *off, int n, int arrow_pos);
+
+    /**
+       @return Dimension of the last matrix decomposed
+     */
+    int size() const;
+
+    /**
+       @return Eigenvalues in increasing order
+     */
+    const std::vector<double> &eigenvalues() const;
+
+    /**
+       @brief Compute out[i] = r^T v_i for every eigenvector v_i in
+       increasing order of eigenvalue, in O(n^2) without forming the
+       eigenvectors.  With r the last unit vector this gives the last
+       components used for the Lanczos residua.
+       @param[out] out Projections (length n)
+       @param[in] r Row vector to project onto (length n)
+     */
+    void project(double *out, const double *r) const;
+
+    /**
+       @brief Form the eigenvectors of the n_vec smallest eigenvalues
+       @param[out] vecs Eigenvectors, with component j of vector i
+       stored at vecs[i * n + j]
+       @param[in] n_vec Number of eigenvectors to form
+     */
+    void eigenvectors(double *vecs, int n_vec) const;
+  };
+
+} // namespace quda
@@ -138,6 +138,16 @@ namespace quda {
      */
     size_t NormBytes() const { return norm_bytes; }
 
+    /**
+       @brief Compute a strong hash of the contents of this host field
+       (see content_hash.h), used to check whether an application
+       field has changed.  The meta data that determine how the
+       contents are interpreted are included in the hash.  This is
+       collective.
+       @return hash value
+     */
+    uint64_t hash() const;
+
     /**
        @return Number of colors
     */
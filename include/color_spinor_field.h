@@ -1031,6 +1031,11 @@ namespace quda {
     void restore() const;
   };
 
+  /**
+     @brief Copy and reorder a spinor field.  At the CPU location this
+     is a plain host loop that creates no tunable, so it may be called
+     off the main thread provided that Dst and Src are host memory.
+  */
   void copyGenericColorSpinor(ColorSpinorField &dst, const ColorSpinorField &src,
       QudaFieldLocation location, void *Dst=0, void *Src=0,
       void *dstNorm=0, void*srcNorm=0);
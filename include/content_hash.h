@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+   @file content_hash.h
+
+   @brief Fast non-cryptographic content hashing, used to detect
+   whether a field passed in by the application has changed since it
+   was last seen.  The block hash is XXH64, which processes four
+   independent 64-bit lanes per 32-byte stripe and so vectorizes
+   well.  Large buffers are split into fixed-size blocks that are
+   hashed in parallel, and the block hashes are then hashed in order,
+   so the result depends on the position of every byte (unlike an XOR
+   of per-site checksums, it detects permutations).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace quda
+{
+
+  /**
+     @brief Compute the XXH64 hash of a buffer
+     @param[in] data Buffer to hash
+     @param[in] bytes Size of the buffer in bytes
+     @param[in] seed Seed of the hash
+     @return Hash value
+   */
+  uint64_t xxhash64(const void *data, size_t bytes, uint64_t seed = 0);
+
+  /**
+     @brief Compute the hash of a large buffer on the local process:
+     the buffer is hashed in blocks in parallel over OpenMP threads,
+     followed by a hash of the block hashes.  This is not collective.
+     @param[in] data Buffer to hash
+     @param[in] bytes Size of the buffer in bytes
+     @param[in] seed Seed of the hash
+     @return Hash value
+   */
+  uint64_t contentHash(const void *data, size_t bytes, uint64_t seed = 0);
+
+  /**
+     @brief Combine a local hash over all processes, such that the
+     result depends on which process contributed which hash.  This is
+     collective.
+     @param[in] hash Local hash
+     @return Global hash
+   */
+  uint64_t contentHashReduce(uint64_t hash);
+
+} // namespace quda
@@ -7,6 +7,7 @@
 #include <clover_field.h>
 #include <dslash_quda.h>
 #include <blas_quda.h>
+#include <mg_profile.h>
 
 #include <typeinfo>
 
@@ -1271,8 +1272,10 @@ public:
     /**
        @brief Initialize the coarse gauge fields.  Location is
        determined by gpu_setup variable.
+       @param[in] compute Whether to compute the fields, else they are
+       only allocated, to be filled through CoarseFields()
     */
-    void initializeCoarse();
+    void initializeCoarse(bool compute = true);
 
     /**
        @brief Create the CPU or GPU coarse gauge fields on demand
@@ -1301,6 +1304,23 @@ public:
      */
     void createYhat(bool gpu = true) const;
 
+    mutable MGCounter counter; /** Performance counter of the applications of this operator */
+
+    /**
+       @brief End the region of an application of the operator and
+       record it in the performance counter, with the bytes moved
+       modeled as the input and output fields and the link fields read
+       @param[in] region The region of the application
+       @param[in] out The output field
+       @param[in] in The input field
+       @param[in] dslash Whether the hopping term was applied
+       @param[in] clover Whether the clover term was applied
+       @param[in] xpay Whether an additional input field was read
+       @param[in] apply_flops The flops of the application
+     */
+    void record(MGRegion &region, const ColorSpinorField &out, const ColorSpinorField &in, bool dslash, bool clover,
+                bool xpay, double apply_flops) const;
+
   public:
     double Mass() const { return mass; }
     double Mu() const { return mu; }
@@ -1310,8 +1330,11 @@ public:
        @param[in] param Parameters defining this operator
        @param[in] gpu_setup Whether to do the setup on GPU or CPU
        @param[in] mapped Set to true to put Y and X fields in mapped memory
+       @param[in] compute Whether to compute the coarse link fields,
+       else they are allocated to be filled through CoarseFields(),
+       e.g., from a persisted hierarchy
      */
-    DiracCoarse(const DiracParam &param, bool gpu_setup=true, bool mapped=false);
+    DiracCoarse(const DiracParam &param, bool gpu_setup=true, bool mapped=false, bool compute=true);
 
     /**
        @param[in] param Parameters defining this operator
@@ -1415,6 +1438,19 @@ public:
      */
     void createPreconditionedCoarseOp(GaugeField &Yhat, GaugeField &Xinv, const GaugeField &Y, const GaugeField &X);
 
+    /**
+       @brief Return the coarse link fields Y, X, Xinv and Yhat in the
+       memory space they were constructed in.  If they are modified
+       then the ghost zones of Y and Yhat must be exchanged
+       bidirectionally afterwards.
+    */
+    std::vector<GaugeField *> CoarseFields() const;
+
+    /**
+       @return The performance counter of the applications of this operator
+    */
+    const MGCounter &Counter() const { return counter; }
+
     /**
       @brief If managed memory and prefetch is enabled, prefetch
       all relevant memory fields (X, Y)
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+   @file eig_checkpoint.h
+
+   @brief Checkpointing of the thick restart state of the Lanczos
+   eigensolvers, so that a long eigensolve can be resumed from its
+   last restart boundary.  A checkpoint consists of
+
+   - a metadata record <prefix>.meta, written by rank 0, holding the
+     scalar restart state, the host restart arrays (the arrow matrix
+     and residua) and the list of live vector files;
+
+   - vector files <prefix>.<generation>.<rank>, one per process per
+     checkpoint, holding the local data of the Krylov vectors that
+     changed since the previous checkpoint.  Locked vectors are not
+     modified by later restarts, so each checkpoint only writes the
+     vectors from the previous lock boundary onwards, and the leading
+     vectors are found in older files.
+
+   The vectors are snapshotted to host memory on the calling thread,
+   and the vector files are then written by the host worker thread
+   (host_worker.h) while the eigensolver continues.  Neither QIO nor
+   the compressed vector container can be used for this, since both
+   communicate inside their write routines.  A checkpoint only
+   becomes the one that is resumed from once every process has
+   written its data and the metadata record has been replaced, so a
+   failure while writing leaves the previous checkpoint intact.
+   Resuming requires the same process grid and local volume.
+ */
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace quda
+{
+
+  class ColorSpinorField;
+
+  class EigenCheckpoint
+  {
+  public:
+    /**
+       @brief Scalar restart state of the eigensolver
+     */
+    struct State {
+      int32_t n_kr;
+      int32_t n_ev;
+      int32_t block_size;
+      int32_t restart_iter;
+      int32_t iter;
+      int32_t num_converged;
+      int32_t num_locked;
+      int32_t num_keep;
+      double a_min;
+      double a_max;
+      int32_t poly_deg;
+      double mat_norm;
+    };
+
+    /**
+       @brief Host array that is part of the restart state, and is
+       identical on all processes
+     */
+    struct Array {
+      void *data;
+      size_t bytes;
+    };
+
+    /**
+       @brief Vector file holding the vectors [first, first + n)
+     */
+    struct Segment {
+      int32_t generation;
+      int32_t first;
+      int32_t n;
+    };
+
+  private:
+    const std::string prefix;
+    int generation;                            // generation of the next checkpoint
+    std::vector<Segment> segments;             // vector files of the committed checkpoint
+    std::vector<Segment> pending_segments;     // vector files of the checkpoint being written
+    int clean;                                 // number of locked vectors in the committed checkpoint
+    int pending_clean;                         // number of locked vectors in the checkpoint being written
+    std::vector<char> pending_meta;            // metadata record of the checkpoint being written
+    std::vector<ColorSpinorField *> snapshot;  // host copies of the vectors being written
+    int ticket;                                // host worker ticket of the write, or -1 if none
+    bool write_ok;                             // set by the host worker
+
+    std::string vectorFile(int generation, int rank) const;
+
+  public:
+    /**
+       @brief Create the checkpoint service for an eigensolve
+       @param[in] prefix Prefix of the checkpoint files
+     */
+    EigenCheckpoint(const std::string &prefix);
+
+    /**
+       @brief Complete any checkpoint in flight and free the
+       snapshot buffers.  This is collective.
+     */
+    ~EigenCheckpoint();
+
+    /**
+       @brief Start a checkpoint of the restart state.  Any checkpoint
+       still in flight is completed first.  Only the vectors from the
+       lock boundary of the committed checkpoint onwards are written,
+       since the locked vectors (the first state.num_locked) are not
+       modified by later restarts.  The vectors are copied to host
+       memory before this returns, and are written in the background.
+       This is collective.
+       @param[in] kSpace The Krylov space
+       @param[in] n_vec Number of leading vectors of kSpace in the restart state
+       @param[in] state Scalar restart state
+       @param[in] arrays Host restart arrays
+     */
+    void save(const std::vector<ColorSpinorField *> &kSpace, int n_vec, const State &state,
+              const std::vector<Array> &arrays);
+
+    /**
+       @brief Complete the checkpoint in flight if every process has
+       finished writing it, without waiting.  This is collective.
+     */
+    void poll();
+
+    /**
+       @brief Wait for the checkpoint in flight and make it the
+       committed checkpoint.  This is collective.
+     */
+    void complete();
+
+    /**
+       @brief Load the committed checkpoint, if there is one.  This
+       is collective.
+       @param[out] kSpace The Krylov space to restore into
+       @param[out] state Scalar restart state
+       @param[out] arrays Host restart arrays, whose sizes must match
+       those that were saved
+       @return Whether a checkpoint was found and loaded
+     */
+    bool load(std::vector<ColorSpinorField *> &kSpace, State &state, const std::vector<Array> &arrays);
+  };
+
+} // namespace quda
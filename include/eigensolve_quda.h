@@ -4,6 +4,8 @@
 #include <quda_internal.h>
 #include <dirac_quda.h>
 #include <color_spinor_field.h>
+#include <arrow_eigensolve.h>
+#include <eig_checkpoint.h>
 
 namespace quda
 {
@@ -29,6 +31,13 @@ protected:
     bool reverse;     /** True if using polynomial acceleration */
     char spectrum[3]; /** Part of the spectrum to be computed */
 
+    /** Chebyshev interval and degree of the polynomial acceleration:
+        those of eig_param, or selected from the recorded spectral
+        bounds where eig_param leaves them unset (see checkChebyOpMax) */
+    double a_min;
+    double a_max;
+    int poly_deg;
+
     // Algorithm variables
     //--------------------
     bool converged;
@@ -45,6 +54,8 @@ protected:
     int num_locked;
     int num_keep;
 
+    double mat_norm; /** Largest Ritz value magnitude seen, which scales the convergence and locking criteria */
+
     double *residua;
 
     // Device side vector workspace
@@ -56,6 +67,8 @@ protected:
 
     QudaPrecision save_prec;
 
+    EigenCheckpoint *checkpoint; /** Checkpoint of the restart state, if enabled */
+
   public:
     /**
        @brief Constructor for base Eigensolver class
@@ -97,12 +110,45 @@ protected:
     void prepareInitialGuess(std::vector<ColorSpinorField *> &kSpace);
 
     /**
-       @brief Check for a maximum of the Chebyshev operator
+       @brief Select the Chebyshev interval and degree left unset in
+       eig_param (see a_min, a_max and poly_deg), which is not modified
        @param[in] mat The problem operator
        @param[in] kSpace The Krylov space vectors
     */
     void checkChebyOpMax(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace);
 
+    /**
+       @brief Record the extreme converged eigenvalues of a Hermitian
+       operator in its spectral bounds (see spectral_bounds.h)
+       @param[in] kSpace The converged eigenvectors
+       @param[in] evals The converged eigenvalues
+    */
+    void recordSpectrum(const std::vector<ColorSpinorField *> &kSpace, const std::vector<Complex> &evals);
+
+    /**
+       @brief Return the host arrays that, together with the Krylov
+       space and the restart counters, make up the thick restart state
+    */
+    virtual std::vector<EigenCheckpoint::Array> restartArrays();
+
+    /**
+       @brief Checkpoint the thick restart state, if checkpointing is
+       enabled and a checkpoint is due, else complete any checkpoint in
+       flight that has finished writing.  Called at the end of each
+       restart.
+       @param[in] kSpace The Krylov space vectors
+    */
+    void checkpointRestart(const std::vector<ColorSpinorField *> &kSpace);
+
+    /**
+       @brief Restore the thick restart state, including the
+       Chebyshev polynomial it was built with, from the checkpoint, if
+       resuming was requested and a checkpoint exists
+       @param[in,out] kSpace The Krylov space vectors
+       @return Whether the state was restored
+    */
+    bool resumeRestart(std::vector<ColorSpinorField *> &kSpace);
+
     /**
        @brief Extend the Krylov space
        @param[in] kSpace The Krylov space vectors
@@ -363,9 +409,12 @@ protected:
 
     virtual bool hermitian() { return true; } /** TRLM is only for Hermitian systems */
 
-    // Variable size matrix
+    // Variable size matrix, holding only the kept Ritz vectors
     std::vector<double> ritz_mat;
 
+    /** Structured eigensolver for the arrow matrix */
+    ArrowEigensolver arrow_eig;
+
     // Tridiagonal/Arrow matrix, fixed size.
     double *alpha;
     double *beta;
@@ -391,7 +440,14 @@ protected:
     void reorder(std::vector<ColorSpinorField *> &kSpace);
 
     /**
-       @brief Get the eigendecomposition from the arrow matrix
+       @brief Return the restart arrays: the residua and the arrow matrix
+    */
+    virtual std::vector<EigenCheckpoint::Array> restartArrays();
+
+    /**
+       @brief Get the eigenvalues and residua from the arrow matrix.
+       The Ritz vectors are only formed for the pairs that are kept,
+       in computeKeptRitz.
     */
     void eigensolveFromArrowMat();
 
@@ -424,9 +480,13 @@ protected:
 
     virtual bool hermitian() { return true; } /** (BLOCK)TRLM is only for Hermitian systems */
 
-    // Variable size matrix
+    // Variable size matrix, holding only the kept Ritz vectors
     std::vector<Complex> block_ritz_mat;
 
+    /** Householder reflectors (packed) and coefficients reducing the block arrow matrix to tridiagonal form */
+    std::vector<Complex> block_householder;
+    std::vector<Complex> block_hcoeffs;
+
     /** Block Tridiagonal/Arrow matrix, fixed size. */
     Complex *block_alpha;
     Complex *block_beta;
@@ -452,7 +512,16 @@ protected:
     void blockLanczosStep(std::vector<ColorSpinorField *> v, int j);
 
     /**
-       @brief Get the eigendecomposition from the current block arrow matrix
+       @brief Return the restart arrays: those of TRLM and the block arrow matrix
+    */
+    virtual std::vector<EigenCheckpoint::Array> restartArrays();
+
+    /**
+       @brief Get the eigenvalues and residua from the current block
+       arrow matrix, which is reduced to real tridiagonal form and
+       solved with the structured arrow eigensolver.  The Ritz vectors
+       are only formed for the pairs that are kept, in
+       computeBlockKeptRitz.
     */
     void eigensolveFromBlockArrowMat();
 
@@ -471,6 +540,101 @@ protected:
     void computeBlockKeptRitz(std::vector<ColorSpinorField *> &kSpace);
   };
 
+  /**
+     @brief Implicitly Restarted Arnoldi Method for non-Hermitian
+     operators.  The restart uses the Krylov-Schur form, which is
+     equivalent to implicit restarting with exact shifts: the
+     Hessenberg matrix of the Arnoldi factorisation is reduced to
+     complex Schur form on the host, the Schur form is reordered so
+     that the wanted Ritz values lead, and the Krylov space is rotated
+     onto the leading Schur vectors.  All vectors stay resident in the
+     Krylov space on the device.
+  */
+  class IRAM : public EigenSolver
+  {
+  public:
+    /**
+       @brief Constructor for Implicitly Restarted Arnoldi Eigensolver class
+       @param eig_param The eigensolver parameters
+       @param mat The operator to solve
+       @param profile Time Profile
+    */
+    IRAM(const DiracMatrix &mat, QudaEigParam *eig_param, TimeProfile &profile);
+
+    /**
+       @brief Destructor for Implicitly Restarted Arnoldi Eigensolver class
+    */
+    virtual ~IRAM();
+
+    virtual bool hermitian() { return false; } /** IRAM is for any linear system */
+
+    /** Hessenberg (after a restart Krylov-Schur) matrix of the
+        factorisation, column major and (n_kr + 1) x n_kr, fixed size */
+    std::vector<Complex> upper_hess;
+
+    /** Upper triangular Schur form and Schur vectors of the leading
+        n_kr x n_kr block of upper_hess, column major, fixed size */
+    std::vector<Complex> schur_mat;
+    std::vector<Complex> schur_vecs;
+
+    /** Eigenvectors of the Schur form, column major, fixed size */
+    std::vector<Complex> ritz_vecs;
+
+    /**
+       @brief Compute eigenpairs
+       @param[in] kSpace Krylov vector space
+       @param[in] evals Computed eigenvalues
+    */
+    void operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals);
+
+    /**
+       @brief Arnoldi step: extends the Krylov space by one vector,
+       orthogonalised by classical Gram-Schmidt with one
+       reorthogonalisation
+       @param[in] v Vector space
+       @param[in] j Index of vector being computed
+    */
+    void arnoldiStep(std::vector<ColorSpinorField *> &v, int j);
+
+    /**
+       @brief Return the restart arrays: the residua and the Krylov-Schur matrix
+    */
+    virtual std::vector<EigenCheckpoint::Array> restartArrays();
+
+    /**
+       @brief Get the Ritz values and residua from the Hessenberg
+       matrix: compute its Schur form, sort it according to the
+       requested spectrum and compute the eigenvectors of the Schur form
+    */
+    void eigensolveFromUpperHess();
+
+    /**
+       @brief Restart the factorisation onto the leading num_keep
+       Schur vectors, which become the first vectors of the Krylov
+       space, followed by the residual vector
+       @param[in] kSpace current Krylov space
+    */
+    void computeKeptSchur(std::vector<ColorSpinorField *> &kSpace);
+
+    /**
+       @brief Form the converged Ritz vectors in the leading n_conv
+       vectors of the Krylov space
+       @param[in] kSpace current Krylov space
+    */
+    void computeRitzVectors(std::vector<ColorSpinorField *> &kSpace);
+
+    /**
+       @brief Replace the leading n_out vectors of the Krylov space
+       with the linear combinations kSpace[j] = sum_i kSpace[i] rot(i, j)
+       of the leading n_in vectors
+       @param[in] kSpace current Krylov space
+       @param[in] rot Column major n_in x n_out rotation matrix
+       @param[in] n_in Number of vectors combined
+       @param[in] n_out Number of vectors formed
+    */
+    void rotateVecs(std::vector<ColorSpinorField *> &kSpace, Complex *rot, int n_in, int n_out);
+  };
+
   /**
      arpack_solve()
 
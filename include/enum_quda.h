@@ -135,6 +135,7 @@ extern "C" {
     QUDA_CA_CGNE_INVERTER,
     QUDA_CA_CGNR_INVERTER,
     QUDA_CA_GCR_INVERTER,
+    QUDA_GCRODR_INVERTER,
     QUDA_INVALID_INVERTER = QUDA_INVALID_ENUM
   } QudaInverterType;
 
@@ -142,7 +143,7 @@ extern "C" {
     QUDA_EIG_TR_LANCZOS,     // Thick restarted lanczos solver
     QUDA_EIG_BLK_TR_LANCZOS, // Block Thick restarted lanczos solver
     QUDA_EIG_IR_LANCZOS,     // Implicitly Restarted Lanczos solver (not implemented)
-    QUDA_EIG_IR_ARNOLDI,     // Implicitly Restarted Arnoldi solver (not implemented)
+    QUDA_EIG_IR_ARNOLDI,     // Implicitly Restarted Arnoldi solver
     QUDA_EIG_INVALID = QUDA_INVALID_ENUM
   } QudaEigType;
 
@@ -208,6 +209,15 @@ extern "C" {
     QUDA_INVALID_BASIS = QUDA_INVALID_ENUM
   } QudaCABasis;
 
+  // Type of event in a solver telemetry record
+  typedef enum QudaSolverEventType_s {
+    QUDA_SOLVER_EVENT_ITERATION,       // iterated residual
+    QUDA_SOLVER_EVENT_RELIABLE_UPDATE, // residual recomputed at full precision
+    QUDA_SOLVER_EVENT_RESTART,         // restart of the Krylov space
+    QUDA_SOLVER_EVENT_CONVERGED,       // end of the solve
+    QUDA_SOLVER_EVENT_INVALID = QUDA_INVALID_ENUM
+  } QudaSolverEventType;
+
   // Whether the preconditioned matrix is (1-k^2 Deo Doe) or (1-k^2 Doe Deo)
   //
   // For the clover-improved Wilson Dirac operator, QUDA_MATPC_EVEN_EVEN
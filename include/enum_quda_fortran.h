@@ -131,12 +131,13 @@
 #define QUDA_CA_CGNE_INVERTER 23
 #define QUDA_CA_CGNR_INVERTER 24
 #define QUDA_CA_GCR_INVERTER 25
+#define QUDA_GCRODR_INVERTER 26
 #define QUDA_INVALID_INVERTER QUDA_INVALID_ENUM
 
 #define QudaEigType integer(4)
 #define QUDA_EIG_TR_LANCZOS 0 // Thick Restarted Lanczos Solver
 #define QUDA_EIG_IR_LANCZOS 1 // Implicitly restarted Lanczos solver (not yet implemented)
-#define QUDA_EIG_IR_ARNOLDI 2 // Implicitly restarted Arnoldi solver (not yet implemented)
+#define QUDA_EIG_IR_ARNOLDI 2 // Implicitly restarted Arnoldi solver
 #define QUDA_EIG_INVALID QUDA_INVALID_ENUM
 
 #define QudaEigSpectrumType integer(4)
@@ -191,6 +192,13 @@
 #define QUDA_CHEBYSHEV_BASIS 1
 #define QUDA_INVALID_BASIS QUDA_INVALID_ENUM
 
+#define QudaSolverEventType integer(4)
+#define QUDA_SOLVER_EVENT_ITERATION 0
+#define QUDA_SOLVER_EVENT_RELIABLE_UPDATE 1
+#define QUDA_SOLVER_EVENT_RESTART 2
+#define QUDA_SOLVER_EVENT_CONVERGED 3
+#define QUDA_SOLVER_EVENT_INVALID QUDA_INVALID_ENUM
+
 #/*
    # Whether the preconditioned matrix is (1-k^2 Deo Doe) or (1-k^2 Doe Deo)
    #
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+   @file gauge_checkpoint.h
+
+   @brief Asynchronous checkpointing of gauge and momentum fields.  A
+   host snapshot of the field is taken on submission, after which the
+   file is written by a background I/O thread using the native ILDG
+   writer (gauge_io.h) while the caller continues.  Only the local
+   data phase of the write runs on the I/O thread: creating the file
+   and completing it (reducing and writing the checksum) are
+   collective, and are done on the calling thread at submission and
+   at wait respectively, so no communication happens off the main
+   thread.
+
+   Snapshot buffers are recycled, and at most
+   QUDA_CHECKPOINT_BUFFERS (default 2) checkpoints are in flight at
+   once: submitting another first waits for the oldest.
+ */
+
+#include <gauge_field.h>
+
+namespace quda
+{
+
+  namespace checkpoint
+  {
+
+    /**
+       @brief Return a host gauge field to snapshot into, reusing one
+       from a completed checkpoint if possible.  If the maximum number
+       of checkpoints are in flight then this waits for the oldest, so
+       must be called collectively.
+       @param[in] param Parameters of the host field (QDP order)
+       @return Snapshot field, to be passed to submit
+     */
+    cpuGaugeField *acquire(const GaugeFieldParam &param);
+
+    /**
+       @brief Start writing a snapshot in the background.  This is
+       collective.  Ownership of the snapshot passes to the checkpoint
+       service until the write completes.
+       @param[in] snapshot Host field in QDP order returned by acquire
+       @param[in] filename File to write to
+       @param[in] file_prec Precision to use in the file
+       @return Handle of the checkpoint
+     */
+    int submit(cpuGaugeField *snapshot, const char *filename, QudaPrecision file_prec);
+
+    /**
+       @brief Query whether the local data of a checkpoint has been
+       written.  This is not collective, and the checkpoint must still
+       be completed with wait.
+       @param[in] handle Handle of the checkpoint
+       @return Whether the local data phase has finished
+     */
+    bool test(int handle);
+
+    /**
+       @brief Wait for a checkpoint to complete.  This is collective.
+       @param[in] handle Handle of the checkpoint, or negative to wait
+       for all outstanding checkpoints
+     */
+    void wait(int handle);
+
+    /**
+       @brief Wait for all outstanding checkpoints, stop the I/O thread
+       and free the snapshot buffers
+     */
+    void destroy();
+
+  } // namespace checkpoint
+
+} // namespace quda
@@ -425,6 +425,16 @@ namespace quda {
      */
     uint64_t checksum(bool mini = false) const;
 
+    /**
+       @brief Compute a strong hash of the contents of this host field
+       (see content_hash.h), used to check whether an application
+       field has changed since it was last loaded.  The meta data that
+       determine how the contents are interpreted are included in the
+       hash.  This is collective.
+       @return hash value
+     */
+    uint64_t hash() const;
+
     /**
        @brief Create the gauge field, with meta data specified in the
        parameter struct.
@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+   @file gauge_io.h
+
+   @brief Native parallel readers and writers for gauge field files
+   that do not depend on QIO.  Each process reads or writes its own
+   sub-lattice directly with large contiguous pread/pwrite ranges,
+   while the byte swapping, precision conversion and checksum
+   computation are done on the fly.  The host gauge field is expected
+   in QDP order (gauge[dir] points to the links in direction dir for
+   all local sites in even-odd order), matching what is used with
+   read_gauge_field / write_gauge_field.
+
+   Supported formats are ILDG and SciDAC gauge files (LIME
+   containers with an ildg-binary-data or scidac-binary-data record)
+   and NERSC archive files (both the 4D_SU3_GAUGE and
+   4D_SU3_GAUGE_3x3 data types).  The file format is detected
+   automatically on reading.
+
+   The writers are also exposed as three phases: a collective begin
+   that creates the file and writes its metadata, a data phase that
+   only writes the local sub-lattice and does no communication, and a
+   collective end that completes the file.  The data phase can thus be
+   run on a background thread while the main thread carries on (see
+   gauge_checkpoint.h).
+ */
+
+#include <string>
+#include <stdint.h>
+#include <enum_quda.h>
+
+/**
+   @brief Read a gauge field in ILDG, SciDAC or NERSC format.  If the
+   file contains a SciDAC or NERSC checksum then this is verified
+   and a mismatch is an error.
+   @param[in] filename File to read from
+   @param[out] gauge Host gauge field in QDP order
+   @param[in] prec Precision of the host gauge field
+   @param[in] X Local lattice dimensions
+ */
+void read_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X);
+
+/**
+   @brief Write a gauge field in ILDG format (big endian,
+   lexicographic site order) including a SciDAC checksum record.
+   @param[in] filename File to write to
+   @param[in] gauge Host gauge field in QDP order
+   @param[in] prec Precision of the host gauge field
+   @param[in] X Local lattice dimensions
+   @param[in] file_prec Precision to use in the file (double or single)
+ */
+void write_gauge_field_ildg(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                            QudaPrecision file_prec);
+
+/**
+   @brief Write a gauge field in NERSC 4D_SU3_GAUGE_3x3 format (big
+   endian) including the link trace and checksum header entries.
+   @param[in] filename File to write to
+   @param[in] gauge Host gauge field in QDP order
+   @param[in] prec Precision of the host gauge field
+   @param[in] X Local lattice dimensions
+   @param[in] file_prec Precision to use in the file (double or single)
+   @param[in] plaquette Plaquette to record in the header (e.g., from
+   plaqQuda), since this cannot be computed without a halo exchange
+ */
+void write_gauge_field_nersc(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                             QudaPrecision file_prec, double plaquette);
+
+/**
+   @brief State of a gauge field file that is being written in phases
+ */
+struct GaugeFileWrite {
+  std::string filename;     /**< File being written */
+  int fd;                   /**< File descriptor of the open file */
+  int X[4];                 /**< Local lattice dimensions */
+  QudaPrecision file_prec;  /**< Precision used in the file */
+  uint64_t data_bytes;      /**< Global size of the binary data */
+  int64_t data_offset;      /**< File offset of the binary data */
+  int64_t checksum_offset;  /**< File offset of the trailing checksum record, or -1 if there is none */
+  uint32_t suma;            /**< SciDAC checksum (local after the data phase, global after the end) */
+  uint32_t sumb;            /**< SciDAC checksum (local after the data phase, global after the end) */
+  uint32_t nersc;           /**< NERSC checksum (NERSC files only) */
+
+  GaugeFileWrite() :
+    fd(-1), X {}, file_prec(QUDA_INVALID_PRECISION), data_bytes(0), data_offset(0), checksum_offset(-1), suma(0), sumb(0),
+    nersc(0)
+  {
+  }
+};
+
+/**
+   @brief Collectively create an ILDG gauge file and write its
+   metadata records
+   @param[in] filename File to write to
+   @param[in] X Local lattice dimensions
+   @param[in] file_prec Precision to use in the file (double or single)
+   @return State to pass to write_gauge_field_data and end_gauge_field_write
+ */
+GaugeFileWrite begin_gauge_field_ildg(const char *filename, const int *X, QudaPrecision file_prec);
+
+/**
+   @brief Collectively create a NERSC gauge file and write its header.
+   Since the header contains the checksum, the field is needed here
+   as well as in the data phase.
+   @param[in] filename File to write to
+   @param[in] gauge Host gauge field in QDP order
+   @param[in] prec Precision of the host gauge field
+   @param[in] X Local lattice dimensions
+   @param[in] file_prec Precision to use in the file (double or single)
+   @param[in] plaquette Plaquette to record in the header
+   @return State to pass to write_gauge_field_data and end_gauge_field_write
+ */
+GaugeFileWrite begin_gauge_field_nersc(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                                       QudaPrecision file_prec, double plaquette);
+
+/**
+   @brief Write the local sub-lattice to a file opened with
+   begin_gauge_field_ildg or begin_gauge_field_nersc.  This does no
+   communication, so may be called from a thread other than the one
+   that does MPI.
+   @param[in,out] file State of the file being written
+   @param[in] gauge Host gauge field in QDP order
+   @param[in] prec Precision of the host gauge field
+ */
+void write_gauge_field_data(GaugeFileWrite &file, void *gauge[], QudaPrecision prec);
+
+/**
+   @brief Collectively complete a file once every process has finished
+   its data phase: the SciDAC checksum is reduced and written (ILDG
+   only) and the file is closed.
+   @param[in,out] file State of the file being written
+ */
+void end_gauge_field_write(GaugeFileWrite &file);
@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+   @file host_worker.h
+
+   @brief A background host thread that runs queued tasks in
+   submission order.  This is used to overlap host-side work, such as
+   reordering application fields to and from the native device order,
+   with device work issued by the main thread.  Tasks must only touch
+   host memory: they must not launch device work, communicate, or
+   allocate QUDA fields, since none of these are thread safe.
+ */
+
+#include <functional>
+
+namespace quda
+{
+
+  namespace host_worker
+  {
+
+    /**
+       @brief Queue a task to run on the host worker thread, starting
+       the thread if needed
+       @param[in] task The task to run
+       @return Ticket of the task
+     */
+    int submit(std::function<void()> task);
+
+    /**
+       @brief Query whether a task has completed
+       @param[in] ticket Ticket of the task
+       @return Whether the task has completed
+     */
+    bool test(int ticket);
+
+    /**
+       @brief Wait for a task to complete.  Since tasks run in order,
+       all earlier tasks have also completed on return.
+       @param[in] ticket Ticket of the task, or negative to wait for
+       all queued tasks
+     */
+    void wait(int ticket);
+
+    /**
+       @brief Wait for all queued tasks and stop the worker thread
+     */
+    void destroy();
+
+  } // namespace host_worker
+
+} // namespace quda
@@ -244,6 +244,9 @@ namespace quda {
     /** Which external lib to use in the solver */
     QudaExtLibType extlib_type;
 
+    /** Where to report per-iteration telemetry, if anywhere */
+    QudaSolverTelemetry *telemetry;
+
     /**
        Default constructor
      */
@@ -252,7 +255,8 @@ namespace quda {
       compute_true_res(true),
       sloppy_converge(false),
       verbosity_precondition(QUDA_SILENT),
-      mg_instance(false)
+      mg_instance(false),
+      telemetry(nullptr)
     {
       ;
     }
@@ -323,7 +327,8 @@ namespace quda {
       is_preconditioner(false),
       global_reduction(true),
       mg_instance(false),
-      extlib_type(param.extlib_type)
+      extlib_type(param.extlib_type),
+      telemetry(param.telemetry)
     {
       if (deflate) { eig_param = *(static_cast<QudaEigParam *>(param.eig_param)); }
       for (int i=0; i<num_offset; i++) {
@@ -397,7 +402,8 @@ namespace quda {
       is_preconditioner(param.is_preconditioner),
       global_reduction(param.global_reduction),
       mg_instance(param.mg_instance),
-      extlib_type(param.extlib_type)
+      extlib_type(param.extlib_type),
+      telemetry(param.telemetry)
     {
       for (int i=0; i<num_offset; i++) {
 	offset[i] = param.offset[i];
@@ -556,6 +562,21 @@ namespace quda {
     */
     void PrintSummary(const char *name, int k, double r2, double b2, double r2_tol, double hq_tol);
 
+    /**
+       @brief Report an event to the telemetry of the solve, if
+       enabled (see QudaSolverTelemetry).  Iterations are reported by
+       PrintStats and the end of the solve by PrintSummary.
+       @param[in] name Name of solver that called this
+       @param[in] type Type of event
+       @param[in] k iteration count
+       @param[in] r2 L2 norm squared of the residual
+       @param[in] b2 L2 norm squared of the source
+       @param[in] hq2 Heavy quark residual
+       @param[in] precision Precision the residual was computed in
+    */
+    void ReportEvent(const char *name, QudaSolverEventType type, int k, double r2, double b2, double hq2,
+                     QudaPrecision precision);
+
     /**
        @brief Constructs the deflation space and eigensolver
        @param[in] meta A sample ColorSpinorField with which to instantiate
@@ -652,6 +673,14 @@ namespace quda {
      */
     void operator()(ColorSpinorField &out, ColorSpinorField &in, ColorSpinorField *p_init, double r2_old_init);
 
+    /**
+     * @brief Solve for all the components of the composite fields
+     * with a breakdown-free block CG: the search block is kept
+     * orthonormal with a rank-revealing orthonormalization, and
+     * converged columns are deflated from the block.
+     * @param out Composite solution-vector.
+     * @param in Composite right-hand side.
+     */
     void blocksolve(ColorSpinorField& out, ColorSpinorField& in);
 
     virtual bool hermitian() { return true; } /** CG is only for Hermitian systems */
@@ -1312,6 +1341,82 @@ public:
 		    std::vector<ColorSpinorField*> q);
   };
 
+  /**
+     @brief Chronological basis of previous solutions, used to forecast
+     the initial guess of the next solve by minimum residual
+     extrapolation.  Unlike MinResExt, which rebuilds the projection
+     from scratch, this keeps the images q_i = A p_i of the basis
+     vectors and the Gram matrix of the projection resident between
+     solves: while the operator is unchanged (as identified by a key
+     supplied by the caller), a new basis vector costs one application
+     of the operator and one row and column of inner products, and the
+     forecast itself costs a single multi-reduction and a small host
+     solve.  When the operator changes all of the images are
+     recomputed.
+  */
+  class ChronoBasis {
+
+    std::vector<ColorSpinorField *> p; /**< Basis vectors, most recent first */
+    std::vector<ColorSpinorField *> q; /**< Basis vectors with the operator applied */
+    std::vector<bool> fresh;           /**< Whether q_i and the Gram row and column i are current */
+    std::vector<Complex> gram;         /**< Gram matrix, (p_i, q_j) if Hermitian else (q_i, q_j) */
+    uint64_t key;                      /**< Key of the operator that q and the Gram matrix were computed with */
+    bool hermitian;                    /**< Whether the Gram matrix is for a Hermitian operator */
+
+    /**
+       @brief Permute the basis, such that new entry i is old entry
+       perm[i], and resize it to perm.size() entries (new entries are
+       given by perm[i] < 0)
+     */
+    void permute(const std::vector<int> &perm);
+
+  public:
+    ChronoBasis() : key(0), hermitian(false) { }
+    ChronoBasis(const ChronoBasis &) = delete;
+    ChronoBasis(ChronoBasis &&basis) = default;
+    ChronoBasis &operator=(const ChronoBasis &) = delete;
+    ChronoBasis &operator=(ChronoBasis &&basis) = default;
+    ~ChronoBasis() { clear(); }
+
+    /**
+       @return The number of basis vectors
+     */
+    size_t size() const { return p.size(); }
+
+    /**
+       @brief Free the basis
+     */
+    void clear();
+
+    /**
+       @brief Forecast the solution of A x = b as the minimum residual
+       extrapolation over the basis: for Hermitian A this minimizes the
+       A-norm of the error, otherwise the residual norm.
+       @param[out] x The forecast solution
+       @param[in] b The source vector, at the precision of the basis.
+       This is not preserved if the residual of the forecast is printed.
+       @param[in] mat The operator A, applied at the precision of the basis
+       @param[in] hermitian Whether A is Hermitian positive definite
+       @param[in] key Identifies A: the resident images and Gram
+       matrix are discarded if the key differs from the last forecast
+       @param[in] profile Timing profile to use
+     */
+    void forecast(ColorSpinorField &x, ColorSpinorField &b, const DiracMatrix &mat, bool hermitian, uint64_t key,
+                  TimeProfile &profile);
+
+    /**
+       @brief Add a solution to the basis.  If replace_last is false
+       the solution is added at the front of the basis, dropping the
+       oldest vector if the basis has max_dim vectors, otherwise it
+       replaces the most recent vector.
+       @param[in] x The solution
+       @param[in] max_dim Maximum number of vectors in the basis
+       @param[in] replace_last Whether to replace the most recent vector
+       @param[in] precision Precision to store the basis at
+     */
+    void push(const ColorSpinorField &x, int max_dim, bool replace_last, QudaPrecision precision);
+  };
+
   using ColorSpinorFieldSet = ColorSpinorField;
 
   //forward declaration
@@ -1411,6 +1516,82 @@ public:
     bool hermitian() { return false; } // GMRESDR for any linear system
  };
 
+  /**
+     @brief GCRO-DR: GCR with deflated restarting and a recycled
+     subspace (Parks et al, SIAM J. Sci. Comput. 28 (2006) 1651).  A
+     recycled subspace U of dimension n_ev and its image C = A U, with
+     C orthonormal, are used to deflate every restart cycle of length
+     max_search_dim, and are updated from the harmonic Ritz vectors of
+     each cycle.  If preserve_deflation is set in the eig_param, the
+     subspace is kept across solves in a deflation_space object, and
+     at the start of the next solve C is recomputed from U if the
+     operator has since changed, so that a sequence of related systems
+     (e.g., along an HMC trajectory or a mass scan) reuses the space.
+   */
+  class GCRODR : public Solver
+  {
+
+  private:
+    std::vector<ColorSpinorField *> U;     /** Recycled subspace */
+    std::vector<ColorSpinorField *> C;     /** Orthonormal image C = A U of the recycled subspace */
+    std::vector<Complex> theta;            /** Harmonic Ritz values of the recycled subspace */
+    std::vector<ColorSpinorField *> U_new; /** Workspace for the update of U */
+    std::vector<ColorSpinorField *> C_new; /** Workspace for the update of C */
+    std::vector<ColorSpinorField *> V;     /** Arnoldi basis, size max_search_dim + 1 */
+
+    ColorSpinorField *rp;       /** residual vector */
+    ColorSpinorField *r_sloppy; /** sloppy residual vector */
+    ColorSpinorField *ep;       /** solution correction of the current cycle */
+    ColorSpinorField *tmpp;     /** temporary for mat-vec */
+    ColorSpinorField *tmp2p;    /** temporary for mat-vec */
+
+    bool init;
+
+    /**
+       @brief Take ownership of the recycled subspace preserved by a
+       previous solve, if it is compatible with this one
+       @param[in] meta Field with the geometry of the solve
+     */
+    void restore(const ColorSpinorField &meta);
+
+    /**
+       @brief Hand the recycled subspace over to a deflation_space
+       object if preserve_deflation is set, else free it
+     */
+    void preserve();
+
+    /**
+       @brief Check whether C = A U still holds for the current
+       operator, from the image of the sum of the recycled vectors,
+       and if its relative deviation exceeds the square root of the
+       sloppy epsilon recompute C and re-orthonormalize it
+       @return The number of matrix-vector products done
+     */
+    int refresh();
+
+    /**
+       @brief Run one restart cycle: project out C, run the Arnoldi
+       process for (I - C C^dag) A, minimize the residual over the
+       combined space and update the recycled subspace
+       @param[in,out] e Solution correction
+       @param[in,out] r Residual, on exit orthogonal to the old C
+       @param[in] b2 Norm squared of the source
+       @param[in] stop Stopping condition on the residual norm squared
+       @param[in] max_iter Maximum number of matrix-vector products
+       @param[in] iter Iteration count at the start of the cycle
+       @return The number of matrix-vector products done
+     */
+    int cycle(ColorSpinorField &e, ColorSpinorField &r, double b2, double stop, int max_iter, int iter);
+
+  public:
+    GCRODR(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile);
+    virtual ~GCRODR();
+
+    void operator()(ColorSpinorField &out, ColorSpinorField &in);
+
+    bool hermitian() { return false; } // GCRODR for any linear system
+  };
+
   /**
      @brief This is an object that captures the state required for a
      deflated solver.
@@ -1419,6 +1600,7 @@ public:
     bool svd;                              /** Whether this space is for an SVD deflaton */
     std::vector<ColorSpinorField *> evecs; /** Container for the eigenvectors */
     std::vector<Complex> evals;            /** The eigenvalues */
+    std::vector<ColorSpinorField *> images; /** For a recycled subspace (GCRO-DR), the image A evecs */
   };
 
 } // namespace quda
@@ -18,15 +18,27 @@ namespace quda {
     int_fastdiv geometry;
     int out_offset;
     int in_offset;
+    bool check_nan; // whether the CPU copy should check the input for NaNs
     CopyGaugeArg(const OutOrder &out, const InOrder &in, const GaugeField &meta)
       : out(out), in(in), volume(meta.Volume()), nDim(meta.Ndim()),
-        geometry(meta.Geometry()), out_offset(0), in_offset(0) {
+        geometry(meta.Geometry()), out_offset(0), in_offset(0), check_nan(false) {
       for (int d=0; d<nDim; d++) faceVolumeCB[d] = meta.SurfaceCB(d) * meta.Nface();
     }
   };
 
   /**
-     Generic CPU gauge reordering and packing
+     Number of checkerboard sites per tile in the CPU gauge reordering
+   */
+  constexpr int copy_gauge_tile = 32;
+
+  /**
+     Generic CPU gauge reordering and packing.  The sites are traversed
+     in tiles of copy_gauge_tile sites, copying all directions of a
+     site together, so that both site-major (e.g., MILC) and
+     direction-major (e.g., QDP) orders are accessed in cache-sized
+     contiguous runs.  The tiles are distributed over the OpenMP
+     threads.  If arg.check_nan is set then the input is checked for
+     NaNs in the same pass.
   */
   template <typename FloatOut, typename FloatIn, int length, typename Arg>
   void copyGauge(Arg &arg) {
@@ -34,58 +46,66 @@ namespace quda {
     typedef typename mapper<FloatOut>::type RegTypeOut;
     constexpr int nColor = Ncolor(length);
 
-    for (int parity=0; parity<2; parity++) {
+    const int volumeCB = arg.volume / 2;
+    const int tiles = (volumeCB + copy_gauge_tile - 1) / copy_gauge_tile;
+    int nan_parity = -1, nan_dir = -1, nan_x = -1, nan_i = -1;
 
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
-#ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<nColor; i++)
-	    for (int j=0; j<nColor; j++) {
-	      arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
-	    }
-#else
-	  Matrix<complex<RegTypeIn>, nColor> in;
-	  Matrix<complex<RegTypeOut>, nColor> out;
-          in = arg.in(d, x, parity);
-          out = in;
-	  arg.out(d, x, parity) = out;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
 #endif
-	}
-      }
-
-    }
-  }
-
-  /**
-     Check whether the field contains Nans
-  */
-  template <typename Float, int length, typename Arg>
-  void checkNan(Arg &arg) {
-    typedef typename mapper<Float>::type RegType;
-    constexpr int nColor = Ncolor(length);
-
-    for (int parity=0; parity<2; parity++) {
+    for (int tile = 0; tile < 2 * tiles; tile++) {
+      const int parity = tile / tiles;
+      const int x_begin = (tile % tiles) * copy_gauge_tile;
+      const int x_end = x_begin + copy_gauge_tile < volumeCB ? x_begin + copy_gauge_tile : volumeCB;
 
-      for (int d=0; d<arg.geometry; d++) {
-	for (int x=0; x<arg.volume/2; x++) {
+      for (int x = x_begin; x < x_end; x++) {
+        for (int d = 0; d < arg.geometry; d++) {
 #ifdef FINE_GRAINED_ACCESS
-	  for (int i=0; i<nColor; i++)
-	    for (int j=0; j<nColor; j++) {
-              complex<Float> u = arg.in(d, parity, x, i, j);
-	      if (isnan(u.real()))
-	        errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j));
-	      if (isnan(u.imag()))
-		errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, 2*(i*Ncolor(length)+j+1));
+          for (int i = 0; i < nColor; i++)
+            for (int j = 0; j < nColor; j++) {
+              if (arg.check_nan) {
+                complex<FloatIn> u = arg.in(d, parity, x, i, j);
+                if (isnan(u.real()) || isnan(u.imag())) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                  {
+                    nan_parity = parity;
+                    nan_dir = d;
+                    nan_x = x;
+                    nan_i = i * nColor + j;
+                  }
+                }
+              }
+              arg.out(d, parity, x, i, j) = arg.in(d, parity, x, i, j);
             }
 #else
-	  Matrix<complex<RegType>, nColor> u = arg.in(d, x, parity);
-	  for (int i=0; i<length/2; i++)
-	    if (isnan(u(i).real()) || isnan(u(i).imag())) errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", parity, d, x, i);
+          Matrix<complex<RegTypeIn>, nColor> in;
+          Matrix<complex<RegTypeOut>, nColor> out;
+          in = arg.in(d, x, parity);
+          if (arg.check_nan) {
+            for (int i = 0; i < length / 2; i++) {
+              if (isnan(in(i).real()) || isnan(in(i).imag())) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                {
+                  nan_parity = parity;
+                  nan_dir = d;
+                  nan_x = x;
+                  nan_i = i;
+                }
+              }
+            }
+          }
+          out = in;
+          arg.out(d, x, parity) = out;
 #endif
-	}
+        }
       }
-
     }
+
+    if (nan_parity >= 0) errorQuda("Nan detected at parity=%d, dir=%d, x=%d, i=%d", nan_parity, nan_dir, nan_x, nan_i);
   }
 
   /**
@@ -9,6 +9,13 @@ namespace quda {
   void printPeakMemUsage();
   void assertAllMemFree();
 
+  /**
+     @brief Register a function that printPeakMemUsage calls to report
+     a breakdown of the memory used by some part of QUDA
+     @param[in] report Function that prints the breakdown
+   */
+  void register_mem_usage_report(void (*report)());
+
   /**
      @return peak device memory allocated
    */
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+   @file mg_cache.h
+
+   @brief Persisted multigrid hierarchy.  Each level of a hierarchy is
+   stored as one file per process, <path>/mg_<key>.<level>.<rank>,
+   holding the raw local data of the level's null-space vectors, its
+   block-orthonormalized prolongator V, and the coarse link fields Y,
+   X, Xinv and Yhat of the next level, at the precision, order and
+   location they are held in.  Each record is checksummed.
+
+   The key is computed by the interface from the gauge configuration
+   hash, the operator parameters and precisions, the multigrid setup
+   parameters, the local volume and the process grid, so that a level
+   found in the cache reproduces the one that would be built.  A
+   level is only used if every process has a valid file for it, and
+   if every finer level was loaded from the cache too.  A level that
+   fails to load part way, e.g. on a checksum mismatch, is rebuilt
+   from the fields that were read.  Files are written to a temporary
+   name and then renamed, so an interrupted write never leaves a
+   partial file behind.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace quda
+{
+
+  class ColorSpinorField;
+  class GaugeField;
+
+  namespace mgcache
+  {
+
+    /**
+       @brief Check whether a level of a hierarchy is in the cache on
+       every process.  This is collective.
+       @param[in] path Cache directory
+       @param[in] key Key of the hierarchy
+       @param[in] level The level
+       @return Whether the level can be loaded
+     */
+    bool exists(const std::string &path, uint64_t key, int level);
+
+    /**
+       @brief Writes one level of a hierarchy to this process's cache
+       file.  Failing to write is not an error: the level is simply
+       not cached, since the cache is only an optimization.
+     */
+    class Writer
+    {
+      std::string filename;
+      std::string tmp_filename;
+      FILE *file;
+      std::vector<char> buffer;
+
+      void write(const void *data, size_t bytes);
+
+    public:
+      /**
+         @brief Start writing a level
+         @param[in] path Cache directory
+         @param[in] key Key of the hierarchy
+         @param[in] level The level
+       */
+      Writer(const std::string &path, uint64_t key, int level);
+
+      /**
+         @brief Discards the file if it was not committed
+       */
+      ~Writer();
+
+      /**
+         @brief Append the local data of a field
+         @param[in] field The field
+       */
+      void write(const ColorSpinorField &field);
+
+      /**
+         @brief Append the local data of a gauge field
+         @param[in] field The field
+       */
+      void write(const GaugeField &field);
+
+      /**
+         @brief Complete the file and move it into place
+       */
+      void commit();
+    };
+
+    /**
+       @brief Reads one level of a hierarchy from this process's cache
+       file, in the order it was written.  The fields read into must
+       have been created with the same parameters as those written.
+       Failing to read is not an error: once a record cannot be read
+       on any process, no further records are read, and the caller is
+       to rebuild the rest of the level.
+     */
+    class Reader
+    {
+      std::string filename;
+      FILE *file;
+      std::vector<char> buffer;
+      bool good; // whether every record so far has been read on this process
+
+      bool read(void *data, size_t bytes);
+
+      /**
+         @brief Agree on whether a record was read on every process
+         @param[in] ok Whether it was read on this process
+         @return Whether it was read on every process
+       */
+      bool agree(bool ok);
+
+    public:
+      /**
+         @brief Open a level, which should exist (see exists)
+         @param[in] path Cache directory
+         @param[in] key Key of the hierarchy
+         @param[in] level The level
+       */
+      Reader(const std::string &path, uint64_t key, int level);
+
+      ~Reader();
+
+      /**
+         @brief Read the next record into a field.  This is collective.
+         @param[out] field The field, which is left unchanged if the
+         record could not be read on every process
+         @return Whether the record was read on every process
+       */
+      bool read(ColorSpinorField &field);
+
+      /**
+         @brief Read the next record into a gauge field.  This is
+         collective.
+         @param[out] field The field, which is left unchanged if the
+         record could not be read on every process
+         @return Whether the record was read on every process
+       */
+      bool read(GaugeField &field);
+    };
+
+  } // namespace mgcache
+
+} // namespace quda
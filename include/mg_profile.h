@@ -0,0 +1,175 @@
+#pragma once
+
+/**
+   @file mg_profile.h
+
+   @brief Performance counters of the multigrid solver.  Each level
+   of a hierarchy records the calls, time, flops and bytes moved of
+   its components: the smoothers, the restrictor and prolongator, the
+   coarse-grid correction and, on coarse levels, the coarse operator.
+   Flops and bytes are those of a model of each kernel, so that the
+   derived GFLOPS, GB/s and arithmetic intensity can be compared
+   against the roofline of the device.  Bytes moved by the fine-grid
+   operator are not modeled, so the fine-level smoothers only count
+   the bytes of their BLAS kernels.
+
+   Only solves are profiled: nothing is recorded while a hierarchy
+   is being set up (see mgprofile::SetupScope).  Counters are always
+   accumulated, but the device is only synchronized around each
+   timed region if QUDA_ENABLE_MG_PROFILE=1 is set, otherwise the
+   times of asynchronous kernels are those of their launches.  The
+   report is printed as a tree when the hierarchy is destroyed, and
+   with QUDA_ENABLE_MG_PROFILE=1 is also written as JSON to
+   QUDA_RESOURCE_PATH/mg_profile_<n>.json.
+ */
+
+#include <string>
+#include <vector>
+#include <quda_internal.h>
+
+namespace quda
+{
+
+  /**
+     Counters of one component of a multigrid level
+  */
+  struct MGCounter {
+    /** Number of times the component was applied */
+    long calls = 0;
+
+    /** Time spent in the component */
+    double time = 0.0;
+
+    /** Modeled flops of the component */
+    double flops = 0.0;
+
+    /** Modeled bytes moved by the component */
+    double bytes = 0.0;
+
+    MGCounter &operator+=(const MGCounter &a)
+    {
+      calls += a.calls;
+      time += a.time;
+      flops += a.flops;
+      bytes += a.bytes;
+      return *this;
+    }
+  };
+
+  /**
+     Statistics of the multigrid cycles applied on one level
+  */
+  struct MGCycleStats {
+    /** Number of cycles applied on this level */
+    long cycles = 0;
+
+    /** Number of coarse-grid corrections, two per cycle for a W-cycle */
+    long coarse_solves = 0;
+
+    /** Iterations of the Krylov coarse-grid solver (of a K-cycle, or
+        the bottom solver), summed over all coarse-grid corrections;
+        zero if the coarse-grid correction is a cycle of the coarser
+        level */
+    long coarse_iter = 0;
+
+    /** Time spent in cycles on this level, including the coarser levels */
+    double time = 0.0;
+
+    /** Time spent in coarse-grid corrections */
+    double coarse_time = 0.0;
+
+    /** Smallest and largest tolerance the coarse-grid solver was run with */
+    double coarse_tol_min = 0.0;
+    double coarse_tol_max = 0.0;
+
+    /** Counters of the pre- and post-smoother */
+    MGCounter presmooth;
+    MGCounter postsmooth;
+  };
+
+  /**
+     Profile of one level of a hierarchy, as collected for the report
+  */
+  struct MGLevelProfile {
+    /** The level */
+    int level = 0;
+
+    /** The cycle applied from this level, "V", "W" or "K", empty on the bottom level */
+    std::string cycle;
+
+    /** Statistics of the cycles applied on this level */
+    MGCycleStats stats;
+
+    /** The named components of this level */
+    std::vector<std::pair<std::string, MGCounter>> components;
+  };
+
+  /**
+     @brief Times a region of a multigrid component.  The device is
+     synchronized at both ends of the region when profiling is
+     enabled.
+   */
+  class MGRegion
+  {
+    Timer timer;
+
+  public:
+    /**
+       @brief Start the region
+     */
+    MGRegion();
+
+    /**
+       @brief End the region
+       @return The time spent in the region
+     */
+    double stop();
+
+    /**
+       @brief End the region and record it as one call of a component
+       @param[in,out] counter The counter of the component
+       @param[in] flops Modeled flops done in the region
+       @param[in] bytes Modeled bytes moved in the region
+     */
+    void stop(MGCounter &counter, double flops, double bytes);
+  };
+
+  namespace mgprofile
+  {
+
+    /**
+       @brief Whether detailed profiling is enabled by setting
+       QUDA_ENABLE_MG_PROFILE=1
+     */
+    bool enabled();
+
+    /**
+       @brief Whether counters are being recorded, which they are
+       unless a hierarchy is being set up
+     */
+    bool recording();
+
+    /**
+       @brief Suspends the recording of counters for its lifetime, so
+       that the setup of a hierarchy is not profiled.  Scopes may be
+       nested.
+     */
+    class SetupScope
+    {
+    public:
+      SetupScope();
+      ~SetupScope();
+    };
+
+    /**
+       @brief Report the profile of a hierarchy: the counters are
+       reduced over processes, times by maximum and flops and bytes by
+       sum, and printed as a tree, and exported as JSON if profiling
+       is enabled.  This is collective.
+       @param[in] levels The profile of each level, finest first
+     */
+    void report(const std::vector<MGLevelProfile> &levels);
+
+  } // namespace mgprofile
+
+} // namespace quda
@@ -2,6 +2,7 @@
 
 #include <invert_quda.h>
 #include <transfer.h>
+#include <mg_profile.h>
 #include <vector>
 #include <complex_quda.h>
 
@@ -15,6 +16,10 @@ namespace quda {
   // forward declarations
   class MG;
   class DiracCoarse;
+  namespace mgcache
+  {
+    class Reader;
+  }
 
   /**
      This struct contains all the metadata required to define the
@@ -101,6 +106,14 @@ namespace quda {
     /** Whether or not this is a staggered solve or not */
     bool is_staggered;
 
+    /** Key of the hierarchy in the persisted hierarchy cache, or 0 if it is not cached */
+    uint64_t cache_key;
+
+    /** Whether this level may be loaded from the hierarchy cache,
+        which is only if every finer level was, since a cached level
+        is only valid on top of the finer levels it was built from */
+    bool cache_load;
+
     /**
        This is top level instantiation done when we start creating the multigrid operator.
      */
@@ -127,7 +140,9 @@ namespace quda {
       smoother_solve_type(param.smoother_solve_type[level]),
       location(param.location[level]),
       setup_location(param.setup_location[level]),
-      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES)
+      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES),
+      cache_key(0),
+      cache_load(true)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.geo_block_size[level][i];
@@ -161,7 +176,9 @@ namespace quda {
       smoother_solve_type(param.mg_global.smoother_solve_type[level]),
       location(param.mg_global.location[level]),
       setup_location(param.mg_global.setup_location[level]),
-      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES)
+      is_staggered(param.is_staggered == QUDA_BOOLEAN_YES),
+      cache_key(param.cache_key),
+      cache_load(param.cache_load)
     {
       // set the block size
       for (int i = 0; i < QUDA_MAX_DIM; i++) geoBlockSize[i] = param.mg_global.geo_block_size[level][i];
@@ -240,6 +257,15 @@ namespace quda {
     /** Coarse temporary vector */
     ColorSpinorField *tmp2_coarse;
 
+    /** Coarse correction of the second coarse-grid visit of a W-cycle */
+    ColorSpinorField *e_coarse;
+
+    /** Residual reduction || r || / || b || reached by the solve this level preconditions */
+    double outer_reduction;
+
+    /** Statistics of the cycles applied on this level */
+    MGCycleStats cycle_stats;
+
     /** The fine operator used for computing inter-grid residuals */
     const Dirac *diracResidual;
 
@@ -270,6 +296,33 @@ namespace quda {
     /** Parallel hyper-cubic random number generator for generating null-space vectors */
     RNG *rng;
 
+    /** Reader of this level from the persisted hierarchy cache while it is being loaded */
+    mgcache::Reader *cache_reader;
+
+    /** Whether this level is that of the hierarchy cache: it was
+        loaded completely, or has nothing to cache and its finer
+        levels were loaded */
+    bool cache_loaded;
+
+    /**
+       @brief Open this level in the persisted hierarchy cache for
+       loading, if the hierarchy is cached and the level is there
+       @return Whether the level is being loaded from the cache
+    */
+    bool openCache();
+
+    /**
+       @brief Close the hierarchy cache after a record of this level
+       could not be loaded, so that the rest of the level is rebuilt
+    */
+    void dropCache();
+
+    /**
+       @brief Save this level to the persisted hierarchy cache: the
+       null-space vectors, the prolongator and the coarse operator
+    */
+    void saveCache() const;
+
     /**
        @brief Helper function called on entry to each MG function
        @param[in] level The level we working on
@@ -301,6 +354,37 @@ public:
      */
     bool hermitian() { return false; };
 
+    /**
+       @brief Set the residual reduction || r || / || b || reached so
+       far by the solve this MG is preconditioning, which drives an
+       adaptive coarse-solver tolerance (see coarse_solver_tol_max)
+       @param[in] reduction The relative residual of the outer solve
+     */
+    void setOuterReduction(double reduction) { outer_reduction = reduction; }
+
+    /**
+       @return The statistics of the cycles applied on this level
+     */
+    const MGCycleStats &cycleStats() const { return cycle_stats; }
+
+    /**
+       @return The bytes moved so far by the kernels of the smoothers
+       on this level: BLAS and, on coarse levels, the coarse operator
+     */
+    double smootherBytes() const;
+
+    /**
+       @brief Append the profile of this and all coarser levels
+       @param[in,out] levels The profile of each level
+     */
+    void collectProfile(std::vector<MGLevelProfile> &levels) const;
+
+    /**
+       @brief Report the per-level and per-component profile of this
+       and all coarser levels (see mg_profile.h).  This is collective.
+     */
+    void reportProfile() const;
+
     /**
        @brief This method resets the solver, e.g., when a parameter has changed such as the mass.
        @param Whether we are refreshing the null-space components or just updating the operators
@@ -350,6 +434,25 @@ public:
      */
     void verify(bool recursively = false);
 
+    /**
+       @brief Compute the deviation of the native coarse operator from
+       the emulated one, || (D_c - P^\dagger D P) eta || / || P^\dagger D P eta ||
+       for a random coarse vector eta
+       @param[out] eta The random coarse vector
+       @param[out] tmp1 P eta
+       @param[out] tmp2 D P eta
+       @param[in] tol Tolerance below which a mu_factor shift is not corrected for
+       @return The relative deviation
+     */
+    double coarseOperatorDeviation(ColorSpinorField &eta, ColorSpinorField &tmp1, ColorSpinorField &tmp2, double tol);
+
+    /**
+       @brief Compute how far the null-space vectors have moved out of
+       the range of the prolongator, max_k || (1 - P P^\dagger) v_k || / || v_k ||
+       @return The largest relative deviation
+     */
+    double prolongatorChange();
+
     /**
        This applies the V-cycle to the residual vector returning the residual vector
        @param out The solution vector
@@ -376,6 +479,19 @@ public:
     */
     void generateNullVectors(std::vector<ColorSpinorField*> &B, bool refresh=false);
 
+    /**
+       @brief Relax a block of null-space vectors together with the
+       block CG solver.  Each vector's system is prepared as in the
+       single-vector setup, and the block solve is for the corrections
+       to the initial guesses.
+       @param B Null-space vectors to relax
+       @param solverParam The setup solver parameters
+       @param mat The setup operator
+       @param matSloppy The sloppy setup operator
+    */
+    void generateNullVectorBlock(std::vector<ColorSpinorField *> &B, const SolverParam &solverParam, DiracMatrix &mat,
+                                 DiracMatrix &matSloppy);
+
     /**
        @brief Generate lowest eigenvectors
     */
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <gauge_io.h>
+
 #ifdef HAVE_QIO
 void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
 		      int argc, char *argv[]);
@@ -8,18 +10,34 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
                        QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[]);
 void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
                         QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[]);
+
+/*
+  Streaming interface for vector files.  A file may contain several
+  spinor records (e.g., one per chunk of vectors), which are read or
+  written one at a time through an opaque handle, so that only a
+  single chunk need be resident in host memory.
+ */
+void *open_spinor_reader(const char *filename, const int *X, QudaSiteSubset subset);
+/* Returns the number of 4-d fields in the next record, or 0 at the end of the file */
+int read_spinor_record_count(void *reader);
+void read_spinor_record(void *reader, void *V[], QudaPrecision precision, QudaSiteSubset subset, QudaParity parity,
+                        int nColor, int nSpin, int Nvec);
+void close_spinor_reader(void *reader);
+void *open_spinor_writer(const char *filename, const int *X, QudaSiteSubset subset);
+void write_spinor_record(void *writer, void *V[], QudaPrecision precision, QudaSiteSubset subset, QudaParity parity,
+                         int nColor, int nSpin, int Nvec);
+void close_spinor_writer(void *writer);
 #else
+// without QIO gauge fields are read and written with the native ILDG / NERSC implementation
 inline void read_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X, int argc,
                              char *argv[])
 {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  read_gauge_field_native(filename, gauge, prec, X);
 }
 inline void write_gauge_field(const char *filename, void *gauge[], QudaPrecision prec, const int *X, int argc,
                               char *argv[])
 {
-  printf("QIO support has not been enabled\n");
-  exit(-1);
+  write_gauge_field_ildg(filename, gauge, prec, X, prec);
 }
 inline void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X,
                               QudaSiteSubset subset, QudaParity parity, int nColor, int nSpin, int Nvec, int argc,
@@ -36,4 +54,26 @@ inline void write_spinor_field(const char *filename, void *V[], QudaPrecision pr
   exit(-1);
 }
 
+inline void *open_spinor_reader(const char *filename, const int *X, QudaSiteSubset subset)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
+inline int read_spinor_record_count(void *reader) { return 0; }
+inline void read_spinor_record(void *reader, void *V[], QudaPrecision precision, QudaSiteSubset subset,
+                               QudaParity parity, int nColor, int nSpin, int Nvec)
+{
+}
+inline void close_spinor_reader(void *reader) { }
+inline void *open_spinor_writer(const char *filename, const int *X, QudaSiteSubset subset)
+{
+  printf("QIO support has not been enabled\n");
+  exit(-1);
+}
+inline void write_spinor_record(void *writer, void *V[], QudaPrecision precision, QudaSiteSubset subset,
+                                QudaParity parity, int nColor, int nSpin, int Nvec)
+{
+}
+inline void close_spinor_writer(void *writer) { }
+
 #endif
@@ -82,6 +82,7 @@ extern "C" {
     int make_resident_mom;   /**< Make the result momentum field resident */
     int return_result_gauge; /**< Return the result gauge field */
     int return_result_mom;   /**< Return the result momentum field */
+    int reference_gauge;     /**< Adopt the field passed to loadGaugeQuda as the resident precise field rather than copying it, if possible (see loadGaugeQuda) */
 
     size_t gauge_offset; /**< Offset into MILC site struct to the gauge field (only if gauge_order=MILC_SITE_GAUGE_ORDER) */
     size_t mom_offset; /**< Offset into MILC site struct to the momentum field (only if gauge_order=MILC_SITE_GAUGE_ORDER) */
@@ -90,6 +91,39 @@ extern "C" {
   } QudaGaugeParam;
 
 
+  /**
+   * A solver telemetry record, describing one event in a linear solve
+   */
+  typedef struct QudaSolverRecord_s {
+    QudaSolverEventType type; /**< The type of event */
+    const char *solver;       /**< Name of the solver reporting the event */
+    int iter;                 /**< Iteration count of the solver */
+    double r2;                /**< Squared residual norm, iterated or (for a reliable update) true */
+    double r2_rel;            /**< Squared residual norm relative to the source */
+    double hq;                /**< Heavy-quark residual, if computed, else zero */
+    QudaPrecision precision;  /**< Precision of the arithmetic the residual was computed in */
+    double time;              /**< Seconds since the start of the first recorded solve */
+    double time_preamble;     /**< For the converged event, time spent in the solver preamble */
+    double time_compute;      /**< For the converged event, time spent in the solver iterations */
+  } QudaSolverRecord;
+
+  /**
+   * Destination of solver telemetry.  Records are appended to
+   * records (if non-null) while count < capacity, and are passed to
+   * callback (if non-null) as they happen.  Solver telemetry is
+   * enabled by pointing QudaInvertParam::telemetry at an instance of
+   * this, and costs nothing otherwise.  Nested solvers, e.g.,
+   * preconditioners, report to the same instance.
+   */
+  typedef struct QudaSolverTelemetry_s {
+    QudaSolverRecord *records; /**< Buffer of records */
+    int capacity;              /**< Size of the buffer */
+    int count;                 /**< Number of events reported (those past capacity are not stored) */
+    double start;              /**< Wall-clock time of the first record, set by QUDA when count is zero */
+    void (*callback)(const QudaSolverRecord *record, void *data); /**< Called for each event */
+    void *data;                                                    /**< Passed to the callback */
+  } QudaSolverTelemetry;
+
   /**
    * Parameters relating to the solver and the choice of Dirac operator.
    */
@@ -313,7 +347,10 @@ extern "C" {
     /** Minimum eigenvalue for Chebyshev CA basis */
     double ca_lambda_min;
 
-    /** Maximum eigenvalue for Chebyshev CA basis */
+    /** Maximum eigenvalue for Chebyshev CA basis (a value less than
+        ca_lambda_min takes it from the recorded spectral bounds of the
+        operator, see spectral_bounds.h, or else from a power
+        iteration) */
     double ca_lambda_max;
 
     /** Number of preconditioner cycles to perform per iteration */
@@ -337,10 +374,12 @@ extern "C" {
     QudaPrecision cuda_prec_ritz;
     /** How many vectors to compute after one solve
      *  for eigCG recommended values 8 or 16
+     *  gcrodr : dimension of the recycled subspace
     */
     int n_ev;
     /** EeigCG  : Search space dimension
      *  gmresdr : Krylov subspace dimension
+     *  gcrodr  : restart cycle length, including the recycled subspace
     */
     int max_search_dim;
     /** For systems with many RHS: current RHS index */
@@ -386,6 +425,9 @@ extern "C" {
     /** Whether to use the platform native or generic BLAS / LAPACK */
     QudaBoolean native_blas_lapack;
 
+    /** If non-null, per-iteration solver telemetry is reported here */
+    QudaSolverTelemetry *telemetry;
+
   } QudaInvertParam;
 
   // Parameter set for solving eigenvalue problems.
@@ -402,10 +444,18 @@ extern "C" {
     /** Use Polynomial Acceleration **/
     QudaBoolean use_poly_acc;
 
-    /** Degree of the Chebysev polynomial **/
+    /** Degree of the Chebysev polynomial (if not positive, chosen
+        from a_min, a_max and the recorded smallest eigenvalue of the
+        operator, see spectral_bounds.h) **/
     int poly_deg;
 
-    /** Range used in polynomial acceleration **/
+    /** Range used in polynomial acceleration.  If a_max is not
+        positive it is taken from the recorded spectral bounds of the
+        operator, or else from a power iteration.  If a_min is not
+        positive it is set above the largest of the n_conv smallest
+        eigenvalues recorded by an earlier SR eigensolve of the
+        operator.  Values chosen this way are not written back, so
+        each eigensolve chooses them afresh. **/
     double a_min;
     double a_max;
 
@@ -507,6 +557,29 @@ extern "C" {
         MILC I/O) */
     QudaBoolean io_parity_inflate;
 
+    /** If set to half or quarter precision, save the vectors in
+        QUDA's compressed vector format with this precision rather
+        than with QIO (default QUDA_INVALID_PRECISION, no compression) */
+    QudaPrecision io_compress_prec;
+
+    /** Whether to apply the lossless entropy stage when saving
+        compressed vectors (requires QUDA_ZLIB) */
+    QudaBoolean io_compress_lossless;
+
+    /** Filename prefix to checkpoint the thick restart state of the
+        Lanczos eigensolvers to, empty (the default) to disable
+        checkpointing.  The checkpoint is written in the background,
+        one file per process (see eig_checkpoint.h). */
+    char checkpoint_file[256];
+
+    /** Number of thick restarts between checkpoints (default 1) */
+    int checkpoint_interval;
+
+    /** Whether to resume the eigensolve from the checkpoint in
+        checkpoint_file, if there is one.  This requires the same
+        process grid and eigensolver parameters as the run that wrote it. */
+    QudaBoolean resume;
+
     /** The Gflops rate of the eigensolver setup */
     double gflops;
 
@@ -561,6 +634,21 @@ extern "C" {
     /** Maximum number of iterations for refreshing the null-space vectors */
     int setup_maxiter_refresh[QUDA_MAX_MG_LEVEL];
 
+    /** Tolerance of an incremental refresh.  If the refreshed
+        null-space vectors deviate from the range of the prolongator
+        by less than this, the prolongator is kept, and if the coarse
+        operator then deviates from the Galerkin product R D P by less
+        than this, it and all coarser levels are kept too.  It should
+        be above the precision of the coarse operator (default 0,
+        always rebuild) */
+    double setup_refresh_tol[QUDA_MAX_MG_LEVEL];
+
+    /** Number of null-space vectors relaxed and orthonormalized
+        together in the setup phase (0 means all of them).  Blocks are
+        relaxed with the block CG solver when the setup inverter is CG
+        and the block solvers are built. */
+    int setup_block_size[QUDA_MAX_MG_LEVEL];
+
     /** Basis to use for CA-CGN(E/R) setup */
     QudaCABasis setup_ca_basis[QUDA_MAX_MG_LEVEL];
 
@@ -588,6 +676,18 @@ extern "C" {
     /** Tolerance for the solver that wraps around the coarse grid correction and smoother */
     double coarse_solver_tol[QUDA_MAX_MG_LEVEL];
 
+    /** Loosest tolerance of an adaptive coarse solver.  If larger
+        than coarse_solver_tol, the tolerance of the Krylov coarse
+        solver of the level above is relaxed in inverse proportion to
+        the residual reduction of the GCR solve that level is
+        preconditioning, up to this value (default 0, fixed
+        tolerance).  This applies to the recursive solver of a K-cycle
+        and to the bottom solver of a V- or W-cycle, the latter only
+        when the level above is the outermost level, since the
+        intermediate levels of a V- or W-cycle do not precondition a
+        GCR solve */
+    double coarse_solver_tol_max[QUDA_MAX_MG_LEVEL];
+
     /** Maximum number of iterations for the solver that wraps around the coarse grid correction and smoother */
     int coarse_solver_maxiter[QUDA_MAX_MG_LEVEL];
 
@@ -681,6 +781,25 @@ extern "C" {
     /** Filename prefix for where to save the null-space vectors */
     char vec_outfile[QUDA_MAX_MG_LEVEL][256];
 
+    /** If set to half or quarter precision, save the null-space
+        vectors in QUDA's compressed vector format with this precision
+        rather than with QIO (default QUDA_INVALID_PRECISION, no
+        compression) */
+    QudaPrecision vec_compress_prec[QUDA_MAX_MG_LEVEL];
+
+    /** Whether to apply the lossless entropy stage when saving
+        compressed null-space vectors (requires QUDA_ZLIB) */
+    QudaBoolean vec_compress_lossless;
+
+    /** Directory in which to persist the setup hierarchy (null-space
+        vectors, prolongators and coarse operators) per gauge
+        configuration, so that a later setup on the same configuration
+        and parameters loads it instead of recomputing it.  Only
+        configurations loaded from host fields are cached, and for
+        clover operators only clover fields computed by QUDA or loaded
+        from host fields (default "", no caching) */
+    char hierarchy_cache[256];
+
     /** Whether to use and initial guess during coarse grid deflation */
     QudaBoolean coarse_guess;
 
@@ -914,6 +1033,24 @@ extern "C" {
 
   /**
    * Load the gauge field from the host.
+   *
+   * If param->reference_gauge is set, and the field is accessible from
+   * the device (device or managed memory) and is already in the
+   * native order, precision (cpu_prec == cuda_prec), reconstruction
+   * and padding (ga_pad) of the precise field, then the field is
+   * adopted as the resident precise field without being copied, and
+   * the sloppy, preconditioner and refinement fields are not created
+   * until they are first needed by a solver.  Otherwise the field is
+   * copied as normal.  When the field is adopted:
+   *   - it must remain allocated until the resident field is freed
+   *     by freeGaugeQuda or replaced by the next loadGaugeQuda of the
+   *     same link type, and QUDA never frees it;
+   *   - QUDA writes the ghost zones into its padded region, and
+   *     operations that act on the resident field in place (e.g.,
+   *     gauge fixing or applying the staggered phases) modify it;
+   *   - the caller must not modify it otherwise, and must call
+   *     loadGaugeQuda again if it does, so that the lower precision
+   *     fields are rebuilt.
    * @param h_gauge Base pointer to host gauge field (regardless of dimensionality)
    * @param param   Contains all metadata regarding host and device storage
    */
@@ -931,6 +1068,46 @@ extern "C" {
    */
   void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param);
 
+  /**
+   * Write a checkpoint of a resident gauge field in the background.
+   * A host snapshot of the field is taken and the file is created
+   * before returning, while the data are written in ILDG format by a
+   * background I/O thread.  This is collective.
+   * @param filename File to write to
+   * @param param   Selects the resident field (param->type, as with
+   *                saveGaugeQuda) and the file precision (param->cpu_prec)
+   * @return Handle to pass to checkpointTestQuda and checkpointWaitQuda
+   */
+  int saveGaugeAsyncQuda(const char *filename, QudaGaugeParam *param);
+
+  /**
+   * Write a checkpoint of the resident momentum field in the
+   * background.  The momentum is written as full anti-Hermitian
+   * matrices in ILDG format, otherwise this is as saveGaugeAsyncQuda.
+   * @param filename File to write to
+   * @param param   The file precision is given by param->cpu_prec
+   * @return Handle to pass to checkpointTestQuda and checkpointWaitQuda
+   */
+  int saveMomAsyncQuda(const char *filename, QudaGaugeParam *param);
+
+  /**
+   * Query whether this process has finished writing its data for a
+   * checkpoint.  This is not collective, and the checkpoint must
+   * still be completed with checkpointWaitQuda.
+   * @param handle Handle returned by saveGaugeAsyncQuda or saveMomAsyncQuda
+   * @return 1 if the local data have been written, else 0
+   */
+  int checkpointTestQuda(int handle);
+
+  /**
+   * Wait for a checkpoint to complete, after which the file is
+   * complete on disk.  This is collective.  endQuda waits for any
+   * outstanding checkpoints.
+   * @param handle Handle returned by saveGaugeAsyncQuda or
+   *               saveMomAsyncQuda, or negative to wait for all
+   */
+  void checkpointWaitQuda(int handle);
+
   /**
    * Load the clover term and/or the clover inverse from the host.
    * Either h_clover or h_clovinv may be set to NULL.
@@ -979,6 +1156,38 @@ extern "C" {
    */
   void invertQuda(void *h_x, void *h_b, QudaInvertParam *param);
 
+  /**
+   * Submit a solve like @invertQuda, returning before it completes.
+   * The reordering of the host source into the device order, and of
+   * the solution back into the host order, are done on a background
+   * host thread, overlapping with the device solves of other
+   * requests: each request is solved on the calling thread at the
+   * next call to invertAsyncQuda or waitQuda, so that a sequence of
+   * submissions followed by waits pipelines the host and device
+   * work.  The arrays h_x and h_b, and param itself, are owned by
+   * QUDA until waitQuda returns for this request and must not be
+   * accessed or modified in the meantime; the solver statistics are
+   * written to param on completion.  Loading or freeing the gauge or
+   * clover fields first completes all outstanding requests.  If
+   * either array is in device memory the solve is done immediately.
+   * @param h_x    Solution spinor field
+   * @param h_b    Source spinor field
+   * @param param  Contains all metadata regarding host and device
+   *               storage and solver parameters
+   * @return Handle to pass to waitQuda
+   */
+  int invertAsyncQuda(void *h_x, void *h_b, QudaInvertParam *param);
+
+  /**
+   * Wait for a solve submitted with invertAsyncQuda to complete,
+   * after which the solution is in h_x and the caller again owns
+   * h_x, h_b and param.  Any earlier outstanding requests are solved
+   * first.
+   * @param handle Handle returned by invertAsyncQuda, or negative to
+   * wait for all outstanding requests
+   */
+  void waitQuda(int handle);
+
   /**
    * Perform the solve like @invertQuda but for multiples right hand sides.
    *
@@ -1425,6 +1634,58 @@ extern "C" {
 
   void setMPICommHandleQuda(void *mycomm);
 
+  /**
+   * Handle to an interface context.  A context owns its own resident
+   * gauge, clover and momentum fields (with their gauge mirror usage
+   * and eviction order), resident solutions, chronological bases,
+   * outstanding asynchronous solves and their handles, and
+   * gauge/clover/solver profiles.  The legacy API works on the
+   * default context, which has no handle.  The *_ctx
+   * variants below behave as the corresponding functions, but on the
+   * given context.  Contexts keep their state apart, but do not run
+   * concurrently: interface calls may be made from any thread, but
+   * are serialized under a single process-wide lock, since the
+   * device, autotuner, memory pools and communicators are shared by
+   * all contexts.  The exceptions are the calls that set up the library
+   * (setVerbosityQuda, setMPICommHandleQuda, initCommsGridQuda and
+   * initQuda*), which must complete before any other call is made.
+   */
+  typedef struct QudaContext_s *QudaContext;
+
+  /**
+   * @brief Create a new, empty, interface context
+   * @return The context
+   */
+  QudaContext newQudaContext(void);
+
+  /**
+   * @brief Complete any outstanding solves on a context, free all of
+   * its resident fields and destroy it.  Any contexts that remain are
+   * destroyed by endQuda.
+   * @param[in] ctx The context to destroy
+   */
+  void destroyQudaContext(QudaContext ctx);
+
+  void loadGaugeQuda_ctx(QudaContext ctx, void *h_gauge, QudaGaugeParam *param);
+  void freeGaugeQuda_ctx(QudaContext ctx);
+  void saveGaugeQuda_ctx(QudaContext ctx, void *h_gauge, QudaGaugeParam *param);
+  void loadCloverQuda_ctx(QudaContext ctx, void *h_clover, void *h_clovinv, QudaInvertParam *inv_param);
+  void freeCloverQuda_ctx(QudaContext ctx);
+  void flushChronoQuda_ctx(QudaContext ctx, int index);
+  void plaqQuda_ctx(QudaContext ctx, double plaq[3]);
+  void dslashQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity parity);
+  void MatQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param);
+  void MatDagMatQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param);
+  void invertQuda_ctx(QudaContext ctx, void *h_x, void *h_b, QudaInvertParam *param);
+  int invertAsyncQuda_ctx(QudaContext ctx, void *h_x, void *h_b, QudaInvertParam *param);
+  void waitQuda_ctx(QudaContext ctx, int handle);
+  void invertMultiSrcQuda_ctx(QudaContext ctx, void **_hp_x, void **_hp_b, QudaInvertParam *param);
+  void invertMultiShiftQuda_ctx(QudaContext ctx, void **_hp_x, void *_hp_b, QudaInvertParam *param);
+  void eigensolveQuda_ctx(QudaContext ctx, void **h_evecs, double_complex *h_evals, QudaEigParam *param);
+  void *newMultigridQuda_ctx(QudaContext ctx, QudaMultigridParam *param);
+  void updateMultigridQuda_ctx(QudaContext ctx, void *mg_instance, QudaMultigridParam *param);
+  void destroyMultigridQuda_ctx(QudaContext ctx, void *mg_instance);
+
 #ifdef __cplusplus
 }
 #endif
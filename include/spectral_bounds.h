@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+   @file spectral_bounds.h
+
+   @brief Record of the spectral bound estimates made for each
+   operator, so that the Chebyshev interval and degree of the
+   polynomial accelerated eigensolvers, and the lambda_max of the
+   CA-CG Chebyshev basis, can be taken from earlier estimates instead
+   of a fresh power iteration.  An operator is identified by its
+   Dirac and matrix types, its parameters and the lattice geometry,
+   and each estimate is tagged with the hash of the gauge
+   configuration it was made on.  Along an HMC stream the bounds move
+   slowly, so an estimate made on an earlier configuration is reused
+   on a later one, widened by a relative drift margin.
+
+   Estimates are recorded from the power iterations of the
+   eigensolvers and CA-CG, from the Lanczos matrix implied by the CG
+   coefficients, and from the eigenvalues of converged Hermitian
+   eigensolves.  The record is local to each process, but is the same
+   on all processes since the estimates come from global reductions.
+
+   Setting QUDA_ENABLE_SPECTRAL_BOUNDS=0 disables the reuse of
+   estimates, and QUDA_SPECTRAL_BOUNDS_DRIFT (default 0.05) sets the
+   drift margin.
+ */
+
+#include <vector>
+#include <stdint.h>
+
+namespace quda
+{
+
+  class DiracMatrix;
+  class ColorSpinorField;
+
+  namespace spectral
+  {
+
+    /**
+       Where an estimate came from, in increasing order of accuracy
+     */
+    enum Source { SPECTRAL_POWER, SPECTRAL_LANCZOS, SPECTRAL_EIGENSOLVE };
+
+    /**
+       @brief Identifies an operator and the gauge configuration it was built from
+     */
+    struct Key {
+      uint64_t op;    // operator type, parameters and geometry
+      uint64_t gauge; // gauge configuration, or 0 if unknown
+    };
+
+    /**
+       @brief Spectral bounds returned by lookup.  Bounds recorded on
+       another gauge configuration have been widened by the drift
+       margin.
+     */
+    struct Bounds {
+      bool has_min = false;
+      bool has_max = false;
+      bool has_edge = false;
+      double lambda_min = 0.0; // estimate of the smallest eigenvalue
+      double lambda_max = 0.0; // estimate of the largest eigenvalue
+      double edge = 0.0;       // largest of the edge_rank smallest eigenvalues
+      int edge_rank = 0;
+      bool exact = true; // whether all bounds were recorded on this gauge configuration
+    };
+
+    /**
+       @brief Set the parameters of the operator being solved that are
+       not visible from the Dirac operator itself, and the gauge
+       configuration hash.  This is set by the interface at the start
+       of each solve.
+       @param[in] params Hash of the operator parameters
+       @param[in] gauge Hash of the gauge configuration, or 0 if unknown
+     */
+    void setContext(uint64_t params, uint64_t gauge);
+
+    /**
+       @brief Return the key of an operator in the current context
+       @param[in] mat The operator
+       @param[in] v A field the operator acts on, giving the geometry
+       @return The key
+     */
+    Key key(const DiracMatrix &mat, const ColorSpinorField &v);
+
+    /**
+       @brief Look up the recorded bounds of an operator
+       @param[in] key The operator
+       @param[out] bounds The recorded bounds
+       @return Whether any bound is recorded and reuse is enabled
+     */
+    bool lookup(const Key &key, Bounds &bounds);
+
+    /**
+       @brief Record an estimate of the smallest eigenvalue.  An
+       estimate from the same configuration only replaces one from a
+       more accurate source, or a larger one from the same source.
+       @param[in] key The operator
+       @param[in] lambda The estimate
+       @param[in] source Where the estimate came from
+     */
+    void recordMin(const Key &key, double lambda, Source source);
+
+    /**
+       @brief Record an estimate of the largest eigenvalue.  An
+       estimate from the same configuration only replaces one from a
+       more accurate source, or a smaller one from the same source.
+       @param[in] key The operator
+       @param[in] lambda The estimate
+       @param[in] source Where the estimate came from
+     */
+    void recordMax(const Key &key, double lambda, Source source);
+
+    /**
+       @brief Record the largest of the rank smallest eigenvalues, as
+       found by an eigensolve
+       @param[in] key The operator
+       @param[in] edge The eigenvalue
+       @param[in] rank The number of eigenvalues
+     */
+    void recordEdge(const Key &key, double edge, int rank);
+
+    /**
+       @brief Estimate the extreme eigenvalues of a Hermitian operator
+       from the coefficients of a conjugate gradient solve, from the
+       Lanczos tridiagonal matrix they define
+       @param[in] alpha CG step lengths
+       @param[in] beta CG direction update coefficients (one fewer than alpha)
+       @param[out] lambda_min Smallest Ritz value
+       @param[out] lambda_max Largest Ritz value
+       @return Whether there were enough coefficients for an estimate
+     */
+    bool lanczosBounds(const std::vector<double> &alpha, const std::vector<double> &beta, double &lambda_min,
+                       double &lambda_max);
+
+    /**
+       @brief Return the lowest degree of Chebyshev filter on the
+       interval [a_min, a_max] that amplifies an eigenvalue lambda <
+       a_min by at least gain relative to the interval
+       @param[in] lambda Eigenvalue to amplify
+       @param[in] a_min Lower end of the damped interval
+       @param[in] a_max Upper end of the damped interval
+       @param[in] gain Amplification required
+       @return The degree, or 0 if lambda is not below the interval
+     */
+    int chebyshevDegree(double lambda, double a_min, double a_max, double gain);
+
+  } // namespace spectral
+
+} // namespace quda
@@ -11,6 +11,7 @@
  */
 
 #include <color_spinor_field.h>
+#include <mg_profile.h>
 #include <vector>
 
 namespace quda {
@@ -149,6 +150,12 @@ namespace quda {
      */
     mutable double flops_;
 
+    /**
+     * Performance counters of the prolongator and restrictor
+     */
+    mutable MGCounter prolong_counter;
+    mutable MGCounter restrict_counter;
+
     /**
      * Reference to profile kept in the corresponding MG instance.
      * Use this to record restriction and prolongation overhead.
@@ -167,18 +174,35 @@ namespace quda {
        * @param parity For single-parity fields are these QUDA_EVEN_PARITY or QUDA_ODD_PARITY
        * @param null_precision The precision to store the null-space basis vectors in
        * @param enable_gpu Whether to enable this to run on GPU (as well as CPU)
+       * @param orthogonalize Whether to block orthogonalize the
+       * null-space vectors now, else the prolongator is to be set with
+       * setVectors
        */
       Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int NblockOrtho, int *geo_bs, int spin_bs,
-               QudaPrecision null_precision, TimeProfile &profile);
+               QudaPrecision null_precision, TimeProfile &profile, bool orthogonalize = true);
 
       /** The destructor for Transfer */
       virtual ~Transfer();
 
+      /**
+         @brief Free the aggregation maps kept for reuse by later
+         transfer operators of the same geometry and blocking
+       */
+      static void freeGeoMapCache();
+
       /**
        @brief for resetting the Transfer when the null vectors have changed
        */
       void reset();
 
+      /**
+         @brief Set the block-orthonormalized prolongator directly,
+         e.g., from a persisted hierarchy, instead of computing it from
+         the null-space vectors
+         @param V The prolongator, with the same parameters as Vectors()
+       */
+      void setVectors(const ColorSpinorField &V);
+
       /**
        * Apply the prolongator
        * @param out The resulting field on the fine lattice
@@ -266,6 +290,16 @@ namespace quda {
      * @return flops expended by this operator
      */
     double flops() const;
+
+    /**
+     * @return The performance counter of the prolongator
+     */
+    const MGCounter &prolongCounter() const { return prolong_counter; }
+
+    /**
+     * @return The performance counter of the restrictor
+     */
+    const MGCounter &restrictCounter() const { return restrict_counter; }
   };
 
   /**
@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+   @file vector_compress.h
+
+   @brief Native parallel reader and writer for QUDA's compressed
+   vector container, used to store deflation eigenvectors and
+   multigrid null-space vectors at reduced size.  Each site is
+   encoded in block floating point, matching QUDA's own half
+   (16-bit) and quarter (8-bit) precision field storage: a per-site
+   float norm (the maximum absolute component) together with the
+   fixed-point components scaled by this norm.  An optional lossless
+   entropy stage (zlib deflate of the byte-plane shuffled data,
+   requires QUDA_ZLIB) can be applied on top.
+
+   Vectors are written in records (chunks of vectors), with each
+   process writing a self-contained block of its sub-lattice per
+   record.  Every block carries a CRC32 checksum of its stored bytes
+   which is verified on reading.  The file can be read with any
+   process grid: each process decodes the blocks that overlap its
+   sub-lattice directly into the target host field.
+ */
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <enum_quda.h>
+
+namespace quda
+{
+
+  class ColorSpinorField;
+
+  /**
+     @brief Fixed-size header at the start of a compressed vector file
+   */
+  struct CompressedVectorHeader {
+    char magic[8];        /**< File identifier "QUDAVCMP" */
+    uint32_t byte_order;  /**< 0x01020304 in the byte order of the writer */
+    int32_t version;      /**< Format version */
+    int32_t L[4];         /**< Global lattice dimensions (full field) */
+    int32_t Ls;           /**< Fifth dimension (1 for 4-d fields) */
+    int32_t nSpin;        /**< Number of spin components */
+    int32_t nColor;       /**< Number of color components */
+    int32_t subset;       /**< QudaSiteSubset of the vectors */
+    int32_t parity;       /**< QudaParity of single-parity vectors */
+    int32_t nvec;         /**< Total number of vectors */
+    int32_t bytes;        /**< Bytes per fixed-point component (2 or 1) */
+    int32_t lossless;     /**< Whether the entropy stage is applied */
+    int32_t grid[4];      /**< Process grid of the writer */
+    int32_t n_record;     /**< Number of records */
+    int64_t index_offset; /**< File offset of the block index */
+  };
+
+  /**
+     @brief Index entry describing the block written by one process
+     for one record
+   */
+  struct CompressedVectorBlock {
+    uint64_t offset;    /**< File offset of the block */
+    uint64_t bytes;     /**< Stored size of the block */
+    uint64_t raw_bytes; /**< Size of the block before the entropy stage */
+    uint32_t crc;       /**< CRC32 of the stored bytes */
+    int32_t nvec;       /**< Number of vectors in the record */
+  };
+
+  /**
+     @brief Return whether filename is a compressed vector file
+     @param[in] filename File to inspect
+   */
+  bool isCompressedVectorFile(const std::string &filename);
+
+  /**
+     @brief Collective writer for compressed vector files
+   */
+  class CompressedVectorWriter
+  {
+    const std::string filename;
+    CompressedVectorHeader header;
+    std::vector<CompressedVectorBlock> index;
+    int fd;
+    int64_t position;
+    double raw_bytes;
+    double stored_bytes;
+
+  public:
+    /**
+       @brief Create a compressed vector file
+       @param[in] filename File to write to
+       @param[in] v Representative host vector (space-spin-color order)
+       @param[in] nvec Total number of vectors that will be written
+       @param[in] prec Encoding precision (QUDA_HALF_PRECISION or QUDA_QUARTER_PRECISION)
+       @param[in] lossless Whether to apply the lossless entropy stage
+     */
+    CompressedVectorWriter(const std::string &filename, const ColorSpinorField &v, int nvec, QudaPrecision prec,
+                           bool lossless);
+
+    /**
+       @brief Write the index and header, and close the file
+     */
+    ~CompressedVectorWriter();
+
+    /**
+       @brief Encode and write a record of vectors.  This is collective
+       and every process must write the same number of vectors.
+       @param[in] v Set of host vectors
+       @param[in] first First vector of the record in v
+       @param[in] n Number of vectors in the record
+     */
+    void write(const std::vector<ColorSpinorField *> &v, int first, int n);
+  };
+
+  /**
+     @brief Reader for compressed vector files
+   */
+  class CompressedVectorReader
+  {
+    const std::string filename;
+    CompressedVectorHeader header;
+    std::vector<CompressedVectorBlock> index;
+    std::vector<int> blocks; // writer blocks that overlap the local sub-lattice
+    int fd;
+    int record;
+
+  public:
+    /**
+       @brief Open a compressed vector file, and check that it is
+       compatible with the vectors it will be read into
+       @param[in] filename File to read from
+       @param[in] v Representative host vector (space-spin-color order)
+     */
+    CompressedVectorReader(const std::string &filename, const ColorSpinorField &v);
+
+    ~CompressedVectorReader();
+
+    /**
+       @return The number of vectors in the next record, or zero if
+       there are no records left
+     */
+    int count() const;
+
+    /**
+       @brief Read and decode the next record of vectors
+       @param[out] v Set of host vectors
+       @param[in] first First vector of the record in v
+       @param[in] n Number of vectors in the record (must equal count())
+     */
+    void read(const std::vector<ColorSpinorField *> &v, int first, int n);
+  };
+
+} // namespace quda
@@ -1,20 +1,33 @@
 #pragma once
 
 #include <string>
+#include <enum_quda.h>
 
 namespace quda
 {
 
   /**
      @brief VectorIO is a simple wrapper class for loading and saving
-     sets of vector fields using QIO.
+     sets of vector fields using QIO.  Vectors are streamed through
+     host memory in chunks of chunk_size vectors, with each chunk
+     stored as a separate QIO record, so the peak temporary host
+     memory is bounded by two chunks independent of the number of
+     vectors.  The file I/O of one chunk is overlapped with the
+     conversion, parity inflation / deflation and host-device
+     transfer of the neighboring chunk.  Files written with a single
+     record (as done prior to chunking) can still be loaded.
+
+     Vectors can optionally be saved in QUDA's compressed vector
+     format (see vector_compress.h), which does not require QIO.
+     Compressed files are detected automatically when loading.
    */
   class VectorIO
   {
     const std::string filename;
-#ifdef HAVE_QIO
     bool parity_inflate;
-#endif
+    int chunk_size;
+    QudaPrecision compress_prec;
+    bool compress_lossless;
   public:
 
     /**
@@ -22,8 +35,16 @@ namespace quda
        @param[in] filename The filename associated with this IO object
        @param[in] parity_inflate Whether to inflate single_parity
        field to dual parity fields for I/O
+       @param[in] chunk_size Number of vectors per chunk.  If zero
+       this is set from the environment variable QUDA_VECTOR_IO_CHUNK
+       (default 32).
+       @param[in] compress_prec If half or quarter precision, save the
+       vectors in the compressed format with this precision
+       @param[in] compress_lossless Whether to apply the lossless
+       entropy stage when saving in the compressed format
     */
-    VectorIO(const std::string &filename, bool parity_inflate = false);
+    VectorIO(const std::string &filename, bool parity_inflate = false, int chunk_size = 0,
+             QudaPrecision compress_prec = QUDA_INVALID_PRECISION, bool compress_lossless = false);
 
     /**
        @brief Load vectors from filename
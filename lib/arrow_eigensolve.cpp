@@ -0,0 +1,432 @@
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <util_quda.h>
+#include <arrow_eigensolve.h>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Dense>
+
+namespace quda
+{
+
+  using namespace Eigen;
+
+  namespace
+  {
+
+    // tridiagonal blocks up to this size are solved directly with implicit QL
+    constexpr int leaf_size = 32;
+
+    // iteration limit of the secular equation root finder
+    constexpr int max_secular_iter = 200;
+
+    constexpr double epsilon = std::numeric_limits<double>::epsilon();
+
+    /**
+       Plane rotation used to deflate two (nearly) equal poles: in the
+       rotated coordinates, e_q -> c e_q - s e_p and e_p -> s e_q + c e_p
+     */
+    struct Rotation {
+      int q;
+      int p;
+      double c;
+      double s;
+    };
+
+    /**
+       @brief Evaluate the secular function of the arrowhead, shifted
+       to the pole d[o],
+       g(tau) = (alpha - d[o]) - tau - sum_i z_i^2 / ((d_i - d[o]) - tau),
+       which is strictly decreasing between consecutive poles.
+     */
+    inline double secular(const std::vector<double> &d, const std::vector<double> &z, double alpha, int o,
+                          double tau, double &deriv)
+    {
+      double g = (alpha - d[o]) - tau;
+      deriv = -1.0;
+      for (unsigned int i = 0; i < d.size(); i++) {
+        double t = z[i] / ((d[i] - d[o]) - tau);
+        g -= z[i] * t;
+        deriv -= t * t;
+      }
+      return g;
+    }
+
+  } // namespace
+
+  /**
+     One divide-and-conquer merge: the matrix is split at a single
+     row, the blocks either side of it are diagonalized, and what is
+     left is the arrowhead [[diag(d), z], [z^T, alpha]] in the basis of
+     the block eigenvectors ("arrow coordinates": left poles, right
+     poles, then the tip).  The arrowhead solution is stored in
+     factored form, and the eigenvectors are formed on demand.
+   */
+  struct ArrowEigensolver::Merge {
+    int n = 0;
+    int n_left = 0;
+    int n_right = 0;
+    bool left_identity = true;
+    MatrixXd q_left;
+    MatrixXd q_right;
+
+    // non-deflated poles in increasing order, their arrow coordinate and recomputed arrow vector
+    std::vector<double> pole;
+    std::vector<int> coord;
+    std::vector<double> zhat;
+    std::vector<Rotation> rot;
+
+    // eigenvalues in increasing order, either a root of the secular
+    // equation at pole[origin] + tau, or deflated (origin < 0) with
+    // unit eigenvector in the (rotated) coordinate unit
+    std::vector<double> lambda;
+    std::vector<int> origin;
+    std::vector<double> tau;
+    std::vector<int> unit;
+
+    /**
+       @brief Full eigendecomposition of a symmetric tridiagonal matrix
+       by divide and conquer
+     */
+    static void tridiagonal(const double *diag, const double *off, int n, VectorXd &lambda, MatrixXd &Q);
+
+    void build(const double *diag, const double *off, int n, int arrow_pos);
+    void solve(std::vector<double> d, std::vector<double> z, double alpha);
+    void column(double *x, int j) const;
+    void vectors(MatrixXd &Q, int n_vec) const;
+    void project(double *out, const double *r) const;
+  };
+
+  void ArrowEigensolver::Merge::tridiagonal(const double *diag, const double *off, int n, VectorXd &lambda, MatrixXd &Q)
+  {
+    if (n <= leaf_size) {
+      VectorXd d = Map<const VectorXd>(diag, n);
+      VectorXd e = n > 1 ? VectorXd(Map<const VectorXd>(off, n - 1)) : VectorXd(0);
+      SelfAdjointEigenSolver<MatrixXd> eigensolver;
+      eigensolver.computeFromTridiagonal(d, e, ComputeEigenvectors);
+      lambda = eigensolver.eigenvalues();
+      Q = eigensolver.eigenvectors();
+    } else {
+      Merge merge;
+      merge.build(diag, off, n, 0);
+      lambda = Map<const VectorXd>(merge.lambda.data(), n);
+      merge.vectors(Q, n);
+    }
+  }
+
+  void ArrowEigensolver::Merge::build(const double *diag, const double *off, int n_, int arrow_pos)
+  {
+    n = n_;
+    // a diagonal leading block is coupled through the arrow, else split the tridiagonal matrix in half
+    n_left = arrow_pos > 0 ? arrow_pos : n / 2;
+    n_right = n - n_left - 1;
+    left_identity = arrow_pos > 0;
+
+    std::vector<double> d(n - 1);
+    std::vector<double> z(n - 1);
+
+    if (left_identity) {
+      q_left.resize(0, 0);
+      for (int i = 0; i < n_left; i++) {
+        d[i] = diag[i];
+        z[i] = off[i];
+      }
+    } else if (n_left > 0) {
+      VectorXd lambda_left;
+      tridiagonal(diag, off, n_left, lambda_left, q_left);
+      for (int i = 0; i < n_left; i++) {
+        d[i] = lambda_left[i];
+        z[i] = off[n_left - 1] * q_left(n_left - 1, i);
+      }
+    }
+
+    if (n_right > 0) {
+      VectorXd lambda_right;
+      tridiagonal(diag + n_left + 1, off + n_left + 1, n_right, lambda_right, q_right);
+      for (int i = 0; i < n_right; i++) {
+        d[n_left + i] = lambda_right[i];
+        z[n_left + i] = off[n_left] * q_right(0, i);
+      }
+    } else {
+      q_right.resize(0, 0);
+    }
+
+    solve(std::move(d), std::move(z), diag[n_left]);
+  }
+
+  void ArrowEigensolver::Merge::solve(std::vector<double> d, std::vector<double> z, double alpha)
+  {
+    const int k = d.size();
+    const int tip = k;
+
+    pole.clear();
+    coord.clear();
+    rot.clear();
+    std::vector<double> z_pole;
+
+    // deflated eigenpairs, merged with the secular roots at the end
+    std::vector<double> lambda_deflated;
+    std::vector<int> unit_deflated;
+
+    double scale = fabs(alpha);
+    double z_norm = 0.0;
+    for (int i = 0; i < k; i++) {
+      scale = std::max(scale, fabs(d[i]));
+      z_norm += z[i] * z[i];
+    }
+    z_norm = sqrt(z_norm);
+    const double tol = 8.0 * epsilon * std::max(scale, z_norm);
+
+    std::vector<int> perm(k);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::stable_sort(perm.begin(), perm.end(), [&](int a, int b) { return d[a] < d[b]; });
+
+    // Deflation: a negligible arrow entry decouples its pole, and of
+    // two poles closer than the tolerance one is rotated out of the arrow
+    for (int s = 0; s < k; s++) {
+      int p = perm[s];
+      if (fabs(z[p]) <= tol) {
+        lambda_deflated.push_back(d[p]);
+        unit_deflated.push_back(p);
+        continue;
+      }
+      if (pole.size() > 0 && d[p] - pole.back() <= tol) {
+        int q = coord.back();
+        double r = hypot(z[q], z[p]);
+        double c = z[p] / r;
+        double sn = z[q] / r;
+        rot.push_back({q, p, c, sn});
+        z[p] = r;
+        z[q] = 0.0;
+        double d_q = c * c * d[q] + sn * sn * d[p];
+        d[p] = sn * sn * d[q] + c * c * d[p];
+        lambda_deflated.push_back(d_q);
+        unit_deflated.push_back(q);
+        pole.pop_back();
+        coord.pop_back();
+        z_pole.pop_back();
+      }
+      pole.push_back(d[p]);
+      coord.push_back(p);
+      z_pole.push_back(z[p]);
+    }
+
+    // Roots of the secular equation: one between each pair of
+    // consecutive poles, and one either side of the poles
+    const int n_pole = pole.size();
+    std::vector<int> origin_root(n_pole + 1);
+    std::vector<double> tau_root(n_pole + 1);
+
+    if (n_pole > 0) {
+      double zp_norm = 0.0;
+      for (int i = 0; i < n_pole; i++) zp_norm += z_pole[i] * z_pole[i];
+      zp_norm = sqrt(zp_norm);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+      for (int j = 0; j <= n_pole; j++) {
+        // bracket the root, measured from the nearer of its two poles
+        int o;
+        double lo, hi, deriv;
+        if (j == 0) {
+          o = 0;
+          lo = std::min(pole[0], alpha) - zp_norm - pole[0];
+          hi = 0.0;
+        } else if (j == n_pole) {
+          o = n_pole - 1;
+          lo = 0.0;
+          hi = std::max(pole[o], alpha) + zp_norm - pole[o];
+        } else {
+          double gap = pole[j] - pole[j - 1];
+          double g = secular(pole, z_pole, alpha, j - 1, 0.5 * gap, deriv);
+          if (g > 0.0) {
+            o = j;
+            lo = -0.5 * gap;
+            hi = 0.0;
+          } else {
+            o = j - 1;
+            lo = 0.0;
+            hi = 0.5 * gap;
+          }
+        }
+
+        // safeguarded Newton iteration, falling back to bisection
+        double t = 0.5 * (lo + hi);
+        for (int iter = 0; iter < max_secular_iter; iter++) {
+          double g = secular(pole, z_pole, alpha, o, t, deriv);
+          if (g == 0.0) break;
+          if (g > 0.0)
+            lo = t;
+          else
+            hi = t;
+          double t_new = t - g / deriv;
+          if (!(t_new > lo && t_new < hi)) t_new = 0.5 * (lo + hi);
+          bool done = fabs(t_new - t) <= 2.0 * epsilon * fabs(t_new)
+            || hi - lo <= 2.0 * epsilon * std::max(fabs(lo), fabs(hi));
+          t = t_new;
+          if (done) break;
+        }
+        origin_root[j] = o;
+        tau_root[j] = t;
+      }
+
+      // Recompute the arrow vector from the computed eigenvalues
+      // (Lowner), so the eigenvectors are orthogonal to working precision:
+      // zhat_i^2 = -(lambda_i - d_i)(lambda_K - d_i) prod_{l != i} (lambda_l - d_i) / (d_l - d_i)
+      zhat.resize(n_pole);
+      auto shift = [&](int l, int i) { return (pole[origin_root[l]] - pole[i]) + tau_root[l]; };
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (int i = 0; i < n_pole; i++) {
+        double prod = -shift(i, i) * shift(n_pole, i);
+        for (int l = 0; l < n_pole; l++)
+          if (l != i) prod *= shift(l, i) / (pole[l] - pole[i]);
+        zhat[i] = copysign(sqrt(std::max(prod, 0.0)), z_pole[i]);
+      }
+    } else {
+      // the tip is decoupled
+      zhat.clear();
+      lambda_deflated.push_back(alpha);
+      unit_deflated.push_back(tip);
+    }
+
+    // Merge the roots and the deflated eigenvalues in increasing order
+    const int n_root = n_pole > 0 ? n_pole + 1 : 0;
+    const int n_eig = n_root + lambda_deflated.size();
+    std::vector<double> value(n_eig);
+    for (int j = 0; j < n_root; j++) value[j] = pole[origin_root[j]] + tau_root[j];
+    for (unsigned int j = 0; j < lambda_deflated.size(); j++) value[n_root + j] = lambda_deflated[j];
+
+    std::vector<int> order(n_eig);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return value[a] < value[b]; });
+
+    lambda.resize(n_eig);
+    origin.resize(n_eig);
+    tau.resize(n_eig);
+    unit.resize(n_eig);
+    for (int j = 0; j < n_eig; j++) {
+      int e = order[j];
+      lambda[j] = value[e];
+      if (e < n_root) {
+        origin[j] = origin_root[e];
+        tau[j] = tau_root[e];
+        unit[j] = -1;
+      } else {
+        origin[j] = -1;
+        tau[j] = 0.0;
+        unit[j] = unit_deflated[e - n_root];
+      }
+    }
+  }
+
+  void ArrowEigensolver::Merge::column(double *x, int j) const
+  {
+    const int tip = n - 1;
+    std::fill(x, x + n, 0.0);
+
+    if (origin[j] < 0) {
+      x[unit[j]] = 1.0;
+    } else {
+      // (D - lambda)^{-1} zhat, with the differences formed relative to the origin pole
+      const int o = origin[j];
+      const double t = tau[j];
+      double norm2 = 1.0;
+      for (unsigned int i = 0; i < pole.size(); i++) {
+        double v = zhat[i] / ((pole[i] - pole[o]) - t);
+        x[coord[i]] = v;
+        norm2 += v * v;
+      }
+      x[tip] = -1.0;
+      double inv_norm = 1.0 / sqrt(norm2);
+      for (unsigned int i = 0; i < pole.size(); i++) x[coord[i]] *= inv_norm;
+      x[tip] *= inv_norm;
+    }
+
+    // undo the deflation rotations
+    for (auto r = rot.rbegin(); r != rot.rend(); r++) {
+      double x_q = x[r->q];
+      double x_p = x[r->p];
+      x[r->q] = r->c * x_q + r->s * x_p;
+      x[r->p] = -r->s * x_q + r->c * x_p;
+    }
+  }
+
+  void ArrowEigensolver::Merge::vectors(MatrixXd &Q, int n_vec) const
+  {
+    // eigenvectors of the arrowhead
+    MatrixXd W(n, n_vec);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int j = 0; j < n_vec; j++) column(W.col(j).data(), j);
+
+    // back transform with the eigenvectors of the two blocks
+    Q.resize(n, n_vec);
+    if (left_identity)
+      Q.topRows(n_left) = W.topRows(n_left);
+    else if (n_left > 0)
+      Q.topRows(n_left).noalias() = q_left * W.topRows(n_left);
+    Q.row(n_left) = W.row(n - 1);
+    if (n_right > 0) Q.bottomRows(n_right).noalias() = q_right * W.middleRows(n_left, n_right);
+  }
+
+  void ArrowEigensolver::Merge::project(double *out, const double *r) const
+  {
+    // the row vector in arrow coordinates
+    Map<const VectorXd> r_vec(r, n);
+    VectorXd ra(n);
+    if (left_identity)
+      ra.head(n_left) = r_vec.head(n_left);
+    else if (n_left > 0)
+      ra.head(n_left).noalias() = q_left.transpose() * r_vec.head(n_left);
+    if (n_right > 0) ra.segment(n_left, n_right).noalias() = q_right.transpose() * r_vec.tail(n_right);
+    ra[n - 1] = r[n_left];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      VectorXd x(n);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (int j = 0; j < n; j++) {
+        column(x.data(), j);
+        out[j] = ra.dot(x);
+      }
+    }
+  }
+
+  ArrowEigensolver::ArrowEigensolver() : merge(new Merge) { }
+
+  ArrowEigensolver::~ArrowEigensolver() = default;
+
+  void ArrowEigensolver::compute(const double *diag, const double *off, int n, int arrow_pos)
+  {
+    if (n < 1) errorQuda("Invalid dimension %d", n);
+    if (arrow_pos < 0 || arrow_pos >= n) errorQuda("Invalid arrow position %d for dimension %d", arrow_pos, n);
+    merge->build(diag, off, n, arrow_pos);
+  }
+
+  int ArrowEigensolver::size() const { return merge->n; }
+
+  const std::vector<double> &ArrowEigensolver::eigenvalues() const { return merge->lambda; }
+
+  void ArrowEigensolver::project(double *out, const double *r) const { merge->project(out, r); }
+
+  void ArrowEigensolver::eigenvectors(double *vecs, int n_vec) const
+  {
+    if (n_vec < 0 || n_vec > merge->n) errorQuda("Requested %d eigenvectors of a %d x %d matrix", n_vec, merge->n, merge->n);
+    MatrixXd Q;
+    merge->vectors(Q, n_vec);
+    Map<MatrixXd>(vecs, merge->n, n_vec) = Q;
+  }
+
+} // namespace quda
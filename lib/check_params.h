@@ -114,6 +114,7 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
   P(make_resident_mom, 0);
   P(return_result_gauge, 1);
   P(return_result_mom, 1);
+  P(reference_gauge, 0);
   P(gauge_offset, 0);
   P(mom_offset, 0);
   P(site_size, 0);
@@ -125,6 +126,7 @@ void printQudaGaugeParam(QudaGaugeParam *param) {
   P(make_resident_mom, INVALID_INT);
   P(return_result_gauge, INVALID_INT);
   P(return_result_mom, INVALID_INT);
+  P(reference_gauge, INVALID_INT);
   P(gauge_offset, (size_t)INVALID_INT);
   P(mom_offset, (size_t)INVALID_INT);
   P(site_size, (size_t)INVALID_INT);
@@ -225,6 +227,26 @@ void printQudaEigParam(QudaEigParam *param) {
   P(io_parity_inflate, QUDA_BOOLEAN_INVALID);
 #endif
 
+  // no compression is the default, so an unset precision is valid
+#if defined INIT_PARAM || defined PRINT_PARAM
+  P(io_compress_prec, QUDA_INVALID_PRECISION);
+#endif
+
+#if defined INIT_PARAM
+  P(io_compress_lossless, QUDA_BOOLEAN_FALSE);
+#else
+  P(io_compress_lossless, QUDA_BOOLEAN_INVALID);
+#endif
+
+#if defined INIT_PARAM
+  strcpy(ret.checkpoint_file, "");
+  P(checkpoint_interval, 1);
+  P(resume, QUDA_BOOLEAN_FALSE);
+#else
+  P(checkpoint_interval, INVALID_INT);
+  P(resume, QUDA_BOOLEAN_INVALID);
+#endif
+
 #ifdef INIT_PARAM
   return ret;
 #endif
@@ -625,6 +647,10 @@ void printQudaInvertParam(QudaInvertParam *param) {
   P(native_blas_lapack, QUDA_BOOLEAN_INVALID);
 #endif
 
+#if defined(INIT_PARAM)
+  P(telemetry, 0);
+#endif
+
 #ifdef INIT_PARAM
   return ret;
 #endif
@@ -700,10 +726,14 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(setup_tol[i], 5e-6);
     P(setup_maxiter[i], 500);
     P(setup_maxiter_refresh[i], 0);
+    P(setup_refresh_tol[i], 0.0);
+    P(setup_block_size[i], 0);
 #else
     P(setup_tol[i], INVALID_DOUBLE);
     P(setup_maxiter[i], INVALID_INT);
     P(setup_maxiter_refresh[i], INVALID_INT);
+    P(setup_refresh_tol[i], INVALID_DOUBLE);
+    P(setup_block_size[i], INVALID_INT);
 #endif
 
 #ifdef INIT_PARAM
@@ -780,6 +810,11 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
     P(mu_factor[i], INVALID_DOUBLE);
 #endif
     P(coarse_solver_tol[i], INVALID_DOUBLE);
+#ifdef INIT_PARAM
+    P(coarse_solver_tol_max[i], 0.0);
+#else
+    P(coarse_solver_tol_max[i], INVALID_DOUBLE);
+#endif
     P(smoother_tol[i], INVALID_DOUBLE);
 #ifdef INIT_PARAM
     P(global_reduction[i], QUDA_BOOLEAN_TRUE);
@@ -838,9 +873,22 @@ void printQudaMultigridParam(QudaMultigridParam *param) {
 #else
     P(vec_load[i], QUDA_BOOLEAN_INVALID);
     P(vec_store[i], QUDA_BOOLEAN_INVALID);
+#endif
+#if defined INIT_PARAM || defined PRINT_PARAM
+    P(vec_compress_prec[i], QUDA_INVALID_PRECISION);
 #endif
   }
 
+#ifdef INIT_PARAM
+  P(vec_compress_lossless, QUDA_BOOLEAN_FALSE);
+#else
+  P(vec_compress_lossless, QUDA_BOOLEAN_INVALID);
+#endif
+
+#ifdef INIT_PARAM
+  strcpy(ret.hierarchy_cache, "");
+#endif
+
 #ifdef INIT_PARAM
   P(gflops, 0.0);
   P(secs, 0.0);
@@ -23,6 +23,9 @@ namespace quda {
   {
     uint64_t checksum_ = 0;
     for (int parity=0; parity<2; parity++)
+#ifdef _OPENMP
+#pragma omp parallel for reduction(^ : checksum_)
+#endif
       for (int x_cb=0; x_cb<arg.volumeCB; x_cb++)
 	for (int d=0; d<arg.U.geometry; d++)
 	  checksum_ ^= siteChecksum(arg, d, parity, x_cb);
@@ -9,6 +9,7 @@
 #include <gauge_field.h>
 #include <color_spinor_field.h>
 #include <blas_quda.h>
+#include <content_hash.h>
 
 namespace quda {
 
@@ -65,6 +66,22 @@ namespace quda {
     rho = rho_;
   }
 
+  uint64_t CloverField::hash() const
+  {
+    if (Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Hashing is only supported for host fields");
+    if (order == QUDA_QDPJIT_CLOVER_ORDER) errorQuda("Hashing is not supported for QDPJIT ordered fields");
+
+    const uint64_t meta[] = {static_cast<uint64_t>(order),          static_cast<uint64_t>(precision),
+                             static_cast<uint64_t>(clover != nullptr), static_cast<uint64_t>(cloverInv != nullptr),
+                             static_cast<uint64_t>(x[0]),           static_cast<uint64_t>(x[1]),
+                             static_cast<uint64_t>(x[2]),           static_cast<uint64_t>(x[3])};
+    uint64_t h = xxhash64(meta, sizeof(meta));
+    if (clover) h = contentHash(clover, bytes, h);
+    if (cloverInv) h = contentHash(cloverInv, bytes, h);
+
+    return contentHashReduce(h);
+  }
+
   cudaCloverField::cudaCloverField(const CloverFieldParam &param) : CloverField(param) {
     
     if (create != QUDA_NULL_FIELD_CREATE && create != QUDA_REFERENCE_FIELD_CREATE) 
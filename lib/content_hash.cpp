@@ -0,0 +1,133 @@
+#include <string.h>
+#include <vector>
+
+#include <comm_quda.h>
+#include <content_hash.h>
+
+namespace quda
+{
+
+  namespace
+  {
+
+    constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+    // size of the blocks that are hashed independently by contentHash
+    constexpr size_t block_bytes = 1 << 20;
+
+    inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    inline uint64_t read64(const unsigned char *p)
+    {
+      uint64_t v;
+      memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline uint32_t read32(const unsigned char *p)
+    {
+      uint32_t v;
+      memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input)
+    {
+      acc += input * prime2;
+      acc = rotl(acc, 31);
+      return acc * prime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t val)
+    {
+      acc ^= round(0, val);
+      return acc * prime1 + prime4;
+    }
+
+  } // namespace
+
+  uint64_t xxhash64(const void *data, size_t bytes, uint64_t seed)
+  {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    const unsigned char *end = p + bytes;
+    uint64_t h;
+
+    if (bytes >= 32) {
+      uint64_t v1 = seed + prime1 + prime2;
+      uint64_t v2 = seed + prime2;
+      uint64_t v3 = seed;
+      uint64_t v4 = seed - prime1;
+      const unsigned char *limit = end - 32;
+      do {
+        v1 = round(v1, read64(p));
+        v2 = round(v2, read64(p + 8));
+        v3 = round(v3, read64(p + 16));
+        v4 = round(v4, read64(p + 24));
+        p += 32;
+      } while (p <= limit);
+
+      h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+      h = mergeRound(h, v1);
+      h = mergeRound(h, v2);
+      h = mergeRound(h, v3);
+      h = mergeRound(h, v4);
+    } else {
+      h = seed + prime5;
+    }
+
+    h += static_cast<uint64_t>(bytes);
+
+    for (; p + 8 <= end; p += 8) {
+      h ^= round(0, read64(p));
+      h = rotl(h, 27) * prime1 + prime4;
+    }
+    if (p + 4 <= end) {
+      h ^= static_cast<uint64_t>(read32(p)) * prime1;
+      h = rotl(h, 23) * prime2 + prime3;
+      p += 4;
+    }
+    for (; p < end; p++) {
+      h ^= (*p) * prime5;
+      h = rotl(h, 11) * prime1;
+    }
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  uint64_t contentHash(const void *data, size_t bytes, uint64_t seed)
+  {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    const long n_block = (bytes + block_bytes - 1) / block_bytes;
+    if (n_block <= 1) return xxhash64(data, bytes, seed);
+
+    std::vector<uint64_t> block_hash(n_block);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (long b = 0; b < n_block; b++) {
+      const size_t offset = b * block_bytes;
+      block_hash[b] = xxhash64(p + offset, offset + block_bytes < bytes ? block_bytes : bytes - offset, seed);
+    }
+
+    return xxhash64(block_hash.data(), n_block * sizeof(uint64_t), seed + bytes);
+  }
+
+  uint64_t contentHashReduce(uint64_t hash)
+  {
+    // mix in the rank so that exchanging data between processes changes the result
+    const uint64_t rank_hash[2] = {hash, static_cast<uint64_t>(comm_rank())};
+    uint64_t global = xxhash64(rank_hash, sizeof(rank_hash));
+    comm_allreduce_xor(&global);
+    return global;
+  }
+
+} // namespace quda
@@ -146,6 +146,38 @@ namespace quda {
     }
   }
 
+  /**
+     Reorder spinor fields on the host, choosing the basis change.
+     This is a plain loop that creates no tunable, so it may be run
+     off the main thread, e.g., by the host worker.
+  */
+  template <int Ns, typename Arg> struct CopyColorSpinorHost {
+    static void apply(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in)
+    {
+      if (out.GammaBasis() != in.GammaBasis()) errorQuda("Cannot change gamma basis for nSpin=%d\n", Ns);
+      copyColorSpinor<Arg, PreserveBasis>(arg);
+    }
+  };
+
+  template <typename Arg> struct CopyColorSpinorHost<4, Arg> {
+    static void apply(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in)
+    {
+      if (out.GammaBasis() == in.GammaBasis()) {
+        copyColorSpinor<Arg, PreserveBasis>(arg);
+      } else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
+        copyColorSpinor<Arg, NonRelBasis>(arg);
+      } else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
+        copyColorSpinor<Arg, RelBasis>(arg);
+      } else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
+        copyColorSpinor<Arg, ChiralToNonRelBasis>(arg);
+      } else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
+        copyColorSpinor<Arg, NonRelToChiralBasis>(arg);
+      } else {
+        errorQuda("Basis change from %d to %d not supported", in.GammaBasis(), out.GammaBasis());
+      }
+    }
+  };
+
   /** CUDA kernel to reorder spinor fields.  Adopts a similar form as the CPU version, using the same inlined functions. */
   template <typename Arg, template <typename> class Basis> __global__ void copyColorSpinorKernel(Arg arg)
   {
@@ -164,7 +196,6 @@ namespace quda {
     class CopyColorSpinor : TunableVectorY {
     Arg &arg;
     const ColorSpinorField &meta;
-    const QudaFieldLocation location;
 
   private:
     unsigned int sharedBytesPerThread() const { return 0; }
@@ -174,20 +205,15 @@ namespace quda {
     unsigned int minThreads() const { return meta.VolumeCB(); }
 
   public:
-    CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in,
-		    QudaFieldLocation location)
-      : TunableVectorY(arg.nParity), arg(arg), meta(in), location(location) {
+    CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in)
+      : TunableVectorY(arg.nParity), arg(arg), meta(in) {
       if (out.GammaBasis()!=in.GammaBasis()) errorQuda("Cannot change gamma basis for nSpin=%d\n", Ns);
       writeAuxString("out_stride=%d,in_stride=%d", arg.out.stride, arg.in.stride);
     }
 
     void apply(const qudaStream_t &stream) {
-      if (location == QUDA_CPU_FIELD_LOCATION) {
-	copyColorSpinor<Arg, PreserveBasis>(arg);
-      } else {
-	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-	qudaLaunchKernel(copyColorSpinorKernel<Arg, PreserveBasis>, tp, stream, arg);
-      }
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      qudaLaunchKernel(copyColorSpinorKernel<Arg, PreserveBasis>, tp, stream, arg);
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), aux); }
@@ -201,7 +227,6 @@ namespace quda {
     Arg &arg;
     const ColorSpinorField &out;
     const ColorSpinorField &in;
-    const QudaFieldLocation location;
 
   private:
     unsigned int sharedBytesPerThread() const { return 0; }
@@ -211,9 +236,8 @@ namespace quda {
     unsigned int minThreads() const { return in.VolumeCB(); }
 
   public:
-    CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in,
-		    QudaFieldLocation location)
-      : TunableVectorY(arg.nParity), arg(arg), out(out), in(in), location(location) {
+    CopyColorSpinor(Arg &arg, const ColorSpinorField &out, const ColorSpinorField &in)
+      : TunableVectorY(arg.nParity), arg(arg), out(out), in(in) {
 
       if (out.GammaBasis()==in.GammaBasis()) {
 	writeAuxString("out_stride=%d,in_stride=%d,PreserveBasis", arg.out.stride, arg.in.stride);
@@ -231,31 +255,17 @@ namespace quda {
     }
 
     void apply(const qudaStream_t &stream) {
-      if (location == QUDA_CPU_FIELD_LOCATION) {
-	if (out.GammaBasis()==in.GammaBasis()) {
-          copyColorSpinor<Arg, PreserveBasis>(arg);
-	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<Arg, NonRelBasis>(arg);
-	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-	  copyColorSpinor<Arg, RelBasis>(arg);
-	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<Arg, ChiralToNonRelBasis>(arg);
-	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-	  copyColorSpinor<Arg, NonRelToChiralBasis>(arg);
-	}
-      } else {
-	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-	if (out.GammaBasis()==in.GammaBasis()) {
-	  qudaLaunchKernel(copyColorSpinorKernel<Arg, PreserveBasis>, tp, stream, arg);
-	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-          qudaLaunchKernel(copyColorSpinorKernel<Arg, NonRelBasis>, tp, stream, arg);
-	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
-          qudaLaunchKernel(copyColorSpinorKernel<Arg, RelBasis>, tp, stream, arg);
-	} else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-          qudaLaunchKernel(copyColorSpinorKernel<Arg, ChiralToNonRelBasis>, tp, stream, arg);
-	} else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
-          qudaLaunchKernel(copyColorSpinorKernel<Arg, NonRelToChiralBasis>, tp, stream, arg);
-	}
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      if (out.GammaBasis()==in.GammaBasis()) {
+        qudaLaunchKernel(copyColorSpinorKernel<Arg, PreserveBasis>, tp, stream, arg);
+      } else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
+        qudaLaunchKernel(copyColorSpinorKernel<Arg, NonRelBasis>, tp, stream, arg);
+      } else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_DEGRAND_ROSSI_GAMMA_BASIS) {
+        qudaLaunchKernel(copyColorSpinorKernel<Arg, RelBasis>, tp, stream, arg);
+      } else if (out.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && in.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
+        qudaLaunchKernel(copyColorSpinorKernel<Arg, ChiralToNonRelBasis>, tp, stream, arg);
+      } else if (in.GammaBasis() == QUDA_UKQCD_GAMMA_BASIS && out.GammaBasis() == QUDA_CHIRAL_GAMMA_BASIS) {
+        qudaLaunchKernel(copyColorSpinorKernel<Arg, NonRelToChiralBasis>, tp, stream, arg);
       }
     }
 
@@ -271,8 +281,12 @@ namespace quda {
 			      const ColorSpinorField &in, QudaFieldLocation location)
   {
     CopyColorSpinorArg<FloatOut, FloatIn, Ns, Nc, Out, In> arg(outOrder, inOrder, out, in);
-    CopyColorSpinor<Ns, decltype(arg)> copy(arg, out, in, location);
-    copy.apply(0);
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      CopyColorSpinorHost<Ns, decltype(arg)>::apply(arg, out, in);
+    } else {
+      CopyColorSpinor<Ns, decltype(arg)> copy(arg, out, in);
+      copy.apply(0);
+    }
   }
 
   /** Decide on the output order*/
@@ -47,7 +47,6 @@ namespace quda {
     const InOrder &in;
     OutOrder &out;
     const ColorSpinorField &meta; // this reference is for meta data only
-    QudaFieldLocation location;
 
   private:
     unsigned int sharedBytesPerThread() const { return 0; }
@@ -58,17 +57,13 @@ namespace quda {
     unsigned int minThreads() const { return meta.VolumeCB(); }
 
   public:
-    CopySpinor(OutOrder &out, const InOrder &in, const ColorSpinorField &meta, QudaFieldLocation location)
-      : out(out), in(in), meta(meta), location(location) { }
+    CopySpinor(OutOrder &out, const InOrder &in, const ColorSpinorField &meta)
+      : out(out), in(in), meta(meta) { }
     virtual ~CopySpinor() { ; }
 
     void apply(const qudaStream_t &stream) {
-      if (location == QUDA_CPU_FIELD_LOCATION) {
-	packSpinor<FloatOut, FloatIn, Ns, Nc>(out, in, meta.VolumeCB());
-      } else {
-	TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
-	qudaLaunchKernel(packSpinorKernel<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder>, tp, stream, out, in, meta.VolumeCB());
-      }
+      TuneParam tp = tuneLaunch(*this, getTuning(), getVerbosity());
+      qudaLaunchKernel(packSpinorKernel<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder>, tp, stream, out, in, meta.VolumeCB());
     }
 
     TuneKey tuneKey() const { return TuneKey(meta.VolString(), typeid(*this).name(), meta.AuxString()); }
@@ -81,8 +76,13 @@ namespace quda {
   template <typename FloatOut, typename FloatIn, int Ns, int Nc, typename OutOrder, typename InOrder>
     void genericCopyColorSpinor(OutOrder &outOrder, const InOrder &inOrder,
 				const ColorSpinorField &out, QudaFieldLocation location) {
-    CopySpinor<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder> copy(outOrder, inOrder, out, location);
-    copy.apply(0);
+    if (location == QUDA_CPU_FIELD_LOCATION) {
+      // plain host loop, no tunable is created
+      packSpinor<FloatOut, FloatIn, Ns, Nc>(outOrder, inOrder, out.VolumeCB());
+    } else {
+      CopySpinor<FloatOut, FloatIn, Ns, Nc, OutOrder, InOrder> copy(outOrder, inOrder, out);
+      copy.apply(0);
+    }
   }
 
   /** Decide on the output order*/
@@ -134,11 +134,11 @@ public:
 		   QudaFieldLocation location, int type) {
 
     CopyGaugeArg<OutOrder,InOrder> arg(outOrder, inOrder, in);
-    CopyGauge<FloatOut, FloatIn, length, CopyGaugeArg<OutOrder,InOrder> > gaugeCopier(arg, out, in, location);
-
 #ifdef HOST_DEBUG
-    if (location == QUDA_CPU_FIELD_LOCATION) checkNan<FloatIn, length>(arg);
+    // fused into the CPU copy; set before the copier takes its copy of arg
+    if (in.Location() == QUDA_CPU_FIELD_LOCATION) arg.check_nan = true;
 #endif
+    CopyGauge<FloatOut, FloatIn, length, CopyGaugeArg<OutOrder,InOrder> > gaugeCopier(arg, out, in, location);
 
     // first copy body
     if (type == 0 || type == 2) {
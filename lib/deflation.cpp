@@ -1,5 +1,5 @@
 #include <deflation.h>
-#include <qio_field.h>
+#include <vector_io.h>
 #include <string.h>
 
 #include <memory>
@@ -352,26 +352,16 @@ namespace quda
     std::string vec_infile(param.eig_global.vec_infile);
     std::vector<ColorSpinorField *> &B = RV->Components();
 
-    const int Nvec = B.size();
-    printfQuda("Start loading %d vectors from %s\n", Nvec, vec_infile.c_str());
-
-    void **V = new void*[Nvec];
-    for (int i = 0; i < Nvec; i++) {
-      V[i] = B[i]->V();
-      if (V[i] == NULL) {
-	printfQuda("Could not allocate V[%d]\n", i);
-      }
-    }
-
     if (strcmp(vec_infile.c_str(),"")!=0) {
-      auto parity = (B[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET ? QUDA_INVALID_PARITY : QUDA_EVEN_PARITY);
-      read_spinor_field(vec_infile.c_str(), &V[0], B[0]->Precision(), B[0]->X(), B[0]->SiteSubset(), parity,
-                        B[0]->Ncolor(), B[0]->Nspin(), Nvec, 0, (char **)0);
+      // assumes even parity if a single-parity field...
+      if (B[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET)
+        for (auto b : B) b->setSuggestedParity(QUDA_EVEN_PARITY);
+      VectorIO io(vec_infile);
+      io.load(B);
     } else {
       errorQuda("No eigenspace file defined");
     }
 
-    printfQuda("Done loading vectors\n");
     profile.TPSTOP(QUDA_PROFILE_IO);
     profile.TPSTART(QUDA_PROFILE_INIT);
   }
@@ -387,24 +377,12 @@ namespace quda
     std::vector<ColorSpinorField*> &B = RV->Components();
 
     if (strcmp(param.eig_global.vec_outfile,"")!=0) {
-      const int Nvec = B.size();
-      printfQuda("Start saving %d vectors to %s\n", Nvec, vec_outfile.c_str());
-
-      void **V = static_cast<void**>(safe_malloc(Nvec*sizeof(void*)));
-      for (int i=0; i<Nvec; i++) {
-	V[i] = B[i]->V();
-	if (V[i] == NULL) {
-	  printfQuda("Could not allocate V[%d]\n", i);
-	}
-      }
-
       // assumes even parity if a single-parity field...
-      auto parity = (B[0]->SiteSubset() == QUDA_FULL_SITE_SUBSET ? QUDA_INVALID_PARITY : QUDA_EVEN_PARITY);
-      write_spinor_field(vec_outfile.c_str(), &V[0], B[0]->Precision(), B[0]->X(), B[0]->SiteSubset(), parity,
-                         B[0]->Ncolor(), B[0]->Nspin(), Nvec, 0, (char **)0);
-
-      host_free(V);
-      printfQuda("Done saving vectors\n");
+      if (B[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET)
+        for (auto b : B) b->setSuggestedParity(QUDA_EVEN_PARITY);
+      VectorIO io(vec_outfile, false, 0, param.eig_global.io_compress_prec,
+                  param.eig_global.io_compress_lossless == QUDA_BOOLEAN_TRUE);
+      io.save(B);
     }
 
     profile.TPSTOP(QUDA_PROFILE_IO);
@@ -4,7 +4,7 @@
 
 namespace quda {
 
-  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped) :
+  DiracCoarse::DiracCoarse(const DiracParam &param, bool gpu_setup, bool mapped, bool compute) :
     Dirac(param),
     mass(param.mass),
     mu(param.mu),
@@ -27,7 +27,7 @@ namespace quda {
     init_cpu(!gpu_setup),
     mapped(mapped)
   {
-    initializeCoarse();
+    initializeCoarse(compute);
   }
 
   DiracCoarse::DiracCoarse(const DiracParam &param, cpuGaugeField *Y_h, cpuGaugeField *X_h, cpuGaugeField *Xinv_h,
@@ -186,10 +186,22 @@ namespace quda {
     else     Xinv_h = new cpuGaugeField(gParam);
   }
 
-  void DiracCoarse::initializeCoarse()
+  void DiracCoarse::initializeCoarse(bool compute)
   {
     createY(gpu_setup, mapped);
 
+    if (!compute) {
+      createYhat(gpu_setup);
+      if (gpu_setup) {
+        enable_gpu = true;
+        init_gpu = true;
+      } else {
+        enable_cpu = true;
+        init_cpu = true;
+      }
+      return;
+    }
+
     if (gpu_setup) dirac->createCoarseOp(*Y_d,*X_d,*transfer,kappa,mass,Mu(),MuFactor());
     else dirac->createCoarseOp(*Y_h,*X_h,*transfer,kappa,mass,Mu(),MuFactor());
 
@@ -256,18 +268,43 @@ namespace quda {
     calculateYhat(Yhat, Xinv, Y, X);
   }
 
+  std::vector<GaugeField *> DiracCoarse::CoarseFields() const
+  {
+    if (gpu_setup) return {Y_d, X_d, Xinv_d, Yhat_d};
+    return {Y_h, X_h, Xinv_h, Yhat_h};
+  }
+
+  void DiracCoarse::record(MGRegion &region, const ColorSpinorField &out, const ColorSpinorField &in, bool dslash,
+                           bool clover, bool xpay, double apply_flops) const
+  {
+    // Yhat and Xinv have the same size as Y and X
+    const bool gpu = out.Location() == QUDA_CUDA_FIELD_LOCATION;
+    const GaugeField *Y = gpu ? static_cast<const GaugeField *>(Y_d) : Y_h;
+    const GaugeField *X = gpu ? static_cast<const GaugeField *>(X_d) : X_h;
+    // a single-parity application only reads the links of its parity
+    const double fraction = out.SiteSubset() == QUDA_FULL_SITE_SUBSET ? 1.0 : 0.5;
+
+    double bytes = (xpay ? 2 : 1) * (in.Bytes() + in.NormBytes()) + out.Bytes() + out.NormBytes();
+    if (dslash) bytes += fraction * Y->Bytes();
+    if (clover) bytes += fraction * X->Bytes();
+    region.stop(counter, apply_flops, bytes);
+  }
+
   void DiracCoarse::Clover(ColorSpinorField &out, const ColorSpinorField &in, const QudaParity parity) const
   {
     if (&in == &out) errorQuda("Fields cannot alias");
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if (location == QUDA_CUDA_FIELD_LOCATION) {
       ApplyCoarse(out, in, in, *Y_d, *X_d, kappa, parity, false, true, dagger, commDim);
     } else if (location == QUDA_CPU_FIELD_LOCATION) {
       ApplyCoarse(out, in, in, *Y_h, *X_h, kappa, parity, false, true, dagger, commDim);
     }
     int n = in.Nspin()*in.Ncolor();
-    flops += (8*n*n-2*n)*(long long)in.VolumeCB();
+    const long long apply_flops = (8*n*n-2*n)*(long long)in.VolumeCB();
+    flops += apply_flops;
+    record(region, out, in, false, true, false, apply_flops);
   }
 
   void DiracCoarse::CloverInv(ColorSpinorField &out, const ColorSpinorField &in, const QudaParity parity) const
@@ -275,13 +312,16 @@ namespace quda {
     if (&in == &out) errorQuda("Fields cannot alias");
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if ( location  == QUDA_CUDA_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_d, *Xinv_d, kappa, parity, false, true, dagger, commDim);
     } else if ( location == QUDA_CPU_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_h, *Xinv_h, kappa, parity, false, true, dagger, commDim);
     }
     int n = in.Nspin()*in.Ncolor();
-    flops += (8*n*n-2*n)*(long long)in.VolumeCB();
+    const long long apply_flops = (8*n*n-2*n)*(long long)in.VolumeCB();
+    flops += apply_flops;
+    record(region, out, in, false, true, false, apply_flops);
   }
 
   void DiracCoarse::Dslash(ColorSpinorField &out, const ColorSpinorField &in,
@@ -289,13 +329,16 @@ namespace quda {
   {
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if ( location == QUDA_CUDA_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_d, *X_d, kappa, parity, true, false, dagger, commDim, halo_precision);
     } else if ( location == QUDA_CPU_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_h, *X_h, kappa, parity, true, false, dagger, commDim, halo_precision);
     }
     int n = in.Nspin()*in.Ncolor();
-    flops += (8*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    const long long apply_flops = (8*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    flops += apply_flops;
+    record(region, out, in, true, false, false, apply_flops);
   }
 
   void DiracCoarse::DslashXpay(ColorSpinorField &out, const ColorSpinorField &in,
@@ -306,26 +349,32 @@ namespace quda {
 
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if ( location == QUDA_CUDA_FIELD_LOCATION ) {
       ApplyCoarse(out, in, x, *Y_d, *X_d, kappa, parity, true, true, dagger, commDim, halo_precision);
     } else if ( location == QUDA_CPU_FIELD_LOCATION ) {
       ApplyCoarse(out, in, x, *Y_h, *X_h, kappa, parity, true, true, dagger, commDim, halo_precision);
     }
     int n = in.Nspin()*in.Ncolor();
-    flops += (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    const long long apply_flops = (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    flops += apply_flops;
+    record(region, out, in, true, true, true, apply_flops);
   }
 
   void DiracCoarse::M(ColorSpinorField &out, const ColorSpinorField &in) const
   {
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if ( location == QUDA_CUDA_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_d, *X_d, kappa, QUDA_INVALID_PARITY, true, true, dagger, commDim, halo_precision);
     } else if ( location == QUDA_CPU_FIELD_LOCATION ) {
       ApplyCoarse(out, in, in, *Y_h, *X_h, kappa, QUDA_INVALID_PARITY, true, true, dagger, commDim, halo_precision);
     }
     int n = in.Nspin()*in.Ncolor();
-    flops += (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    const long long apply_flops = (9*(8*n*n)-2*n)*(long long)in.VolumeCB()*in.SiteSubset();
+    flops += apply_flops;
+    record(region, out, in, true, true, false, apply_flops);
   }
 
   void DiracCoarse::MdagM(ColorSpinorField &out, const ColorSpinorField &in) const
@@ -395,6 +444,7 @@ namespace quda {
   {
     QudaFieldLocation location = checkLocation(out,in);
     initializeLazy(location);
+    MGRegion region;
     if ( location == QUDA_CUDA_FIELD_LOCATION) {
       ApplyCoarse(out, in, in, *Yhat_d, *X_d, kappa, parity, true, false, dagger, commDim, halo_precision);
     } else if ( location == QUDA_CPU_FIELD_LOCATION ) {
@@ -402,7 +452,9 @@ namespace quda {
     }
 
     int n = in.Nspin()*in.Ncolor();
-    flops += (8*(8*n*n)-2*n)*in.VolumeCB()*in.SiteSubset();
+    const long long apply_flops = (8*(8*n*n)-2*n)*in.VolumeCB()*in.SiteSubset();
+    flops += apply_flops;
+    record(region, out, in, true, false, false, apply_flops);
   }
 
   void DiracCoarsePC::DslashXpay(ColorSpinorField &out, const ColorSpinorField &in, const QudaParity parity,
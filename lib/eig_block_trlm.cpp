@@ -86,11 +86,11 @@ namespace quda
     // original size before exit.
     prepareKrylovSpace(kSpace, evals);
 
-    // Check for Chebyshev maximum estimation
-    checkChebyOpMax(mat, kSpace);
+    // Continue from the last checkpointed restart if requested, which
+    // also restores the Chebyshev polynomial, else select it
+    if (!resumeRestart(kSpace)) checkChebyOpMax(mat, kSpace);
 
     // Convergence and locking criteria
-    double mat_norm = 0.0;
     double epsilon = setEpsilon(kSpace[0]->Precision());
 
     // Print Eigensolver params
@@ -181,9 +181,12 @@ namespace quda
       // Check for convergence
       if (num_converged >= n_conv) converged = true;
       restart_iter++;
+
+      if (!converged) checkpointRestart(kSpace);
     }
 
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    if (checkpoint) checkpoint->complete();
 
     // Post computation report
     //---------------------------------------------------------------------------
@@ -211,6 +214,7 @@ namespace quda
 
       // Compute eigenvalues
       computeEvals(mat, kSpace, evals);
+      recordSpectrum(kSpace, evals);
     }
 
     // Local clean-up
@@ -227,6 +231,15 @@ namespace quda
 
   // Block Thick Restart Member functions
   //---------------------------------------------------------------------------
+  std::vector<EigenCheckpoint::Array> BLKTRLM::restartArrays()
+  {
+    auto arrays = TRLM::restartArrays();
+    size_t bytes = (n_kr / block_size) * block_data_length * sizeof(Complex);
+    arrays.push_back({block_alpha, bytes});
+    arrays.push_back({block_beta, bytes});
+    return arrays;
+  }
+
   void BLKTRLM::blockLanczosStep(std::vector<ColorSpinorField *> v, int j)
   {
     // Compute r = A * v_j - b_{j-i} * v_{j-1}
@@ -396,7 +409,6 @@ namespace quda
 
     // Eigen objects
     MatrixXcd T = MatrixXcd::Zero(dim, dim);
-    block_ritz_mat.resize(dim * dim);
     int idx = 0;
 
     // Populate the r and eblocks
@@ -449,22 +461,36 @@ namespace quda
       }
     }
 
-    // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXcd> eigensolver;
-    eigensolver.compute(T);
+    // Reduce the arrow matrix to real tridiagonal form, T = Q S Q^dag, and eigensolve S
+    Tridiagonalization<MatrixXcd> tridiag(T);
+    VectorXd diag = tridiag.diagonal();
+    VectorXd sub_diag = tridiag.subDiagonal();
+    arrow_eig.compute(diag.data(), sub_diag.data(), dim, 0);
+
+    // Keep the reflectors to form the kept Ritz vectors
+    block_householder.resize(dim * dim);
+    block_hcoeffs.resize(dim - 1);
+    Map<MatrixXcd>(block_householder.data(), dim, dim) = tridiag.packedMatrix();
+    Map<VectorXcd>(block_hcoeffs.data(), dim - 1) = tridiag.householderCoefficients();
 
     // Populate the alpha array with eigenvalues
-    for (int i = 0; i < dim; i++) alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+    for (int i = 0; i < dim; i++) alpha[i + num_locked] = arrow_eig.eigenvalues()[i];
 
-    // Repopulate ritz matrix: COLUMN major
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) block_ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    // The last component of each Ritz vector is the last row of Q applied to the eigenvectors of S
+    VectorXcd q_last = tridiag.matrixQ().adjoint() * VectorXcd::Unit(dim, dim - 1);
+    VectorXd q_last_re = q_last.real();
+    VectorXd q_last_im = -q_last.imag();
+    std::vector<double> last_re(dim);
+    std::vector<double> last_im(dim);
+    arrow_eig.project(last_re.data(), q_last_re.data());
+    arrow_eig.project(last_im.data(), q_last_im.data());
 
     for (int i = 0; i < blocks; i++) {
       for (int b = 0; b < block_size; b++) {
         idx = b * (block_size + 1);
-        residua[i * block_size + b + num_locked] = fabs(block_beta[n_kr * block_size - block_data_length + idx]
-                                                        * block_ritz_mat[dim * (i * block_size + b + 1) - 1]);
+        int j = i * block_size + b;
+        residua[j + num_locked]
+          = fabs(block_beta[n_kr * block_size - block_data_length + idx] * Complex(last_re[j], last_im[j]));
       }
     }
 
@@ -476,6 +502,23 @@ namespace quda
     int offset = n_kr + block_size;
     int dim = n_kr - num_locked;
 
+    // Form the Ritz vectors we keep by applying the reflectors to the
+    // eigenvectors of the tridiagonal matrix
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+    {
+      MatrixXd evecs(dim, iter_keep);
+      arrow_eig.eigenvectors(evecs.data(), iter_keep);
+      MatrixXcd householder = Map<MatrixXcd>(block_householder.data(), dim, dim);
+      VectorXcd hcoeffs = Map<VectorXcd>(block_hcoeffs.data(), dim - 1).conjugate();
+      HouseholderSequence<MatrixXcd, VectorXcd> Q(householder, hcoeffs);
+      Q.setLength(dim - 1).setShift(1);
+      block_ritz_mat.resize(dim * iter_keep);
+      Map<MatrixXcd> ritz(block_ritz_mat.data(), dim, iter_keep);
+      ritz = evecs.cast<Complex>();
+      ritz.applyOnTheLeft(Q);
+    }
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+
     // Multi-BLAS friendly array to store part of Ritz matrix we want
     Complex *ritz_mat_keep = (Complex *)safe_malloc((dim * iter_keep) * sizeof(Complex));
 
@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <comm_quda.h>
+#include <content_hash.h>
+#include <host_worker.h>
+#include <eig_checkpoint.h>
+
+namespace quda
+{
+
+  namespace
+  {
+
+    constexpr int32_t checkpoint_version = 1;
+
+    /**
+       @brief Fixed-size header of the metadata record, followed by
+       the segments and then by the arrays (each preceded by its size)
+     */
+    struct MetaHeader {
+      char magic[8];
+      int32_t version;
+      int32_t n_rank;
+      int32_t grid[4];
+      int32_t x[5];
+      int32_t nSpin;
+      int32_t nColor;
+      int32_t siteSubset;
+      int32_t precision;
+      int32_t generation;
+      int32_t n_vec;
+      int32_t n_segment;
+      int32_t n_array;
+      int64_t vec_bytes;
+      EigenCheckpoint::State state;
+    };
+
+    /**
+       @brief Header of a per-process vector file, followed by the raw
+       vector data
+     */
+    struct VectorHeader {
+      char magic[8];
+      int32_t version;
+      int32_t generation;
+      int32_t rank;
+      int32_t n_vec;
+      int64_t vec_bytes;
+      uint64_t hash;
+    };
+
+    /**
+       @brief Parameters of the host snapshot of a vector: native
+       precision (at least single) in space-spin-color order
+     */
+    ColorSpinorParam snapshotParam(const ColorSpinorField &v)
+    {
+      ColorSpinorParam param(v);
+      param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+      param.setPrecision(v.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v.Precision());
+      param.location = QUDA_CPU_FIELD_LOCATION;
+      param.create = QUDA_NULL_FIELD_CREATE;
+      return param;
+    }
+
+    uint64_t hashVectors(const std::vector<ColorSpinorField *> &v, int n)
+    {
+      std::vector<uint64_t> hash(n);
+      for (int i = 0; i < n; i++) hash[i] = contentHash(v[i]->V(), v[i]->Bytes());
+      return xxhash64(hash.data(), n * sizeof(uint64_t));
+    }
+
+    /**
+       @brief Write a vector file.  This runs on the host worker, so
+       it only touches host memory and reports failure rather than
+       raising an error.
+     */
+    bool writeVectors(const std::string &filename, const std::vector<ColorSpinorField *> &v, int n, int generation,
+                      int rank)
+    {
+      VectorHeader header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, "QUDAEIGV", 8);
+      header.version = checkpoint_version;
+      header.generation = generation;
+      header.rank = rank;
+      header.n_vec = n;
+      header.vec_bytes = v[0]->Bytes();
+      header.hash = hashVectors(v, n);
+
+      FILE *f = fopen(filename.c_str(), "wb");
+      if (!f) return false;
+      bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+      for (int i = 0; ok && i < n; i++) ok = fwrite(v[i]->V(), v[i]->Bytes(), 1, f) == 1;
+      ok = (fclose(f) == 0) && ok;
+      return ok;
+    }
+
+    void readVectors(const std::string &filename, std::vector<ColorSpinorField *> &v, int n, int generation)
+    {
+      FILE *f = fopen(filename.c_str(), "rb");
+      if (!f) errorQuda("Unable to open checkpoint vector file %s", filename.c_str());
+      VectorHeader header;
+      if (fread(&header, sizeof(header), 1, f) != 1) errorQuda("Unable to read the header of %s", filename.c_str());
+      if (strncmp(header.magic, "QUDAEIGV", 8) != 0 || header.version != checkpoint_version)
+        errorQuda("%s is not a checkpoint vector file of version %d", filename.c_str(), checkpoint_version);
+      if (header.generation != generation || header.rank != comm_rank() || header.n_vec != n
+          || header.vec_bytes != static_cast<int64_t>(v[0]->Bytes()))
+        errorQuda("Checkpoint vector file %s does not match its metadata", filename.c_str());
+      for (int i = 0; i < n; i++)
+        if (fread(v[i]->V(), v[i]->Bytes(), 1, f) != 1) errorQuda("Unable to read vector %d of %s", i, filename.c_str());
+      fclose(f);
+      if (hashVectors(v, n) != header.hash) errorQuda("Checksum of checkpoint vector file %s failed", filename.c_str());
+    }
+
+    template <typename T> void append(std::vector<char> &buffer, const T *data, size_t count = 1)
+    {
+      const char *p = reinterpret_cast<const char *>(data);
+      buffer.insert(buffer.end(), p, p + count * sizeof(T));
+    }
+
+    template <typename T> const char *extract(T *data, const char *p, const char *end, size_t count = 1)
+    {
+      if (p + count * sizeof(T) > end) errorQuda("Checkpoint metadata record is truncated");
+      memcpy(data, p, count * sizeof(T));
+      return p + count * sizeof(T);
+    }
+
+  } // namespace
+
+  EigenCheckpoint::EigenCheckpoint(const std::string &prefix) :
+    prefix(prefix), generation(0), clean(0), pending_clean(0), ticket(-1), write_ok(false)
+  {
+  }
+
+  EigenCheckpoint::~EigenCheckpoint()
+  {
+    complete();
+    for (auto v : snapshot) delete v;
+  }
+
+  std::string EigenCheckpoint::vectorFile(int generation, int rank) const
+  {
+    return prefix + "." + std::to_string(generation) + "." + std::to_string(rank);
+  }
+
+  void EigenCheckpoint::save(const std::vector<ColorSpinorField *> &kSpace, int n_vec, const State &state,
+                             const std::vector<Array> &arrays)
+  {
+    // the snapshot buffers are reused, so the previous checkpoint must be complete
+    complete();
+
+    // the committed vector files still needed, followed by the vectors that changed since
+    const int first = std::min(clean, n_vec);
+    const int n = n_vec - first;
+    pending_segments.clear();
+    for (auto &s : segments)
+      if (s.first < first) pending_segments.push_back(s);
+    if (n > 0) pending_segments.push_back({generation, first, n});
+    pending_clean = state.num_locked;
+
+    // take the snapshot
+    ColorSpinorParam param = snapshotParam(*kSpace[0]);
+    while (static_cast<int>(snapshot.size()) < n) snapshot.push_back(ColorSpinorField::Create(param));
+    for (int i = 0; i < n; i++) *snapshot[i] = *kSpace[first + i];
+
+    // prepare the metadata record, written once every process has its vectors on disk
+    MetaHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "QUDAEIGC", 8);
+    header.version = checkpoint_version;
+    header.n_rank = comm_size();
+    for (int d = 0; d < 4; d++) header.grid[d] = comm_dim(d);
+    for (int d = 0; d < 5; d++) header.x[d] = d < kSpace[0]->Ndim() ? kSpace[0]->X(d) : 1;
+    header.nSpin = param.nSpin;
+    header.nColor = param.nColor;
+    header.siteSubset = param.siteSubset;
+    header.precision = param.Precision();
+    header.generation = generation;
+    header.n_vec = n_vec;
+    header.n_segment = pending_segments.size();
+    header.n_array = arrays.size();
+    header.vec_bytes = n > 0 ? snapshot[0]->Bytes() : 0;
+    header.state = state;
+
+    pending_meta.clear();
+    append(pending_meta, &header);
+    append(pending_meta, pending_segments.data(), pending_segments.size());
+    for (auto &a : arrays) {
+      int64_t bytes = a.bytes;
+      append(pending_meta, &bytes);
+      append(pending_meta, static_cast<const char *>(a.data), a.bytes);
+    }
+
+    // write the vectors in the background
+    const int rank = comm_rank();
+    const std::string filename = vectorFile(generation, rank);
+    const int gen = generation;
+    write_ok = false;
+    ticket = host_worker::submit(
+      [this, filename, n, gen, rank]() { write_ok = n == 0 || writeVectors(filename, snapshot, n, gen, rank); });
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Started eigensolver checkpoint %d at restart %d, writing vectors %d to %d of %d\n", generation,
+                 state.restart_iter, first, n_vec - 1, n_vec);
+    generation++;
+  }
+
+  void EigenCheckpoint::poll()
+  {
+    if (ticket < 0) return;
+    double done = host_worker::test(ticket) ? 1.0 : 0.0;
+    comm_allreduce_min(&done);
+    if (done > 0.0) complete();
+  }
+
+  void EigenCheckpoint::complete()
+  {
+    if (ticket < 0) return;
+    host_worker::wait(ticket);
+    ticket = -1;
+
+    const MetaHeader *header = reinterpret_cast<const MetaHeader *>(pending_meta.data());
+    double ok = write_ok ? 1.0 : 0.0;
+    comm_allreduce_min(&ok);
+    if (ok == 0.0) {
+      warningQuda("Eigensolver checkpoint %d could not be written, keeping the previous checkpoint", header->generation);
+      remove(vectorFile(header->generation, comm_rank()).c_str());
+      return;
+    }
+
+    // replace the metadata record, which commits the checkpoint
+    if (comm_rank() == 0) {
+      const std::string meta = prefix + ".meta";
+      const std::string tmp = meta + ".tmp";
+      FILE *f = fopen(tmp.c_str(), "wb");
+      if (!f) errorQuda("Unable to open %s", tmp.c_str());
+      if (fwrite(pending_meta.data(), pending_meta.size(), 1, f) != 1) errorQuda("Unable to write %s", tmp.c_str());
+      if (fclose(f) != 0) errorQuda("Unable to close %s", tmp.c_str());
+      if (rename(tmp.c_str(), meta.c_str()) != 0) errorQuda("Unable to rename %s to %s", tmp.c_str(), meta.c_str());
+    }
+    comm_barrier();
+
+    // remove the vector files that are no longer referenced
+    for (auto &s : segments) {
+      auto live = [&s](const Segment &p) { return p.generation == s.generation; };
+      if (std::none_of(pending_segments.begin(), pending_segments.end(), live))
+        remove(vectorFile(s.generation, comm_rank()).c_str());
+    }
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Committed eigensolver checkpoint %d at restart %d\n", header->generation, header->state.restart_iter);
+
+    segments = pending_segments;
+    clean = pending_clean;
+  }
+
+  bool EigenCheckpoint::load(std::vector<ColorSpinorField *> &kSpace, State &state, const std::vector<Array> &arrays)
+  {
+    complete();
+
+    const std::string meta = prefix + ".meta";
+    double exists = access(meta.c_str(), R_OK) == 0 ? 1.0 : 0.0;
+    comm_allreduce_min(&exists);
+    if (exists == 0.0) return false;
+
+    std::vector<char> record;
+    {
+      FILE *f = fopen(meta.c_str(), "rb");
+      if (!f) errorQuda("Unable to open %s", meta.c_str());
+      char buffer[65536];
+      size_t count;
+      while ((count = fread(buffer, 1, sizeof(buffer), f)) > 0) record.insert(record.end(), buffer, buffer + count);
+      fclose(f);
+    }
+    const char *p = record.data();
+    const char *end = p + record.size();
+
+    MetaHeader header;
+    p = extract(&header, p, end);
+    if (strncmp(header.magic, "QUDAEIGC", 8) != 0 || header.version != checkpoint_version)
+      errorQuda("%s is not an eigensolver checkpoint of version %d", meta.c_str(), checkpoint_version);
+
+    // the vector files are per process, so the decomposition must match
+    ColorSpinorParam param = snapshotParam(*kSpace[0]);
+    bool match = header.n_rank == comm_size() && header.nSpin == param.nSpin && header.nColor == param.nColor
+      && header.siteSubset == param.siteSubset && header.precision == param.Precision();
+    for (int d = 0; d < 4; d++) match = match && header.grid[d] == comm_dim(d);
+    for (int d = 0; d < 5; d++) match = match && header.x[d] == (d < kSpace[0]->Ndim() ? kSpace[0]->X(d) : 1);
+    if (!match) errorQuda("Checkpoint %s was written with a different process grid or vector layout", meta.c_str());
+    if (header.n_vec > static_cast<int>(kSpace.size()))
+      errorQuda("Checkpoint %s holds %d vectors but the Krylov space has %lu", meta.c_str(), header.n_vec, kSpace.size());
+    if (header.n_array != static_cast<int>(arrays.size()))
+      errorQuda("Checkpoint %s holds %d arrays, expected %lu", meta.c_str(), header.n_array, arrays.size());
+
+    std::vector<Segment> saved(header.n_segment);
+    p = extract(saved.data(), p, end, saved.size());
+
+    for (auto &a : arrays) {
+      int64_t bytes;
+      p = extract(&bytes, p, end);
+      if (bytes != static_cast<int64_t>(a.bytes))
+        errorQuda("Checkpoint array has %ld bytes, expected %lu", static_cast<long>(bytes), a.bytes);
+      p = extract(static_cast<char *>(a.data), p, end, a.bytes);
+    }
+
+    // restore the vectors, oldest file first so newer copies take precedence
+    for (auto &s : saved) {
+      while (static_cast<int>(snapshot.size()) < s.n) snapshot.push_back(ColorSpinorField::Create(param));
+      readVectors(vectorFile(s.generation, comm_rank()), snapshot, s.n, s.generation);
+      for (int i = 0; i < s.n; i++) *kSpace[s.first + i] = *snapshot[i];
+    }
+
+    state = header.state;
+    segments = saved;
+    clean = state.num_locked;
+    generation = header.generation + 1;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Loaded eigensolver checkpoint %d from %s: restart %d, %d vectors, %d locked, %d converged\n",
+                 header.generation, meta.c_str(), state.restart_iter, header.n_vec, state.num_locked,
+                 state.num_converged);
+    return true;
+  }
+
+} // namespace quda
@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <quda_internal.h>
+#include <eigensolve_quda.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <util_quda.h>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Dense>
+
+namespace quda
+{
+
+  using namespace Eigen;
+
+  // Whether Ritz value a comes before b in the requested part of the spectrum
+  static bool ritzBefore(const Complex &a, const Complex &b, QudaEigSpectrumType spectrum)
+  {
+    switch (spectrum) {
+    case QUDA_SPECTRUM_SR_EIG: return a.real() < b.real();
+    case QUDA_SPECTRUM_LR_EIG: return a.real() > b.real();
+    case QUDA_SPECTRUM_SM_EIG: return abs(a) < abs(b);
+    case QUDA_SPECTRUM_LM_EIG: return abs(a) > abs(b);
+    case QUDA_SPECTRUM_SI_EIG: return a.imag() < b.imag();
+    case QUDA_SPECTRUM_LI_EIG: return a.imag() > b.imag();
+    default: errorQuda("Unexpected spectrum type %d", spectrum);
+    }
+    return false;
+  }
+
+  // Apply the plane rotation x = c x + s y, y = c y - conj(s) x
+  template <typename X, typename Y> static void planeRotate(X &&x, Y &&y, double c, Complex s)
+  {
+    for (int i = 0; i < x.size(); i++) {
+      Complex xi = x(i);
+      Complex yi = y(i);
+      x(i) = c * xi + s * yi;
+      y(i) = c * yi - conj(s) * xi;
+    }
+  }
+
+  // Swap the adjacent diagonal entries k and k + 1 of the Schur form T
+  // by a unitary rotation, and accumulate it into the Schur vectors Q
+  static void swapSchur(Ref<MatrixXcd> T, Ref<MatrixXcd> Q, int k)
+  {
+    const int n = T.rows();
+    const Complex t11 = T(k, k);
+    const Complex t22 = T(k + 1, k + 1);
+
+    // Givens rotation annihilating t22 - t11 against T(k, k + 1)
+    const Complex f = T(k, k + 1);
+    const Complex g = t22 - t11;
+    double c = 1.0;
+    Complex s = 0.0;
+    if (f == 0.0) {
+      c = 0.0;
+      s = conj(g) / abs(g);
+    } else if (g != 0.0) {
+      double norm = sqrt(std::norm(f) + std::norm(g));
+      c = abs(f) / norm;
+      s = (f / abs(f)) * conj(g) / norm;
+    }
+
+    if (k + 2 < n) planeRotate(T.row(k).tail(n - k - 2), T.row(k + 1).tail(n - k - 2), c, s);
+    planeRotate(T.col(k).head(k), T.col(k + 1).head(k), c, conj(s));
+    T(k, k) = t22;
+    T(k + 1, k + 1) = t11;
+    planeRotate(Q.col(k), Q.col(k + 1), c, conj(s));
+  }
+
+  // Implicitly Restarted Arnoldi Method constructor
+  IRAM::IRAM(const DiracMatrix &mat, QudaEigParam *eig_param, TimeProfile &profile) :
+    EigenSolver(mat, eig_param, profile)
+  {
+    bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
+    if (!profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
+
+    // Upper Hessenberg matrix and its Schur decomposition
+    upper_hess.resize((n_kr + 1) * n_kr, 0.0);
+    schur_mat.resize(n_kr * n_kr, 0.0);
+    schur_vecs.resize(n_kr * n_kr, 0.0);
+    ritz_vecs.resize(n_kr * n_kr, 0.0);
+
+    // Implicit restart specific checks
+    if (n_kr < n_ev + 6) errorQuda("n_kr=%d must be greater than n_ev+6=%d\n", n_kr, n_ev + 6);
+
+    if (eig_param->use_poly_acc) errorQuda("Polynomial acceleration is not supported by the IR Arnoldi solver");
+
+    if (!profile_running) profile.TPSTOP(QUDA_PROFILE_INIT);
+  }
+
+  void IRAM::operator()(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
+  {
+    // In case we are deflating an operator, save the tunechache from the inverter
+    saveTuneCache();
+
+    // Override any user input for block size.
+    block_size = 1;
+
+    // Pre-launch checks and preparation
+    //---------------------------------------------------------------------------
+    // Check to see if we are loading eigenvectors
+    if (strcmp(eig_param->vec_infile, "") != 0) {
+      printfQuda("Loading evecs from file name %s\n", eig_param->vec_infile);
+      loadFromFile(mat, kSpace, evals);
+      return;
+    }
+
+    // Check for an initial guess. If none present, populate with rands, then
+    // orthonormalise
+    prepareInitialGuess(kSpace);
+
+    // Increase the size of kSpace passed to the function, will be trimmed to
+    // original size before exit.
+    prepareKrylovSpace(kSpace, evals);
+
+    // Continue from the last checkpointed restart if requested
+    resumeRestart(kSpace);
+
+    // Convergence criteria
+    setEpsilon(kSpace[0]->Precision());
+
+    // Print Eigensolver params
+    printEigensolverSetup();
+    //---------------------------------------------------------------------------
+
+    // Begin IRAM Eigensolver computation
+    //---------------------------------------------------------------------------
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+    // Loop over restart iterations.
+    while (restart_iter < max_restarts && !converged) {
+
+      for (int step = num_keep; step < n_kr; step++) arnoldiStep(kSpace, step);
+      iter += (n_kr - num_keep);
+
+      // The Ritz values are the diagonal of the sorted Schur form
+      profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+      eigensolveFromUpperHess();
+      profile.TPSTART(QUDA_PROFILE_COMPUTE);
+
+      // mat_norm is updated.
+      for (int i = 0; i < n_kr; i++) mat_norm = std::max(mat_norm, abs(schur_mat[i * n_kr + i]));
+
+      // Convergence check: the leading Ritz pairs in the sorted order
+      num_converged = 0;
+      while (num_converged < n_kr && residua[num_converged] < tol * mat_norm) {
+        if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+          printfQuda("**** Converged %d resid=%+.6e condition=%.6e ****\n", num_converged, residua[num_converged],
+                     tol * mat_norm);
+        num_converged++;
+      }
+
+      if (getVerbosity() >= QUDA_VERBOSE) {
+        printfQuda("%04d converged eigenvalues at restart iter %04d\n", num_converged, restart_iter + 1);
+      }
+
+      if (num_converged >= n_conv) {
+        converged = true;
+      } else {
+        // Keep the converged Schur vectors and half of the remaining space
+        num_keep = std::min(std::max(n_ev, num_converged + (n_kr - num_converged) / 2), n_kr - 1);
+
+        if (getVerbosity() >= QUDA_DEBUG_VERBOSE) {
+          printfQuda("num_converged = %d\n", num_converged);
+          printfQuda("num_keep = %d\n", num_keep);
+          for (int i = 0; i < n_kr; i++) {
+            printfQuda("Ritz[%d] = (%+.16e, %+.16e) residual[%d] = %.16e\n", i, schur_mat[i * n_kr + i].real(),
+                       schur_mat[i * n_kr + i].imag(), i, residua[i]);
+          }
+        }
+
+        computeKeptSchur(kSpace);
+      }
+
+      restart_iter++;
+
+      if (!converged) checkpointRestart(kSpace);
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    if (checkpoint) checkpoint->complete();
+
+    // Post computation report
+    //---------------------------------------------------------------------------
+    if (!converged) {
+      if (eig_param->require_convergence) {
+        errorQuda("IRAM failed to compute the requested %d vectors with a %d search space and %d Krylov space in %d "
+                  "restart steps. Exiting.",
+                  n_conv, n_ev, n_kr, max_restarts);
+      } else {
+        warningQuda("IRAM failed to compute the requested %d vectors with a %d search space and %d Krylov space in %d "
+                    "restart steps. Continuing with current Arnoldi factorisation.",
+                    n_conv, n_ev, n_kr, max_restarts);
+      }
+    } else {
+      if (getVerbosity() >= QUDA_SUMMARIZE) {
+        printfQuda("IRAM computed the requested %d vectors in %d restart steps and %d OP*x operations.\n", n_conv,
+                   restart_iter, iter);
+
+        // Dump all Ritz values and residua
+        for (int i = 0; i < n_conv; i++) {
+          printfQuda("RitzValue[%04d]: (%+.16e, %+.16e) residual %.16e\n", i, schur_mat[i * n_kr + i].real(),
+                     schur_mat[i * n_kr + i].imag(), residua[i]);
+        }
+      }
+
+      // Form the Ritz vectors and compute the eigenvalues
+      computeRitzVectors(kSpace);
+      computeEvals(mat, kSpace, evals);
+      recordSpectrum(kSpace, evals);
+    }
+
+    // Local clean-up
+    cleanUpEigensolver(kSpace, evals);
+  }
+
+  // Destructor
+  IRAM::~IRAM() { }
+
+  // Implicit Restart Member functions
+  //---------------------------------------------------------------------------
+  std::vector<EigenCheckpoint::Array> IRAM::restartArrays()
+  {
+    auto arrays = EigenSolver::restartArrays();
+    arrays.push_back({upper_hess.data(), upper_hess.size() * sizeof(Complex)});
+    return arrays;
+  }
+
+  void IRAM::arnoldiStep(std::vector<ColorSpinorField *> &v, int j)
+  {
+    Map<MatrixXcd> H(upper_hess.data(), n_kr + 1, n_kr);
+
+    // r = A * v_j
+    matVec(mat, *r[0], *v[j]);
+
+    // Orthogonalise r against the Krylov space, accumulating the
+    // projections into column j of the Hessenberg matrix.  One
+    // reorthogonalisation recovers the orthogonality lost by classical
+    // Gram-Schmidt.
+    std::vector<ColorSpinorField *> v_(v.begin(), v.begin() + j + 1);
+    std::vector<Complex> h(j + 1);
+    for (int k = 0; k < 2; k++) {
+      blas::cDotProduct(h.data(), v_, r);
+      for (int i = 0; i <= j; i++) {
+        H(i, j) += h[i];
+        h[i] = -h[i];
+      }
+      blas::caxpy(h.data(), v_, r);
+    }
+
+    // h_{j+1,j} = ||r||
+    double beta = sqrt(blas::norm2(*r[0]));
+    H(j + 1, j) = beta;
+
+    // Prepare next step.
+    // v_{j+1} = r / h_{j+1,j}
+    blas::zero(*v[j + 1]);
+    blas::axpy(1.0 / beta, *r[0], *v[j + 1]);
+
+    // Save Arnoldi step tuning
+    saveTuneCache();
+  }
+
+  void IRAM::eigensolveFromUpperHess()
+  {
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+
+    Map<MatrixXcd> H(upper_hess.data(), n_kr + 1, n_kr);
+    Map<MatrixXcd> T(schur_mat.data(), n_kr, n_kr);
+    Map<MatrixXcd> Q(schur_vecs.data(), n_kr, n_kr);
+    Map<MatrixXcd> Y(ritz_vecs.data(), n_kr, n_kr);
+
+    // Schur decomposition H = Q T Q^dag of the Hessenberg matrix
+    ComplexSchur<MatrixXcd> schur(H.topRows(n_kr));
+    T = schur.matrixT();
+    Q = schur.matrixU();
+
+    // Bring the wanted Ritz values to the front of the Schur form
+    for (int i = 0; i < n_kr; i++) {
+      int best = i;
+      for (int j = i + 1; j < n_kr; j++)
+        if (ritzBefore(T(j, j), T(best, best), eig_param->spectrum)) best = j;
+      for (int j = best; j > i; j--) swapSchur(T, Q, j - 1);
+    }
+
+    // Unit eigenvectors of the Schur form by back substitution
+    const double small = DBL_EPSILON * T.norm();
+    Y.setZero();
+    for (int i = 0; i < n_kr; i++) {
+      Y(i, i) = 1.0;
+      for (int l = i - 1; l >= 0; l--) {
+        Complex sum = 0.0;
+        for (int p = l + 1; p <= i; p++) sum += T(l, p) * Y(p, i);
+        Complex diff = T(l, l) - T(i, i);
+        if (abs(diff) < small) diff = small;
+        Y(l, i) = -sum / diff;
+      }
+      Y.col(i).head(i + 1).normalize();
+    }
+
+    // The residual of Ritz pair i is |h_{n_kr,n_kr-1} e^T Q y_i|
+    RowVectorXcd last = H(n_kr, n_kr - 1) * Q.row(n_kr - 1);
+    for (int i = 0; i < n_kr; i++) residua[i] = abs((last * Y.col(i)).value());
+
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+  }
+
+  void IRAM::computeKeptSchur(std::vector<ColorSpinorField *> &kSpace)
+  {
+    Map<MatrixXcd> H(upper_hess.data(), n_kr + 1, n_kr);
+    Map<MatrixXcd> T(schur_mat.data(), n_kr, n_kr);
+    Map<MatrixXcd> Q(schur_vecs.data(), n_kr, n_kr);
+
+    // V_k = V Q_k
+    rotateVecs(kSpace, schur_vecs.data(), n_kr, num_keep);
+
+    // The residual vector follows the kept Schur vectors
+    std::swap(kSpace[num_keep], kSpace[n_kr]);
+
+    // Krylov-Schur form: the leading block of the Schur form, with the
+    // coupling to the residual vector in row num_keep
+    RowVectorXcd b = H(n_kr, n_kr - 1) * Q.row(n_kr - 1).head(num_keep);
+    H.setZero();
+    H.topLeftCorner(num_keep, num_keep) = T.topLeftCorner(num_keep, num_keep);
+    H.row(num_keep).head(num_keep) = b;
+  }
+
+  void IRAM::computeRitzVectors(std::vector<ColorSpinorField *> &kSpace)
+  {
+    // The Ritz vectors are V Q y_i
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+    Map<MatrixXcd> Q(schur_vecs.data(), n_kr, n_kr);
+    Map<MatrixXcd> Y(ritz_vecs.data(), n_kr, n_kr);
+    MatrixXcd rot = Q * Y.leftCols(n_conv);
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+
+    rotateVecs(kSpace, rot.data(), n_kr, n_conv);
+  }
+
+  void IRAM::rotateVecs(std::vector<ColorSpinorField *> &kSpace, Complex *rot, int n_in, int n_out)
+  {
+    // The rotated vectors are accumulated in the space after the residual vector
+    int offset = n_kr + 1;
+    if ((int)kSpace.size() < offset + n_out) {
+      ColorSpinorParam csParamClone(*kSpace[0]);
+      csParamClone.create = QUDA_ZERO_FIELD_CREATE;
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Resizing kSpace to %d vectors\n", offset + n_out);
+      kSpace.reserve(offset + n_out);
+      for (int i = kSpace.size(); i < offset + n_out; i++) kSpace.push_back(ColorSpinorField::Create(csParamClone));
+    }
+
+    blockRotateComplex(kSpace, rot, n_in, {0, n_in}, {0, n_out}, PENCIL, offset);
+    blockReset(kSpace, 0, n_out, offset);
+  }
+
+} // namespace quda
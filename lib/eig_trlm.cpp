@@ -70,11 +70,11 @@ namespace quda
     // original size before exit.
     prepareKrylovSpace(kSpace, evals);
 
-    // Check for Chebyshev maximum estimation
-    checkChebyOpMax(mat, kSpace);
+    // Continue from the last checkpointed restart if requested, which
+    // also restores the Chebyshev polynomial, else select it
+    if (!resumeRestart(kSpace)) checkChebyOpMax(mat, kSpace);
 
     // Convergence and locking criteria
-    double mat_norm = 0.0;
     double epsilon = setEpsilon(kSpace[0]->Precision());
 
     // Print Eigensolver params
@@ -160,9 +160,12 @@ namespace quda
       }
 
       restart_iter++;
+
+      if (!converged) checkpointRestart(kSpace);
     }
 
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    if (checkpoint) checkpoint->complete();
 
     // Post computation report
     //---------------------------------------------------------------------------
@@ -189,6 +192,7 @@ namespace quda
 
       // Compute eigenvalues
       computeEvals(mat, kSpace, evals);
+      recordSpectrum(kSpace, evals);
     }
 
     // Local clean-up
@@ -206,6 +210,14 @@ namespace quda
 
   // Thick Restart Member functions
   //---------------------------------------------------------------------------
+  std::vector<EigenCheckpoint::Array> TRLM::restartArrays()
+  {
+    auto arrays = EigenSolver::restartArrays();
+    arrays.push_back({alpha, n_kr * sizeof(double)});
+    arrays.push_back({beta, n_kr * sizeof(double)});
+    return arrays;
+  }
+
   void TRLM::lanczosStep(std::vector<ColorSpinorField *> v, int j)
   {
     // Compute r = A * v_j - b_{j-i} * v_{j-1}
@@ -284,11 +296,6 @@ namespace quda
     // int arrow_pos = std::max(num_keep - num_locked + 1, 2);
     int arrow_pos = num_keep - num_locked;
 
-    // Eigen objects
-    MatrixXd A = MatrixXd::Zero(dim, dim);
-    ritz_mat.resize(dim * dim);
-    for (int i = 0; i < dim * dim; i++) ritz_mat[i] = 0.0;
-
     // Invert the spectrum due to chebyshev
     if (reverse) {
       for (int i = num_locked; i < n_kr - 1; i++) {
@@ -298,39 +305,20 @@ namespace quda
       alpha[n_kr - 1] *= -1.0;
     }
 
-    // Construct arrow mat A_{dim,dim}
-    for (int i = 0; i < dim; i++) {
-
-      // alpha populates the diagonal
-      A(i, i) = alpha[i + num_locked];
-    }
-
-    for (int i = 0; i < arrow_pos; i++) {
+    // Eigensolve the arrow matrix: alpha populates the diagonal, beta
+    // populates the arrow and then the sub-diagonal
+    arrow_eig.compute(alpha + num_locked, beta + num_locked, dim, arrow_pos);
 
-      // beta populates the arrow
-      A(i, arrow_pos) = beta[i + num_locked];
-      A(arrow_pos, i) = beta[i + num_locked];
-    }
-
-    for (int i = arrow_pos; i < dim - 1; i++) {
-
-      // beta populates the sub-diagonal
-      A(i, i + 1) = beta[i + num_locked];
-      A(i + 1, i) = beta[i + num_locked];
-    }
-
-    // Eigensolve the arrow matrix
-    SelfAdjointEigenSolver<MatrixXd> eigensolver;
-    eigensolver.compute(A);
-
-    // repopulate ritz matrix
-    for (int i = 0; i < dim; i++)
-      for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+    // The residua only need the last component of each eigenvector
+    std::vector<double> unit(dim, 0.0);
+    std::vector<double> last(dim);
+    unit[dim - 1] = 1.0;
+    arrow_eig.project(last.data(), unit.data());
 
     for (int i = 0; i < dim; i++) {
-      residua[i + num_locked] = fabs(beta[n_kr - 1] * eigensolver.eigenvectors().col(i)[dim - 1]);
+      residua[i + num_locked] = fabs(beta[n_kr - 1] * last[i]);
       // Update the alpha array
-      alpha[i + num_locked] = eigensolver.eigenvalues()[i];
+      alpha[i + num_locked] = arrow_eig.eigenvalues()[i];
     }
 
     // Put spectrum back in order
@@ -346,6 +334,12 @@ namespace quda
     int offset = n_kr + 1;
     int dim = n_kr - num_locked;
 
+    // Form the Ritz vectors we keep
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+    ritz_mat.resize(dim * iter_keep);
+    arrow_eig.eigenvectors(ritz_mat.data(), iter_keep);
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+
     // Multi-BLAS friendly array to store part of Ritz matrix we want
     double *ritz_mat_keep = (double *)safe_malloc((dim * iter_keep) * sizeof(double));
 
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <iostream>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <blas_quda.h>
 #include <util_quda.h>
 #include <vector_io.h>
+#include <spectral_bounds.h>
 
 #include <Eigen/Eigenvalues>
 #include <Eigen/Dense>
@@ -28,7 +30,8 @@ namespace quda
     eig_param(eig_param),
     profile(profile),
     tmp1(nullptr),
-    tmp2(nullptr)
+    tmp2(nullptr),
+    checkpoint(nullptr)
   {
     bool profile_running = profile.isRunning(QUDA_PROFILE_INIT);
     if (!profile_running) profile.TPSTART(QUDA_PROFILE_INIT);
@@ -42,6 +45,9 @@ namespace quda
     n_ev_deflate = (eig_param->n_ev_deflate == -1 ? n_conv : eig_param->n_ev_deflate);
     tol = eig_param->tol;
     reverse = false;
+    a_min = eig_param->a_min;
+    a_max = eig_param->a_max;
+    poly_deg = eig_param->poly_deg;
 
     // Algorithm variables
     converged = false;
@@ -57,6 +63,7 @@ namespace quda
     num_converged = 0;
     num_locked = 0;
     num_keep = 0;
+    mat_norm = 0.0;
 
     save_prec = eig_param->save_prec;
 
@@ -71,6 +78,12 @@ namespace quda
     residua = (double *)safe_malloc(n_kr * sizeof(double));
     for (int i = 0; i < n_kr; i++) { residua[i] = 0.0; }
 
+    if (strcmp(eig_param->checkpoint_file, "") != 0) {
+      if (eig_param->checkpoint_interval <= 0)
+        errorQuda("Invalid checkpoint interval %d", eig_param->checkpoint_interval);
+      checkpoint = new EigenCheckpoint(eig_param->checkpoint_file);
+    }
+
     // Part of the spectrum to be computed.
     switch (eig_param->spectrum) {
     case QUDA_SPECTRUM_SR_EIG: strcpy(spectrum, "SR"); break;
@@ -103,7 +116,10 @@ namespace quda
     EigenSolver *eig_solver = nullptr;
 
     switch (eig_param->eig_type) {
-    case QUDA_EIG_IR_ARNOLDI: errorQuda("IR Arnoldi not implemented"); break;
+    case QUDA_EIG_IR_ARNOLDI:
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating IR Arnoldi eigensolver\n");
+      eig_solver = new IRAM(mat, eig_param, profile);
+      break;
     case QUDA_EIG_IR_LANCZOS: errorQuda("IR Lanczos not implemented"); break;
     case QUDA_EIG_TR_LANCZOS:
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating TR Lanczos eigensolver\n");
@@ -155,11 +171,132 @@ namespace quda
 
   void EigenSolver::checkChebyOpMax(const DiracMatrix &mat, std::vector<ColorSpinorField *> &kSpace)
   {
-    if (eig_param->use_poly_acc && eig_param->a_max <= 0.0) {
-      // Use part of the kSpace as temps
-      eig_param->a_max = estimateChebyOpMax(mat, *kSpace[block_size + 2], *kSpace[block_size + 1]);
-      if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev maximum estimate: %e.\n", eig_param->a_max);
+    if (!eig_param->use_poly_acc) return;
+
+    // Anything not set by the user is taken from the recorded bounds of the operator
+    const spectral::Key key = spectral::key(mat, *kSpace[0]);
+    spectral::Bounds bounds;
+    spectral::lookup(key, bounds);
+    const char *recorded = bounds.exact ? "recorded" : "earlier configuration";
+
+    if (a_max <= 0.0) {
+      if (bounds.has_max) {
+        a_max = 1.10 * bounds.lambda_max;
+        if (getVerbosity() >= QUDA_SUMMARIZE)
+          printfQuda("Chebyshev maximum from %s bounds: %e.\n", recorded, a_max);
+      } else {
+        // Use part of the kSpace as temps
+        a_max = estimateChebyOpMax(mat, *kSpace[block_size + 2], *kSpace[block_size + 1]);
+        spectral::recordMax(key, a_max / 1.10, spectral::SPECTRAL_POWER);
+        if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Chebyshev maximum estimate: %e.\n", a_max);
+      }
+    }
+
+    if (a_min <= 0.0) {
+      // The damped interval starts above the wanted eigenvalues found last time
+      if (eig_param->spectrum != QUDA_SPECTRUM_SR_EIG || !bounds.has_edge || bounds.edge_rank != n_conv
+          || bounds.edge <= 0.0 || 1.10 * bounds.edge >= a_max)
+        errorQuda("Chebyshev minimum not set, and no SR eigensolve with n_conv = %d has been recorded for this operator",
+                  n_conv);
+      a_min = 1.10 * bounds.edge;
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Chebyshev minimum from %s bounds: %e.\n", recorded, a_min);
+    }
+
+    if (poly_deg <= 0) {
+      // Amplify the smallest eigenvalue by cheby_gain relative to the damped interval
+      constexpr double cheby_gain = 1e3;
+      constexpr int max_poly_deg = 1024;
+      int degree = bounds.has_min ?
+        spectral::chebyshevDegree(bounds.lambda_min, a_min, a_max, cheby_gain) :
+        0;
+      if (degree <= 0)
+        errorQuda("Chebyshev degree not set, and no lower spectral bound below a_min = %e has been recorded",
+                  a_min);
+      poly_deg = std::min(degree, max_poly_deg);
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Chebyshev degree from %s bounds: %d.\n", recorded, poly_deg);
+    }
+  }
+
+  void EigenSolver::recordSpectrum(const std::vector<ColorSpinorField *> &kSpace, const std::vector<Complex> &evals)
+  {
+    if (!mat.hermitian()) return;
+
+    double lambda_min = evals[0].real();
+    double lambda_max = evals[0].real();
+    for (int i = 1; i < n_conv; i++) {
+      lambda_min = std::min(lambda_min, evals[i].real());
+      lambda_max = std::max(lambda_max, evals[i].real());
     }
+
+    const spectral::Key key = spectral::key(mat, *kSpace[0]);
+    switch (eig_param->spectrum) {
+    case QUDA_SPECTRUM_SR_EIG:
+      spectral::recordMin(key, lambda_min, spectral::SPECTRAL_EIGENSOLVE);
+      spectral::recordEdge(key, lambda_max, n_conv);
+      break;
+    case QUDA_SPECTRUM_LR_EIG: spectral::recordMax(key, lambda_max, spectral::SPECTRAL_EIGENSOLVE); break;
+    default: break;
+    }
+  }
+
+  std::vector<EigenCheckpoint::Array> EigenSolver::restartArrays()
+  {
+    return {{residua, n_kr * sizeof(double)}};
+  }
+
+  void EigenSolver::checkpointRestart(const std::vector<ColorSpinorField *> &kSpace)
+  {
+    if (!checkpoint) return;
+
+    if (restart_iter % eig_param->checkpoint_interval != 0) {
+      checkpoint->poll();
+      return;
+    }
+
+    // the restart state is the kept vectors followed by the residual block
+    EigenCheckpoint::State state = {n_kr,
+                                    n_ev,
+                                    block_size,
+                                    restart_iter,
+                                    iter,
+                                    num_converged,
+                                    num_locked,
+                                    num_keep,
+                                    a_min,
+                                    a_max,
+                                    poly_deg,
+                                    mat_norm};
+    checkpoint->save(kSpace, num_keep + block_size, state, restartArrays());
+  }
+
+  bool EigenSolver::resumeRestart(std::vector<ColorSpinorField *> &kSpace)
+  {
+    if (!checkpoint || eig_param->resume != QUDA_BOOLEAN_TRUE) return false;
+
+    EigenCheckpoint::State state;
+    if (!checkpoint->load(kSpace, state, restartArrays())) {
+      warningQuda("No eigensolver checkpoint found at %s, starting from scratch", eig_param->checkpoint_file);
+      return false;
+    }
+
+    if (state.n_kr != n_kr || state.n_ev != n_ev || state.block_size != block_size)
+      errorQuda("Checkpoint has n_kr = %d, n_ev = %d, block_size = %d, expected %d, %d, %d", state.n_kr, state.n_ev,
+                state.block_size, n_kr, n_ev, block_size);
+
+    restart_iter = state.restart_iter;
+    iter = state.iter;
+    num_converged = state.num_converged;
+    num_locked = state.num_locked;
+    num_keep = state.num_keep;
+    mat_norm = state.mat_norm;
+    // the Chebyshev polynomial must match the one the arrow matrix was built with
+    a_min = state.a_min;
+    a_max = state.a_max;
+    poly_deg = state.poly_deg;
+
+    return true;
   }
 
   void EigenSolver::prepareKrylovSpace(std::vector<ColorSpinorField *> &kSpace, std::vector<Complex> &evals)
@@ -191,9 +328,9 @@ namespace quda
       printfQuda("n_kr %d\n", n_kr);
       if (block_size > 1) printfQuda("block size %d\n", block_size);
       if (eig_param->use_poly_acc) {
-        printfQuda("polyDeg %d\n", eig_param->poly_deg);
-        printfQuda("a-min %f\n", eig_param->a_min);
-        printfQuda("a-max %f\n", eig_param->a_max);
+        printfQuda("polyDeg %d\n", poly_deg);
+        printfQuda("a-min %f\n", a_min);
+        printfQuda("a-max %f\n", a_max);
       }
     }
   }
@@ -262,7 +399,8 @@ namespace quda
         }
       }
       // save the vectors
-      VectorIO io(eig_param->vec_outfile, eig_param->io_parity_inflate == QUDA_BOOLEAN_TRUE);
+      VectorIO io(eig_param->vec_outfile, eig_param->io_parity_inflate == QUDA_BOOLEAN_TRUE, 0,
+                  eig_param->io_compress_prec, eig_param->io_compress_lossless == QUDA_BOOLEAN_TRUE);
       io.save(vecs_ptr);
       for (unsigned int i = 0; i < kSpace.size() && save_prec < prec; i++) delete vecs_ptr[i];
     }
@@ -300,11 +438,11 @@ namespace quda
       return;
     }
 
-    if (eig_param->poly_deg == 0) { errorQuda("Polynomial acceleration requested with zero polynomial degree"); }
+    if (poly_deg == 0) { errorQuda("Polynomial acceleration requested with zero polynomial degree"); }
 
     // Compute the polynomial accelerated operator.
-    double a = eig_param->a_min;
-    double b = eig_param->a_max;
+    double a = a_min;
+    double b = a_max;
     double delta = (b - a) / 2.0;
     double theta = (b + a) / 2.0;
     double sigma1 = -delta / theta;
@@ -317,7 +455,7 @@ namespace quda
     // C_1(x) = x
     matVec(mat, out, in);
     blas::caxpby(d2, const_cast<ColorSpinorField &>(in), d1, out);
-    if (eig_param->poly_deg == 1) return;
+    if (poly_deg == 1) return;
 
     // C_0 is the current 'in'  vector.
     // C_1 is the current 'out' vector.
@@ -335,7 +473,7 @@ namespace quda
     double sigma_old = sigma1;
 
     // construct C_{m+1}(x)
-    for (int i = 2; i < eig_param->poly_deg; i++) {
+    for (int i = 2; i < poly_deg; i++) {
       sigma = 1.0 / (2.0 / sigma1 - sigma_old);
 
       d1 = 2.0 * sigma / delta;
@@ -788,6 +926,7 @@ namespace quda
 
   EigenSolver::~EigenSolver()
   {
+    if (checkpoint) delete checkpoint;
     if (tmp1) delete tmp1;
     if (tmp2) delete tmp2;
     host_free(residua);
@@ -0,0 +1,190 @@
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <gauge_io.h>
+#include <gauge_checkpoint.h>
+#include <timer.h>
+
+namespace quda
+{
+
+  namespace checkpoint
+  {
+
+    namespace
+    {
+
+      struct Job {
+        cpuGaugeField *snapshot;
+        GaugeFileWrite file;
+        bool done;      // set by the I/O thread once the local data has been written
+        double seconds; // time spent in the data phase
+        Timer timer;    // total time from submission to completion
+      };
+
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::thread worker;
+      bool stop = false;
+
+      std::map<int, Job> jobs;         // checkpoints that have been submitted but not completed
+      std::deque<Job *> queue;         // checkpoints waiting for the I/O thread
+      std::vector<cpuGaugeField *> pool; // snapshot buffers from completed checkpoints
+      int next_handle = 0;
+
+      int maxInFlight()
+      {
+        static int max_in_flight = 0;
+        if (max_in_flight == 0) {
+          char *buffers_env = getenv("QUDA_CHECKPOINT_BUFFERS");
+          max_in_flight = buffers_env ? atoi(buffers_env) : 2;
+          if (max_in_flight <= 0) errorQuda("Invalid QUDA_CHECKPOINT_BUFFERS=%s", buffers_env);
+        }
+        return max_in_flight;
+      }
+
+      /**
+         @brief Body of the I/O thread: write the local data of each
+         queued checkpoint in turn.  Only host memory and file I/O are
+         touched here.
+       */
+      void run()
+      {
+        while (true) {
+          Job *job = nullptr;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [] { return stop || !queue.empty(); });
+            if (queue.empty()) return;
+            job = queue.front();
+          }
+
+          Timer timer;
+          timer.Start(__func__, __FILE__, __LINE__);
+          write_gauge_field_data(job->file, static_cast<void **>(job->snapshot->Gauge_p()), job->snapshot->Precision());
+          timer.Stop(__func__, __FILE__, __LINE__);
+
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.pop_front();
+            job->seconds = timer.last;
+            job->done = true;
+          }
+          cv.notify_all();
+        }
+      }
+
+      bool matches(const cpuGaugeField &u, const GaugeFieldParam &param)
+      {
+        if (u.Precision() != param.Precision() || u.Order() != param.order || u.Geometry() != param.geometry) return false;
+        for (int d = 0; d < 4; d++)
+          if (u.X()[d] != param.x[d]) return false;
+        return true;
+      }
+
+    } // namespace
+
+    cpuGaugeField *acquire(const GaugeFieldParam &param)
+    {
+      if (param.order != QUDA_QDP_GAUGE_ORDER) errorQuda("Checkpoint snapshots must be in QDP order");
+      if ((int)jobs.size() >= maxInFlight()) wait(jobs.begin()->first);
+
+      for (auto it = pool.begin(); it != pool.end(); it++) {
+        if (matches(**it, param)) {
+          cpuGaugeField *u = *it;
+          pool.erase(it);
+          return u;
+        }
+      }
+
+      GaugeFieldParam snapshot_param(param);
+      snapshot_param.location = QUDA_CPU_FIELD_LOCATION;
+      snapshot_param.create = QUDA_NULL_FIELD_CREATE;
+      snapshot_param.pad = 0;
+      snapshot_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+      return new cpuGaugeField(snapshot_param);
+    }
+
+    int submit(cpuGaugeField *snapshot, const char *filename, QudaPrecision file_prec)
+    {
+      const int handle = next_handle++;
+      Job &job = jobs[handle];
+      job.timer.Start(__func__, __FILE__, __LINE__);
+      job.snapshot = snapshot;
+      job.done = false;
+      job.seconds = 0.0;
+      job.file = begin_gauge_field_ildg(filename, snapshot->X(), file_prec);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!worker.joinable()) {
+          stop = false;
+          worker = std::thread(run);
+        }
+        queue.push_back(&job);
+      }
+      cv.notify_all();
+
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Started checkpoint %d to %s\n", handle, filename);
+      return handle;
+    }
+
+    bool test(int handle)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = jobs.find(handle);
+      return it == jobs.end() || it->second.done;
+    }
+
+    void wait(int handle)
+    {
+      if (handle < 0) {
+        while (!jobs.empty()) wait(jobs.begin()->first);
+        return;
+      }
+
+      auto it = jobs.find(handle);
+      if (it == jobs.end()) return; // already completed
+      Job &job = it->second;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&job] { return job.done; });
+      }
+
+      end_gauge_field_write(job.file);
+      job.timer.Stop(__func__, __FILE__, __LINE__);
+
+      if (getVerbosity() >= QUDA_SUMMARIZE)
+        printfQuda("Checkpoint %d: wrote %.3f GB to %s in %.3f s (%.3f GB/s) in the background, %.3f s from submission "
+                   "to completion, checksum %x %x\n",
+                   handle, job.file.data_bytes / 1e9, job.file.filename.c_str(), job.seconds,
+                   job.file.data_bytes / (1e9 * job.seconds), job.timer.last, job.file.suma, job.file.sumb);
+
+      pool.push_back(job.snapshot);
+      jobs.erase(it);
+    }
+
+    void destroy()
+    {
+      wait(-1);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      cv.notify_all();
+      if (worker.joinable()) worker.join();
+
+      for (auto u : pool) delete u;
+      pool.clear();
+    }
+
+  } // namespace checkpoint
+
+} // namespace quda
@@ -1,6 +1,7 @@
 #include <gauge_field.h>
 #include <typeinfo>
 #include <blas_quda.h>
+#include <content_hash.h>
 
 namespace quda {
 
@@ -341,6 +342,36 @@ namespace quda {
     return Checksum(*this, mini);
   }
 
+  uint64_t GaugeField::hash() const
+  {
+    if (Location() != QUDA_CPU_FIELD_LOCATION) errorQuda("Hashing is only supported for host fields");
+
+    const uint64_t meta[] = {static_cast<uint64_t>(order),     static_cast<uint64_t>(precision),
+                             static_cast<uint64_t>(reconstruct), static_cast<uint64_t>(geometry),
+                             static_cast<uint64_t>(link_type), static_cast<uint64_t>(nColor),
+                             static_cast<uint64_t>(x[0]),      static_cast<uint64_t>(x[1]),
+                             static_cast<uint64_t>(x[2]),      static_cast<uint64_t>(x[3])};
+    uint64_t h = xxhash64(meta, sizeof(meta));
+
+    if (order == QUDA_QDP_GAUGE_ORDER || order == QUDA_QDPJIT_GAUGE_ORDER) {
+      for (int d = 0; d < geometry; d++) h = contentHash(static_cast<void *const *>(Gauge_p())[d], bytes / geometry, h);
+    } else if (order == QUDA_MILC_SITE_GAUGE_ORDER) {
+      // only hash the links, not the rest of the application's site struct
+      const char *base = static_cast<const char *>(Gauge_p()) + site_offset;
+      const size_t link_bytes = geometry * nInternal * precision;
+      std::vector<uint64_t> site_hash(volume);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t i = 0; i < volume; i++) site_hash[i] = xxhash64(base + i * site_size, link_bytes, h);
+      h = contentHash(site_hash.data(), site_hash.size() * sizeof(uint64_t), h);
+    } else {
+      h = contentHash(Gauge_p(), bytes, h);
+    }
+
+    return contentHashReduce(h);
+  }
+
   GaugeField* GaugeField::Create(const GaugeFieldParam &param) {
 
     GaugeField *field = nullptr;
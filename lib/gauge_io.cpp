@@ -0,0 +1,893 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <util_quda.h>
+#include <timer.h>
+#include <gauge_io.h>
+
+using namespace quda;
+
+namespace
+{
+
+  constexpr uint32_t lime_magic = 0x456789ab;
+  constexpr size_t lime_header_bytes = 144;
+  constexpr size_t lime_type_bytes = 128;
+  constexpr int lime_mb = 0x8000; // message begin flag
+  constexpr int lime_me = 0x4000; // message end flag
+
+  constexpr int n_dir = 4;
+  constexpr int link_size = 18;
+
+  bool host_little_endian()
+  {
+    const uint32_t one = 1;
+    return *reinterpret_cast<const char *>(&one) == 1;
+  }
+
+  template <typename T> T swap_bytes(T value)
+  {
+    char *p = reinterpret_cast<char *>(&value);
+    std::reverse(p, p + sizeof(T));
+    return value;
+  }
+
+  template <typename T> T big_endian(T value) { return host_little_endian() ? swap_bytes(value) : value; }
+
+  /**
+     @brief Standard (zlib) CRC32 as used for the SciDAC checksum
+  */
+  class CRC32
+  {
+    uint32_t table[256];
+
+  public:
+    CRC32()
+    {
+      for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+      }
+    }
+
+    uint32_t operator()(const char *buf, size_t len) const
+    {
+      uint32_t c = 0xffffffffu;
+      for (size_t i = 0; i < len; i++) c = table[(c ^ static_cast<unsigned char>(buf[i])) & 0xff] ^ (c >> 8);
+      return c ^ 0xffffffffu;
+    }
+  };
+
+  const CRC32 crc32;
+
+  inline uint32_t rotl(uint32_t x, int k) { return k == 0 ? x : (x << k) | (x >> (32 - k)); }
+
+  /**
+     @brief Local and global geometry of the lattice, together with
+     the mapping from local coordinates to the host QDP-order index
+     and to the global lexicographic index used by the file formats.
+  */
+  struct Geometry {
+    int X[4];      // local dimensions
+    int L[4];      // global dimensions
+    int offset[4]; // global coordinate of the local origin
+    size_t volume;
+    size_t global_volume;
+
+    Geometry(const int *X_) : volume(1), global_volume(1)
+    {
+      for (int d = 0; d < 4; d++) {
+        X[d] = X_[d];
+        L[d] = comm_dim(d) * X[d];
+        offset[d] = comm_coord(d) * X[d];
+        volume *= X[d];
+        global_volume *= L[d];
+      }
+    }
+
+    size_t cbIndex(const int x[]) const
+    {
+      size_t r = ((static_cast<size_t>(x[3]) * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0];
+      int parity = (x[0] + x[1] + x[2] + x[3] + offset[0] + offset[1] + offset[2] + offset[3]) & 1;
+      return r / 2 + parity * (volume / 2);
+    }
+
+    size_t globalIndex(const int x[]) const
+    {
+      size_t r = static_cast<size_t>(x[3] + offset[3]);
+      for (int d = 2; d >= 0; d--) r = r * L[d] + x[d] + offset[d];
+      return r;
+    }
+  };
+
+  /**
+     @brief A contiguous range of the file that maps onto a contiguous
+     range of the local buffer
+  */
+  struct Extent {
+    off_t file_offset;
+    size_t buf_offset;
+    size_t bytes;
+  };
+
+  /**
+     @brief Compute the contiguous file extents of time slice t of the
+     local sub-lattice.  Rows of the local volume that are adjacent in
+     the file (when a dimension is not partitioned) are coalesced.
+  */
+  std::vector<Extent> sliceExtents(const Geometry &geom, int t, off_t data_offset, size_t site_bytes)
+  {
+    std::vector<Extent> extents;
+    size_t row_bytes = geom.X[0] * site_bytes;
+    size_t buf_offset = 0;
+    for (int z = 0; z < geom.X[2]; z++) {
+      for (int y = 0; y < geom.X[1]; y++) {
+        int x[4] = {0, y, z, t};
+        off_t file_offset = data_offset + geom.globalIndex(x) * site_bytes;
+        if (!extents.empty() && extents.back().file_offset + (off_t)extents.back().bytes == file_offset)
+          extents.back().bytes += row_bytes;
+        else
+          extents.push_back({file_offset, buf_offset, row_bytes});
+        buf_offset += row_bytes;
+      }
+    }
+    return extents;
+  }
+
+  void pread_all(int fd, char *buf, size_t bytes, off_t offset, const char *filename)
+  {
+    while (bytes > 0) {
+      ssize_t n = pread(fd, buf, bytes, offset);
+      if (n <= 0) errorQuda("Failed to read %lu bytes at offset %ld from %s", bytes, (long)offset, filename);
+      buf += n;
+      bytes -= n;
+      offset += n;
+    }
+  }
+
+  void pwrite_all(int fd, const char *buf, size_t bytes, off_t offset, const char *filename)
+  {
+    while (bytes > 0) {
+      ssize_t n = pwrite(fd, buf, bytes, offset);
+      if (n <= 0) errorQuda("Failed to write %lu bytes at offset %ld to %s", bytes, (long)offset, filename);
+      buf += n;
+      bytes -= n;
+      offset += n;
+    }
+  }
+
+  /**
+     @brief Extract the value between <tag> and </tag> in an xml string
+  */
+  std::string xmlValue(const std::string &xml, const std::string &tag)
+  {
+    auto begin = xml.find("<" + tag + ">");
+    if (begin == std::string::npos) return "";
+    begin += tag.size() + 2;
+    auto end = xml.find("</" + tag + ">", begin);
+    if (end == std::string::npos) return "";
+    return xml.substr(begin, end - begin);
+  }
+
+  enum class FileFormat { ILDG, NERSC };
+
+  /**
+     @brief Description of the binary payload of a gauge file
+  */
+  struct FileInfo {
+    FileFormat format;
+    off_t data_offset;
+    uint64_t data_bytes; // length of the binary record, or what follows the header for NERSC
+    QudaPrecision precision;
+    bool big_endian;
+    int rows; // number of rows stored per link (2 or 3)
+    int L[4];
+    // checksums stored in the file
+    bool has_scidac_checksum;
+    uint32_t suma, sumb;
+    bool has_nersc_checksum;
+    uint32_t nersc_checksum;
+    bool has_link_trace;
+    double link_trace;
+
+    FileInfo() :
+      format(FileFormat::ILDG),
+      data_offset(0),
+      data_bytes(0),
+      precision(QUDA_INVALID_PRECISION),
+      big_endian(true),
+      rows(3),
+      L {0, 0, 0, 0},
+      has_scidac_checksum(false),
+      suma(0),
+      sumb(0),
+      has_nersc_checksum(false),
+      nersc_checksum(0),
+      has_link_trace(false),
+      link_trace(0.0)
+    {
+    }
+
+    size_t siteBytes() const { return n_dir * rows * 6 * precision; }
+  };
+
+  /**
+     @brief Walk the LIME records of an ILDG / SciDAC file and extract
+     the payload description.  This only reads the record headers and
+     the (small) xml records.
+  */
+  FileInfo parseLime(int fd, const char *filename)
+  {
+    FileInfo info;
+    info.format = FileFormat::ILDG;
+    bool found_data = false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) errorQuda("Failed to stat %s", filename);
+    off_t offset = 0;
+
+    while (offset + (off_t)lime_header_bytes <= st.st_size) {
+      char header[lime_header_bytes];
+      pread_all(fd, header, lime_header_bytes, offset, filename);
+
+      uint32_t magic;
+      uint64_t length;
+      memcpy(&magic, header, sizeof(magic));
+      memcpy(&length, header + 8, sizeof(length));
+      if (big_endian(magic) != lime_magic) errorQuda("Invalid LIME record at offset %ld in %s", (long)offset, filename);
+      length = big_endian(length);
+      std::string type(header + 16, strnlen(header + 16, lime_type_bytes));
+      off_t record = offset + lime_header_bytes;
+
+      if (record + (off_t)length > st.st_size)
+        errorQuda("LIME record %s at offset %ld in %s is truncated (%lu bytes, file size %ld)", type.c_str(),
+                  (long)offset, filename, (unsigned long)length, (long)st.st_size);
+
+      if (type == "ildg-binary-data" || type == "scidac-binary-data") {
+        info.data_offset = record;
+        info.data_bytes = length;
+        found_data = true;
+      } else if (type == "ildg-format" || type == "scidac-private-record-xml" || type == "scidac-checksum") {
+        std::string xml(length, '\0');
+        pread_all(fd, &xml[0], length, record, filename);
+
+        if (type == "ildg-format") {
+          std::string prec = xmlValue(xml, "precision");
+          if (prec == "64")
+            info.precision = QUDA_DOUBLE_PRECISION;
+          else if (prec == "32")
+            info.precision = QUDA_SINGLE_PRECISION;
+          const char *dims[] = {"lx", "ly", "lz", "lt"};
+          for (int d = 0; d < 4; d++) info.L[d] = atoi(xmlValue(xml, dims[d]).c_str());
+        } else if (type == "scidac-private-record-xml") {
+          // QIO written files without an ildg-format record
+          if (info.precision == QUDA_INVALID_PRECISION) {
+            std::string prec = xmlValue(xml, "precision");
+            info.precision = prec == "D" ? QUDA_DOUBLE_PRECISION : prec == "F" ? QUDA_SINGLE_PRECISION : info.precision;
+          }
+        } else {
+          info.has_scidac_checksum = true;
+          info.suma = strtoul(xmlValue(xml, "suma").c_str(), nullptr, 16);
+          info.sumb = strtoul(xmlValue(xml, "sumb").c_str(), nullptr, 16);
+        }
+      }
+
+      offset = record + ((length + 7) / 8) * 8;
+    }
+
+    if (!found_data) errorQuda("No binary gauge field record found in %s", filename);
+    if (info.precision == QUDA_INVALID_PRECISION) errorQuda("Could not determine the precision of %s", filename);
+    return info;
+  }
+
+  /**
+     @brief Parse the ascii header of a NERSC archive file
+  */
+  FileInfo parseNERSC(int fd, const char *filename)
+  {
+    FileInfo info;
+    info.format = FileFormat::NERSC;
+
+    // the header is small: read a generous chunk and search for the terminator
+    struct stat st;
+    if (fstat(fd, &st) != 0) errorQuda("Failed to stat %s", filename);
+    size_t bytes = std::min(static_cast<size_t>(st.st_size), static_cast<size_t>(65536));
+    std::string header(bytes, '\0');
+    pread_all(fd, &header[0], bytes, 0, filename);
+
+    const std::string end_tag = "END_HEADER";
+    auto end = header.find(end_tag);
+    if (end == std::string::npos) errorQuda("No END_HEADER found in NERSC file %s", filename);
+    info.data_offset = header.find('\n', end) + 1;
+    info.data_bytes = st.st_size - info.data_offset;
+
+    std::string datatype, floating_point;
+    size_t pos = 0;
+    while (pos < end) {
+      size_t eol = header.find('\n', pos);
+      std::string line = header.substr(pos, eol - pos);
+      pos = eol + 1;
+      auto eq = line.find('=');
+      if (eq == std::string::npos) continue;
+      auto trim = [](std::string s) {
+        s.erase(0, s.find_first_not_of(" \t\r"));
+        s.erase(s.find_last_not_of(" \t\r") + 1);
+        return s;
+      };
+      std::string key = trim(line.substr(0, eq));
+      std::string value = trim(line.substr(eq + 1));
+
+      if (key == "DATATYPE") datatype = value;
+      else if (key == "FLOATING_POINT") floating_point = value;
+      else if (key == "CHECKSUM") {
+        info.has_nersc_checksum = true;
+        info.nersc_checksum = strtoul(value.c_str(), nullptr, 16);
+      } else if (key == "LINK_TRACE") {
+        info.has_link_trace = true;
+        info.link_trace = atof(value.c_str());
+      } else if (key.compare(0, 10, "DIMENSION_") == 0) {
+        int d = atoi(key.substr(10).c_str()) - 1;
+        if (d >= 0 && d < 4) info.L[d] = atoi(value.c_str());
+      }
+    }
+
+    if (datatype == "4D_SU3_GAUGE") info.rows = 2;
+    else if (datatype == "4D_SU3_GAUGE_3x3") info.rows = 3;
+    else errorQuda("Unsupported NERSC DATATYPE %s in %s", datatype.c_str(), filename);
+
+    if (floating_point.compare(0, 6, "IEEE64") == 0) info.precision = QUDA_DOUBLE_PRECISION;
+    else if (floating_point.compare(0, 6, "IEEE32") == 0) info.precision = QUDA_SINGLE_PRECISION;
+    else errorQuda("Unsupported NERSC FLOATING_POINT %s in %s", floating_point.c_str(), filename);
+    info.big_endian = floating_point.find("LITTLE") == std::string::npos;
+
+    return info;
+  }
+
+  /**
+     @brief Accumulated checksums of the local sub-lattice
+  */
+  struct Checksum {
+    uint32_t suma;
+    uint32_t sumb;
+    uint32_t nersc;
+    double trace;
+    Checksum() : suma(0), sumb(0), nersc(0), trace(0.0) { }
+
+    /**
+       @brief Reduce over all processes
+    */
+    void reduce()
+    {
+      uint64_t scidac = (static_cast<uint64_t>(suma) << 32) | sumb;
+      comm_allreduce_xor(&scidac);
+      suma = scidac >> 32;
+      sumb = scidac & 0xffffffffu;
+
+      // the NERSC checksum is a sum modulo 2^32: reduce the two halves exactly in double
+      double sum[3] = {static_cast<double>(nersc & 0xffff), static_cast<double>(nersc >> 16), trace};
+      comm_allreduce_array(sum, 3);
+      nersc = static_cast<uint32_t>(static_cast<uint64_t>(sum[0]) + (static_cast<uint64_t>(sum[1]) << 16));
+      trace = sum[2];
+    }
+  };
+
+  /**
+     @brief Sum of the 32-bit words of a link stored in precision File,
+     as used by the NERSC checksum
+  */
+  template <typename File> uint32_t nerscSum(const File *link)
+  {
+    uint32_t sum = 0;
+    const uint32_t *words = reinterpret_cast<const uint32_t *>(link);
+    for (size_t i = 0; i < link_size * sizeof(File) / sizeof(uint32_t); i++) sum += words[i];
+    return sum;
+  }
+
+  /**
+     @brief Reconstruct the third row of an SU(3) matrix from the
+     first two: row3 = conj(row1 x row2)
+  */
+  template <typename Float> void reconstructThirdRow(Float *u)
+  {
+    using complex = std::complex<Float>;
+    complex a[3], b[3];
+    for (int j = 0; j < 3; j++) {
+      a[j] = complex(u[2 * j], u[2 * j + 1]);
+      b[j] = complex(u[6 + 2 * j], u[6 + 2 * j + 1]);
+    }
+    for (int j = 0; j < 3; j++) {
+      complex c = std::conj(a[(j + 1) % 3] * b[(j + 2) % 3] - a[(j + 2) % 3] * b[(j + 1) % 3]);
+      u[12 + 2 * j] = c.real();
+      u[12 + 2 * j + 1] = c.imag();
+    }
+  }
+
+  /**
+     @brief Convert a time slice of file data into the host gauge
+     field, accumulating the checksums.
+  */
+  template <typename Float, typename File>
+  Checksum unpackSlice(Float **gauge, const char *buf, const Geometry &geom, const FileInfo &info, int t)
+  {
+    const size_t site_bytes = info.siteBytes();
+    const bool swap = info.big_endian == host_little_endian();
+    const int rows = geom.X[1] * geom.X[2];
+
+    uint32_t suma = 0, sumb = 0, nersc = 0;
+    double trace = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(^ : suma, sumb) reduction(+ : nersc, trace)
+#endif
+    for (int row = 0; row < rows; row++) {
+      for (int x0 = 0; x0 < geom.X[0]; x0++) {
+        int x[4] = {x0, row % geom.X[1], row / geom.X[1], t};
+        const char *site = buf + (static_cast<size_t>(row) * geom.X[0] + x0) * site_bytes;
+
+        if (info.has_scidac_checksum) {
+          size_t rank = geom.globalIndex(x);
+          uint32_t crc = crc32(site, site_bytes);
+          suma ^= rotl(crc, rank % 29);
+          sumb ^= rotl(crc, rank % 31);
+        }
+
+        size_t index = geom.cbIndex(x);
+        for (int dir = 0; dir < n_dir; dir++) {
+          File link[link_size];
+          memcpy(link, site + dir * info.rows * 6 * sizeof(File), info.rows * 6 * sizeof(File));
+          if (swap)
+            for (int i = 0; i < info.rows * 6; i++) link[i] = swap_bytes(link[i]);
+          if (info.rows == 2) reconstructThirdRow(link);
+
+          if (info.format == FileFormat::NERSC) nersc += nerscSum(link);
+          trace += link[0] + link[8] + link[16];
+
+          Float *dst = gauge[dir] + index * link_size;
+          for (int i = 0; i < link_size; i++) dst[i] = link[i];
+        }
+      }
+    }
+
+    Checksum sum;
+    sum.suma = suma;
+    sum.sumb = sumb;
+    sum.nersc = nersc;
+    sum.trace = trace;
+    return sum;
+  }
+
+  /**
+     @brief Convert a time slice of the host gauge field into big
+     endian file data, accumulating the checksums.
+  */
+  template <typename Float, typename File>
+  Checksum packSlice(char *buf, Float **gauge, const Geometry &geom, int t)
+  {
+    const size_t site_bytes = n_dir * link_size * sizeof(File);
+    const bool swap = host_little_endian();
+    const int rows = geom.X[1] * geom.X[2];
+
+    uint32_t suma = 0, sumb = 0, nersc = 0;
+    double trace = 0.0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(^ : suma, sumb) reduction(+ : nersc, trace)
+#endif
+    for (int row = 0; row < rows; row++) {
+      for (int x0 = 0; x0 < geom.X[0]; x0++) {
+        int x[4] = {x0, row % geom.X[1], row / geom.X[1], t};
+        char *site = buf + (static_cast<size_t>(row) * geom.X[0] + x0) * site_bytes;
+        size_t index = geom.cbIndex(x);
+
+        for (int dir = 0; dir < n_dir; dir++) {
+          File link[link_size];
+          const Float *src = gauge[dir] + index * link_size;
+          for (int i = 0; i < link_size; i++) link[i] = src[i];
+          nersc += nerscSum(link);
+          trace += link[0] + link[8] + link[16];
+          if (swap)
+            for (int i = 0; i < link_size; i++) link[i] = swap_bytes(link[i]);
+          memcpy(site + dir * link_size * sizeof(File), link, link_size * sizeof(File));
+        }
+
+        size_t rank = geom.globalIndex(x);
+        uint32_t crc = crc32(site, site_bytes);
+        suma ^= rotl(crc, rank % 29);
+        sumb ^= rotl(crc, rank % 31);
+      }
+    }
+
+    Checksum sum;
+    sum.suma = suma;
+    sum.sumb = sumb;
+    sum.nersc = nersc;
+    sum.trace = trace;
+    return sum;
+  }
+
+  template <typename Float, typename File>
+  Checksum readSlices(int fd, Float **gauge, const Geometry &geom, const FileInfo &info, const char *filename)
+  {
+    const size_t site_bytes = info.siteBytes();
+    std::vector<char> buf(geom.X[0] * geom.X[1] * geom.X[2] * site_bytes);
+    Checksum total;
+
+    for (int t = 0; t < geom.X[3]; t++) {
+      auto extents = sliceExtents(geom, t, info.data_offset, site_bytes);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t i = 0; i < extents.size(); i++)
+        pread_all(fd, buf.data() + extents[i].buf_offset, extents[i].bytes, extents[i].file_offset, filename);
+
+      Checksum sum = unpackSlice<Float, File>(gauge, buf.data(), geom, info, t);
+      total.suma ^= sum.suma;
+      total.sumb ^= sum.sumb;
+      total.nersc += sum.nersc;
+      total.trace += sum.trace;
+    }
+
+    return total;
+  }
+
+  template <typename Float, typename File>
+  Checksum writeSlices(int fd, Float **gauge, const Geometry &geom, off_t data_offset, const char *filename)
+  {
+    const size_t site_bytes = n_dir * link_size * sizeof(File);
+    std::vector<char> buf(geom.X[0] * geom.X[1] * geom.X[2] * site_bytes);
+    Checksum total;
+
+    for (int t = 0; t < geom.X[3]; t++) {
+      Checksum sum = packSlice<Float, File>(buf.data(), gauge, geom, t);
+      total.suma ^= sum.suma;
+      total.sumb ^= sum.sumb;
+      total.nersc += sum.nersc;
+      total.trace += sum.trace;
+
+      auto extents = sliceExtents(geom, t, data_offset, site_bytes);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t i = 0; i < extents.size(); i++)
+        pwrite_all(fd, buf.data() + extents[i].buf_offset, extents[i].bytes, extents[i].file_offset, filename);
+    }
+
+    return total;
+  }
+
+  /**
+     @brief Compute the checksums of the host gauge field as they
+     would be written in file precision File, without doing any I/O
+  */
+  template <typename Float, typename File> Checksum computeChecksum(Float **gauge, const Geometry &geom)
+  {
+    const size_t site_bytes = n_dir * link_size * sizeof(File);
+    std::vector<char> buf(geom.X[0] * geom.X[1] * geom.X[2] * site_bytes);
+    Checksum total;
+    for (int t = 0; t < geom.X[3]; t++) {
+      Checksum sum = packSlice<Float, File>(buf.data(), gauge, geom, t);
+      total.nersc += sum.nersc;
+      total.trace += sum.trace;
+    }
+    return total;
+  }
+
+  std::string limeHeader(const std::string &type, uint64_t length, int flags)
+  {
+    std::string header(lime_header_bytes, '\0');
+    uint32_t magic = big_endian(lime_magic);
+    uint16_t version = big_endian(static_cast<uint16_t>(1));
+    uint16_t mbme = big_endian(static_cast<uint16_t>(flags));
+    length = big_endian(length);
+    memcpy(&header[0], &magic, sizeof(magic));
+    memcpy(&header[4], &version, sizeof(version));
+    memcpy(&header[6], &mbme, sizeof(mbme));
+    memcpy(&header[8], &length, sizeof(length));
+    memcpy(&header[16], type.c_str(), std::min(type.size(), lime_type_bytes - 1));
+    return header;
+  }
+
+  /**
+     @brief Return a LIME record (header, payload and padding) as a string
+  */
+  std::string limeRecord(const std::string &type, const std::string &data, int flags)
+  {
+    std::string record = limeHeader(type, data.size(), flags) + data;
+    record.resize(lime_header_bytes + ((data.size() + 7) / 8) * 8, '\0');
+    return record;
+  }
+
+  /**
+     @brief Check that the file holds a field of the lattice we are reading into
+  */
+  void checkLayout(const FileInfo &info, const Geometry &geom, const char *filename)
+  {
+    for (int d = 0; d < 4; d++) {
+      if (info.L[d] != 0 && info.L[d] != geom.L[d])
+        errorQuda("Lattice dimension %d of %s is %d, expected %d", d, filename, info.L[d], geom.L[d]);
+    }
+
+    // the payload must hold exactly one field of the expected precision and reconstruct, or at least that for NERSC
+    const uint64_t expected = static_cast<uint64_t>(info.siteBytes()) * geom.global_volume;
+    if (info.format == FileFormat::ILDG ? info.data_bytes != expected : info.data_bytes < expected)
+      errorQuda("Binary data of %s is %lu bytes, expected %lu bytes for %s precision and %d rows per link", filename,
+                (unsigned long)info.data_bytes, (unsigned long)expected,
+                info.precision == QUDA_DOUBLE_PRECISION ? "double" : "single", info.rows);
+  }
+
+} // namespace
+
+void read_gauge_field_native(const char *filename, void *gauge[], QudaPrecision prec, const int *X)
+{
+  if (prec != QUDA_DOUBLE_PRECISION && prec != QUDA_SINGLE_PRECISION) errorQuda("Unsupported precision %d", prec);
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+
+  Geometry geom(X);
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) errorQuda("Failed to open %s for reading", filename);
+
+  char magic_bytes[12] = {};
+  pread_all(fd, magic_bytes, sizeof(magic_bytes), 0, filename);
+  uint32_t magic;
+  memcpy(&magic, magic_bytes, sizeof(magic));
+
+  FileInfo info;
+  if (big_endian(magic) == lime_magic) {
+    info = parseLime(fd, filename);
+  } else if (strncmp(magic_bytes, "BEGIN_HEADER", sizeof(magic_bytes)) == 0) {
+    info = parseNERSC(fd, filename);
+  } else {
+    errorQuda("Unrecognized gauge file format for %s", filename);
+  }
+  checkLayout(info, geom, filename);
+
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("%s: reading %s gauge field %s (%s precision, %d rows)\n", __func__,
+               info.format == FileFormat::NERSC ? "NERSC" : "ILDG", filename,
+               info.precision == QUDA_DOUBLE_PRECISION ? "double" : "single", info.rows);
+
+  Checksum sum;
+  if (prec == QUDA_DOUBLE_PRECISION) {
+    if (info.precision == QUDA_DOUBLE_PRECISION)
+      sum = readSlices<double, double>(fd, reinterpret_cast<double **>(gauge), geom, info, filename);
+    else
+      sum = readSlices<double, float>(fd, reinterpret_cast<double **>(gauge), geom, info, filename);
+  } else {
+    if (info.precision == QUDA_DOUBLE_PRECISION)
+      sum = readSlices<float, double>(fd, reinterpret_cast<float **>(gauge), geom, info, filename);
+    else
+      sum = readSlices<float, float>(fd, reinterpret_cast<float **>(gauge), geom, info, filename);
+  }
+  close(fd);
+
+  sum.reduce();
+  double link_trace = sum.trace / (3.0 * n_dir * geom.global_volume);
+
+  if (info.has_scidac_checksum && (sum.suma != info.suma || sum.sumb != info.sumb))
+    errorQuda("SciDAC checksum mismatch for %s: computed %x %x, expected %x %x", filename, sum.suma, sum.sumb,
+              info.suma, info.sumb);
+  if (info.has_nersc_checksum && sum.nersc != info.nersc_checksum)
+    errorQuda("NERSC checksum mismatch for %s: computed %x, expected %x", filename, sum.nersc, info.nersc_checksum);
+  if (info.has_link_trace && fabs(link_trace - info.link_trace) > 1e-6)
+    errorQuda("NERSC link trace mismatch for %s: computed %e, expected %e", filename, link_trace, info.link_trace);
+
+  timer.Stop(__func__, __FILE__, __LINE__);
+  if (getVerbosity() >= QUDA_SUMMARIZE) {
+    double bytes = static_cast<double>(info.siteBytes()) * geom.global_volume;
+    printfQuda("%s: read %.3f GB in %.3f s (%.3f GB/s), link trace = %.15e\n", __func__, bytes / 1e9, timer.last,
+               bytes / (1e9 * timer.last), link_trace);
+  }
+}
+
+namespace
+{
+
+  /**
+     @brief Open a file for parallel writing: process 0 creates and
+     truncates the file before any other process opens it
+  */
+  int openForWriting(const char *filename, off_t size)
+  {
+    int fd = -1;
+    if (comm_rank() == 0) {
+      fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) errorQuda("Failed to open %s for writing", filename);
+      if (ftruncate(fd, size) != 0) errorQuda("Failed to resize %s to %ld bytes", filename, (long)size);
+    }
+    comm_barrier();
+    if (comm_rank() != 0) {
+      fd = open(filename, O_WRONLY);
+      if (fd < 0) errorQuda("Failed to open %s for writing", filename);
+    }
+    return fd;
+  }
+
+  template <typename Float>
+  Checksum writeData(int fd, void *gauge[], const Geometry &geom, off_t data_offset, QudaPrecision file_prec,
+                     const char *filename)
+  {
+    if (file_prec == QUDA_DOUBLE_PRECISION)
+      return writeSlices<Float, double>(fd, reinterpret_cast<Float **>(gauge), geom, data_offset, filename);
+    else
+      return writeSlices<Float, float>(fd, reinterpret_cast<Float **>(gauge), geom, data_offset, filename);
+  }
+
+  void checkWritePrecisions(QudaPrecision prec, QudaPrecision file_prec)
+  {
+    if (prec != QUDA_DOUBLE_PRECISION && prec != QUDA_SINGLE_PRECISION) errorQuda("Unsupported precision %d", prec);
+    if (file_prec != QUDA_DOUBLE_PRECISION && file_prec != QUDA_SINGLE_PRECISION)
+      errorQuda("Unsupported file precision %d", file_prec);
+  }
+
+} // namespace
+
+GaugeFileWrite begin_gauge_field_ildg(const char *filename, const int *X, QudaPrecision file_prec)
+{
+  checkWritePrecisions(QUDA_DOUBLE_PRECISION, file_prec);
+
+  Geometry geom(X);
+  GaugeFileWrite file;
+  file.filename = filename;
+  for (int d = 0; d < 4; d++) file.X[d] = X[d];
+  file.file_prec = file_prec;
+  file.data_bytes = static_cast<uint64_t>(n_dir) * link_size * file_prec * geom.global_volume;
+
+  char format[1024];
+  snprintf(format, sizeof(format),
+           "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+           "<ildgFormat xmlns=\"http://www.lqcd.org/ildg\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+           "xsi:schemaLocation=\"http://www.lqcd.org/ildg http://www.lqcd.org/ildg/ildgFormat.xsd\">"
+           "<version>1.0</version><field>su3gauge</field><precision>%d</precision>"
+           "<lx>%d</lx><ly>%d</ly><lz>%d</lz><lt>%d</lt></ildgFormat>",
+           file_prec == QUDA_DOUBLE_PRECISION ? 64 : 32, geom.L[0], geom.L[1], geom.L[2], geom.L[3]);
+
+  // the layout of the file is known up front: [ildg-format][ildg-binary-data][scidac-checksum]
+  std::string format_record = limeRecord("ildg-format", format, lime_mb);
+  std::string data_header = limeHeader("ildg-binary-data", file.data_bytes, lime_me);
+  file.data_offset = format_record.size() + data_header.size();
+  file.checksum_offset = file.data_offset + ((file.data_bytes + 7) / 8) * 8;
+
+  file.fd = openForWriting(filename, file.checksum_offset);
+  if (comm_rank() == 0) {
+    pwrite_all(file.fd, format_record.data(), format_record.size(), 0, filename);
+    pwrite_all(file.fd, data_header.data(), data_header.size(), format_record.size(), filename);
+  }
+
+  return file;
+}
+
+GaugeFileWrite begin_gauge_field_nersc(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                                       QudaPrecision file_prec, double plaquette)
+{
+  checkWritePrecisions(prec, file_prec);
+
+  Geometry geom(X);
+  GaugeFileWrite file;
+  file.filename = filename;
+  for (int d = 0; d < 4; d++) file.X[d] = X[d];
+  file.file_prec = file_prec;
+  file.data_bytes = static_cast<uint64_t>(n_dir) * link_size * file_prec * geom.global_volume;
+
+  // the header contains the checksum, so this needs computing before any data is written
+  Checksum sum;
+  if (prec == QUDA_DOUBLE_PRECISION)
+    sum = file_prec == QUDA_DOUBLE_PRECISION ? computeChecksum<double, double>(reinterpret_cast<double **>(gauge), geom) :
+                                               computeChecksum<double, float>(reinterpret_cast<double **>(gauge), geom);
+  else
+    sum = file_prec == QUDA_DOUBLE_PRECISION ? computeChecksum<float, double>(reinterpret_cast<float **>(gauge), geom) :
+                                               computeChecksum<float, float>(reinterpret_cast<float **>(gauge), geom);
+  sum.reduce();
+  file.nersc = sum.nersc;
+
+  char header[2048];
+  snprintf(header, sizeof(header),
+           "BEGIN_HEADER\n"
+           "HDR_VERSION = 1.0\n"
+           "DATATYPE = 4D_SU3_GAUGE_3x3\n"
+           "STORAGE_FORMAT = 1.0\n"
+           "DIMENSION_1 = %d\nDIMENSION_2 = %d\nDIMENSION_3 = %d\nDIMENSION_4 = %d\n"
+           "BOUNDARY_1 = PERIODIC\nBOUNDARY_2 = PERIODIC\nBOUNDARY_3 = PERIODIC\nBOUNDARY_4 = PERIODIC\n"
+           "LINK_TRACE = %.15e\n"
+           "PLAQUETTE = %.15e\n"
+           "CHECKSUM = %x\n"
+           "FLOATING_POINT = %s\n"
+           "ENSEMBLE_ID = quda\n"
+           "CREATOR = quda\n"
+           "END_HEADER\n",
+           geom.L[0], geom.L[1], geom.L[2], geom.L[3], sum.trace / (3.0 * n_dir * geom.global_volume), plaquette,
+           sum.nersc, file_prec == QUDA_DOUBLE_PRECISION ? "IEEE64BIG" : "IEEE32BIG");
+  file.data_offset = strlen(header);
+  file.checksum_offset = -1; // no trailing checksum record
+
+  file.fd = openForWriting(filename, file.data_offset + file.data_bytes);
+  if (comm_rank() == 0) pwrite_all(file.fd, header, file.data_offset, 0, filename);
+
+  return file;
+}
+
+void write_gauge_field_data(GaugeFileWrite &file, void *gauge[], QudaPrecision prec)
+{
+  checkWritePrecisions(prec, file.file_prec);
+
+  Geometry geom(file.X);
+  const char *filename = file.filename.c_str();
+  Checksum sum = prec == QUDA_DOUBLE_PRECISION ?
+    writeData<double>(file.fd, gauge, geom, file.data_offset, file.file_prec, filename) :
+    writeData<float>(file.fd, gauge, geom, file.data_offset, file.file_prec, filename);
+  file.suma = sum.suma;
+  file.sumb = sum.sumb;
+}
+
+void end_gauge_field_write(GaugeFileWrite &file)
+{
+  if (file.checksum_offset >= 0) {
+    Checksum sum;
+    sum.suma = file.suma;
+    sum.sumb = file.sumb;
+    sum.reduce();
+    file.suma = sum.suma;
+    file.sumb = sum.sumb;
+
+    if (comm_rank() == 0) {
+      char checksum[256];
+      snprintf(checksum, sizeof(checksum),
+               "<?xml version=\"1.0\" encoding=\"UTF-8\"?><scidacChecksum><version>1.0</version>"
+               "<suma>%x</suma><sumb>%x</sumb></scidacChecksum>",
+               sum.suma, sum.sumb);
+      std::string checksum_record = limeRecord("scidac-checksum", checksum, lime_mb | lime_me);
+      pwrite_all(file.fd, checksum_record.data(), checksum_record.size(), file.checksum_offset, file.filename.c_str());
+    }
+  }
+
+  close(file.fd);
+  file.fd = -1;
+  comm_barrier();
+}
+
+void write_gauge_field_ildg(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                            QudaPrecision file_prec)
+{
+  checkWritePrecisions(prec, file_prec);
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+
+  GaugeFileWrite file = begin_gauge_field_ildg(filename, X, file_prec);
+  write_gauge_field_data(file, gauge, prec);
+  end_gauge_field_write(file);
+
+  timer.Stop(__func__, __FILE__, __LINE__);
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("%s: wrote %.3f GB to %s in %.3f s (%.3f GB/s), checksum %x %x\n", __func__, file.data_bytes / 1e9,
+               filename, timer.last, file.data_bytes / (1e9 * timer.last), file.suma, file.sumb);
+}
+
+void write_gauge_field_nersc(const char *filename, void *gauge[], QudaPrecision prec, const int *X,
+                             QudaPrecision file_prec, double plaquette)
+{
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+
+  GaugeFileWrite file = begin_gauge_field_nersc(filename, gauge, prec, X, file_prec, plaquette);
+  write_gauge_field_data(file, gauge, prec);
+  end_gauge_field_write(file);
+
+  timer.Stop(__func__, __FILE__, __LINE__);
+  if (getVerbosity() >= QUDA_SUMMARIZE)
+    printfQuda("%s: wrote %.3f GB to %s in %.3f s (%.3f GB/s), checksum %x\n", __func__, file.data_bytes / 1e9,
+               filename, timer.last, file.data_bytes / (1e9 * timer.last), file.nersc);
+}
@@ -0,0 +1,96 @@
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <host_worker.h>
+
+namespace quda
+{
+
+  namespace host_worker
+  {
+
+    namespace
+    {
+
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::thread worker;
+      bool stop = false;
+
+      std::deque<std::function<void()>> queue; // tasks that have not completed
+      int submitted = 0;                       // number of tasks submitted
+      int completed = 0;                       // number of tasks completed
+
+      /**
+         @brief Body of the worker thread: run each queued task in turn
+       */
+      void run()
+      {
+        while (true) {
+          std::function<void()> *task = nullptr;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [] { return stop || !queue.empty(); });
+            if (queue.empty()) return;
+            task = &queue.front();
+          }
+
+          (*task)();
+
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.pop_front();
+            completed++;
+          }
+          cv.notify_all();
+        }
+      }
+
+    } // namespace
+
+    int submit(std::function<void()> task)
+    {
+      int ticket;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!worker.joinable()) {
+          stop = false;
+          worker = std::thread(run);
+        }
+        queue.push_back(std::move(task));
+        ticket = submitted++;
+      }
+      cv.notify_all();
+      return ticket;
+    }
+
+    bool test(int ticket)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return ticket < completed;
+    }
+
+    void wait(int ticket)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (ticket < 0) ticket = submitted - 1;
+      cv.wait(lock, [ticket] { return ticket < completed; });
+    }
+
+    void destroy()
+    {
+      wait(-1);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      cv.notify_all();
+      if (worker.joinable()) worker.join();
+    }
+
+  } // namespace host_worker
+
+} // namespace quda
@@ -2,7 +2,12 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <array>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sys/time.h>
 #include <complex.h>
 
@@ -60,6 +65,10 @@
 #include <contract_quda.h>
 
 #include <momentum.h>
+#include <gauge_checkpoint.h>
+#include <host_worker.h>
+#include <content_hash.h>
+#include <spectral_bounds.h>
 
 using namespace quda;
 
@@ -129,7 +138,30 @@ std::vector<cudaColorSpinorField*> solutionResident;
 // vector of spinors used for forecasting solutions in HMC
 #define QUDA_MAX_CHRONO 12
 // each entry is one p
-std::vector< std::vector<ColorSpinorField*> > chronoResident(QUDA_MAX_CHRONO);
+std::vector<ChronoBasis> chronoResident(QUDA_MAX_CHRONO);
+
+/**
+   State of a solve submitted with invertAsyncQuda.  The host wrappers
+   of the application fields, the device source (also used to describe
+   the native order of the staging buffer) and the pinned staging
+   buffers are owned by the request until waitQuda.
+ */
+struct AsyncInvert {
+  QudaInvertParam *param;
+  void *hp_x;
+  void *hp_b;
+  ColorSpinorField *h_x;
+  ColorSpinorField *h_b;
+  ColorSpinorField *b;
+  void *staging; /**< Source in native order, reused for the solution */
+  void *guess;   /**< Initial guess in native order */
+  int stage_in;  /**< Ticket of the host worker task reordering the source and guess */
+  int stage_out; /**< Ticket of the host worker task reordering the solution */
+  bool solved;
+};
+
+static std::map<int, AsyncInvert> async_inverts;
+static int async_handle = 0;
 
 // Mapped memory buffer used to hold unitarization failures
 static int *num_failures_h = nullptr;
@@ -509,6 +541,8 @@ void initQudaDevice(int dev)
 /*
  * Any persistent memory allocations that QUDA uses are done here.
  */
+static void printGaugeMirrorUsage();
+
 void initQudaMemory()
 {
   profileInit.TPSTART(QUDA_PROFILE_TOTAL);
@@ -524,6 +558,8 @@ void initQudaMemory()
   // initalize the memory pool allocators
   pool::init();
 
+  register_mem_usage_report(printGaugeMirrorUsage);
+
   num_failures_h = static_cast<int*>(mapped_malloc(sizeof(int)));
   num_failures_d = static_cast<int*>(get_mapped_device_pointer(num_failures_h));
 
@@ -557,60 +593,553 @@ void initQuda(int dev)
 // possible flag to indicate we need to recompute the clover field
 static bool invalidate_clover = true;
 
+// Hashes of the host fields that the resident gauge fields were last
+// loaded from, keyed by gauge type.  A type is only present while its
+// resident fields are known to be unmodified copies of that host field.
+static std::map<QudaLinkType, uint64_t> gauge_hash;
+
+// Hash of what the resident clover field was created from: the host
+// field it was loaded from, or the hash of the resident gauge field it
+// was computed from.  It is 0 if that is not known.
+static uint64_t clover_hash = 0;
+
+// Incremented whenever a resident gauge or clover field may have
+// changed, so that state derived from the operator can be invalidated
+static uint64_t resident_generation = 0;
+
+/**
+   @brief Forget the host field hash for a gauge type: this must be
+   called whenever the resident fields of that type are replaced or
+   modified by anything other than loadGaugeQuda
+ */
+static void invalidateGaugeHash(QudaLinkType type)
+{
+  gauge_hash.erase(type);
+  resident_generation++;
+}
+
+/**
+   @brief Return the hash of a host gauge field being loaded, combined
+   with the parameters that determine the resident fields created
+   from it
+ */
+static uint64_t gaugeHash(const GaugeField &in, const QudaGaugeParam &param)
+{
+  const int64_t ints[] = {static_cast<int64_t>(param.type),
+                          static_cast<int64_t>(param.cuda_prec),
+                          static_cast<int64_t>(param.cuda_prec_sloppy),
+                          static_cast<int64_t>(param.cuda_prec_precondition),
+                          static_cast<int64_t>(param.cuda_prec_refinement_sloppy),
+                          static_cast<int64_t>(param.reconstruct),
+                          static_cast<int64_t>(param.reconstruct_sloppy),
+                          static_cast<int64_t>(param.reconstruct_precondition),
+                          static_cast<int64_t>(param.reconstruct_refinement_sloppy),
+                          static_cast<int64_t>(param.ga_pad),
+                          static_cast<int64_t>(param.overlap),
+                          static_cast<int64_t>(param.t_boundary),
+                          static_cast<int64_t>(param.gauge_fix),
+                          static_cast<int64_t>(param.staggered_phase_type),
+                          static_cast<int64_t>(param.staggered_phase_applied)};
+  const double reals[] = {param.anisotropy, param.tadpole_coeff, param.scale, param.i_mu};
+  const uint64_t hash = xxhash64(ints, sizeof(ints), in.hash());
+  return xxhash64(reals, sizeof(reals), hash);
+}
+
+// Levels of the lower precision mirrors of each resident gauge field
+enum GaugeMirrorLevel { GAUGE_MIRROR_SLOPPY, GAUGE_MIRROR_PRECONDITION, GAUGE_MIRROR_REFINEMENT, GAUGE_MIRROR_LEVELS };
+
+// Reconstruct types requested for the mirrors of each gauge type when it was last loaded
+static std::map<QudaLinkType, std::array<QudaReconstructType, GAUGE_MIRROR_LEVELS>> mirror_recon;
+
+struct GaugeMirrorStats {
+  int builds = 0;          /**< Number of times the mirror has been created */
+  int evictions = 0;       /**< Number of times the mirror has been freed to stay within the memory budget */
+  double build_time = 0.0; /**< Total time spent creating the mirror */
+  size_t peak_bytes = 0;   /**< Largest device memory allocated for the mirror */
+  uint64_t last_use = 0;   /**< When the mirror was last used, for least-recently-used eviction */
+};
+
+static std::map<std::pair<QudaLinkType, int>, GaugeMirrorStats> mirror_stats;
+static uint64_t mirror_clock = 0;
+
+// Number of live multigrid and deflation instances, whose Dirac
+// operators hold the mirrors they were created with between solves
+static int persistent_mirror_users = 0;
+
+/**
+   @brief Return the resident precise field of a gauge type
+ */
+static cudaGaugeField *preciseGauge(QudaLinkType type)
+{
+  switch (type) {
+  case QUDA_WILSON_LINKS: return gaugePrecise;
+  case QUDA_ASQTAD_FAT_LINKS: return gaugeFatPrecise;
+  case QUDA_ASQTAD_LONG_LINKS: return gaugeLongPrecise;
+  default: errorQuda("Invalid gauge type %d", type); return nullptr;
+  }
+}
+
+/**
+   @brief Return a reference to the pointer that holds a mirror of a
+   resident gauge field
+ */
+static cudaGaugeField *&gaugeMirrorField(QudaLinkType type, int level)
+{
+  static cudaGaugeField **wilson[] = {&gaugeSloppy, &gaugePrecondition, &gaugeRefinement};
+  static cudaGaugeField **fat[] = {&gaugeFatSloppy, &gaugeFatPrecondition, &gaugeFatRefinement};
+  static cudaGaugeField **lng[] = {&gaugeLongSloppy, &gaugeLongPrecondition, &gaugeLongRefinement};
+  if (level < 0 || level >= GAUGE_MIRROR_LEVELS) errorQuda("Invalid gauge mirror level %d", level);
+
+  switch (type) {
+  case QUDA_WILSON_LINKS: return *wilson[level];
+  case QUDA_ASQTAD_FAT_LINKS: return *fat[level];
+  case QUDA_ASQTAD_LONG_LINKS: return *lng[level];
+  default: errorQuda("Invalid gauge type %d", type); return *wilson[level];
+  }
+}
+
+static constexpr QudaLinkType mirror_types[] = {QUDA_WILSON_LINKS, QUDA_ASQTAD_FAT_LINKS, QUDA_ASQTAD_LONG_LINKS};
+
+/**
+   @brief Free a mirror of a resident gauge field, unless its storage
+   is shared with the precise field or with another mirror
+ */
+static void freeGaugeMirror(QudaLinkType type, int level)
+{
+  cudaGaugeField *&mirror = gaugeMirrorField(type, level);
+  cudaGaugeField *u = mirror;
+  mirror = nullptr;
+
+  if (u == nullptr || u == preciseGauge(type)) return;
+  for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++)
+    if (gaugeMirrorField(type, l) == u) return;
+  delete u;
+}
+
+/**
+   @brief Free all the mirrors of a resident gauge field
+ */
+static void freeGaugeMirrors(QudaLinkType type)
+{
+  for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++) freeGaugeMirror(type, l);
+}
+
+/**
+   @brief Return the device memory used by the mirrors of all resident
+   gauge fields, not counting storage shared with a precise field
+ */
+static size_t gaugeMirrorBytes()
+{
+  std::vector<const cudaGaugeField *> counted;
+  size_t bytes = 0;
+  for (auto type : mirror_types) {
+    for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++) {
+      const cudaGaugeField *u = gaugeMirrorField(type, l);
+      if (u == nullptr || u == preciseGauge(type) || std::find(counted.begin(), counted.end(), u) != counted.end())
+        continue;
+      counted.push_back(u);
+      bytes += u->Bytes();
+    }
+  }
+  return bytes;
+}
+
+/**
+   @brief Return a mirror of a resident gauge field with the given
+   precision, creating it first if it does not exist or has a
+   different precision or reconstruction.  The mirror shares the
+   storage of the precise field, or of another mirror, if these
+   already match.  The reconstruction used is that requested when the
+   gauge field was loaded.
+   @param[in] type Gauge type
+   @param[in] level Mirror level
+   @param[in] prec Precision of the mirror
+   @return The mirror, or nullptr if there is no precise field of this type
+ */
+static cudaGaugeField *gaugeMirror(QudaLinkType type, int level, QudaPrecision prec)
+{
+  cudaGaugeField *precise = preciseGauge(type);
+  if (precise == nullptr) return nullptr;
+
+  // fat links are never reconstructed
+  QudaReconstructType recon = precise->Reconstruct();
+  auto requested = mirror_recon.find(type);
+  if (type != QUDA_ASQTAD_FAT_LINKS && requested != mirror_recon.end()) recon = requested->second[level];
+
+  auto &stats = mirror_stats[std::make_pair(type, level)];
+  stats.last_use = ++mirror_clock;
+
+  auto matches = [=](const cudaGaugeField *u) { return u && u->Precision() == prec && u->Reconstruct() == recon; };
+  cudaGaugeField *&mirror = gaugeMirrorField(type, level);
+  if (matches(mirror)) return mirror;
+  freeGaugeMirror(type, level);
+
+  if (matches(precise)) return mirror = precise;
+  for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++)
+    if (matches(gaugeMirrorField(type, l))) return mirror = gaugeMirrorField(type, l);
+
+  Timer timer;
+  timer.Start(__func__, __FILE__, __LINE__);
+
+  GaugeFieldParam gauge_param(*precise);
+  gauge_param.reconstruct = recon;
+  gauge_param.setPrecision(prec, true);
+  mirror = new cudaGaugeField(gauge_param);
+  mirror->copy(*precise);
+
+  qudaDeviceSynchronize();
+  timer.Stop(__func__, __FILE__, __LINE__);
+
+  stats.builds++;
+  stats.build_time += timer.last;
+  stats.peak_bytes = std::max(stats.peak_bytes, mirror->Bytes());
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+    printfQuda("Created gauge mirror (type %d, level %d, precision %d, reconstruct %d) in %.3f s\n", type, level,
+               prec, recon, timer.last);
+
+  return mirror;
+}
+
+/**
+   @brief Create the mirrors needed by a Dirac operator at a given level, if they do not exist
+   @param[in] param Invert parameters of the operator
+   @param[in] level Mirror level
+   @param[in] prec Precision of the operator
+ */
+static void createGaugeMirrors(const QudaInvertParam &param, int level, QudaPrecision prec)
+{
+  if (param.dslash_type == QUDA_ASQTAD_DSLASH) {
+    gaugeMirror(QUDA_ASQTAD_FAT_LINKS, level, prec);
+    gaugeMirror(QUDA_ASQTAD_LONG_LINKS, level, prec);
+  } else {
+    gaugeMirror(QUDA_WILSON_LINKS, level, prec);
+  }
+}
+
+/**
+   @brief If the mirrors of the resident gauge fields use more device
+   memory than QUDA_GAUGE_MIRROR_MEMORY (in MiB, default unlimited),
+   free the least recently used mirrors until they do not.  Mirrors
+   at the precisions requested by param are kept, since these are
+   about to be used.  This is called before a solver creates its
+   Dirac operators, so the operators of the solve itself cannot hold
+   a freed mirror; the operators of multigrid and deflation instances
+   persist between solves, so nothing is evicted while any exists.
+   @param[in] param Invert parameters of the solve about to be done
+ */
+static void evictGaugeMirrors(const QudaInvertParam &param)
+{
+  static long budget = -1;
+  if (budget < 0) {
+    char *budget_env = getenv("QUDA_GAUGE_MIRROR_MEMORY");
+    budget = budget_env ? std::max(atol(budget_env), 0l) * (1l << 20) : 0;
+  }
+  if (budget == 0) return;
+  if (persistent_mirror_users > 0) {
+    if (getVerbosity() >= QUDA_DEBUG_VERBOSE && gaugeMirrorBytes() > static_cast<size_t>(budget))
+      printfQuda("Not freeing gauge mirrors while %d multigrid or deflation instances use them\n",
+                 persistent_mirror_users);
+    return;
+  }
+
+  const QudaPrecision needed[] = {param.cuda_prec_sloppy, param.cuda_prec_precondition, param.cuda_prec_refinement_sloppy};
+
+  while (gaugeMirrorBytes() > static_cast<size_t>(budget)) {
+    QudaLinkType lru_type = QUDA_INVALID_LINKS;
+    int lru_level = 0;
+    uint64_t lru_use = std::numeric_limits<uint64_t>::max();
+    for (auto type : mirror_types) {
+      for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++) {
+        const cudaGaugeField *u = gaugeMirrorField(type, l);
+        if (u == nullptr || u == preciseGauge(type) || u->Precision() == needed[l]) continue;
+        auto &stats = mirror_stats[std::make_pair(type, l)];
+        if (stats.last_use < lru_use) {
+          lru_use = stats.last_use;
+          lru_type = type;
+          lru_level = l;
+        }
+      }
+    }
+    if (lru_type == QUDA_INVALID_LINKS) break; // everything left is needed
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Freeing gauge mirror (type %d, level %d) to stay within QUDA_GAUGE_MIRROR_MEMORY\n", lru_type,
+                 lru_level);
+    freeGaugeMirror(lru_type, lru_level);
+    mirror_stats[std::make_pair(lru_type, lru_level)].evictions++;
+  }
+}
+
+/**
+   @brief Report the memory used and time spent creating each gauge
+   mirror, called by printPeakMemUsage
+ */
+static void printGaugeMirrorUsage()
+{
+  static const char *level_name[] = {"sloppy", "precondition", "refinement"};
+  for (auto &it : mirror_stats) {
+    const char *type_name = it.first.first == QUDA_WILSON_LINKS ? "gauge" :
+      it.first.first == QUDA_ASQTAD_FAT_LINKS                   ? "fat" :
+                                                                  "long";
+    const auto &stats = it.second;
+    if (stats.builds == 0) continue;
+    printfQuda("Gauge mirror %s %s: %.1f MB, created %d times in %.3f s, evicted %d times\n", type_name,
+               level_name[it.first.second], stats.peak_bytes / (double)(1 << 20), stats.builds, stats.build_time,
+               stats.evictions);
+  }
+}
+
+/**
+   The resident state of a QudaContext.  The interface functions work
+   on the file-scope globals above, so the state of a context is
+   swapped into the globals while it is bound, and back out again
+   afterwards; the state of the default context lives in the globals
+   whenever no other context is bound.  Binding is done under a
+   process-wide lock, since the device, the autotuner, the memory
+   pools and communication are shared by all contexts.
+ */
+struct QudaContext_s {
+  cudaGaugeField *gaugePrecise = nullptr;
+  cudaGaugeField *gaugeSloppy = nullptr;
+  cudaGaugeField *gaugePrecondition = nullptr;
+  cudaGaugeField *gaugeRefinement = nullptr;
+  cudaGaugeField *gaugeExtended = nullptr;
+
+  cudaGaugeField *gaugeFatPrecise = nullptr;
+  cudaGaugeField *gaugeFatSloppy = nullptr;
+  cudaGaugeField *gaugeFatPrecondition = nullptr;
+  cudaGaugeField *gaugeFatRefinement = nullptr;
+  cudaGaugeField *gaugeFatExtended = nullptr;
+
+  cudaGaugeField *gaugeLongExtended = nullptr;
+  cudaGaugeField *gaugeLongPrecise = nullptr;
+  cudaGaugeField *gaugeLongSloppy = nullptr;
+  cudaGaugeField *gaugeLongPrecondition = nullptr;
+  cudaGaugeField *gaugeLongRefinement = nullptr;
+
+  cudaGaugeField *gaugeSmeared = nullptr;
+
+  cudaCloverField *cloverPrecise = nullptr;
+  cudaCloverField *cloverSloppy = nullptr;
+  cudaCloverField *cloverPrecondition = nullptr;
+  cudaCloverField *cloverRefinement = nullptr;
+
+  cudaGaugeField *momResident = nullptr;
+  cudaGaugeField *extendedGaugeResident = nullptr;
+
+  std::vector<cudaColorSpinorField *> solutionResident;
+  std::vector<ChronoBasis> chronoResident;
+
+  bool invalidate_clover = true;
+  std::map<QudaLinkType, uint64_t> gauge_hash;
+  uint64_t clover_hash = 0;
+  uint64_t resident_generation = 0;
+  std::map<QudaLinkType, std::array<QudaReconstructType, GAUGE_MIRROR_LEVELS>> mirror_recon;
+  std::map<std::pair<QudaLinkType, int>, GaugeMirrorStats> mirror_stats;
+  uint64_t mirror_clock = 0;
+  std::map<int, AsyncInvert> async_inverts;
+  int async_handle = 0;
+  int persistent_mirror_users = 0;
+
+  TimeProfile profileGauge;
+  TimeProfile profileClover;
+  TimeProfile profileInvert;
+  TimeProfile profileMulti;
+  TimeProfile profileEigensolve;
+
+  QudaContext_s() :
+    chronoResident(QUDA_MAX_CHRONO),
+    profileGauge("loadGaugeQuda"),
+    profileClover("loadCloverQuda"),
+    profileInvert("invertQuda"),
+    profileMulti("invertMultiShiftQuda"),
+    profileEigensolve("eigensolveQuda")
+  {
+  }
+};
+
+static std::recursive_mutex context_mutex;
+static QudaContext_s *bound_context = nullptr; // context whose state is in the globals, if not the default
+static std::set<QudaContext_s *> contexts;      // contexts that have been created but not destroyed
+
+/**
+   @brief Exchange the state of a context with the globals
+ */
+static void swapContext(QudaContext_s &ctx)
+{
+  std::swap(gaugePrecise, ctx.gaugePrecise);
+  std::swap(gaugeSloppy, ctx.gaugeSloppy);
+  std::swap(gaugePrecondition, ctx.gaugePrecondition);
+  std::swap(gaugeRefinement, ctx.gaugeRefinement);
+  std::swap(gaugeExtended, ctx.gaugeExtended);
+
+  std::swap(gaugeFatPrecise, ctx.gaugeFatPrecise);
+  std::swap(gaugeFatSloppy, ctx.gaugeFatSloppy);
+  std::swap(gaugeFatPrecondition, ctx.gaugeFatPrecondition);
+  std::swap(gaugeFatRefinement, ctx.gaugeFatRefinement);
+  std::swap(gaugeFatExtended, ctx.gaugeFatExtended);
+
+  std::swap(gaugeLongExtended, ctx.gaugeLongExtended);
+  std::swap(gaugeLongPrecise, ctx.gaugeLongPrecise);
+  std::swap(gaugeLongSloppy, ctx.gaugeLongSloppy);
+  std::swap(gaugeLongPrecondition, ctx.gaugeLongPrecondition);
+  std::swap(gaugeLongRefinement, ctx.gaugeLongRefinement);
+
+  std::swap(gaugeSmeared, ctx.gaugeSmeared);
+
+  std::swap(cloverPrecise, ctx.cloverPrecise);
+  std::swap(cloverSloppy, ctx.cloverSloppy);
+  std::swap(cloverPrecondition, ctx.cloverPrecondition);
+  std::swap(cloverRefinement, ctx.cloverRefinement);
+
+  std::swap(momResident, ctx.momResident);
+  std::swap(extendedGaugeResident, ctx.extendedGaugeResident);
+
+  std::swap(solutionResident, ctx.solutionResident);
+  std::swap(chronoResident, ctx.chronoResident);
+
+  std::swap(invalidate_clover, ctx.invalidate_clover);
+  std::swap(gauge_hash, ctx.gauge_hash);
+  std::swap(clover_hash, ctx.clover_hash);
+  std::swap(resident_generation, ctx.resident_generation);
+  std::swap(mirror_recon, ctx.mirror_recon);
+  std::swap(mirror_stats, ctx.mirror_stats);
+  std::swap(mirror_clock, ctx.mirror_clock);
+  std::swap(async_inverts, ctx.async_inverts);
+  std::swap(async_handle, ctx.async_handle);
+  std::swap(persistent_mirror_users, ctx.persistent_mirror_users);
+
+  std::swap(profileGauge, ctx.profileGauge);
+  std::swap(profileClover, ctx.profileClover);
+  std::swap(profileInvert, ctx.profileInvert);
+  std::swap(profileMulti, ctx.profileMulti);
+  std::swap(profileEigensolve, ctx.profileEigensolve);
+}
+
+/**
+   Serializes an interface call against calls from other threads, and
+   binds a context for its duration.  A null context, or the context
+   that is already bound, leaves the current binding in place, so
+   interface functions may call each other freely.
+ */
+class ContextScope
+{
+  std::lock_guard<std::recursive_mutex> lock;
+  QudaContext_s *ctx;
+
+public:
+  ContextScope(QudaContext_s *ctx) : lock(context_mutex), ctx(ctx != bound_context ? ctx : nullptr)
+  {
+    if (!this->ctx) return;
+    if (bound_context) errorQuda("Cannot bind context %p while context %p is bound", this->ctx, bound_context);
+    if (contexts.count(this->ctx) == 0) errorQuda("Invalid context %p", this->ctx);
+    swapContext(*this->ctx);
+    bound_context = this->ctx;
+  }
+
+  ~ContextScope()
+  {
+    if (!ctx) return;
+    swapContext(*ctx);
+    bound_context = nullptr;
+  }
+};
+
+/**
+   @brief Return whether the resident fields of a gauge type are
+   present with the precision and reconstruction requested by param
+   (the mirrors are created on demand, so are not needed)
+ */
+static bool residentGaugeMatches(const QudaGaugeParam &param)
+{
+  auto matches = [&](const cudaGaugeField *u) {
+    return u && u->Precision() == param.cuda_prec && u->Reconstruct() == param.reconstruct;
+  };
+
+  switch (param.type) {
+  case QUDA_WILSON_LINKS: return matches(gaugePrecise) && (!param.overlap || gaugeExtended);
+  case QUDA_ASQTAD_FAT_LINKS: return matches(gaugeFatPrecise) && (!param.overlap || gaugeFatExtended);
+  case QUDA_ASQTAD_LONG_LINKS: return matches(gaugeLongPrecise) && (!param.overlap || gaugeLongExtended);
+  case QUDA_SMEARED_LINKS: return gaugeSmeared != nullptr;
+  default: return false;
+  }
+}
+
+/**
+   @brief Return whether the field passed to loadGaugeQuda can be
+   adopted as the precise field without a copy: it must be accessible
+   from the device, and already be in the native order and precision
+   of the precise field (the padding is assumed to be ga_pad)
+ */
+static bool adoptableGauge(void *h_gauge, const QudaGaugeParam &param)
+{
+  if (param.type == QUDA_SMEARED_LINKS || param.use_resident_gauge || !h_gauge) return false;
+  if (get_pointer_location(h_gauge) != QUDA_CUDA_FIELD_LOCATION) return false;
+
+  GaugeFieldParam precise_param(h_gauge, param);
+  precise_param.reconstruct = param.reconstruct;
+  precise_param.setPrecision(param.cuda_prec, true);
+  return param.cpu_prec == param.cuda_prec && param.gauge_order == precise_param.order;
+}
+
 void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 {
+  ContextScope scope(nullptr);
   profileGauge.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!initialized) errorQuda("QUDA not initialized");
   if (getVerbosity() == QUDA_DEBUG_VERBOSE) printQudaGaugeParam(param);
 
   checkGaugeParam(param);
+  waitQuda(-1); // outstanding solves use the current gauge field
 
   profileGauge.TPSTART(QUDA_PROFILE_INIT);
   // Set the specific input parameters and create the cpu gauge field
   GaugeFieldParam gauge_param(h_gauge, *param);
 
+  const bool adopt = param->reference_gauge && adoptableGauge(h_gauge, *param);
+  if (param->reference_gauge && getVerbosity() >= QUDA_VERBOSE)
+    printfQuda(adopt ? "Adopting gauge field %p as the resident field\n" :
+                       "Gauge field %p cannot be adopted as the resident field, copying\n", h_gauge);
+
   if (gauge_param.order <= 4) gauge_param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
-  GaugeField *in = (param->location == QUDA_CPU_FIELD_LOCATION) ?
+  GaugeField *in = adopt ? nullptr :
+    (param->location == QUDA_CPU_FIELD_LOCATION) ?
     static_cast<GaugeField*>(new cpuGaugeField(gauge_param)) :
     static_cast<GaugeField*>(new cudaGaugeField(gauge_param));
 
-  if (in->Order() == QUDA_BQCD_GAUGE_ORDER) {
-    static size_t checksum = SIZE_MAX;
-    size_t in_checksum = in->checksum(true);
-    if (in_checksum == checksum) {
-      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Gauge field unchanged - using cached gauge field %lu\n", checksum);
-      profileGauge.TPSTOP(QUDA_PROFILE_INIT);
-      profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
-      delete in;
-      invalidate_clover = false;
-      return;
-    }
-    checksum = in_checksum;
-    invalidate_clover = true;
+  // if the host field is unchanged since it was last loaded then the
+  // resident fields (including the sloppy mirrors) are still valid
+  const bool hashable = param->location == QUDA_CPU_FIELD_LOCATION && !param->use_resident_gauge && !adopt;
+  const uint64_t in_hash = hashable ? gaugeHash(*in, *param) : 0;
+  auto cached = gauge_hash.find(param->type);
+  if (hashable && cached != gauge_hash.end() && cached->second == in_hash && residentGaugeMatches(*param)) {
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Gauge field unchanged - using cached gauge field %016llx\n", (unsigned long long)in_hash);
+    profileGauge.TPSTOP(QUDA_PROFILE_INIT);
+    profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
+    delete in;
+    if (param->type == QUDA_WILSON_LINKS) invalidate_clover = false;
+    if (param->type != QUDA_SMEARED_LINKS)
+      mirror_recon[param->type]
+        = {param->reconstruct_sloppy, param->reconstruct_precondition, param->reconstruct_refinement_sloppy};
+    return;
   }
+  invalidateGaugeHash(param->type);
+  if (param->type == QUDA_WILSON_LINKS) invalidate_clover = true;
 
   // free any current gauge field before new allocations to reduce memory overhead
   switch (param->type) {
     case QUDA_WILSON_LINKS:
-      if (gaugeRefinement != gaugeSloppy && gaugeRefinement) delete gaugeRefinement;
-      if (gaugeSloppy != gaugePrecondition && gaugePrecise != gaugePrecondition && gaugePrecondition)
-        delete gaugePrecondition;
-      if (gaugePrecise != gaugeSloppy && gaugeSloppy) delete gaugeSloppy;
+      freeGaugeMirrors(param->type);
       if (gaugePrecise && !param->use_resident_gauge) delete gaugePrecise;
       break;
     case QUDA_ASQTAD_FAT_LINKS:
-      if (gaugeFatRefinement != gaugeFatSloppy && gaugeFatRefinement) delete gaugeFatRefinement;
-      if (gaugeFatSloppy != gaugeFatPrecondition && gaugeFatPrecise != gaugeFatPrecondition && gaugeFatPrecondition)
-        delete gaugeFatPrecondition;
-      if (gaugeFatPrecise != gaugeFatSloppy && gaugeFatSloppy) delete gaugeFatSloppy;
+      freeGaugeMirrors(param->type);
       if (gaugeFatPrecise && !param->use_resident_gauge) delete gaugeFatPrecise;
       break;
     case QUDA_ASQTAD_LONG_LINKS:
-      if (gaugeLongRefinement != gaugeLongSloppy && gaugeLongRefinement) delete gaugeLongRefinement;
-      if (gaugeLongSloppy != gaugeLongPrecondition && gaugeLongPrecise != gaugeLongPrecondition && gaugeLongPrecondition)
-        delete gaugeLongPrecondition;
-      if (gaugeLongPrecise != gaugeLongSloppy && gaugeLongSloppy) delete gaugeLongSloppy;
+      freeGaugeMirrors(param->type);
       if (gaugeLongPrecise) delete gaugeLongPrecise;
       break;
     case QUDA_SMEARED_LINKS:
@@ -624,7 +1153,7 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   cudaGaugeField *precise = nullptr;
 
   // switch the parameters for creating the mirror precise cuda gauge field
-  gauge_param.create = QUDA_NULL_FIELD_CREATE;
+  gauge_param.create = adopt ? QUDA_REFERENCE_FIELD_CREATE : QUDA_NULL_FIELD_CREATE;
   gauge_param.reconstruct = param->reconstruct;
   gauge_param.setPrecision(param->cuda_prec, true);
   gauge_param.ghostExchange = QUDA_GHOST_EXCHANGE_PAD;
@@ -632,7 +1161,11 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 
   precise = new cudaGaugeField(gauge_param);
 
-  if (param->use_resident_gauge) {
+  if (adopt) {
+    // the constructor zeroes the pad of a reference field, so fill in the ghost zones again
+    precise->exchangeGhost();
+    profileGauge.TPSTOP(QUDA_PROFILE_INIT);
+  } else if (param->use_resident_gauge) {
     if(gaugePrecise == nullptr) errorQuda("No resident gauge field");
     // copy rather than point at to ensure that the padded region is filled in
     precise->copy(*gaugePrecise);
@@ -656,93 +1189,47 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     delete in;
     profileGauge.TPSTOP(QUDA_PROFILE_FREE);
 
+    if (hashable) gauge_hash[param->type] = in_hash;
+
     profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
     return;
   }
 
-  // creating sloppy fields isn't really compute, but it is work done on the gpu
-  profileGauge.TPSTART(QUDA_PROFILE_COMPUTE);
-
-  // switch the parameters for creating the mirror sloppy cuda gauge field
-  gauge_param.reconstruct = param->reconstruct_sloppy;
-  gauge_param.setPrecision(param->cuda_prec_sloppy, true);
-  cudaGaugeField *sloppy = nullptr;
-  if (param->cuda_prec == param->cuda_prec_sloppy && param->reconstruct == param->reconstruct_sloppy) {
-    sloppy = precise;
-  } else {
-    sloppy = new cudaGaugeField(gauge_param);
-    sloppy->copy(*precise);
-  }
-
-  // switch the parameters for creating the mirror preconditioner cuda gauge field
-  gauge_param.reconstruct = param->reconstruct_precondition;
-  gauge_param.setPrecision(param->cuda_prec_precondition, true);
-  cudaGaugeField *precondition = nullptr;
-  if (param->cuda_prec == param->cuda_prec_precondition && param->reconstruct == param->reconstruct_precondition) {
-    precondition = precise;
-  } else if (param->cuda_prec_sloppy == param->cuda_prec_precondition
-             && param->reconstruct_sloppy == param->reconstruct_precondition) {
-    precondition = sloppy;
-  } else {
-    precondition = new cudaGaugeField(gauge_param);
-    precondition->copy(*precise);
-  }
-
-  // switch the parameters for creating the refinement cuda gauge field
-  gauge_param.reconstruct = param->reconstruct_refinement_sloppy;
-  gauge_param.setPrecision(param->cuda_prec_refinement_sloppy, true);
-  cudaGaugeField *refinement = nullptr;
-  if (param->cuda_prec_sloppy == param->cuda_prec_refinement_sloppy
-      && param->reconstruct_sloppy == param->reconstruct_refinement_sloppy) {
-    refinement = sloppy;
-  } else {
-    refinement = new cudaGaugeField(gauge_param);
-    refinement->copy(*sloppy);
+  switch (param->type) {
+  case QUDA_WILSON_LINKS: gaugePrecise = precise; break;
+  case QUDA_ASQTAD_FAT_LINKS: gaugeFatPrecise = precise; break;
+  case QUDA_ASQTAD_LONG_LINKS: gaugeLongPrecise = precise; break;
+  default: errorQuda("Invalid gauge type %d", param->type);
   }
 
-  profileGauge.TPSTOP(QUDA_PROFILE_COMPUTE);
+  // the sloppy, preconditioner and refinement mirrors are created
+  // when a Dirac operator first needs them (see gaugeMirror)
+  mirror_recon[param->type]
+    = {param->reconstruct_sloppy, param->reconstruct_precondition, param->reconstruct_refinement_sloppy};
 
   // create an extended preconditioning field
-  cudaGaugeField* extended = nullptr;
-  if (param->overlap){
+  if (param->overlap) {
+    // creating the preconditioner mirror isn't really compute, but it is work done on the gpu
+    profileGauge.TPSTART(QUDA_PROFILE_COMPUTE);
+    cudaGaugeField *precondition = gaugeMirror(param->type, GAUGE_MIRROR_PRECONDITION, param->cuda_prec_precondition);
+    profileGauge.TPSTOP(QUDA_PROFILE_COMPUTE);
+
     int R[4]; // domain-overlap widths in different directions
     for (int i=0; i<4; ++i) R[i] = param->overlap*commDimPartitioned(i);
-    extended = createExtendedGauge(*precondition, R, profileGauge);
-  }
-
-  switch (param->type) {
-    case QUDA_WILSON_LINKS:
-      gaugePrecise = precise;
-      gaugeSloppy = sloppy;
-      gaugePrecondition = precondition;
-      gaugeRefinement = refinement;
+    cudaGaugeField *extended = createExtendedGauge(*precondition, R, profileGauge);
 
-      if(param->overlap) gaugeExtended = extended;
-      break;
+    switch (param->type) {
+    case QUDA_WILSON_LINKS: gaugeExtended = extended; break;
     case QUDA_ASQTAD_FAT_LINKS:
-      gaugeFatPrecise = precise;
-      gaugeFatSloppy = sloppy;
-      gaugeFatPrecondition = precondition;
-      gaugeFatRefinement = refinement;
-
-      if(param->overlap){
-        if(gaugeFatExtended) errorQuda("Extended gauge fat field already allocated");
-	gaugeFatExtended = extended;
-      }
+      if (gaugeFatExtended) errorQuda("Extended gauge fat field already allocated");
+      gaugeFatExtended = extended;
       break;
     case QUDA_ASQTAD_LONG_LINKS:
-      gaugeLongPrecise = precise;
-      gaugeLongSloppy = sloppy;
-      gaugeLongPrecondition = precondition;
-      gaugeLongRefinement = refinement;
-
-      if(param->overlap){
-        if(gaugeLongExtended) errorQuda("Extended gauge long field already allocated");
-   	gaugeLongExtended = extended;
-      }
+      if (gaugeLongExtended) errorQuda("Extended gauge long field already allocated");
+      gaugeLongExtended = extended;
       break;
-    default:
-      errorQuda("Invalid gauge type %d", param->type);
+    default: errorQuda("Invalid gauge type %d", param->type);
+    }
   }
 
   profileGauge.TPSTART(QUDA_PROFILE_FREE);
@@ -759,11 +1246,14 @@ void loadGaugeQuda(void *h_gauge, QudaGaugeParam *param)
     extendedGaugeResident = createExtendedGauge(*gaugePrecise, R, profileGauge, false, recon);
   }
 
+  if (hashable) gauge_hash[param->type] = in_hash;
+
   profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
 void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
 {
+  ContextScope scope(nullptr);
   profileGauge.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (param->location != QUDA_CPU_FIELD_LOCATION)
@@ -808,15 +1298,117 @@ void saveGaugeQuda(void *h_gauge, QudaGaugeParam *param)
   profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
 }
 
+/**
+   @brief Return the parameters of a host snapshot of a resident field
+   for checkpointing, with the precision given by param->cpu_prec
+ */
+static GaugeFieldParam checkpointParam(const QudaGaugeParam &param, QudaLinkType link_type)
+{
+  if (param.cpu_prec != QUDA_DOUBLE_PRECISION && param.cpu_prec != QUDA_SINGLE_PRECISION)
+    errorQuda("Unsupported checkpoint precision %d", param.cpu_prec);
+  GaugeFieldParam gParam(nullptr, param, link_type);
+  gParam.create = QUDA_NULL_FIELD_CREATE;
+  gParam.reconstruct = QUDA_RECONSTRUCT_NO;
+  gParam.order = QUDA_QDP_GAUGE_ORDER;
+  gParam.setPrecision(param.cpu_prec);
+  return gParam;
+}
+
+int saveGaugeAsyncQuda(const char *filename, QudaGaugeParam *param)
+{
+  ContextScope scope(nullptr);
+  profileGauge.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  checkGaugeParam(param);
+
+  cudaGaugeField *cudaGauge = nullptr;
+  switch (param->type) {
+  case QUDA_WILSON_LINKS: cudaGauge = gaugePrecise; break;
+  case QUDA_ASQTAD_FAT_LINKS: cudaGauge = gaugeFatPrecise; break;
+  case QUDA_ASQTAD_LONG_LINKS: cudaGauge = gaugeLongPrecise; break;
+  default: errorQuda("Unsupported gauge type %d for checkpointing", param->type);
+  }
+  if (!cudaGauge) errorQuda("No resident gauge field of type %d", param->type);
+
+  cpuGaugeField *snapshot = checkpoint::acquire(checkpointParam(*param, param->type));
+
+  profileGauge.TPSTART(QUDA_PROFILE_D2H);
+  cudaGauge->saveCPUField(*snapshot);
+  profileGauge.TPSTOP(QUDA_PROFILE_D2H);
+
+  int handle = checkpoint::submit(snapshot, filename, param->cpu_prec);
+
+  profileGauge.TPSTOP(QUDA_PROFILE_TOTAL);
+  return handle;
+}
+
+int saveMomAsyncQuda(const char *filename, QudaGaugeParam *param)
+{
+  ContextScope scope(nullptr);
+  profileGaugeForce.TPSTART(QUDA_PROFILE_TOTAL);
+
+  if (!initialized) errorQuda("QUDA not initialized");
+  checkGaugeParam(param);
+  if (!momResident) errorQuda("No resident momentum field");
+
+  cpuGaugeField *snapshot = checkpoint::acquire(checkpointParam(*param, QUDA_ASQTAD_MOM_LINKS));
+
+  // download in MILC order with the native 10-real compression, then expand to full anti-Hermitian matrices
+  profileGaugeForce.TPSTART(QUDA_PROFILE_D2H);
+  GaugeFieldParam gParamMom(nullptr, *param, QUDA_ASQTAD_MOM_LINKS);
+  gParamMom.create = QUDA_NULL_FIELD_CREATE;
+  gParamMom.order = QUDA_MILC_GAUGE_ORDER;
+  gParamMom.reconstruct = QUDA_RECONSTRUCT_10;
+  gParamMom.setPrecision(param->cpu_prec);
+  cpuGaugeField cpuMom(gParamMom);
+  momResident->saveCPUField(cpuMom);
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_D2H);
+
+  profileGaugeForce.TPSTART(QUDA_PROFILE_COMPUTE);
+  auto expand = [&](auto *milc, auto **qdp) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (size_t x = 0; x < cpuMom.Volume(); x++) {
+      for (int d = 0; d < 4; d++) {
+        const auto *in = milc + (x * 4 + d) * 10;
+        auto *out = qdp[d] + x * 18;
+        // diagonal is imaginary, lower triangle is minus the conjugate of the upper
+        const double m[18] = {0.0,    in[6], in[0], in[1],  in[2], in[3], -in[0], in[1], 0.0,
+                              in[7],  in[4], in[5], -in[2], in[3], -in[4], in[5], 0.0,   in[8]};
+        for (int i = 0; i < 18; i++) out[i] = m[i];
+      }
+    }
+  };
+  if (param->cpu_prec == QUDA_DOUBLE_PRECISION)
+    expand(static_cast<double *>(cpuMom.Gauge_p()), static_cast<double **>(snapshot->Gauge_p()));
+  else
+    expand(static_cast<float *>(cpuMom.Gauge_p()), static_cast<float **>(snapshot->Gauge_p()));
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_COMPUTE);
+
+  int handle = checkpoint::submit(snapshot, filename, param->cpu_prec);
+
+  profileGaugeForce.TPSTOP(QUDA_PROFILE_TOTAL);
+  return handle;
+}
+
+int checkpointTestQuda(int handle) { return checkpoint::test(handle) ? 1 : 0; }
+
+void checkpointWaitQuda(int handle) { checkpoint::wait(handle); }
+
 void loadSloppyCloverQuda(const QudaPrecision prec[]);
 void freeSloppyCloverQuda();
 
 void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
 {
+  ContextScope scope(nullptr);
   profileClover.TPSTART(QUDA_PROFILE_TOTAL);
   profileClover.TPSTART(QUDA_PROFILE_INIT);
 
   checkCloverParam(inv_param);
+  waitQuda(-1); // outstanding solves use the current clover field
+  resident_generation++;
   bool device_calc = false; // calculate clover and inverse on the device?
 
   pushVerbosity(inv_param->verbosity);
@@ -914,6 +1506,10 @@ void loadCloverQuda(void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
       bool inverse = (h_clovinv && !inv_param->compute_clover_inverse && !dynamic_clover_inverse());
       cloverPrecise->copy(*in, inverse);
       profileClover.TPSTOP(QUDA_PROFILE_H2D);
+      // the resident clover field is only known if it was loaded from a hashable host field
+      const bool hashable
+        = inv_param->clover_location == QUDA_CPU_FIELD_LOCATION && inv_param->clover_order != QUDA_QDPJIT_CLOVER_ORDER;
+      clover_hash = hashable ? in->hash() : 0;
     } else {
       profileClover.TPSTOP(QUDA_PROFILE_TOTAL);
       createCloverQuda(inv_param);
@@ -1060,39 +1656,18 @@ void freeSloppyGaugeQuda()
 {
   if (!initialized) errorQuda("QUDA not initialized");
 
-  if (gaugeSloppy != gaugeRefinement && gaugeRefinement) delete gaugeRefinement;
-  if (gaugeSloppy != gaugePrecondition && gaugePrecise != gaugePrecondition && gaugePrecondition)
-    delete gaugePrecondition;
-  if (gaugePrecise != gaugeSloppy && gaugeSloppy) delete gaugeSloppy;
-
-  gaugeRefinement = nullptr;
-  gaugePrecondition = nullptr;
-  gaugeSloppy = nullptr;
-
-  if (gaugeLongSloppy != gaugeLongRefinement && gaugeLongRefinement) delete gaugeLongRefinement;
-  if (gaugeLongSloppy != gaugeLongPrecondition && gaugeLongPrecise != gaugeLongPrecondition && gaugeLongPrecondition)
-    delete gaugeLongPrecondition;
-  if (gaugeLongPrecise != gaugeLongSloppy && gaugeLongSloppy) delete gaugeLongSloppy;
-
-  gaugeLongRefinement = nullptr;
-  gaugeLongPrecondition = nullptr;
-  gaugeLongSloppy = nullptr;
-
-  if (gaugeFatSloppy != gaugeFatRefinement && gaugeFatRefinement) delete gaugeFatRefinement;
-  if (gaugeFatSloppy != gaugeFatPrecondition && gaugeFatPrecise != gaugeFatPrecondition && gaugeFatPrecondition)
-    delete gaugeFatPrecondition;
-  if (gaugeFatPrecise != gaugeFatSloppy && gaugeFatSloppy) delete gaugeFatSloppy;
-
-  gaugeFatRefinement = nullptr;
-  gaugeFatPrecondition = nullptr;
-  gaugeFatSloppy = nullptr;
+  for (auto type : mirror_types) freeGaugeMirrors(type);
 }
 
 void freeGaugeQuda(void)
 {
+  ContextScope scope(nullptr);
   if (!initialized) errorQuda("QUDA not initialized");
+  waitQuda(-1);
 
   freeSloppyGaugeQuda();
+  gauge_hash.clear();
+  resident_generation++;
 
   if (gaugePrecise) delete gaugePrecise;
   if (gaugeExtended) delete gaugeExtended;
@@ -1123,146 +1698,13 @@ void freeGaugeQuda(void)
 
 void loadSloppyGaugeQuda(const QudaPrecision *prec, const QudaReconstructType *recon)
 {
-  // first do SU3 links (if they exist)
-  if (gaugePrecise) {
-    GaugeFieldParam gauge_param(*gaugePrecise);
-    // switch the parameters for creating the mirror sloppy cuda gauge field
-
-    gauge_param.reconstruct = recon[0];
-    gauge_param.setPrecision(prec[0], true);
-
-    if (gaugeSloppy) errorQuda("gaugeSloppy already exists");
-
-    if (gauge_param.Precision() == gaugePrecise->Precision() && gauge_param.reconstruct == gaugePrecise->Reconstruct()) {
-      gaugeSloppy = gaugePrecise;
-    } else {
-      gaugeSloppy = new cudaGaugeField(gauge_param);
-      gaugeSloppy->copy(*gaugePrecise);
-    }
-
-    // switch the parameters for creating the mirror preconditioner cuda gauge field
-    gauge_param.reconstruct = recon[1];
-    gauge_param.setPrecision(prec[1], true);
-
-    if (gaugePrecondition) errorQuda("gaugePrecondition already exists");
-
-    if (gauge_param.Precision() == gaugePrecise->Precision() && gauge_param.reconstruct == gaugePrecise->Reconstruct()) {
-      gaugePrecondition = gaugePrecise;
-    } else if (gauge_param.Precision() == gaugeSloppy->Precision()
-               && gauge_param.reconstruct == gaugeSloppy->Reconstruct()) {
-      gaugePrecondition = gaugeSloppy;
-    } else {
-      gaugePrecondition = new cudaGaugeField(gauge_param);
-      gaugePrecondition->copy(*gaugePrecise);
-    }
-
-    // switch the parameters for creating the mirror refinement cuda gauge field
-    gauge_param.reconstruct = recon[2];
-    gauge_param.setPrecision(prec[2], true);
-
-    if (gaugeRefinement) errorQuda("gaugeRefinement already exists");
-
-    if (gauge_param.Precision() == gaugeSloppy->Precision() && gauge_param.reconstruct == gaugeSloppy->Reconstruct()) {
-      gaugeRefinement = gaugeSloppy;
-    } else {
-      gaugeRefinement = new cudaGaugeField(gauge_param);
-      gaugeRefinement->copy(*gaugeSloppy);
-    }
-  }
-
-  // fat links (if they exist)
-  if (gaugeFatPrecise) {
-    GaugeFieldParam gauge_param(*gaugeFatPrecise);
-
-    gauge_param.setPrecision(prec[0], true);
-
-    if (gaugeFatSloppy) errorQuda("gaugeFatSloppy already exists");
-
-    if (gauge_param.Precision() == gaugeFatPrecise->Precision()
-        && gauge_param.reconstruct == gaugeFatPrecise->Reconstruct()) {
-      gaugeFatSloppy = gaugeFatPrecise;
-    } else {
-      gaugeFatSloppy = new cudaGaugeField(gauge_param);
-      gaugeFatSloppy->copy(*gaugeFatPrecise);
-    }
-
-    // switch the parameters for creating the mirror preconditioner cuda gauge field
-    gauge_param.setPrecision(prec[1], true);
-
-    if (gaugeFatPrecondition) errorQuda("gaugeFatPrecondition already exists\n");
-
-    if (gauge_param.Precision() == gaugeFatPrecise->Precision()
-        && gauge_param.reconstruct == gaugeFatPrecise->Reconstruct()) {
-      gaugeFatPrecondition = gaugeFatPrecise;
-    } else if (gauge_param.Precision() == gaugeFatSloppy->Precision()
-               && gauge_param.reconstruct == gaugeFatSloppy->Reconstruct()) {
-      gaugeFatPrecondition = gaugeFatSloppy;
-    } else {
-      gaugeFatPrecondition = new cudaGaugeField(gauge_param);
-      gaugeFatPrecondition->copy(*gaugeFatPrecise);
-    }
-
-    // switch the parameters for creating the mirror refinement cuda gauge field
-    gauge_param.setPrecision(prec[2], true);
-
-    if (gaugeFatRefinement) errorQuda("gaugeFatRefinement already exists\n");
-
-    if (gauge_param.Precision() == gaugeFatSloppy->Precision()
-        && gauge_param.reconstruct == gaugeFatSloppy->Reconstruct()) {
-      gaugeFatRefinement = gaugeFatSloppy;
-    } else {
-      gaugeFatRefinement = new cudaGaugeField(gauge_param);
-      gaugeFatRefinement->copy(*gaugeFatSloppy);
-    }
-  }
-
-  // long links (if they exist)
-  if (gaugeLongPrecise) {
-    GaugeFieldParam gauge_param(*gaugeLongPrecise);
-
-    gauge_param.reconstruct = recon[0];
-    gauge_param.setPrecision(prec[0], true);
-
-    if (gaugeLongSloppy) errorQuda("gaugeLongSloppy already exists");
-
-    if (gauge_param.Precision() == gaugeLongPrecise->Precision()
-        && gauge_param.reconstruct == gaugeLongPrecise->Reconstruct()) {
-      gaugeLongSloppy = gaugeLongPrecise;
-    } else {
-      gaugeLongSloppy = new cudaGaugeField(gauge_param);
-      gaugeLongSloppy->copy(*gaugeLongPrecise);
-    }
-
-    // switch the parameters for creating the mirror preconditioner cuda gauge field
-    gauge_param.reconstruct = recon[1];
-    gauge_param.setPrecision(prec[1], true);
-
-    if (gaugeLongPrecondition) errorQuda("gaugeLongPrecondition already exists\n");
-
-    if (gauge_param.Precision() == gaugeLongPrecise->Precision()
-        && gauge_param.reconstruct == gaugeLongPrecise->Reconstruct()) {
-      gaugeLongPrecondition = gaugeLongPrecise;
-    } else if (gauge_param.Precision() == gaugeLongSloppy->Precision()
-               && gauge_param.reconstruct == gaugeLongSloppy->Reconstruct()) {
-      gaugeLongPrecondition = gaugeLongSloppy;
-    } else {
-      gaugeLongPrecondition = new cudaGaugeField(gauge_param);
-      gaugeLongPrecondition->copy(*gaugeLongPrecise);
-    }
-
-    // switch the parameters for creating the mirror refinement cuda gauge field
-    gauge_param.reconstruct = recon[2];
-    gauge_param.setPrecision(prec[2], true);
-
-    if (gaugeLongRefinement) errorQuda("gaugeLongRefinement already exists\n");
-
-    if (gauge_param.Precision() == gaugeLongSloppy->Precision()
-        && gauge_param.reconstruct == gaugeLongSloppy->Reconstruct()) {
-      gaugeLongRefinement = gaugeLongSloppy;
-    } else {
-      gaugeLongRefinement = new cudaGaugeField(gauge_param);
-      gaugeLongRefinement->copy(*gaugeLongSloppy);
+  for (auto type : mirror_types) {
+    if (preciseGauge(type) == nullptr) continue;
+    for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++) {
+      if (gaugeMirrorField(type, l)) errorQuda("Gauge mirror (type %d, level %d) already exists", type, l);
     }
+    mirror_recon[type] = {recon[0], recon[1], recon[2]};
+    for (int l = 0; l < GAUGE_MIRROR_LEVELS; l++) gaugeMirror(type, l, prec[l]);
   }
 }
 
@@ -1281,31 +1723,38 @@ void freeSloppyCloverQuda()
 
 void freeCloverQuda(void)
 {
+  ContextScope scope(nullptr);
   if (!initialized) errorQuda("QUDA not initialized");
+  waitQuda(-1);
+  resident_generation++;
   freeSloppyCloverQuda();
   if (cloverPrecise) delete cloverPrecise;
   cloverPrecise = nullptr;
+  clover_hash = 0;
 }
 
 void flushChronoQuda(int i)
 {
+  ContextScope scope(nullptr);
   if (i >= QUDA_MAX_CHRONO)
     errorQuda("Requested chrono index %d is outside of max %d\n", i, QUDA_MAX_CHRONO);
 
-  auto &basis = chronoResident[i];
-
-  for (auto v : basis) {
-    if (v)  delete v;
-  }
-  basis.clear();
+  chronoResident[i].clear();
 }
 
 void endQuda(void)
 {
+  ContextScope scope(nullptr);
   profileEnd.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!initialized) return;
 
+  // complete any outstanding checkpoints and solves before tearing anything down
+  checkpoint::destroy();
+  while (!contexts.empty()) destroyQudaContext(*contexts.begin());
+  waitQuda(-1);
+  host_worker::destroy();
+
   freeGaugeQuda();
   freeCloverQuda();
 
@@ -1318,6 +1767,7 @@ void endQuda(void)
 
   LatticeField::freeGhostBuffer();
   cpuColorSpinorField::freeGhostBuffer();
+  Transfer::freeGeoMapCache();
 
   blas_lapack::generic::destroy();
   blas_lapack::native::destroy();
@@ -1391,6 +1841,164 @@ void endQuda(void)
   device::destroy();
 }
 
+QudaContext newQudaContext(void)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  std::lock_guard<std::recursive_mutex> lock(context_mutex);
+  QudaContext ctx = new QudaContext_s;
+  contexts.insert(ctx);
+  return ctx;
+}
+
+void destroyQudaContext(QudaContext ctx)
+{
+  if (!initialized) errorQuda("QUDA not initialized");
+  std::lock_guard<std::recursive_mutex> lock(context_mutex);
+  if (ctx == bound_context) errorQuda("Cannot destroy context %p while it is bound", ctx);
+
+  {
+    ContextScope scope(ctx);
+    waitQuda(-1);
+    freeGaugeQuda();
+    freeCloverQuda();
+
+    for (int i = 0; i < QUDA_MAX_CHRONO; i++) flushChronoQuda(i);
+
+    for (auto v : solutionResident)
+      if (v) delete v;
+    solutionResident.clear();
+
+    if (momResident) delete momResident;
+    momResident = nullptr;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("\nProfile of context %p\n", ctx);
+      profileGauge.Print();
+      profileClover.Print();
+      profileInvert.Print();
+      profileMulti.Print();
+      profileEigensolve.Print();
+    }
+  }
+
+  contexts.erase(ctx);
+  delete ctx;
+}
+
+void loadGaugeQuda_ctx(QudaContext ctx, void *h_gauge, QudaGaugeParam *param)
+{
+  ContextScope scope(ctx);
+  loadGaugeQuda(h_gauge, param);
+}
+
+void freeGaugeQuda_ctx(QudaContext ctx)
+{
+  ContextScope scope(ctx);
+  freeGaugeQuda();
+}
+
+void saveGaugeQuda_ctx(QudaContext ctx, void *h_gauge, QudaGaugeParam *param)
+{
+  ContextScope scope(ctx);
+  saveGaugeQuda(h_gauge, param);
+}
+
+void loadCloverQuda_ctx(QudaContext ctx, void *h_clover, void *h_clovinv, QudaInvertParam *inv_param)
+{
+  ContextScope scope(ctx);
+  loadCloverQuda(h_clover, h_clovinv, inv_param);
+}
+
+void freeCloverQuda_ctx(QudaContext ctx)
+{
+  ContextScope scope(ctx);
+  freeCloverQuda();
+}
+
+void flushChronoQuda_ctx(QudaContext ctx, int index)
+{
+  ContextScope scope(ctx);
+  flushChronoQuda(index);
+}
+
+void plaqQuda_ctx(QudaContext ctx, double plaq[3])
+{
+  ContextScope scope(ctx);
+  plaqQuda(plaq);
+}
+
+void dslashQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity parity)
+{
+  ContextScope scope(ctx);
+  dslashQuda(h_out, h_in, inv_param, parity);
+}
+
+void MatQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param)
+{
+  ContextScope scope(ctx);
+  MatQuda(h_out, h_in, inv_param);
+}
+
+void MatDagMatQuda_ctx(QudaContext ctx, void *h_out, void *h_in, QudaInvertParam *inv_param)
+{
+  ContextScope scope(ctx);
+  MatDagMatQuda(h_out, h_in, inv_param);
+}
+
+void invertQuda_ctx(QudaContext ctx, void *h_x, void *h_b, QudaInvertParam *param)
+{
+  ContextScope scope(ctx);
+  invertQuda(h_x, h_b, param);
+}
+
+int invertAsyncQuda_ctx(QudaContext ctx, void *h_x, void *h_b, QudaInvertParam *param)
+{
+  ContextScope scope(ctx);
+  return invertAsyncQuda(h_x, h_b, param);
+}
+
+void waitQuda_ctx(QudaContext ctx, int handle)
+{
+  ContextScope scope(ctx);
+  waitQuda(handle);
+}
+
+void invertMultiSrcQuda_ctx(QudaContext ctx, void **_hp_x, void **_hp_b, QudaInvertParam *param)
+{
+  ContextScope scope(ctx);
+  invertMultiSrcQuda(_hp_x, _hp_b, param);
+}
+
+void invertMultiShiftQuda_ctx(QudaContext ctx, void **_hp_x, void *_hp_b, QudaInvertParam *param)
+{
+  ContextScope scope(ctx);
+  invertMultiShiftQuda(_hp_x, _hp_b, param);
+}
+
+void eigensolveQuda_ctx(QudaContext ctx, void **h_evecs, double _Complex *h_evals, QudaEigParam *param)
+{
+  ContextScope scope(ctx);
+  eigensolveQuda(h_evecs, h_evals, param);
+}
+
+void *newMultigridQuda_ctx(QudaContext ctx, QudaMultigridParam *param)
+{
+  ContextScope scope(ctx);
+  return newMultigridQuda(param);
+}
+
+void updateMultigridQuda_ctx(QudaContext ctx, void *mg_instance, QudaMultigridParam *param)
+{
+  ContextScope scope(ctx);
+  updateMultigridQuda(mg_instance, param);
+}
+
+void destroyMultigridQuda_ctx(QudaContext ctx, void *mg_instance)
+{
+  ContextScope scope(ctx);
+  destroyMultigridQuda(mg_instance);
+}
+
 
 namespace quda {
 
@@ -1517,6 +2125,7 @@ namespace quda {
   {
     setDiracParam(diracParam, inv_param, pc);
 
+    createGaugeMirrors(*inv_param, GAUGE_MIRROR_SLOPPY, inv_param->cuda_prec_sloppy);
     diracParam.gauge = inv_param->dslash_type == QUDA_ASQTAD_DSLASH ? gaugeFatSloppy : gaugeSloppy;
     diracParam.fatGauge = gaugeFatSloppy;
     diracParam.longGauge = gaugeLongSloppy;
@@ -1535,6 +2144,7 @@ namespace quda {
   {
     setDiracParam(diracParam, inv_param, pc);
 
+    createGaugeMirrors(*inv_param, GAUGE_MIRROR_REFINEMENT, inv_param->cuda_prec_refinement_sloppy);
     diracParam.gauge = inv_param->dslash_type == QUDA_ASQTAD_DSLASH ? gaugeFatRefinement : gaugeRefinement;
     diracParam.fatGauge = gaugeFatRefinement;
     diracParam.longGauge = gaugeLongRefinement;
@@ -1559,6 +2169,7 @@ namespace quda {
       diracParam.fatGauge = gaugeFatExtended;
       diracParam.longGauge = gaugeLongExtended;
     } else {
+      createGaugeMirrors(*inv_param, GAUGE_MIRROR_PRECONDITION, inv_param->cuda_prec_precondition);
       diracParam.gauge = inv_param->dslash_type == QUDA_ASQTAD_DSLASH ? gaugeFatPrecondition : gaugePrecondition;
       diracParam.fatGauge = gaugeFatPrecondition;
       diracParam.longGauge = gaugeLongPrecondition;
@@ -1573,7 +2184,7 @@ namespace quda {
     if(inv_param->inv_type == QUDA_PCG_INVERTER && inv_param->dslash_type == QUDA_ASQTAD_DSLASH
        && inv_param->dslash_type_precondition == QUDA_STAGGERED_DSLASH) {
        diracParam.type = pc ? QUDA_STAGGEREDPC_DIRAC : QUDA_STAGGERED_DIRAC;
-       diracParam.gauge = gaugeFatPrecondition;
+       diracParam.gauge = gaugeMirror(QUDA_ASQTAD_FAT_LINKS, GAUGE_MIRROR_PRECONDITION, inv_param->cuda_prec_precondition);
     }
 
     if (diracParam.gauge->Precision() != inv_param->cuda_prec_precondition)
@@ -1581,6 +2192,31 @@ namespace quda {
                 inv_param->cuda_prec_precondition);
   }
 
+  /**
+     @brief Return whether the solver selected by param applies its
+     preconditioner operator.  The CG and BiCGstab family only do so
+     to deflate, so otherwise they are given the sloppy operator in its
+     place, and the preconditioner gauge mirrors are never created.
+     GCRO-DR only uses the eig_param to preserve its recycled subspace.
+   */
+  static bool usesPreconditioner(const QudaInvertParam &param)
+  {
+    switch (param.inv_type) {
+    case QUDA_CG_INVERTER:
+    case QUDA_CGNE_INVERTER:
+    case QUDA_CGNR_INVERTER:
+    case QUDA_CG3_INVERTER:
+    case QUDA_CG3NE_INVERTER:
+    case QUDA_CG3NR_INVERTER:
+    case QUDA_CA_CG_INVERTER:
+    case QUDA_CA_CGNE_INVERTER:
+    case QUDA_CA_CGNR_INVERTER:
+    case QUDA_BICGSTAB_INVERTER: return param.eig_param != nullptr;
+    case QUDA_GCRODR_INVERTER: return false;
+    default: return true;
+    }
+  }
+
   void createDirac(Dirac *&d, Dirac *&dSloppy, Dirac *&dPre, QudaInvertParam &param, const bool pc_solve)
   {
     DiracParam diracParam;
@@ -1591,7 +2227,10 @@ namespace quda {
     setDiracSloppyParam(diracSloppyParam, &param, pc_solve);
     // eigCG and deflation need 2 sloppy precisions and do not use Schwarz
     bool comms_flag = (param.schwarz_type != QUDA_INVALID_SCHWARZ) ? false : true;
-    setDiracPreParam(diracPreParam, &param, pc_solve, comms_flag);
+    if (usesPreconditioner(param))
+      setDiracPreParam(diracPreParam, &param, pc_solve, comms_flag);
+    else
+      diracPreParam = diracSloppyParam;
 
     d = Dirac::create(diracParam); // create the Dirac operator
     dSloppy = Dirac::create(diracSloppyParam);
@@ -1610,7 +2249,10 @@ namespace quda {
     setDiracRefineParam(diracRefParam, &param, pc_solve);
     // eigCG and deflation need 2 sloppy precisions and do not use Schwarz
     bool comms_flag = (param.inv_type == QUDA_INC_EIGCG_INVERTER || param.eig_param) ? true : false;
-    setDiracPreParam(diracPreParam, &param, pc_solve, comms_flag);
+    if (usesPreconditioner(param))
+      setDiracPreParam(diracPreParam, &param, pc_solve, comms_flag);
+    else
+      diracPreParam = diracSloppyParam;
 
     d = Dirac::create(diracParam); // create the Dirac operator
     dSloppy = Dirac::create(diracSloppyParam);
@@ -1707,6 +2349,7 @@ namespace quda {
 
 void dslashQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity parity)
 {
+  ContextScope scope(nullptr);
   profileDslash.TPSTART(QUDA_PROFILE_TOTAL);
   profileDslash.TPSTART(QUDA_PROFILE_INIT);
 
@@ -1799,6 +2442,7 @@ void dslashQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity
 
 void MatQuda(void *h_out, void *h_in, QudaInvertParam *inv_param)
 {
+  ContextScope scope(nullptr);
   pushVerbosity(inv_param->verbosity);
 
   const auto &gauge = (inv_param->dslash_type != QUDA_ASQTAD_DSLASH) ? *gaugePrecise : *gaugeFatPrecise;
@@ -1869,6 +2513,7 @@ void MatQuda(void *h_out, void *h_in, QudaInvertParam *inv_param)
 
 void MatDagMatQuda(void *h_out, void *h_in, QudaInvertParam *inv_param)
 {
+  ContextScope scope(nullptr);
   pushVerbosity(inv_param->verbosity);
 
   const auto &gauge = (inv_param->dslash_type != QUDA_ASQTAD_DSLASH) ? *gaugePrecise : *gaugeFatPrecise;
@@ -1975,6 +2620,233 @@ void checkClover(QudaInvertParam *param) {
   if (cloverRefinement == nullptr) errorQuda("Refinement clover field doesn't exist");
 }
 
+/**
+   @brief Hash the operator parameters that are not visible from the
+   Dirac operator.  The precision is excluded.
+   @param[in] param The solver parameters
+   @return The hash
+ */
+static uint64_t operatorHash(const QudaInvertParam &param)
+{
+  struct {
+    int dslash_type;
+    int matpc_type;
+    int solve_type;
+    int twist_flavor;
+    int Ls;
+    int eofa_pm;
+    int laplace3D;
+    double kappa;
+    double mass;
+    double mu;
+    double epsilon;
+    double m5;
+    double clover_coeff;
+    double eofa_shift;
+    double mq1;
+    double mq2;
+    double mq3;
+  } op;
+  memset(&op, 0, sizeof(op)); // zero the padding since it is hashed
+
+  op.dslash_type = param.dslash_type;
+  op.matpc_type = param.matpc_type;
+  op.solve_type = param.solve_type;
+  op.twist_flavor = param.twist_flavor;
+  op.Ls = param.Ls;
+  op.eofa_pm = param.eofa_pm;
+  op.laplace3D = param.laplace3D;
+  op.kappa = param.kappa;
+  op.mass = param.mass;
+  op.mu = param.mu;
+  op.epsilon = param.epsilon;
+  op.m5 = param.m5;
+  op.clover_coeff = param.clover_coeff;
+  op.eofa_shift = param.eofa_shift;
+  op.mq1 = param.mq1;
+  op.mq2 = param.mq2;
+  op.mq3 = param.mq3;
+
+  uint64_t hash = xxhash64(&op, sizeof(op));
+  hash = xxhash64(param.b_5, sizeof(param.b_5), hash);
+  hash = xxhash64(param.c_5, sizeof(param.c_5), hash);
+  return hash;
+}
+
+/**
+   @brief Hash the resident gauge configuration used by an operator.
+   It is only known if all its links were loaded from hashable host
+   fields.
+   @param[in] param The solver parameters
+   @return The hash, or 0 if it is not known
+ */
+static uint64_t residentGaugeHash(const QudaInvertParam &param)
+{
+  std::vector<QudaLinkType> links;
+  if (param.dslash_type == QUDA_ASQTAD_DSLASH)
+    links = {QUDA_ASQTAD_FAT_LINKS, QUDA_ASQTAD_LONG_LINKS};
+  else
+    links = {QUDA_WILSON_LINKS};
+
+  uint64_t gauge = 0;
+  for (auto type : links) {
+    auto it = gauge_hash.find(type);
+    if (it == gauge_hash.end()) return 0;
+    gauge = xxhash64(&it->second, sizeof(it->second), gauge);
+  }
+  return gauge;
+}
+
+/**
+   @brief Set the context of the spectral bounds record: the hash of
+   the operator parameters and of the resident gauge configuration.
+   The precision is excluded since it does not change the spectrum.
+   @param[in] param The solver parameters
+ */
+static void setSpectralContext(const QudaInvertParam &param)
+{
+  spectral::setContext(operatorHash(param), residentGaugeHash(param));
+}
+
+/**
+   @brief Compute the key of a multigrid hierarchy in the persisted
+   hierarchy cache from everything that determines the setup: the
+   resident gauge configuration and clover field, the operator and its
+   precisions, the setup parameters of each level, the local volume
+   and the process grid.  Parameters that only affect the solve, e.g.,
+   the smoothers and the coarse solvers, are excluded.
+   @param[in] mg_param The multigrid parameters
+   @param[in] param The solver parameters of the fine-grid operator
+   @param[in] X The local lattice dimensions
+   @return The key, or 0 if the gauge configuration or clover field
+   is not known
+ */
+static uint64_t hierarchyKey(const QudaMultigridParam &mg_param, const QudaInvertParam &param, const int *X)
+{
+  uint64_t gauge = residentGaugeHash(param);
+  if (!gauge) return 0;
+
+  uint64_t key = xxhash64(&gauge, sizeof(gauge), operatorHash(param));
+
+  // the clover field need not be computed from the gauge field, e.g., if it was loaded from the host
+  if (param.dslash_type == QUDA_CLOVER_WILSON_DSLASH || param.dslash_type == QUDA_TWISTED_CLOVER_DSLASH
+      || param.dslash_type == QUDA_CLOVER_HASENBUSCH_TWIST_DSLASH) {
+    if (!clover_hash) return 0;
+    key = xxhash64(&clover_hash, sizeof(clover_hash), key);
+    key = xxhash64(&param.clover_rho, sizeof(param.clover_rho), key);
+  }
+
+  struct {
+    int cuda_prec_sloppy;
+    int cuda_prec_precondition;
+    int n_level;
+    int setup_type;
+    int pre_orthonormalize;
+    int post_orthonormalize;
+    int compute_null_vector;
+    int generate_all_levels;
+    int is_staggered;
+    int x[QUDA_MAX_DIM];
+    int comm[QUDA_MAX_DIM];
+  } global;
+  memset(&global, 0, sizeof(global)); // zero the padding since it is hashed
+
+  global.cuda_prec_sloppy = param.cuda_prec_sloppy;
+  global.cuda_prec_precondition = param.cuda_prec_precondition;
+  global.n_level = mg_param.n_level;
+  global.setup_type = mg_param.setup_type;
+  global.pre_orthonormalize = mg_param.pre_orthonormalize;
+  global.post_orthonormalize = mg_param.post_orthonormalize;
+  global.compute_null_vector = mg_param.compute_null_vector;
+  global.generate_all_levels = mg_param.generate_all_levels;
+  global.is_staggered = mg_param.is_staggered;
+  for (int d = 0; d < 4; d++) {
+    global.x[d] = X[d];
+    global.comm[d] = comm_dim(d);
+  }
+  key = xxhash64(&global, sizeof(global), key);
+
+  for (int i = 0; i < mg_param.n_level; i++) {
+    struct {
+      int geo_block_size[QUDA_MAX_DIM];
+      int spin_block_size;
+      int n_vec;
+      int precision_null;
+      int n_block_ortho;
+      int setup_inv_type;
+      int num_setup_iter;
+      int setup_maxiter;
+      int setup_block_size;
+      int setup_ca_basis;
+      int setup_ca_basis_size;
+      int coarse_grid_solution_type;
+      int smoother_solve_type;
+      int location;
+      int setup_location;
+      int vec_load;
+      int use_eig_solver;
+      int eig_type;
+      int eig_spectrum;
+      int eig_n_ev;
+      int eig_n_kr;
+      int eig_n_conv;
+      int eig_use_poly_acc;
+      int eig_poly_deg;
+      double setup_tol;
+      double setup_ca_lambda_min;
+      double setup_ca_lambda_max;
+      double mu_factor;
+      double eig_tol;
+      double eig_a_min;
+      double eig_a_max;
+    } level;
+    memset(&level, 0, sizeof(level));
+
+    for (int d = 0; d < QUDA_MAX_DIM; d++) level.geo_block_size[d] = mg_param.geo_block_size[i][d];
+    level.spin_block_size = mg_param.spin_block_size[i];
+    level.n_vec = mg_param.n_vec[i];
+    level.precision_null = mg_param.precision_null[i];
+    level.n_block_ortho = mg_param.n_block_ortho[i];
+    level.setup_inv_type = mg_param.setup_inv_type[i];
+    level.num_setup_iter = mg_param.num_setup_iter[i];
+    level.setup_maxiter = mg_param.setup_maxiter[i];
+    level.setup_block_size = mg_param.setup_block_size[i];
+    level.setup_ca_basis = mg_param.setup_ca_basis[i];
+    level.setup_ca_basis_size = mg_param.setup_ca_basis_size[i];
+    level.coarse_grid_solution_type = mg_param.coarse_grid_solution_type[i];
+    level.smoother_solve_type = mg_param.smoother_solve_type[i];
+    level.location = mg_param.location[i];
+    level.setup_location = mg_param.setup_location[i];
+    level.vec_load = mg_param.vec_load[i];
+    level.use_eig_solver = mg_param.use_eig_solver[i];
+    if (mg_param.use_eig_solver[i] == QUDA_BOOLEAN_TRUE && mg_param.eig_param[i]) {
+      const QudaEigParam &eig = *mg_param.eig_param[i];
+      level.eig_type = eig.eig_type;
+      level.eig_spectrum = eig.spectrum;
+      level.eig_n_ev = eig.n_ev;
+      level.eig_n_kr = eig.n_kr;
+      level.eig_n_conv = eig.n_conv;
+      level.eig_use_poly_acc = eig.use_poly_acc;
+      level.eig_poly_deg = eig.poly_deg;
+      level.eig_tol = eig.tol;
+      level.eig_a_min = eig.a_min;
+      level.eig_a_max = eig.a_max;
+    }
+    level.setup_tol = mg_param.setup_tol[i];
+    level.setup_ca_lambda_min = mg_param.setup_ca_lambda_min[i];
+    level.setup_ca_lambda_max = mg_param.setup_ca_lambda_max[i];
+    level.mu_factor = mg_param.mu_factor[i];
+
+    key = xxhash64(&level, sizeof(level), key);
+    // loaded null-space vectors are only identified by their file name
+    if (mg_param.vec_load[i] == QUDA_BOOLEAN_TRUE)
+      key = xxhash64(mg_param.vec_infile[i], strlen(mg_param.vec_infile[i]), key);
+  }
+
+  // reserve 0 for an uncached hierarchy
+  return key ? key : 1;
+}
+
 quda::cudaGaugeField *checkGauge(QudaInvertParam *param)
 {
   quda::cudaGaugeField *cudaGauge = nullptr;
@@ -1985,20 +2857,6 @@ quda::cudaGaugeField *checkGauge(QudaInvertParam *param)
       errorQuda("Solve precision %d doesn't match gauge precision %d", param->cuda_prec, gaugePrecise->Precision());
     }
 
-    if (param->cuda_prec_sloppy != gaugeSloppy->Precision()
-        || param->cuda_prec_precondition != gaugePrecondition->Precision()
-        || param->cuda_prec_refinement_sloppy != gaugeRefinement->Precision()) {
-      QudaPrecision precision[3]
-          = {param->cuda_prec_sloppy, param->cuda_prec_precondition, param->cuda_prec_refinement_sloppy};
-      QudaReconstructType recon[3]
-          = {gaugeSloppy->Reconstruct(), gaugePrecondition->Reconstruct(), gaugeRefinement->Reconstruct()};
-      freeSloppyGaugeQuda();
-      loadSloppyGaugeQuda(precision, recon);
-    }
-
-    if (gaugeSloppy == nullptr) errorQuda("Sloppy gauge field doesn't exist");
-    if (gaugePrecondition == nullptr) errorQuda("Precondition gauge field doesn't exist");
-    if (gaugeRefinement == nullptr) errorQuda("Refinement gauge field doesn't exist");
     if (param->overlap) {
       if (gaugeExtended == nullptr) errorQuda("Extended gauge field doesn't exist");
     }
@@ -2011,45 +2869,28 @@ quda::cudaGaugeField *checkGauge(QudaInvertParam *param)
       errorQuda("Solve precision %d doesn't match gauge precision %d", param->cuda_prec, gaugeFatPrecise->Precision());
     }
 
-    if (param->cuda_prec_sloppy != gaugeFatSloppy->Precision()
-        || param->cuda_prec_precondition != gaugeFatPrecondition->Precision()
-        || param->cuda_prec_refinement_sloppy != gaugeFatRefinement->Precision()
-        || param->cuda_prec_sloppy != gaugeLongSloppy->Precision()
-        || param->cuda_prec_precondition != gaugeLongPrecondition->Precision()
-        || param->cuda_prec_refinement_sloppy != gaugeLongRefinement->Precision()) {
-
-      QudaPrecision precision[3]
-        = {param->cuda_prec_sloppy, param->cuda_prec_precondition, param->cuda_prec_refinement_sloppy};
-      // recon is always no for fat links, so just use long reconstructs here
-      QudaReconstructType recon[3]
-        = {gaugeLongSloppy->Reconstruct(), gaugeLongPrecondition->Reconstruct(), gaugeLongRefinement->Reconstruct()};
-      freeSloppyGaugeQuda();
-      loadSloppyGaugeQuda(precision, recon);
-    }
-
-    if (gaugeFatSloppy == nullptr) errorQuda("Sloppy gauge fat field doesn't exist");
-    if (gaugeFatPrecondition == nullptr) errorQuda("Precondition gauge fat field doesn't exist");
-    if (gaugeFatRefinement == nullptr) errorQuda("Refinement gauge fat field doesn't exist");
     if (param->overlap) {
       if (gaugeFatExtended == nullptr) errorQuda("Extended gauge fat field doesn't exist");
-    }
-
-    if (gaugeLongSloppy == nullptr) errorQuda("Sloppy gauge long field doesn't exist");
-    if (gaugeLongPrecondition == nullptr) errorQuda("Precondition gauge long field doesn't exist");
-    if (gaugeLongRefinement == nullptr) errorQuda("Refinement gauge long field doesn't exist");
-    if (param->overlap) {
       if (gaugeLongExtended == nullptr) errorQuda("Extended gauge long field doesn't exist");
     }
     cudaGauge = gaugeFatPrecise;
   }
 
+  // the sloppy, preconditioner and refinement mirrors are created at
+  // the requested precisions as the Dirac operators are created, so
+  // this is the point to free unneeded mirrors if over budget
+  evictGaugeMirrors(*param);
+
   checkClover(param);
 
+  setSpectralContext(*param);
+
   return cudaGauge;
 }
 
 void cloverQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity parity, int inverse)
 {
+  ContextScope scope(nullptr);
   pushVerbosity(inv_param->verbosity);
 
   if (!initialized) errorQuda("QUDA not initialized");
@@ -2119,6 +2960,7 @@ void cloverQuda(void *h_out, void *h_in, QudaInvertParam *inv_param, QudaParity
 
 void eigensolveQuda(void **host_evecs, double _Complex *host_evals, QudaEigParam *eig_param)
 {
+  ContextScope scope(nullptr);
   profileEigensolve.TPSTART(QUDA_PROFILE_TOTAL);
   profileEigensolve.TPSTART(QUDA_PROFILE_INIT);
 
@@ -2334,6 +3176,11 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &pr
 
   // fill out the MG parameters for the fine level
   mgParam = new MGParam(mg_param, B, m, mSmooth, mSmoothSloppy);
+  if (strcmp(mg_param.hierarchy_cache, "") != 0) {
+    mgParam->cache_key = hierarchyKey(mg_param, *param, cudaGauge->X());
+    if (!mgParam->cache_key)
+      warningQuda("Gauge configuration is not known, the multigrid hierarchy will not be cached");
+  }
 
   mg = new MG(*mgParam, profile);
   mgParam->updateInvertParam(*param);
@@ -2344,12 +3191,14 @@ multigrid_solver::multigrid_solver(QudaMultigridParam &mg_param, TimeProfile &pr
 }
 
 void* newMultigridQuda(QudaMultigridParam *mg_param) {
+  ContextScope scope(nullptr);
   profilerStart(__func__);
 
   pushVerbosity(mg_param->invert_param->verbosity);
 
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
   auto *mg = new multigrid_solver(*mg_param, profileInvert);
+  persistent_mirror_users++;
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
 
   saveTuneCache();
@@ -2361,11 +3210,15 @@ void* newMultigridQuda(QudaMultigridParam *mg_param) {
 }
 
 void destroyMultigridQuda(void *mg) {
+  ContextScope scope(nullptr);
+  static_cast<multigrid_solver *>(mg)->mg->reportProfile();
   delete static_cast<multigrid_solver*>(mg);
+  persistent_mirror_users--;
 }
 
 void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 {
+  ContextScope scope(nullptr);
   profilerStart(__func__);
 
   pushVerbosity(mg_param->invert_param->verbosity);
@@ -2390,6 +3243,9 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
     // FIXME: add support for updating kappa, mu as appropriate
 
     // FIXME: assumes gauge parameters haven't changed.
+    createGaugeMirrors(*param, GAUGE_MIRROR_SLOPPY, param->cuda_prec_sloppy);
+    if (!param->overlap) createGaugeMirrors(*param, GAUGE_MIRROR_PRECONDITION, param->cuda_prec_precondition);
+
     // These routines will set gauge = gaugeFat for DiracImprovedStaggered
     mg->d->updateFields(gaugeSloppy, gaugeFatSloppy, gaugeLongSloppy, cloverSloppy);
     mg->d->setMass(param->mass);
@@ -2471,6 +3327,7 @@ void updateMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 
 void dumpMultigridQuda(void *mg_, QudaMultigridParam *mg_param)
 {
+  ContextScope scope(nullptr);
   profilerStart(__func__);
   pushVerbosity(mg_param->invert_param->verbosity);
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
@@ -2553,11 +3410,13 @@ deflated_solver::deflated_solver(QudaEigParam &eig_param, TimeProfile &profile)
 }
 
 void* newDeflationQuda(QudaEigParam *eig_param) {
+  ContextScope scope(nullptr);
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
 #ifdef MAGMA_LIB
   openMagma();
 #endif
   auto *defl = new deflated_solver(*eig_param, profileInvert);
+  persistent_mirror_users++;
 
   profileInvert.TPSTOP(QUDA_PROFILE_TOTAL);
 
@@ -2567,13 +3426,121 @@ void* newDeflationQuda(QudaEigParam *eig_param) {
 }
 
 void destroyDeflationQuda(void *df) {
+  ContextScope scope(nullptr);
 #ifdef MAGMA_LIB
   closeMagma();
 #endif
   delete static_cast<deflated_solver*>(df);
+  persistent_mirror_users--;
 }
 
-void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
+/**
+   @brief Return a key identifying the operator used for chronological
+   forecasting: this changes if the resident fields, or the parameters
+   that define the operator, change
+   @param[in] param The solver parameters
+   @param[in] direct Whether the operator is M, else M^dag M
+ */
+static uint64_t chronoKey(const QudaInvertParam &param, bool direct)
+{
+  struct {
+    uint64_t generation;
+    int direct;
+    int dslash_type;
+    int matpc_type;
+    int solve_type;
+    int dagger;
+    int twist_flavor;
+    int cuda_prec;
+    int cuda_prec_sloppy;
+    int chrono_precision;
+    int Ls;
+    int eofa_pm;
+    int laplace3D;
+    double kappa;
+    double mass;
+    double mu;
+    double epsilon;
+    double m5;
+    double clover_coeff;
+    double eofa_shift;
+    double mq1;
+    double mq2;
+    double mq3;
+  } op;
+  memset(&op, 0, sizeof(op)); // zero the padding since it is hashed
+
+  op.generation = resident_generation;
+  op.direct = direct;
+  op.dslash_type = param.dslash_type;
+  op.matpc_type = param.matpc_type;
+  op.solve_type = param.solve_type;
+  op.dagger = param.dagger;
+  op.twist_flavor = param.twist_flavor;
+  op.cuda_prec = param.cuda_prec;
+  op.cuda_prec_sloppy = param.cuda_prec_sloppy;
+  op.chrono_precision = param.chrono_precision;
+  op.Ls = param.Ls;
+  op.eofa_pm = param.eofa_pm;
+  op.laplace3D = param.laplace3D;
+  op.kappa = param.kappa;
+  op.mass = param.mass;
+  op.mu = param.mu;
+  op.epsilon = param.epsilon;
+  op.m5 = param.m5;
+  op.clover_coeff = param.clover_coeff;
+  op.eofa_shift = param.eofa_shift;
+  op.mq1 = param.mq1;
+  op.mq2 = param.mq2;
+  op.mq3 = param.mq3;
+
+  uint64_t key = xxhash64(&op, sizeof(op));
+  key = xxhash64(param.b_5, sizeof(param.b_5), key);
+  return xxhash64(param.c_5, sizeof(param.c_5), key);
+}
+
+/**
+   @brief Forecast the initial guess of a solve from the chronological
+   basis param.chrono_index, applying the operator at the chrono
+   precision
+ */
+static void chronoForecast(ColorSpinorField &out, ColorSpinorField &in, const QudaInvertParam &param,
+                           const DiracMatrix &m, const DiracMatrix &mSloppy, bool hermitian, bool direct)
+{
+  profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
+
+  const DiracMatrix *mChrono = nullptr;
+  if (param.chrono_precision == param.cuda_prec) {
+    mChrono = &m;
+  } else if (param.chrono_precision == param.cuda_prec_sloppy) {
+    mChrono = &mSloppy;
+  } else {
+    errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
+              param.chrono_precision, param.cuda_prec, param.cuda_prec_sloppy);
+  }
+
+  ColorSpinorParam cs_param(in);
+  cs_param.create = QUDA_NULL_FIELD_CREATE;
+  cs_param.setPrecision(param.chrono_precision);
+  ColorSpinorField *tmp = ColorSpinorField::Create(cs_param);
+  blas::copy(*tmp, in);
+
+  chronoResident[param.chrono_index].forecast(out, *tmp, *mChrono, hermitian, chronoKey(param, direct), profileInvert);
+
+  delete tmp;
+
+  profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
+}
+
+/**
+   @brief Solve, with the host side of the transfers either done
+   synchronously here (async == nullptr), or by the host worker for a
+   request submitted with invertAsyncQuda: the source and guess are
+   then uploaded from the staging buffers, and the solution is
+   downloaded to the staging buffer with its reorder queued on the
+   host worker.
+ */
+static void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param, AsyncInvert *async)
 {
   profilerStart(__func__);
 
@@ -2634,16 +3601,24 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 
   // wrap CPU host side pointers
   ColorSpinorParam cpuParam(hp_b, *param, X, pc_solution, param->input_location);
-  ColorSpinorField *h_b = ColorSpinorField::Create(cpuParam);
+  ColorSpinorField *h_b = async ? async->h_b : ColorSpinorField::Create(cpuParam);
 
   cpuParam.v = hp_x;
   cpuParam.location = param->output_location;
-  ColorSpinorField *h_x = ColorSpinorField::Create(cpuParam);
+  ColorSpinorField *h_x = async ? async->h_x : ColorSpinorField::Create(cpuParam);
 
   // download source
   ColorSpinorParam cudaParam(cpuParam, *param);
-  cudaParam.create = QUDA_COPY_FIELD_CREATE;
-  b = new cudaColorSpinorField(*h_b, cudaParam);
+  if (async) {
+    // the source has been reordered into the staging buffer by the host worker
+    host_worker::wait(async->stage_in);
+    b = async->b;
+    qudaMemcpy(b->V(), async->staging, b->Bytes(), cudaMemcpyHostToDevice);
+    qudaMemcpy(b->Norm(), static_cast<char *>(async->staging) + b->Bytes(), b->NormBytes(), cudaMemcpyHostToDevice);
+  } else {
+    cudaParam.create = QUDA_COPY_FIELD_CREATE;
+    b = new cudaColorSpinorField(*h_b, cudaParam);
+  }
 
   // now check if we need to invalidate the solutionResident vectors
   bool invalidate = false;
@@ -2673,7 +3648,12 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
       errorQuda("Initial guess not supported for two-pass solver");
     }
 
-    *x = *h_x; // solution
+    if (async) {
+      qudaMemcpy(x->V(), async->guess, x->Bytes(), cudaMemcpyHostToDevice);
+      qudaMemcpy(x->Norm(), static_cast<char *>(async->guess) + x->Bytes(), x->NormBytes(), cudaMemcpyHostToDevice);
+    } else {
+      *x = *h_x; // solution
+    }
   } else { // zero initial guess
     blas::zero(*x);
   }
@@ -2693,7 +3673,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   double nb = blas::norm2(*b);
   if (nb==0.0) errorQuda("Source has zero norm");
 
-  if (getVerbosity() >= QUDA_VERBOSE) {
+  // the host fields of an asynchronous solve are owned by the host worker
+  if (getVerbosity() >= QUDA_VERBOSE && !async) {
     double nh_b = blas::norm2(*h_b);
     printfQuda("Source: CPU = %g, CUDA copy = %g\n", nh_b, nb);
     if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES) {
@@ -2785,44 +3766,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     DiracM m(dirac), mSloppy(diracSloppy), mPre(diracPre);
     SolverParam solverParam(*param);
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
-      profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
-
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(*basis[0]);
-      ColorSpinorField *tmp = ColorSpinorField::Create(cs_param);
-      ColorSpinorField *tmp2 = (param->chrono_precision == out->Precision()) ? out : ColorSpinorField::Create(cs_param);
-      std::vector<ColorSpinorField*> Ap;
-      for (unsigned int k=0; k < basis.size(); k++) {
-        Ap.emplace_back((ColorSpinorField::Create(cs_param)));
-      }
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j=0; j<basis.size(); j++) m(*Ap[j], *basis[j], *tmp, *tmp2);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j=0; j<basis.size(); j++) mSloppy(*Ap[j], *basis[j], *tmp, *tmp2);
-      } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
-      }
-
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = false;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian, profileInvert);
-
-      blas::copy(*tmp, *in);
-      mre(*out, *tmp, basis, Ap);
-
-      for (auto ap: Ap) {
-        if (ap) delete (ap);
-      }
-      delete tmp;
-      if (tmp2 != out) delete tmp2;
-
-      profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
-    }
+    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0)
+      chronoForecast(*out, *in, *param, m, mSloppy, false, true);
 
     Solver *solve = Solver::create(solverParam, m, mSloppy, mPre, profileInvert);
     (*solve)(*out, *in);
@@ -2833,44 +3778,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     SolverParam solverParam(*param);
 
     // chronological forecasting
-    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0) {
-      profileInvert.TPSTART(QUDA_PROFILE_CHRONO);
-
-      auto &basis = chronoResident[param->chrono_index];
-
-      ColorSpinorParam cs_param(*basis[0]);
-      std::vector<ColorSpinorField*> Ap;
-      ColorSpinorField *tmp = ColorSpinorField::Create(cs_param);
-      ColorSpinorField *tmp2 = (param->chrono_precision == out->Precision()) ? out : ColorSpinorField::Create(cs_param);
-      for (unsigned int k=0; k < basis.size(); k++) {
-        Ap.emplace_back((ColorSpinorField::Create(cs_param)));
-      }
-
-      if (param->chrono_precision == param->cuda_prec) {
-        for (unsigned int j=0; j<basis.size(); j++) m(*Ap[j], *basis[j], *tmp, *tmp2);
-      } else if (param->chrono_precision == param->cuda_prec_sloppy) {
-        for (unsigned int j=0; j<basis.size(); j++) mSloppy(*Ap[j], *basis[j], *tmp, *tmp2);
-      } else {
-        errorQuda("Unexpected precision %d for chrono vectors (doesn't match outer %d or sloppy precision %d)",
-                  param->chrono_precision, param->cuda_prec, param->cuda_prec_sloppy);
-      }
-
-      bool orthogonal = true;
-      bool apply_mat = false;
-      bool hermitian = true;
-      MinResExt mre(m, orthogonal, apply_mat, hermitian, profileInvert);
-
-      blas::copy(*tmp, *in);
-      mre(*out, *tmp, basis, Ap);
-
-      for (auto ap: Ap) {
-        if (ap) delete(ap);
-      }
-      delete tmp;
-      if (tmp2 != out) delete tmp2;
-
-      profileInvert.TPSTOP(QUDA_PROFILE_CHRONO);
-    }
+    if (param->chrono_use_resident && chronoResident[param->chrono_index].size() > 0)
+      chronoForecast(*out, *in, *param, m, mSloppy, true, false);
 
     // if using a Schwarz preconditioner with a normal operator then we must use the DiracMdagMLocal operator
     if (param->inv_type_precondition != QUDA_INVALID_INVERTER && param->schwarz_type != QUDA_INVALID_SCHWARZ) {
@@ -2917,20 +3826,8 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
       errorQuda("Requested chrono_max_dim %i is smaller than already existing chroology %i",param->chrono_max_dim,(int)basis.size());
     }
 
-    if(not param->chrono_replace_last){
-      // if we have not filled the space yet just augment
-      if ((int)basis.size() < param->chrono_max_dim) {
-        ColorSpinorParam cs_param(*out);
-        cs_param.setPrecision(param->chrono_precision);
-        basis.emplace_back(ColorSpinorField::Create(cs_param));
-      }
-
-      // shuffle every entry down one and bring the last to the front
-      ColorSpinorField *tmp = basis[basis.size()-1];
-      for (unsigned int j=basis.size()-1; j>0; j--) basis[j] = basis[j-1];
-        basis[0] = tmp;
-    }
-    *(basis[0]) = *out; // set first entry to new solution
+    // the image of the new vector is computed at the next forecast
+    basis.push(*out, param->chrono_max_dim, param->chrono_replace_last, param->chrono_precision);
   }
   dirac.reconstruct(*x, *b, param->solution_type);
 
@@ -2942,7 +3839,21 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 
   if (!param->make_resident_solution) {
     profileInvert.TPSTART(QUDA_PROFILE_D2H);
-    *h_x = *x;
+    if (async) {
+      // download in native order and leave the reorder to the host
+      // worker: a copy at the CPU location is a plain host loop that
+      // never reaches the autotuner
+      void *staging = async->staging;
+      qudaMemcpy(staging, x->V(), x->Bytes(), cudaMemcpyDeviceToHost);
+      qudaMemcpy(static_cast<char *>(staging) + x->Bytes(), x->Norm(), x->NormBytes(), cudaMemcpyDeviceToHost);
+      ColorSpinorField *meta = b;
+      async->stage_out = host_worker::submit([h_x, meta, staging] {
+        copyGenericColorSpinor(*h_x, *meta, QUDA_CPU_FIELD_LOCATION, 0, staging, 0,
+                               static_cast<char *>(staging) + meta->Bytes());
+      });
+    } else {
+      *h_x = *x;
+    }
     profileInvert.TPSTOP(QUDA_PROFILE_D2H);
   }
 
@@ -2954,7 +3865,7 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
     param->action[1] = action.imag();
   }
 
-  if (getVerbosity() >= QUDA_VERBOSE){
+  if (getVerbosity() >= QUDA_VERBOSE && !async) {
     double nx = blas::norm2(*x);
     double nh_x = blas::norm2(*h_x);
     printfQuda("Reconstructed: CUDA solution = %g, CPU copy = %g\n", nx, nh_x);
@@ -2963,9 +3874,11 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
 
   profileInvert.TPSTART(QUDA_PROFILE_FREE);
 
-  delete h_b;
-  delete h_x;
-  delete b;
+  if (!async) {
+    delete h_b;
+    delete h_x;
+    delete b;
+  }
 
   if (param->use_resident_solution && !param->make_resident_solution) {
     for (auto v: solutionResident) if (v) delete v;
@@ -2990,6 +3903,126 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
   profilerStop(__func__);
 }
 
+void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
+{
+  ContextScope scope(nullptr);
+  waitQuda(-1); // keep solves in submission order
+  invertQuda(hp_x, hp_b, param, nullptr);
+}
+
+/**
+   @brief Solve the outstanding asynchronous requests that have not
+   yet been solved, in submission order.  The reorder of each solution
+   is queued on the host worker, so it overlaps with the next solve.
+   @param[in] last Handle of the last request to solve
+ */
+static void solveAsyncInverts(int last)
+{
+  for (auto &it : async_inverts) {
+    AsyncInvert &request = it.second;
+    if (it.first > last) break;
+    if (request.solved) continue;
+    invertQuda(request.hp_x, request.hp_b, request.param, &request);
+    request.solved = true;
+  }
+}
+
+int invertAsyncQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
+{
+  ContextScope scope(nullptr);
+  if (!initialized) errorQuda("QUDA not initialized");
+
+  pushVerbosity(param->verbosity);
+  checkInvertParam(param, hp_x, hp_b);
+
+  const int handle = async_handle++;
+  AsyncInvert &request = async_inverts[handle];
+  request.param = param;
+  request.hp_x = hp_x;
+  request.hp_b = hp_b;
+  request.h_x = nullptr;
+  request.h_b = nullptr;
+  request.b = nullptr;
+  request.staging = nullptr;
+  request.guess = nullptr;
+  request.stage_in = -1;
+  request.stage_out = -1;
+  request.solved = false;
+
+  if (param->input_location == QUDA_CUDA_FIELD_LOCATION || param->output_location == QUDA_CUDA_FIELD_LOCATION) {
+    // there is no host reordering to overlap, so solve now
+    request.solved = true;
+    solveAsyncInverts(handle);
+    invertQuda(hp_x, hp_b, param, nullptr);
+    popVerbosity();
+    return handle;
+  }
+
+  const int *X = checkGauge(param)->X();
+  bool pc_solution
+    = (param->solution_type == QUDA_MATPC_SOLUTION) || (param->solution_type == QUDA_MATPCDAG_MATPC_SOLUTION);
+
+  // wrap the host pointers and create the device source, whose
+  // layout the staging buffers follow
+  ColorSpinorParam cpuParam(hp_b, *param, X, pc_solution, param->input_location);
+  request.h_b = ColorSpinorField::Create(cpuParam);
+  cpuParam.v = hp_x;
+  cpuParam.location = param->output_location;
+  request.h_x = ColorSpinorField::Create(cpuParam);
+
+  ColorSpinorParam cudaParam(cpuParam, *param);
+  cudaParam.create = QUDA_NULL_FIELD_CREATE;
+  request.b = new cudaColorSpinorField(cudaParam);
+
+  const size_t bytes = request.b->Bytes() + request.b->NormBytes();
+  request.staging = pool_pinned_malloc(bytes);
+  if (param->use_init_guess == QUDA_USE_INIT_GUESS_YES) request.guess = pool_pinned_malloc(bytes);
+
+  ColorSpinorField *h_b = request.h_b, *h_x = request.h_x, *meta = request.b;
+  void *staging = request.staging, *guess = request.guess;
+  // the reorder is done by a plain host loop (CPU location), so the
+  // worker never touches the autotuner or the device
+  request.stage_in = host_worker::submit([h_b, h_x, meta, staging, guess, bytes] {
+    memset(staging, 0, bytes); // zero the padding
+    copyGenericColorSpinor(*meta, *h_b, QUDA_CPU_FIELD_LOCATION, staging, 0,
+                           static_cast<char *>(staging) + meta->Bytes(), 0);
+    if (guess) {
+      memset(guess, 0, bytes);
+      copyGenericColorSpinor(*meta, *h_x, QUDA_CPU_FIELD_LOCATION, guess, 0, static_cast<char *>(guess) + meta->Bytes(), 0);
+    }
+  });
+
+  // solve the earlier requests while this one is staged
+  solveAsyncInverts(handle - 1);
+
+  if (getVerbosity() >= QUDA_DEBUG_VERBOSE) printfQuda("Submitted asynchronous solve %d\n", handle);
+  popVerbosity();
+  return handle;
+}
+
+void waitQuda(int handle)
+{
+  ContextScope scope(nullptr);
+  if (handle < 0) {
+    while (!async_inverts.empty()) waitQuda(async_inverts.begin()->first);
+    return;
+  }
+
+  auto it = async_inverts.find(handle);
+  if (it == async_inverts.end()) return; // already completed
+  AsyncInvert &request = it->second;
+
+  solveAsyncInverts(handle);
+  if (request.stage_in >= 0) host_worker::wait(std::max(request.stage_in, request.stage_out));
+
+  if (request.staging) pool_pinned_free(request.staging);
+  if (request.guess) pool_pinned_free(request.guess);
+  delete request.h_b;
+  delete request.h_x;
+  delete request.b;
+  async_inverts.erase(it);
+}
+
 
 /*!
  * Generic version of the multi-shift solver. Should work for
@@ -3001,6 +4034,7 @@ void invertQuda(void *hp_x, void *hp_b, QudaInvertParam *param)
  */
 void invertMultiSrcQuda(void **_hp_x, void **_hp_b, QudaInvertParam *param)
 {
+  ContextScope scope(nullptr);
   // currently that code is just a copy of invertQuda and cannot work
   profileInvert.TPSTART(QUDA_PROFILE_TOTAL);
 
@@ -3346,6 +4380,7 @@ for(int i=0; i < param->num_src; i++) {
  */
 void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
 {
+  ContextScope scope(nullptr);
   profilerStart(__func__);
 
   profileMulti.TPSTART(QUDA_PROFILE_TOTAL);
@@ -3743,6 +4778,7 @@ void invertMultiShiftQuda(void **_hp_x, void *_hp_b, QudaInvertParam *param)
 }
 
 void computeKSLinkQuda(void* fatlink, void* longlink, void* ulink, void* inlink, double *path_coeff, QudaGaugeParam *param) {
+  ContextScope scope(nullptr);
 
 #ifdef GPU_FATLINK
   profileFatLink.TPSTART(QUDA_PROFILE_TOTAL);
@@ -3844,6 +4880,7 @@ int getGaugePadding(GaugeFieldParam& param){
 int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int* path_length,
 			  double* loop_coeff, int num_paths, int max_length, double eb3, QudaGaugeParam* qudaGaugeParam)
 {
+  ContextScope scope(nullptr);
 #ifdef GPU_GAUGE_FORCE
   profileGaugeForce.TPSTART(QUDA_PROFILE_TOTAL);
   profileGaugeForce.TPSTART(QUDA_PROFILE_INIT);
@@ -3935,6 +4972,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
   if (qudaGaugeParam->make_resident_gauge) {
     if (gaugePrecise && gaugePrecise != cudaSiteLink) delete gaugePrecise;
     gaugePrecise = cudaSiteLink;
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     delete cudaSiteLink;
   }
@@ -3968,6 +5006,7 @@ int computeGaugeForceQuda(void* mom, void* siteLink,  int*** input_path_buf, int
 
 void momResidentQuda(void *mom, QudaGaugeParam *param)
 {
+  ContextScope scope(nullptr);
   profileGaugeForce.TPSTART(QUDA_PROFILE_TOTAL);
   profileGaugeForce.TPSTART(QUDA_PROFILE_INIT);
 
@@ -4025,6 +5064,7 @@ void momResidentQuda(void *mom, QudaGaugeParam *param)
 
 void createCloverQuda(QudaInvertParam* invertParam)
 {
+  ContextScope scope(nullptr);
   profileClover.TPSTART(QUDA_PROFILE_TOTAL);
   if (!cloverPrecise) errorQuda("Clover field not allocated");
 
@@ -4046,6 +5086,9 @@ void createCloverQuda(QudaInvertParam* invertParam)
   computeFmunu(Fmunu, *gauge);
   computeClover(*cloverPrecise, Fmunu, invertParam->clover_coeff);
   profileClover.TPSTOP(QUDA_PROFILE_COMPUTE);
+  // the clover field is now determined by the resident gauge field and the operator parameters
+  auto hashed = gauge_hash.find(QUDA_WILSON_LINKS);
+  clover_hash = hashed != gauge_hash.end() ? xxhash64(&hashed->second, sizeof(hashed->second)) : 0;
   profileClover.TPSTOP(QUDA_PROFILE_TOTAL);
 
   // FIXME always preserve the extended gauge
@@ -4054,6 +5097,7 @@ void createCloverQuda(QudaInvertParam* invertParam)
 
 void* createGaugeFieldQuda(void* gauge, int geometry, QudaGaugeParam* param)
 {
+  ContextScope scope(nullptr);
   GaugeFieldParam gParam(gauge, *param, QUDA_GENERAL_LINKS);
   gParam.geometry = static_cast<QudaFieldGeometry>(geometry);
   if (geometry != QUDA_SCALAR_GEOMETRY && geometry != QUDA_VECTOR_GEOMETRY)
@@ -4076,6 +5120,7 @@ void* createGaugeFieldQuda(void* gauge, int geometry, QudaGaugeParam* param)
 
 
 void saveGaugeFieldQuda(void* gauge, void* inGauge, QudaGaugeParam* param){
+  ContextScope scope(nullptr);
 
   auto* cudaGauge = reinterpret_cast<cudaGaugeField*>(inGauge);
 
@@ -4089,6 +5134,7 @@ void saveGaugeFieldQuda(void* gauge, void* inGauge, QudaGaugeParam* param){
 
 
 void destroyGaugeFieldQuda(void* gauge){
+  ContextScope scope(nullptr);
   auto* g = reinterpret_cast<cudaGaugeField*>(gauge);
   delete g;
 }
@@ -4097,6 +5143,7 @@ void destroyGaugeFieldQuda(void* gauge){
 void computeStaggeredForceQuda(void* h_mom, double dt, double delta, void *h_force, void **x,
 			       QudaGaugeParam *gauge_param, QudaInvertParam *inv_param)
 {
+  ContextScope scope(nullptr);
   profileStaggeredForce.TPSTART(QUDA_PROFILE_TOTAL);
   profileStaggeredForce.TPSTART(QUDA_PROFILE_INIT);
 
@@ -4269,6 +5316,7 @@ void computeHISQForceQuda(void* const milc_momentum,
                           double **coeff,
                           QudaGaugeParam* gParam)
 {
+  ContextScope scope(nullptr);
 #ifdef  GPU_STAGGERED_OPROD
   using namespace quda;
   using namespace quda::fermion_force;
@@ -4511,6 +5559,7 @@ void computeCloverForceQuda(void *h_mom, double dt, void **h_x, void **h_p,
 			    double *coeff, double kappa2, double ck,
 			    int nvector, double multiplicity, void *gauge,
 			    QudaGaugeParam *gauge_param, QudaInvertParam *inv_param) {
+  ContextScope scope(nullptr);
 
   using namespace quda;
   profileCloverForce.TPSTART(QUDA_PROFILE_TOTAL);
@@ -4699,6 +5748,7 @@ void updateGaugeFieldQuda(void* gauge,
 			  int exact,
 			  QudaGaugeParam* param)
 {
+  ContextScope scope(nullptr);
   profileGaugeUpdate.TPSTART(QUDA_PROFILE_TOTAL);
 
   checkGaugeParam(param);
@@ -4744,6 +5794,7 @@ void updateGaugeFieldQuda(void* gauge,
     if (!gaugePrecise) errorQuda("No resident gauge field allocated");
     cudaInGauge = gaugePrecise;
     gaugePrecise = nullptr;
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   }
 
   if (!param->use_resident_mom) {
@@ -4773,6 +5824,7 @@ void updateGaugeFieldQuda(void* gauge,
   if (param->make_resident_gauge) {
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaOutGauge;
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     delete cudaOutGauge;
   }
@@ -4843,6 +5895,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     invalidateGaugeHash(QUDA_WILSON_LINKS);
    } else {
      delete cudaGauge;
    }
@@ -4897,6 +5950,7 @@ void updateGaugeFieldQuda(void* gauge,
    if (param->make_resident_gauge) {
      if (gaugePrecise != nullptr && cudaGauge != gaugePrecise) delete gaugePrecise;
      gaugePrecise = cudaGauge;
+     invalidateGaugeHash(QUDA_WILSON_LINKS);
    } else {
      delete cudaGauge;
    }
@@ -4911,6 +5965,7 @@ void updateGaugeFieldQuda(void* gauge,
 // evaluate the momentum action
 double momActionQuda(void* momentum, QudaGaugeParam* param)
 {
+  ContextScope scope(nullptr);
   profileMomAction.TPSTART(QUDA_PROFILE_TOTAL);
 
   profileMomAction.TPSTART(QUDA_PROFILE_INIT);
@@ -5156,9 +6211,11 @@ void compute_staggered_force_quda_(void* h_mom, double *dt, double *delta, void
 
 // apply the staggered phases
 void apply_staggered_phase_quda_() {
+  ContextScope scope(nullptr);
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("applying staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->applyStaggeredPhase();
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5166,9 +6223,11 @@ void apply_staggered_phase_quda_() {
 
 // remove the staggered phases
 void remove_staggered_phase_quda_() {
+  ContextScope scope(nullptr);
   if (getVerbosity() >= QUDA_VERBOSE) printfQuda("removing staggered phase\n");
   if (gaugePrecise) {
     gaugePrecise->removeStaggeredPhase();
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     errorQuda("No persistent gauge field");
   }
@@ -5215,6 +6274,7 @@ void set_kernel_pack_t_(int* pack)
 
 void gaussGaugeQuda(unsigned long long seed, double sigma)
 {
+  ContextScope scope(nullptr);
   profileGauss.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!gaugePrecise) errorQuda("Cannot generate Gauss GaugeField as there is no resident gauge field");
@@ -5248,6 +6308,7 @@ void plaq_quda_(double plaq[3]) {
 
 void plaqQuda(double plaq[3])
 {
+  ContextScope scope(nullptr);
   profilePlaq.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!gaugePrecise) errorQuda("Cannot compute plaquette as there is no resident gauge field");
@@ -5270,6 +6331,7 @@ void plaqQuda(double plaq[3])
  */
 void copyExtendedResidentGaugeQuda(void* resident_gauge, QudaFieldLocation loc)
 {
+  ContextScope scope(nullptr);
   //profilePlaq.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (!gaugePrecise) errorQuda("Cannot perform deep copy of resident gauge field as there is no resident gauge field");
@@ -5286,6 +6348,7 @@ void copyExtendedResidentGaugeQuda(void* resident_gauge, QudaFieldLocation loc)
 
 void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param, unsigned int n_steps, double alpha)
 {
+  ContextScope scope(nullptr);
   profileWuppertal.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
@@ -5361,12 +6424,14 @@ void performWuppertalnStep(void *h_out, void *h_in, QudaInvertParam *inv_param,
 
 void performAPEnStep(unsigned int n_steps, double alpha, int meas_interval)
 {
+  ContextScope scope(nullptr);
   profileAPE.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
 
   if (gaugeSmeared != nullptr) delete gaugeSmeared;
   gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileAPE);
+  invalidateGaugeHash(QUDA_SMEARED_LINKS);
 
   GaugeFieldParam gParam(*gaugeSmeared);
   auto *cudaGaugeTemp = new cudaGaugeField(gParam);
@@ -5395,12 +6460,14 @@ void performAPEnStep(unsigned int n_steps, double alpha, int meas_interval)
 
 void performSTOUTnStep(unsigned int n_steps, double rho, int meas_interval)
 {
+  ContextScope scope(nullptr);
   profileSTOUT.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
 
   if (gaugeSmeared != nullptr) delete gaugeSmeared;
   gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileSTOUT);
+  invalidateGaugeHash(QUDA_SMEARED_LINKS);
 
   GaugeFieldParam gParam(*gaugeSmeared);
   auto *cudaGaugeTemp = new cudaGaugeField(gParam);
@@ -5429,12 +6496,14 @@ void performSTOUTnStep(unsigned int n_steps, double rho, int meas_interval)
 
 void performOvrImpSTOUTnStep(unsigned int n_steps, double rho, double epsilon, int meas_interval)
 {
+  ContextScope scope(nullptr);
   profileOvrImpSTOUT.TPSTART(QUDA_PROFILE_TOTAL);
 
   if (gaugePrecise == nullptr) errorQuda("Gauge field must be loaded");
 
   if (gaugeSmeared != nullptr) delete gaugeSmeared;
   gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileOvrImpSTOUT);
+  invalidateGaugeHash(QUDA_SMEARED_LINKS);
 
   GaugeFieldParam gParam(*gaugeSmeared);
   auto *cudaGaugeTemp = new cudaGaugeField(gParam);
@@ -5463,6 +6532,7 @@ void performOvrImpSTOUTnStep(unsigned int n_steps, double rho, double epsilon, i
 
 void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval, QudaWFlowType wflow_type)
 {
+  ContextScope scope(nullptr);
   pushOutputPrefix("performWFlownStep: ");
   profileWFlow.TPSTART(QUDA_PROFILE_TOTAL);
 
@@ -5470,6 +6540,7 @@ void performWFlownStep(unsigned int n_steps, double step_size, int meas_interval
 
   if (gaugeSmeared != nullptr) delete gaugeSmeared;
   gaugeSmeared = createExtendedGauge(*gaugePrecise, R, profileWFlow);
+  invalidateGaugeHash(QUDA_SMEARED_LINKS);
 
   GaugeFieldParam gParamEx(*gaugeSmeared);
   auto *gaugeAux = GaugeField::Create(gParamEx);
@@ -5519,6 +6590,7 @@ int computeGaugeFixingOVRQuda(void *gauge, const unsigned int gauge_dir, const u
                               const unsigned int reunit_interval, const unsigned int stopWtheta, QudaGaugeParam *param,
                               double *timeinfo)
 {
+  ContextScope scope(nullptr);
   GaugeFixOVRQuda.TPSTART(QUDA_PROFILE_TOTAL);
 
   checkGaugeParam(param);
@@ -5577,8 +6649,11 @@ int computeGaugeFixingOVRQuda(void *gauge, const unsigned int gauge_dir, const u
   GaugeFixOVRQuda.TPSTOP(QUDA_PROFILE_TOTAL);
 
   if (param->make_resident_gauge) {
+    // the mirrors of the old field are stale, and may share its storage
+    freeGaugeMirrors(QUDA_WILSON_LINKS);
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaInGauge;
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     delete cudaInGauge;
   }
@@ -5597,6 +6672,7 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   const unsigned int verbose_interval, const double alpha, const unsigned int autotune, const double tolerance, \
   const unsigned int  stopWtheta, QudaGaugeParam* param , double* timeinfo)
 {
+  ContextScope scope(nullptr);
   GaugeFixFFTQuda.TPSTART(QUDA_PROFILE_TOTAL);
 
   checkGaugeParam(param);
@@ -5647,8 +6723,11 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
   GaugeFixFFTQuda.TPSTOP(QUDA_PROFILE_TOTAL);
 
   if (param->make_resident_gauge) {
+    // the mirrors of the old field are stale, and may share its storage
+    freeGaugeMirrors(QUDA_WILSON_LINKS);
     if (gaugePrecise != nullptr) delete gaugePrecise;
     gaugePrecise = cudaInGauge;
+    invalidateGaugeHash(QUDA_WILSON_LINKS);
   } else {
     delete cudaInGauge;
   }
@@ -5666,6 +6745,7 @@ int computeGaugeFixingFFTQuda(void* gauge, const unsigned int gauge_dir,  const
 void contractQuda(const void *hp_x, const void *hp_y, void *h_result, const QudaContractType cType,
                   QudaInvertParam *param, const int *X)
 {
+  ContextScope scope(nullptr);
   // DMH: Easiest way to construct ColorSpinorField? Do we require the user
   //     to declare and fill and invert_param, or can it just be hacked?.
 
@@ -5721,6 +6801,7 @@ void contractQuda(const void *hp_x, const void *hp_y, void *h_result, const Quda
 
 void gaugeObservablesQuda(QudaGaugeObservableParam *param)
 {
+  ContextScope scope(nullptr);
   profileGaugeObs.TPSTART(QUDA_PROFILE_TOTAL);
   checkGaugeObservableParam(param);
 
@@ -275,6 +275,7 @@ namespace quda {
 	maxrx = rNorm;
 	//r0Norm = rNorm;      
 	rUpdate++;
+	ReportEvent("BiCGstab", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, k, r2, b2, heavy_quark_res, param.precision);
       }
     
       k++;
@@ -1,5 +1,6 @@
 #include <invert_quda.h>
 #include <blas_quda.h>
+#include <spectral_bounds.h>
 #include <Eigen/Dense>
 
 /**
@@ -542,6 +543,19 @@ namespace quda {
     auto &lambda_min = param.ca_lambda_min;
     auto &lambda_max = param.ca_lambda_max;
 
+    // Use the recorded spectral bounds of the operator if there are any
+    const spectral::Key spectral_key = spectral::key(matSloppy, r_);
+    if (basis == QUDA_CHEBYSHEV_BASIS && lambda_max < lambda_min && !lambda_init) {
+      spectral::Bounds bounds;
+      if (spectral::lookup(spectral_key, bounds) && bounds.has_max) {
+        lambda_max = 1.1 * bounds.lambda_max;
+        if (getVerbosity() >= QUDA_SUMMARIZE)
+          printfQuda("CA-CG lambda max from %s bounds = 1.1 x %e\n", bounds.exact ? "recorded" : "earlier configuration",
+                     bounds.lambda_max);
+        lambda_init = true;
+      }
+    }
+
     if (basis == QUDA_CHEBYSHEV_BASIS && lambda_max < lambda_min && !lambda_init) {
       if (!param.is_preconditioner) { profile.TPSTOP(QUDA_PROFILE_PREAMBLE); profile.TPSTART(QUDA_PROFILE_INIT); }
 
@@ -564,6 +578,7 @@ namespace quda {
       matSloppy(*AQ[0], *Q[0], tmpSloppy, tmpSloppy2);
       lambda_max = 1.1*(sqrt(blas::norm2(*AQ[0])));
       if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("CA-CG Approximate lambda max = 1.1 x %e\n", lambda_max/1.1);
+      spectral::recordMax(spectral_key, lambda_max / 1.1, spectral::SPECTRAL_POWER);
       lambda_init = true;
 
       if (!param.is_preconditioner) { profile.TPSTOP(QUDA_PROFILE_INIT); profile.TPSTART(QUDA_PROFILE_PREAMBLE); }
@@ -745,6 +760,7 @@ namespace quda {
         blas::copy(*S[0], r_);
 
         if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x, r_).z);
+        ReportEvent("CA-CG", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, total_iter, r2, b2, heavy_quark_res, param.precision);
 
         // break-out check if we have reached the limit of the precision
         if (r2 > r2_old) {
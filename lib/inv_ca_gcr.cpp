@@ -360,6 +360,7 @@ namespace quda {
         restart++; // restarting if residual is still too great
 
         PrintStats("CA-GCR (restart)", restart, r2, b2, heavy_quark_res);
+        ReportEvent("CA-GCR", QUDA_SOLVER_EVENT_RESTART, total_iter, r2, b2, heavy_quark_res, param.precision);
         blas::copy(*p[0],r); // no-op if uni-precision
 
         r2_old = r2;
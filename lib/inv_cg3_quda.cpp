@@ -420,6 +420,7 @@ namespace quda {
           r0Norm = sqrt(r2);
           maxrr = rNorm;
           maxrx = rNorm;
+          ReportEvent("CG3", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, k, r2, b2, heavy_quark_res, param.precision);
           // we update sloppy and old fields
           if (!convergence(r2, heavy_quark_res, stop, param.tol_hq)) {
             blas::copy(rS, r);
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
 #include <limits>
 #include <memory>
 #include <iostream>
+#include <vector>
 
 #ifdef BLOCKSOLVER
 #include <Eigen/Dense>
@@ -16,6 +18,7 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <eigensolve_quda.h>
+#include <spectral_bounds.h>
 
 namespace quda {
 
@@ -463,6 +466,13 @@ namespace quda {
     int steps_since_reliable = 1;
     bool converged = convergence(r2, heavy_quark_res, stop, param.tol_hq);
 
+    // CG coefficients up to the first reliable update, from which the
+    // Lanczos matrix gives an estimate of the spectral bounds
+    const int lanczos_max = 128;
+    bool lanczos_collect = !param.is_preconditioner && !p_init;
+    std::vector<double> lanczos_alpha;
+    std::vector<double> lanczos_beta;
+
     // alternative reliable updates
     if(alternative_reliable){
       dinit = uhigh * (rNorm + Anorm * xNorm);
@@ -515,6 +525,8 @@ namespace quda {
         sigma = imag(cg_norm) >= 0.0 ? imag(cg_norm) : r2;  // use r2 if (r_k+1, r_k+1-r_k) breaks
       }
 
+      if (lanczos_collect) lanczos_alpha.push_back(alpha[j]);
+
       // reliable update conditions
       rNorm = sqrt(r2);
       int updateX;
@@ -541,6 +553,10 @@ namespace quda {
 
       if ( !(updateR || updateX )) {
         beta = sigma / r2_old;  // use the alternative beta computation
+        if (lanczos_collect) {
+          lanczos_beta.push_back(beta);
+          if (static_cast<int>(lanczos_alpha.size()) == lanczos_max) lanczos_collect = false;
+        }
 
         if (param.pipeline && !breakdown) {
 
@@ -633,6 +649,7 @@ namespace quda {
 
         // calculate new reliable HQ resididual
         if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(y, r).z);
+        ReportEvent("CG", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, k, r2, b2, heavy_quark_res, param.precision);
 
         // break-out check if we have reached the limit of the precision
         if (sqrt(r2) > r0Norm && updateX and not L2breakdown) { // reuse r0Norm for this
@@ -703,6 +720,7 @@ namespace quda {
         steps_since_reliable = 0;
         r0Norm = sqrt(r2);
         rUpdate++;
+        lanczos_collect = false;
 
         heavy_quark_res_old = heavy_quark_res;
       }
@@ -753,6 +771,16 @@ namespace quda {
     if (getVerbosity() >= QUDA_VERBOSE)
       printfQuda("CG: Reliable updates = %d\n", rUpdate);
 
+    double lambda_min, lambda_max;
+    if (!param.is_preconditioner && spectral::lanczosBounds(lanczos_alpha, lanczos_beta, lambda_min, lambda_max)) {
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("CG: Lanczos estimate of the spectrum [%e, %e] from %lu steps\n", lambda_min, lambda_max,
+                   lanczos_alpha.size());
+      const spectral::Key spectral_key = spectral::key(matSloppy, rSloppy);
+      spectral::recordMin(spectral_key, lambda_min, spectral::SPECTRAL_LANCZOS);
+      spectral::recordMax(spectral_key, lambda_max, spectral::SPECTRAL_LANCZOS);
+    }
+
     if (param.compute_true_res) {
       // compute the true residuals
       mat(r, x, y, tmp3);
@@ -775,381 +803,359 @@ namespace quda {
     if (param.is_preconditioner && param.global_reduction == false) commGlobalReductionSet(true);
   }
 
-// use BlockCGrQ algortithm or BlockCG (with / without GS, see BLOCKCG_GS option)
-#define BCGRQ 1
-#if BCGRQ
-void CG::blocksolve(ColorSpinorField& x, ColorSpinorField& b) {
-  #ifndef BLOCKSOLVER
-  errorQuda("QUDA_BLOCKSOLVER not built.");
-  #else
-
-  if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION)
-  errorQuda("Not supported");
-
-  profile.TPSTART(QUDA_PROFILE_INIT);
+#ifdef BLOCKSOLVER
+  namespace
+  {
 
-  using Eigen::MatrixXcd;
+    using BlockMatrix = Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
-  // Check to see that we're not trying to invert on a zero-field source
-  //MW: it might be useful to check what to do here.
-  double b2[QUDA_MAX_MULTI_SHIFT];
-  double b2avg=0;
-  for(int i=0; i< param.num_src; i++){
-    b2[i]=blas::norm2(b.Component(i));
-    b2avg += b2[i];
-    if(b2[i] == 0){
-      profile.TPSTOP(QUDA_PROFILE_INIT);
-      errorQuda("Warning: inverting on zero-field source - undefined for block solver\n");
-      x=b;
-      param.true_res = 0.0;
-      param.true_res_hq = 0.0;
-      return;
+    /**
+       @brief Return the given components of a composite field as a
+       vector of fields, for use with the multi-blas kernels
+     */
+    std::vector<ColorSpinorField *> columns(ColorSpinorField &f, const std::vector<int> &index)
+    {
+      std::vector<ColorSpinorField *> v;
+      v.reserve(index.size());
+      for (auto i : index) v.push_back(&f.Component(i));
+      return v;
     }
-  }
-
-  b2avg = b2avg / param.num_src;
-
-  ColorSpinorParam csParam(x);
-  if (!init) {
-    csParam.setPrecision(param.precision);
-    csParam.create = QUDA_ZERO_FIELD_CREATE;
-    rp = ColorSpinorField::Create(csParam);
-    yp = ColorSpinorField::Create(csParam);
 
-    // sloppy fields
-    csParam.setPrecision(param.precision_sloppy);
-    pp = ColorSpinorField::Create(csParam);
-    App = ColorSpinorField::Create(csParam);
-    if(param.precision != param.precision_sloppy) {
-      rSloppyp = ColorSpinorField::Create(csParam);
-      xSloppyp = ColorSpinorField::Create(csParam);
-    } else {
-      rSloppyp = rp;
-      param.use_sloppy_partial_accumulator = false;
-    }
+    /**
+       @brief Return the first n components of a composite field
+     */
+    std::vector<ColorSpinorField *> columns(ColorSpinorField &f, int n)
+    {
+      std::vector<ColorSpinorField *> v;
+      v.reserve(n);
+      for (int i = 0; i < n; i++) v.push_back(&f.Component(i));
+      return v;
+    }
+
+    /**
+       @brief Rank-revealing orthonormalization of the block w into p.
+       With the Gram matrix W^dag W = V Lambda V^dag, directions with
+       Lambda_k <= n epsilon Lambda_max are dropped and the remainder
+       is written to the leading components of p as P = W V_k
+       Lambda_k^{-1/2}.
+       @param[out] p Orthonormal block, must hold at least w.size() fields
+       @param[in] w Block to orthonormalize
+       @param[in] epsilon Unit roundoff of the precision of w
+       @return The numerical rank of w
+     */
+    int orthonormalize(std::vector<ColorSpinorField *> &p, std::vector<ColorSpinorField *> &w, double epsilon)
+    {
+      const int n = w.size();
+      BlockMatrix G(n, n);
+      blas::hDotProduct(G.data(), w, w);
 
-    // temporary fields
-    tmpp = ColorSpinorField::Create(csParam);
-    if(!mat.isStaggered()) {
-      // tmp2 only needed for multi-gpu Wilson-like kernels
-      tmp2p = ColorSpinorField::Create(csParam);
-      // additional high-precision temporary if Wilson and mixed-precision
-      csParam.setPrecision(param.precision);
-      tmp3p = (param.precision != param.precision_sloppy) ?
-	ColorSpinorField::Create(csParam) : tmpp;
-    } else {
-      tmp3p = tmp2p = tmpp;
-    }
+      Eigen::SelfAdjointEigenSolver<BlockMatrix> eigen(G);
+      const double cutoff = n * epsilon * eigen.eigenvalues().maxCoeff();
 
-    init = true;
-  }
+      std::vector<int> keep;
+      for (int k = n - 1; k >= 0; k--)
+        if (eigen.eigenvalues()(k) > cutoff) keep.push_back(k);
+      const int rank = keep.size();
+      if (rank == 0) return 0;
 
-  if(!rnewp) {
-    csParam.create = QUDA_ZERO_FIELD_CREATE;
-    csParam.setPrecision(param.precision_sloppy);
-    // ColorSpinorField *rpnew = ColorSpinorField::Create(csParam);
-  }
+      BlockMatrix C(n, rank);
+      for (int k = 0; k < rank; k++)
+        C.col(k) = eigen.eigenvectors().col(keep[k]) / sqrt(eigen.eigenvalues()(keep[k]));
 
-  ColorSpinorField &r = *rp;
-  ColorSpinorField &y = *yp;
-  ColorSpinorField &p = *pp;
-  ColorSpinorField &Ap = *App;
-  ColorSpinorField &rnew = *rnewp;
-  ColorSpinorField &tmp = *tmpp;
-  ColorSpinorField &tmp2 = *tmp2p;
-  ColorSpinorField &tmp3 = *tmp3p;
-  ColorSpinorField &rSloppy = *rSloppyp;
-  ColorSpinorField &xSloppy = param.use_sloppy_partial_accumulator ? *xSloppyp : x;
+      std::vector<ColorSpinorField *> p_(p.begin(), p.begin() + rank);
+      for (auto pi : p_) blas::zero(*pi);
+      blas::caxpy(C.data(), w, p_);
 
-  // calculate residuals for all vectors
-  // and initialize r2 matrix
-  double r2avg=0;
-  MatrixXcd r2(param.num_src, param.num_src);
-  for(int i=0; i<param.num_src; i++){
-    mat(r.Component(i), x.Component(i), y.Component(i));
-    r2(i,i) = blas::xmyNorm(b.Component(i), r.Component(i));
-    r2avg += r2(i,i).real();
-    printfQuda("r2[%i] %e\n", i, r2(i,i).real());
-  }
-  for(int i=0; i<param.num_src; i++){
-    for(int j=i+1; j < param.num_src; j++){
-      r2(i,j) = blas::cDotProduct(r.Component(i),r.Component(j));
-      r2(j,i) = std::conj(r2(i,j));
+      return rank;
     }
-  }
-
-  blas::copy(rSloppy, r);
-  blas::copy(p, rSloppy);
-  blas::copy(rnew, rSloppy);
-
-  if (&x != &xSloppy) {
-    blas::copy(y, x);
-    blas::zero(xSloppy);
-  } else {
-    blas::zero(y);
-  }
-
-  const bool use_heavy_quark_res =
-  (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) ? true : false;
-  if(use_heavy_quark_res) errorQuda("ERROR: heavy quark residual not supported in block solver");
-
-  profile.TPSTOP(QUDA_PROFILE_INIT);
-  profile.TPSTART(QUDA_PROFILE_PREAMBLE);
 
-  double stop[QUDA_MAX_MULTI_SHIFT];
-
-  for(int i = 0; i < param.num_src; i++){
-    stop[i] = stopping(param.tol, b2[i], param.residual_type);  // stopping condition of solver
-  }
-
-  // Eigen Matrices instead of scalars
-  MatrixXcd alpha = MatrixXcd::Zero(param.num_src,param.num_src);
-  MatrixXcd beta = MatrixXcd::Zero(param.num_src,param.num_src);
-  MatrixXcd C = MatrixXcd::Zero(param.num_src,param.num_src);
-  MatrixXcd S = MatrixXcd::Identity(param.num_src,param.num_src);
-  MatrixXcd pAp = MatrixXcd::Identity(param.num_src,param.num_src);
-  quda::Complex * AC = new quda::Complex[param.num_src*param.num_src];
-
-  #ifdef MWVERBOSE
-  MatrixXcd pTp =  MatrixXcd::Identity(param.num_src,param.num_src);
-  #endif
+  } // namespace
+#endif
 
+  /**
+     Breakdown-free block CG (Ji and Li, 2017) with deflation of
+     converged columns.  The search block P is kept orthonormal with a
+     rank-revealing orthonormalization, so that linearly dependent
+     residuals reduce the block size rather than break the Cholesky
+     factorization of the block recurrence, and columns whose residual
+     has converged leave the residual block, so that the block (and
+     hence the number of matrix-vector products per iteration) shrinks
+     as the solve proceeds.  All block updates and inner products use
+     the multi-blas and multi-reduce kernels.  Reliable updates are
+     done for the whole block once every remaining column has reduced
+     its residual by delta, and once all columns have converged, when
+     any column whose true residual has not converged rejoins the
+     block.
+  */
+  void CG::blocksolve(ColorSpinorField &x, ColorSpinorField &b)
+  {
+#ifndef BLOCKSOLVER
+    errorQuda("QUDA_BLOCKSOLVER not built.");
+#else
+    if (checkLocation(x, b) != QUDA_CUDA_FIELD_LOCATION) errorQuda("Not supported");
+    if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL)
+      errorQuda("Heavy quark residual not supported in block solver");
 
+    const int n_src = param.num_src;
+    if (n_src > QUDA_MAX_BLOCK_SRC) errorQuda("Number of sources %d exceeds QUDA_MAX_BLOCK_SRC=%d", n_src, QUDA_MAX_BLOCK_SRC);
 
+    profile.TPSTART(QUDA_PROFILE_INIT);
 
-  //FIXME:reliable updates currently not implemented
-  /*
-  double rNorm[QUDA_MAX_MULTI_SHIFT];
-  double r0Norm[QUDA_MAX_MULTI_SHIFT];
-  double maxrx[QUDA_MAX_MULTI_SHIFT];
-  double maxrr[QUDA_MAX_MULTI_SHIFT];
+    std::vector<double> b2(n_src);
+    double b2avg = 0.0;
+    for (int i = 0; i < n_src; i++) {
+      b2[i] = blas::norm2(b.Component(i));
+      if (b2[i] == 0.0) errorQuda("Source %d has zero norm, undefined for block solver", i);
+      b2avg += b2[i] / n_src;
+    }
 
-  for(int i = 0; i < param.num_src; i++){
-    rNorm[i] = sqrt(r2(i,i).real());
-    r0Norm[i] = rNorm[i];
-    maxrx[i] = rNorm[i];
-    maxrr[i] = rNorm[i];
-  }
-  bool L2breakdown = false;
-  int rUpdate = 0;
-  nt steps_since_reliable = 1;
-  */
+    ColorSpinorParam csParam(x);
+    if (!init) {
+      csParam.setPrecision(param.precision);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      rp = ColorSpinorField::Create(csParam);
+      yp = ColorSpinorField::Create(csParam);
 
-  profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
-  profile.TPSTART(QUDA_PROFILE_COMPUTE);
-  blas::flops = 0;
+      // sloppy fields
+      csParam.setPrecision(param.precision_sloppy);
+      pp = ColorSpinorField::Create(csParam);
+      App = ColorSpinorField::Create(csParam);
+      rnewp = ColorSpinorField::Create(csParam);
+      if (param.precision != param.precision_sloppy) {
+        rSloppyp = ColorSpinorField::Create(csParam);
+        xSloppyp = ColorSpinorField::Create(csParam);
+      } else {
+        rSloppyp = rp;
+        param.use_sloppy_partial_accumulator = false;
+      }
 
-  int k = 0;
+      // temporary fields are only used one column at a time
+      csParam.is_composite = false;
+      csParam.composite_dim = 0;
+      tmpp = ColorSpinorField::Create(csParam);
+      if (!mat.isStaggered()) {
+        // tmp2 only needed for multi-gpu Wilson-like kernels
+        tmp2p = ColorSpinorField::Create(csParam);
+        // additional high-precision temporary if Wilson and mixed-precision
+        csParam.setPrecision(param.precision);
+        tmp3p = (param.precision != param.precision_sloppy) ? ColorSpinorField::Create(csParam) : tmpp;
+      } else {
+        tmp3p = tmp2p = tmpp;
+      }
 
-  PrintStats("CG", k, r2avg / param.num_src, b2avg, 0.);
-  bool allconverged = true;
-  bool converged[QUDA_MAX_MULTI_SHIFT];
-  for(int i=0; i<param.num_src; i++){
-    converged[i] = convergence(r2(i,i).real(), 0., stop[i], param.tol_hq);
-    allconverged = allconverged && converged[i];
-  }
+      init = true;
+    }
 
-  // CHolesky decomposition
-  MatrixXcd L = r2.llt().matrixL();//// retrieve factor L  in the decomposition
-  C = L.adjoint();
-  MatrixXcd Linv = C.inverse();
+    ColorSpinorField &r = *rp;
+    ColorSpinorField &y = *yp;
+    ColorSpinorField &p = *pp;
+    ColorSpinorField &Ap = *App;
+    ColorSpinorField &w = *rnewp;
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &tmp2 = *tmp2p;
+    ColorSpinorField &tmp3 = *tmp3p;
+    ColorSpinorField &rSloppy = *rSloppyp;
+    ColorSpinorField &xSloppy = param.use_sloppy_partial_accumulator ? *xSloppyp : x;
 
-  #ifdef MWVERBOSE
-  std::cout << "r2\n " << r2 << std::endl;
-  std::cout << "L\n " << L.adjoint() << std::endl;
-  #endif
+    std::vector<double> r2(n_src);
+    std::vector<double> stop(n_src);
+    std::vector<double> maxrr(n_src);
+    for (int i = 0; i < n_src; i++) {
+      mat(r.Component(i), x.Component(i), y.Component(i), tmp3);
+      r2[i] = blas::xmyNorm(b.Component(i), r.Component(i));
+      stop[i] = stopping(param.tol, b2[i], param.residual_type);
+      maxrr[i] = sqrt(r2[i]);
+
+      blas::copy(rSloppy.Component(i), r.Component(i));
+      if (&x != &xSloppy) {
+        blas::copy(y.Component(i), x.Component(i));
+        blas::zero(xSloppy.Component(i));
+      } else {
+        blas::zero(y.Component(i));
+      }
+    }
 
-  // set p to QR decompsition of r
-  // temporary hack - use AC to pass matrix arguments to multiblas
-  for(int i=0; i<param.num_src; i++){
-    blas::zero(p.Component(i));
-    for(int j=0;j<param.num_src; j++){
-      AC[i*param.num_src + j] = Linv(i,j);
+    double epsilon;
+    switch (param.precision_sloppy) {
+    case QUDA_DOUBLE_PRECISION: epsilon = std::numeric_limits<double>::epsilon(); break;
+    case QUDA_SINGLE_PRECISION: epsilon = std::numeric_limits<float>::epsilon(); break;
+    case QUDA_HALF_PRECISION: epsilon = 1.0 / std::numeric_limits<short>::max(); break;
+    default: epsilon = 1.0 / std::numeric_limits<char>::max();
     }
-  }
-  blas::caxpy(AC,r,p);
 
-  // set rsloppy to to QR decompoistion of r (p)
-  for(int i=0; i< param.num_src; i++){
-    blas::copy(rSloppy.Component(i), p.Component(i));
-  }
+    auto r2avg = [&r2, n_src]() {
+      double sum = 0.0;
+      for (auto r2_i : r2) sum += r2_i;
+      return sum / n_src;
+    };
 
-  #ifdef MWVERBOSE
-  for(int i=0; i<param.num_src; i++){
-    for(int j=0; j<param.num_src; j++){
-      pTp(i,j) = blas::cDotProduct(p.Component(i), p.Component(j));
-    }
-  }
-  std::cout << " pTp  " << std::endl << pTp << std::endl;
-  std::cout << " L " << std::endl << L.adjoint() << std::endl;
-  std::cout << " C " << std::endl << C << std::endl;
-  #endif
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_PREAMBLE);
 
-  while ( !allconverged && k < param.maxiter ) {
-    // apply matrix
-    for(int i=0; i<param.num_src; i++){
-      matSloppy(Ap.Component(i), p.Component(i), tmp.Component(i), tmp2.Component(i));  // tmp as tmp
-    }
+    // columns that have not yet converged, and columns with solution
+    // updates in xSloppy that have not been flushed by a reliable update
+    std::vector<int> active;
+    std::vector<bool> dirty(n_src, false);
+    for (int i = 0; i < n_src; i++)
+      if (!convergence(r2[i], 0.0, stop[i], param.tol_hq)) active.push_back(i);
 
-    // calculate pAp
-    for(int i=0; i<param.num_src; i++){
-      for(int j=i; j < param.num_src; j++){
-        pAp(i,j) = blas::cDotProduct(p.Component(i), Ap.Component(j));
-        if (i!=j) pAp(j,i) = std::conj(pAp(i,j));
-      }
+    auto P_all = columns(p, n_src);
+    int rank = 0;
+    if (!active.empty()) {
+      auto R = columns(rSloppy, active);
+      rank = orthonormalize(P_all, R, epsilon);
     }
 
-    // update Xsloppy
-    alpha = pAp.inverse() * C;
-    // temporary hack using AC
-    for(int i=0; i<param.num_src; i++){
-      for(int j=0;j<param.num_src; j++){
-        AC[i*param.num_src + j] = alpha(i,j);
-      }
-    }
-    blas::caxpy(AC,p,xSloppy);
+    profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    blas::flops = 0;
 
-    // update rSloppy
-    beta = pAp.inverse();
-    // temporary hack
-    for(int i=0; i<param.num_src; i++){
-      for(int j=0;j<param.num_src; j++){
-        AC[i*param.num_src + j] = -beta(i,j);
-      }
-    }
-    blas::caxpy(AC,Ap,rSloppy);
+    int k = 0;
+    int rUpdate = 0;
+    PrintStats("BlockCG", k, r2avg(), b2avg, 0.0);
+
+    while (!active.empty() && rank > 0 && k < param.maxiter) {
+      const int m = active.size();
+      auto P = columns(p, rank);
+      auto Q = columns(Ap, rank);
+      auto R = columns(rSloppy, active);
+      auto X = columns(xSloppy, active);
+
+      // Q = A P, one matrix-vector product per direction in the block
+      for (int j = 0; j < rank; j++) matSloppy(*Q[j], *P[j], tmp, tmp2);
+
+      // P^dag Q and P^dag R in a single multi-reduction
+      std::vector<ColorSpinorField *> QR(Q);
+      QR.insert(QR.end(), R.begin(), R.end());
+      BlockMatrix PQR(rank, rank + m);
+      blas::cDotProduct(PQR.data(), P, QR);
+
+      BlockMatrix PQ = PQR.leftCols(rank);
+      PQ = (0.5 * (PQ + PQ.adjoint())).eval();
+      Eigen::LDLT<BlockMatrix> PQ_solver(PQ);
+
+      // X += P alpha, R -= Q alpha
+      BlockMatrix alpha = PQ_solver.solve(PQR.rightCols(m));
+      blas::caxpy(alpha.data(), P, X);
+      alpha = -alpha;
+      blas::caxpy(alpha.data(), Q, R);
+      for (auto i : active) dirty[i] = true;
+
+      // Q^dag R for the next search block and the residual norms in a single multi-reduction
+      BlockMatrix QRR(rank + m, m);
+      blas::cDotProduct(QRR.data(), QR, R);
+      for (int i = 0; i < m; i++) r2[active[i]] = QRR(rank + i, i).real();
 
-    // orthorgonalize R
-    // copy rSloppy to rnew as temporary
-    for(int i=0; i< param.num_src; i++){
-      blas::copy(rnew.Component(i), rSloppy.Component(i));
-    }
-    for(int i=0; i<param.num_src; i++){
-      for(int j=i; j < param.num_src; j++){
-        r2(i,j) = blas::cDotProduct(r.Component(i),r.Component(j));
-        if (i!=j) r2(j,i) = std::conj(r2(i,j));
-      }
-    }
-    // Cholesky decomposition
-    L = r2.llt().matrixL();// retrieve factor L  in the decomposition
-    S = L.adjoint();
-    Linv = S.inverse();
-    // temporary hack
-    for(int i=0; i<param.num_src; i++){
-      blas::zero(rSloppy.Component(i));
-      for(int j=0;j<param.num_src; j++){
-        AC[i*param.num_src + j] = Linv(i,j);
+      k++;
+      PrintStats("BlockCG", k, r2avg(), b2avg, 0.0);
+
+      // deflate the converged columns, and do a reliable update once
+      // every remaining column has reduced its residual by delta
+      std::vector<int> remaining;
+      std::vector<int> position;
+      bool update = true;
+      for (int i = 0; i < m; i++) {
+        const int col = active[i];
+        if (convergence(r2[col], 0.0, stop[col], param.tol_hq)) continue;
+        remaining.push_back(col);
+        position.push_back(i);
+        if (sqrt(r2[col]) >= param.delta * maxrr[col]) update = false;
       }
-    }
-    blas::caxpy(AC,rnew,rSloppy);
+      if (remaining.size() < active.size() && getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("BlockCG: %d of %d columns converged at iteration %d\n", n_src - (int)remaining.size(), n_src, k);
+      active = remaining;
+
+      BlockMatrix QtR(rank, active.size());
+      if (update) {
+        for (int i = 0; i < n_src; i++) {
+          if (!dirty[i]) continue;
+          blas::copy(x.Component(i), xSloppy.Component(i)); // nop when these alias
+          blas::xpy(x.Component(i), y.Component(i));
+          mat(r.Component(i), y.Component(i), x.Component(i), tmp3); // here we can use x as tmp
+          r2[i] = blas::xmyNorm(b.Component(i), r.Component(i));
+          blas::copy(rSloppy.Component(i), r.Component(i)); // nop when these alias
+          blas::zero(xSloppy.Component(i));
+          maxrr[i] = sqrt(r2[i]);
+          dirty[i] = false;
+        }
+        rUpdate++;
+        ReportEvent("BlockCG", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, k, r2avg(), b2avg, 0.0, param.precision);
 
-    #ifdef MWVERBOSE
-    for(int i=0; i<param.num_src; i++){
-      for(int j=0; j<param.num_src; j++){
-        pTp(i,j) = blas::cDotProduct(rSloppy.Component(i), rSloppy.Component(j));
-      }
-    }
-    std::cout << " rTr " << std::endl << pTp << std::endl;
-    std::cout <<  "QR" << S<<  std::endl << "QP " << S.inverse()*S << std::endl;;
-    #endif
+        // any column whose true residual has not converged rejoins the block
+        active.clear();
+        for (int i = 0; i < n_src; i++)
+          if (!convergence(r2[i], 0.0, stop[i], param.tol_hq)) active.push_back(i);
+        if (active.empty()) break;
 
-    // update p
-    // use rnew as temporary again for summing up
-    for(int i=0; i<param.num_src; i++){
-      blas::copy(rnew.Component(i),rSloppy.Component(i));
-    }
-    // temporary hack
-    for(int i=0; i<param.num_src; i++){
-      for(int j=0;j<param.num_src; j++){
-        AC[i*param.num_src + j] = std::conj(S(j,i));
+        auto R_new = columns(rSloppy, active);
+        QtR.resize(rank, active.size());
+        blas::cDotProduct(QtR.data(), Q, R_new);
+      } else {
+        if (active.empty()) break;
+        for (unsigned int i = 0; i < active.size(); i++) QtR.col(i) = QRR.block(0, position[i], rank, 1);
       }
-    }
-    blas::caxpy(AC,p,rnew);
-    // set p = rnew
-    for(int i=0; i < param.num_src; i++){
-      blas::copy(p.Component(i),rnew.Component(i));
-    }
 
-    // update C
-    C = S * C;
+      // P = orth(R - P (P^dag Q)^{-1} Q^dag R)
+      const int m_new = active.size();
+      auto R_new = columns(rSloppy, active);
+      auto W = columns(w, m_new);
+      for (int i = 0; i < m_new; i++) blas::copy(*W[i], *R_new[i]);
+      BlockMatrix beta = -PQ_solver.solve(QtR);
+      blas::caxpy(beta.data(), P, W);
 
-    #ifdef MWVERBOSE
-    for(int i=0; i<param.num_src; i++){
-      for(int j=0; j<param.num_src; j++){
-        pTp(i,j) = blas::cDotProduct(p.Component(i), p.Component(j));
-      }
+      const int rank_old = rank;
+      rank = orthonormalize(P_all, W, epsilon);
+      if (rank < m_new && getVerbosity() >= QUDA_VERBOSE)
+        printfQuda("BlockCG: search block rank %d for %d columns at iteration %d (was %d)\n", rank, m_new, k, rank_old);
     }
-    std::cout << " pTp " << std::endl << pTp << std::endl;
-    std::cout <<  "S " << S<<  std::endl << "C " << C << std::endl;
-    #endif
 
-    // calculate the residuals for all shifts
-    r2avg=0;
-    for (int j=0; j<param.num_src; j++ ){
-      r2(j,j) = C(0,j)*conj(C(0,j));
-      for(int i=1; i < param.num_src; i++)
-      r2(j,j) += C(i,j) * conj(C(i,j));
-      r2avg += r2(j,j).real();
-    }
+    if (!active.empty() && rank == 0) warningQuda("BlockCG: search block lost rank at iteration %d", k);
 
-    k++;
-    PrintStats("CG", k, r2avg / param.num_src, b2avg, 0);
-    // check convergence
-    allconverged = true;
-    for(int i=0; i<param.num_src; i++){
-      converged[i] = convergence(r2(i,i).real(), 0, stop[i], param.tol_hq);
-      allconverged = allconverged && converged[i];
+    for (int i = 0; i < n_src; i++) {
+      blas::copy(x.Component(i), xSloppy.Component(i));
+      blas::xpy(y.Component(i), x.Component(i));
     }
 
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EPILOGUE);
 
-  }
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (blas::flops + mat.flops() + matSloppy.flops()) * 1e-9;
+    param.gflops = gflops;
+    param.iter += k;
 
-  for(int i=0; i<param.num_src; i++){
-    blas::xpy(y.Component(i), xSloppy.Component(i));
-  }
+    if (k == param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
 
-  profile.TPSTOP(QUDA_PROFILE_COMPUTE);
-  profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+    if (getVerbosity() >= QUDA_VERBOSE) printfQuda("BlockCG: Reliable updates = %d\n", rUpdate);
 
-  param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
-  double gflops = (blas::flops + mat.flops() + matSloppy.flops())*1e-9;
-  param.gflops = gflops;
-  param.iter += k;
-
-  if (k == param.maxiter)
-  warningQuda("Exceeded maximum iterations %d", param.maxiter);
+    // compute the true residuals, reporting the worst column in true_res
+    param.true_res = 0.0;
+    param.true_res_hq = 0.0;
+    for (int i = 0; i < n_src; i++) {
+      mat(r.Component(i), x.Component(i), y.Component(i), tmp3);
+      const double true_res = sqrt(blas::xmyNorm(b.Component(i), r.Component(i)) / b2[i]);
+      const double true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x.Component(i), r.Component(i)).z);
+      param.true_res = std::max(param.true_res, true_res);
+      param.true_res_hq = std::max(param.true_res_hq, true_res_hq);
+      if (i < QUDA_MAX_MULTI_SHIFT) {
+        param.true_res_offset[i] = true_res;
+        param.true_res_hq_offset[i] = true_res_hq;
+      }
 
-  // if (getVerbosity() >= QUDA_VERBOSE)
-  // printfQuda("CG: Reliable updates = %d\n", rUpdate);
+      PrintSummary("BlockCG", k, r2[i], b2[i], stop[i], 0.0);
+    }
 
-  // compute the true residuals
-  for(int i=0; i<param.num_src; i++){
-    mat(r.Component(i), x.Component(i), y.Component(i), tmp3.Component(i));
-    param.true_res = sqrt(blas::xmyNorm(b.Component(i), r.Component(i)) / b2[i]);
-    param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x.Component(i), r.Component(i)).z);
-    param.true_res_offset[i] = param.true_res;
-    param.true_res_hq_offset[i] = param.true_res_hq;
+    // reset the flops counters
+    blas::flops = 0;
+    mat.flops();
+    matSloppy.flops();
 
-    PrintSummary("CG", k, r2(i,i).real(), b2[i], stop[i], 0.0);
+    profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+#endif
   }
 
-  // reset the flops counters
-  blas::flops = 0;
-  mat.flops();
-  matSloppy.flops();
-
-  profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
-  profile.TPSTART(QUDA_PROFILE_FREE);
-
-  delete[] AC;
-  profile.TPSTOP(QUDA_PROFILE_FREE);
-
-  return;
-
-  #endif
-}
-
-#else
+// legacy block CG variant (with / without GS, see BLOCKCG_GS option)
+#if 0
 
 // use Gram Schmidt in Block CG ?
 #define BLOCKCG_GS 1
@@ -10,6 +10,7 @@
 #include <invert_quda.h>
 #include <util_quda.h>
 #include <color_spinor_field.h>
+#include <multigrid.h>
 
 #include <sys/time.h>
 
@@ -399,6 +400,9 @@ namespace quda {
     while ( !convergence(r2, heavy_quark_res, stop, param.tol_hq) && total_iter < param.maxiter) {
 
       if (K) {
+	// let a multigrid preconditioner adapt its coarse solver tolerance to our progress
+	if (param.inv_type_precondition == QUDA_MG_INVERTER && param.preconditioner)
+	  static_cast<MG *>(K)->setOuterReduction(sqrt(r2 / b2));
 	pushVerbosity(param.verbosity_precondition);
 	(*K)(*p[k], rSloppy);
 	popVerbosity();
@@ -459,6 +463,7 @@ namespace quda {
         }
 
         if (use_heavy_quark_res) heavy_quark_res = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+        ReportEvent("GCR", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, total_iter, r2, b2, heavy_quark_res, param.precision);
 
         // break-out check if we have reached the limit of the precision
         if (r2 > r2_old) {
@@ -481,6 +486,7 @@ namespace quda {
           restart++; // restarting if residual is still too great
 
           PrintStats("GCR (restart)", restart, r2, b2, heavy_quark_res);
+          ReportEvent("GCR", QUDA_SOLVER_EVENT_RESTART, total_iter, r2, b2, heavy_quark_res, param.precision);
           blas::copy(rSloppy, r);
 
           r2_old = r2;
@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <blas_quda.h>
+#include <invert_quda.h>
+#include <util_quda.h>
+
+#include <Eigen/Dense>
+#include <Eigen/Eigenvalues>
+
+/*
+  GCRO-DR algorithm:
+  M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson and S. Maiti,
+  "Recycling Krylov subspaces for sequences of linear systems",
+  SIAM J. Sci. Comput. 28 (2006) p. 1651-1674
+*/
+
+namespace quda
+{
+
+  namespace
+  {
+
+    using DenseMatrix = Eigen::MatrixXcd;
+    using RowMajorDenseMatrix = Eigen::Matrix<Complex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+       @brief Return the block of inner products X^dag Y
+     */
+    DenseMatrix blockDot(std::vector<ColorSpinorField *> &x, std::vector<ColorSpinorField *> &y)
+    {
+      RowMajorDenseMatrix result = RowMajorDenseMatrix::Zero(x.size(), y.size());
+      if (x.size() > 0 && y.size() > 0) blas::cDotProduct(result.data(), x, y);
+      return result;
+    }
+
+    /**
+       @brief Compute Y += X a with the block caxpy
+     */
+    void blockCaxpy(const DenseMatrix &a, std::vector<ColorSpinorField *> &x, std::vector<ColorSpinorField *> &y)
+    {
+      if (x.size() == 0 || y.size() == 0) return;
+      RowMajorDenseMatrix a_(a);
+      blas::caxpy(a_.data(), x, y);
+    }
+
+    double precisionEpsilon(QudaPrecision precision)
+    {
+      switch (precision) {
+      case QUDA_DOUBLE_PRECISION: return std::numeric_limits<double>::epsilon();
+      case QUDA_SINGLE_PRECISION: return std::numeric_limits<float>::epsilon();
+      case QUDA_HALF_PRECISION: return 1.0 / std::numeric_limits<short>::max();
+      default: return 1.0 / std::numeric_limits<char>::max();
+      }
+    }
+
+  } // namespace
+
+  GCRODR::GCRODR(const DiracMatrix &mat, const DiracMatrix &matSloppy, SolverParam &param, TimeProfile &profile) :
+    Solver(mat, matSloppy, matSloppy, param, profile),
+    rp(nullptr),
+    r_sloppy(nullptr),
+    ep(nullptr),
+    tmpp(nullptr),
+    tmp2p(nullptr),
+    init(false)
+  {
+  }
+
+  GCRODR::~GCRODR()
+  {
+    profile.TPSTART(QUDA_PROFILE_FREE);
+
+    preserve();
+    for (auto v : U_new) delete v;
+    for (auto v : C_new) delete v;
+    for (auto v : V) delete v;
+
+    if (init) {
+      if (r_sloppy != rp) delete r_sloppy;
+      delete rp;
+      delete ep;
+      if (tmp2p != tmpp) delete tmp2p;
+      delete tmpp;
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_FREE);
+  }
+
+  void GCRODR::restore(const ColorSpinorField &meta)
+  {
+    if (U.size() > 0 || !param.deflate || !param.eig_param.preserve_deflation_space) return;
+    auto *space = reinterpret_cast<deflation_space *>(param.eig_param.preserve_deflation_space);
+
+    bool compatible = !space->svd && space->evecs.size() > 0 && space->images.size() == space->evecs.size()
+      && space->evecs.size() <= (size_t)param.n_ev;
+    for (auto &vec : space->evecs) {
+      compatible = compatible && vec->Precision() == param.precision_sloppy && vec->VolumeCB() == meta.VolumeCB()
+        && vec->SiteSubset() == meta.SiteSubset() && vec->Nspin() == meta.Nspin() && vec->Ncolor() == meta.Ncolor();
+    }
+
+    if (compatible) {
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("GCRODR: restoring recycled subspace of size %lu\n", space->evecs.size());
+      U = space->evecs;
+      C = space->images;
+      theta = space->evals;
+      theta.resize(U.size(), 0.0);
+    } else {
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("GCRODR: discarding incompatible preserved deflation space\n");
+      for (auto &vec : space->evecs)
+        if (vec) delete vec;
+      for (auto &vec : space->images)
+        if (vec) delete vec;
+    }
+
+    space->evecs.resize(0);
+    space->images.resize(0);
+    space->evals.resize(0);
+    delete space;
+    param.eig_param.preserve_deflation_space = nullptr;
+  }
+
+  void GCRODR::preserve()
+  {
+    if (U.size() > 0 && param.deflate && param.eig_param.preserve_deflation) {
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("GCRODR: preserving recycled subspace of size %lu\n", U.size());
+
+      if (param.eig_param.preserve_deflation_space) {
+        deflation_space *space = reinterpret_cast<deflation_space *>(param.eig_param.preserve_deflation_space);
+        // first ensure that any existing space is freed
+        for (auto &vec : space->evecs)
+          if (vec) delete vec;
+        for (auto &vec : space->images)
+          if (vec) delete vec;
+        delete space;
+      }
+
+      deflation_space *space = new deflation_space;
+      space->svd = false;
+      space->evecs = U;
+      space->images = C;
+      space->evals = theta;
+      param.eig_param.preserve_deflation_space = space;
+    } else {
+      for (auto v : U) delete v;
+      for (auto v : C) delete v;
+    }
+
+    U.resize(0);
+    C.resize(0);
+    theta.resize(0);
+  }
+
+  int GCRODR::refresh()
+  {
+    const int k = U.size();
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &tmp2 = *tmp2p;
+
+    // the image of the sum of the recycled vectors is the sum of the
+    // columns of C, which has norm sqrt(k) since C is orthonormal.
+    // The relative deviation from it is compared against the square
+    // root of the sloppy epsilon: rounding in the sloppy mat-vec is
+    // far below this, even for an ill-conditioned operator, while a
+    // change of the operator this small barely degrades the recycled
+    // subspace as a deflation space.
+    std::vector<ColorSpinorField *> u {V[0]}, Au {V[1]};
+    blas::zero(*V[0]);
+    blockCaxpy(DenseMatrix::Ones(k, 1), U, u);
+    matSloppy(*V[1], *V[0], tmp, tmp2);
+    blockCaxpy(-DenseMatrix::Ones(k, 1), C, Au);
+    const double deviation = sqrt(blas::norm2(*V[1]) / k);
+    const double tol = sqrt(precisionEpsilon(param.precision_sloppy));
+    int iter = 1;
+
+    if (deviation <= tol) return iter;
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("GCRODR: operator has changed (relative deviation %e > %e), recomputing the image of the recycled "
+                 "subspace\n",
+                 deviation, tol);
+
+    // C = A U, followed by C -> C R^{-1}, U -> U R^{-1} with C^dag C = R^dag R
+    for (int i = 0; i < k; i++) matSloppy(*C[i], *U[i], tmp, tmp2);
+    iter += k;
+
+    DenseMatrix G = blockDot(C, C);
+    Eigen::LLT<DenseMatrix> llt(0.5 * (G + G.adjoint()));
+    if (llt.info() != Eigen::Success) {
+      warningQuda("GCRODR: image of the recycled subspace is rank deficient, discarding it");
+      for (auto v : U) delete v;
+      for (auto v : C) delete v;
+      U.resize(0);
+      C.resize(0);
+      theta.resize(0);
+      return iter;
+    }
+
+    DenseMatrix Rinv = llt.matrixU().solve(DenseMatrix::Identity(k, k));
+
+    ColorSpinorParam csParam(*V[0]);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    while ((int)U_new.size() < k) U_new.push_back(ColorSpinorField::Create(csParam));
+    while ((int)C_new.size() < k) C_new.push_back(ColorSpinorField::Create(csParam));
+
+    std::vector<ColorSpinorField *> U_next(U_new.begin(), U_new.begin() + k);
+    std::vector<ColorSpinorField *> C_next(C_new.begin(), C_new.begin() + k);
+    for (int i = 0; i < k; i++) {
+      blas::zero(*U_next[i]);
+      blas::zero(*C_next[i]);
+    }
+    blockCaxpy(Rinv, U, U_next);
+    blockCaxpy(Rinv, C, C_next);
+
+    std::swap_ranges(U.begin(), U.end(), U_new.begin());
+    std::swap_ranges(C.begin(), C.end(), C_new.begin());
+
+    return iter;
+  }
+
+  int GCRODR::cycle(ColorSpinorField &e, ColorSpinorField &r, double b2, double stop, int max_iter, int iter)
+  {
+    const int k = U.size();
+    const int s_max = std::min(param.m - k, max_iter);
+    ColorSpinorField &tmp = *tmpp;
+    ColorSpinorField &tmp2 = *tmp2p;
+    std::vector<ColorSpinorField *> r_ {&r}, e_ {&e};
+
+    // project out the recycled subspace: since A U = C, e += U C^dag r and r -= C C^dag r
+    if (k > 0) {
+      DenseMatrix Cr = blockDot(C, r_);
+      blockCaxpy(Cr, U, e_);
+      blockCaxpy(-Cr, C, r_);
+    }
+
+    const double beta = sqrt(blas::norm2(r));
+    if (beta == 0.0) return 0; // the solution lies in the recycled subspace
+    blas::zero(*V[0]);
+    blas::axpy(1.0 / beta, r, *V[0]);
+
+    // Arnoldi process for (I - C C^dag) A:
+    // A [U V_s] = [C V_{s+1}] G with G = [[I, B], [0, H]]
+    DenseMatrix G = DenseMatrix::Zero(k + s_max + 1, k + s_max);
+    G.topLeftCorner(k, k) = DenseMatrix::Identity(k, k);
+    DenseMatrix g = DenseMatrix::Zero(k + s_max + 1, 1);
+    g(k, 0) = beta;
+    DenseMatrix y;
+
+    int s = 0;
+    bool breakdown = false;
+    while (s < s_max) {
+      matSloppy(*V[s + 1], *V[s], tmp, tmp2);
+
+      // classical Gram-Schmidt against [C V_s] with one reorthogonalization
+      std::vector<ColorSpinorField *> W(C);
+      W.insert(W.end(), V.begin(), V.begin() + s + 1);
+      std::vector<ColorSpinorField *> w {V[s + 1]};
+      for (int pass = 0; pass < 2; pass++) {
+        DenseMatrix h = blockDot(W, w);
+        blockCaxpy(-h, W, w);
+        G.block(0, k + s, k + s + 1, 1) += h;
+      }
+
+      const double norm = sqrt(blas::norm2(*V[s + 1]));
+      G(k + s + 1, k + s) = norm;
+      const double column_norm = G.col(k + s).norm();
+      s++;
+
+      // minimize the residual over the combined space
+      auto Gs = G.topLeftCorner(k + s + 1, k + s);
+      y = Gs.colPivHouseholderQr().solve(g.topRows(k + s + 1));
+      const double r2 = (g.topRows(k + s + 1) - Gs * y).squaredNorm();
+      PrintStats("GCRODR", iter + s, r2, b2, 0.0);
+
+      if (norm <= precisionEpsilon(param.precision_sloppy) * column_norm) {
+        breakdown = true;
+        break;
+      }
+      blas::ax(1.0 / norm, *V[s]);
+      if (convergence(r2, 0.0, stop, param.tol_hq)) break;
+    }
+
+    // e += [U V_s] y
+    std::vector<ColorSpinorField *> Vs(V.begin(), V.begin() + s);
+    std::vector<ColorSpinorField *> Vs1(V.begin(), V.begin() + s + 1);
+    blockCaxpy(y.topRows(k), U, e_);
+    blockCaxpy(y.bottomRows(s), Vs, e_);
+
+    // the Krylov space is invariant, so nothing more is to be gained from recycling it
+    if (breakdown) return s;
+
+    // update the recycled subspace from the harmonic Ritz vectors of
+    // the cycle, i.e., the solutions of G^dag G z = theta G^dag W^dag Z z
+    // with W = [C V_{s+1}], Z = [U D V_s] and D the inverse column norms of U
+    DenseMatrix Gs = G.topLeftCorner(k + s + 1, k + s);
+    DenseMatrix WZ = DenseMatrix::Zero(k + s + 1, k + s);
+    DenseMatrix D = DenseMatrix::Identity(k, k);
+    if (k > 0) {
+      std::vector<ColorSpinorField *> WU(C);
+      WU.insert(WU.end(), Vs1.begin(), Vs1.end());
+      WU.insert(WU.end(), U.begin(), U.end());
+      DenseMatrix M = blockDot(WU, U);
+      for (int i = 0; i < k; i++) D(i, i) = 1.0 / sqrt(M(k + s + 1 + i, i).real());
+      WZ.topLeftCorner(k + s + 1, k) = M.topRows(k + s + 1) * D;
+      Gs.topLeftCorner(k, k) = D;
+    }
+    WZ.block(k, k, s, s) = DenseMatrix::Identity(s, s);
+
+    // G^+ W^dag Z has eigenvalues 1 / theta, so we keep the largest
+    Eigen::ComplexEigenSolver<DenseMatrix> eigen(Gs.colPivHouseholderQr().solve(WZ));
+    std::vector<int> order(k + s);
+    for (int i = 0; i < k + s; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&eigen](int a, int b) {
+      return std::abs(eigen.eigenvalues()(a)) > std::abs(eigen.eigenvalues()(b));
+    });
+
+    const int k_new = std::min(param.n_ev, k + s);
+    DenseMatrix P(k + s, k_new);
+    std::vector<Complex> theta_new(k_new);
+    for (int i = 0; i < k_new; i++) {
+      P.col(i) = eigen.eigenvectors().col(order[i]);
+      const Complex mu = eigen.eigenvalues()(order[i]);
+      theta_new[i] = std::abs(mu) > 0.0 ? 1.0 / mu : std::numeric_limits<double>::infinity();
+    }
+
+    // G P = Q R, C <- W Q, U <- Z P R^{-1}
+    Eigen::HouseholderQR<DenseMatrix> qr(Gs * P);
+    DenseMatrix Q = qr.householderQ() * DenseMatrix::Identity(k + s + 1, k_new);
+    DenseMatrix R = qr.matrixQR().topRows(k_new).triangularView<Eigen::Upper>();
+    if (R.diagonal().cwiseAbs().minCoeff() == 0.0) {
+      warningQuda("GCRODR: harmonic Ritz vectors are rank deficient, keeping the recycled subspace");
+      return s;
+    }
+    DenseMatrix Rinv = R.triangularView<Eigen::Upper>().solve(DenseMatrix::Identity(k_new, k_new));
+    DenseMatrix PR = P * Rinv;
+
+    ColorSpinorParam csParam(*V[0]);
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+    while ((int)U_new.size() < k_new) U_new.push_back(ColorSpinorField::Create(csParam));
+    while ((int)C_new.size() < k_new) C_new.push_back(ColorSpinorField::Create(csParam));
+
+    std::vector<ColorSpinorField *> U_next(U_new.begin(), U_new.begin() + k_new);
+    std::vector<ColorSpinorField *> C_next(C_new.begin(), C_new.begin() + k_new);
+    for (int i = 0; i < k_new; i++) {
+      blas::zero(*U_next[i]);
+      blas::zero(*C_next[i]);
+    }
+    blockCaxpy(D * PR.topRows(k), U, U_next);
+    blockCaxpy(PR.bottomRows(s), Vs, U_next);
+    blockCaxpy(Q.topRows(k), C, C_next);
+    blockCaxpy(Q.bottomRows(s + 1), Vs1, C_next);
+
+    // the old recycled vectors become workspace
+    U_new.erase(U_new.begin(), U_new.begin() + k_new);
+    C_new.erase(C_new.begin(), C_new.begin() + k_new);
+    U_new.insert(U_new.end(), U.begin(), U.end());
+    C_new.insert(C_new.end(), C.begin(), C.end());
+    U = U_next;
+    C = C_next;
+    theta = theta_new;
+
+    return s;
+  }
+
+  void GCRODR::operator()(ColorSpinorField &x, ColorSpinorField &b)
+  {
+    profile.TPSTART(QUDA_PROFILE_INIT);
+
+    if (param.n_ev < 1 || param.m < param.n_ev + 2)
+      errorQuda("GCRODR requires 0 < n_ev=%d and n_ev + 2 <= max_search_dim=%d", param.n_ev, param.m);
+    if (param.residual_type & QUDA_HEAVY_QUARK_RESIDUAL) errorQuda("Heavy quark residual not supported by GCRODR");
+
+    const double b2 = blas::norm2(b);
+
+    // Check to see that we're not trying to invert on a zero-field source
+    if (b2 == 0) {
+      profile.TPSTOP(QUDA_PROFILE_INIT);
+      warningQuda("inverting on zero-field source\n");
+      x = b;
+      param.true_res = 0.0;
+      param.true_res_hq = 0.0;
+      return;
+    }
+
+    if (!init) {
+      ColorSpinorParam csParam(b);
+      csParam.create = QUDA_ZERO_FIELD_CREATE;
+      rp = ColorSpinorField::Create(csParam);
+      ep = ColorSpinorField::Create(csParam);
+
+      csParam.setPrecision(param.precision_sloppy);
+      r_sloppy = param.precision_sloppy != param.precision ? ColorSpinorField::Create(csParam) : rp;
+      tmpp = ColorSpinorField::Create(csParam);
+      // tmp2 only needed for multi-gpu Wilson-like kernels
+      tmp2p = !mat.isStaggered() ? ColorSpinorField::Create(csParam) : tmpp;
+      for (int i = 0; i < param.m + 1; i++) V.push_back(ColorSpinorField::Create(csParam));
+
+      init = true;
+    }
+
+    restore(b);
+
+    ColorSpinorField &r = *rp;
+    ColorSpinorField &rSloppy = *r_sloppy;
+    ColorSpinorField &e = *ep;
+
+    const double stop = stopping(param.tol, b2, param.residual_type); // stopping condition of solver
+
+    profile.TPSTOP(QUDA_PROFILE_INIT);
+    profile.TPSTART(QUDA_PROFILE_PREAMBLE);
+
+    mat(r, x);
+    double r2 = blas::xmyNorm(b, r);
+
+    profile.TPSTOP(QUDA_PROFILE_PREAMBLE);
+    profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    blas::flops = 0;
+
+    int total_iter = 0;
+    if (U.size() > 0) total_iter += refresh();
+
+    PrintStats("GCRODR", total_iter, r2, b2, 0.0);
+
+    int cycles = 0;
+    while (!convergence(r2, 0.0, stop, param.tol_hq) && total_iter < param.maxiter) {
+      if (cycles > 0) ReportEvent("GCRODR", QUDA_SOLVER_EVENT_RESTART, total_iter, r2, b2, 0.0, param.precision);
+
+      blas::copy(rSloppy, r); // nop when these alias
+      blas::zero(e);
+      const int iter = cycle(e, rSloppy, b2, stop, param.maxiter - total_iter, total_iter);
+      total_iter += iter;
+
+      // accumulate the correction and compute the true residual
+      blas::xpy(e, x);
+      mat(r, x);
+      r2 = blas::xmyNorm(b, r);
+      cycles++;
+      if (iter == 0) break;
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_COMPUTE);
+    profile.TPSTART(QUDA_PROFILE_EPILOGUE);
+
+    param.secs = profile.Last(QUDA_PROFILE_COMPUTE);
+    double gflops = (blas::flops + mat.flops() + matSloppy.flops()) * 1e-9;
+    param.gflops = gflops;
+    param.iter += total_iter;
+
+    if (total_iter >= param.maxiter) warningQuda("Exceeded maximum iterations %d", param.maxiter);
+
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("GCRODR: %d cycles, recycled subspace of size %lu\n", cycles, U.size());
+
+    param.true_res = sqrt(r2 / b2);
+    param.true_res_hq = sqrt(blas::HeavyQuarkResidualNorm(x, r).z);
+
+    PrintSummary("GCRODR", total_iter, r2, b2, stop, param.tol_hq);
+
+    // reset the flops counters
+    blas::flops = 0;
+    mat.flops();
+    matSloppy.flops();
+
+    profile.TPSTOP(QUDA_PROFILE_EPILOGUE);
+  }
+
+} // namespace quda
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <limits>
+
 #include <invert_quda.h>
 #include <blas_quda.h>
 #include <Eigen/Dense>
@@ -169,6 +172,200 @@ namespace quda {
     (*this)(x, b, p, q);
   }
 
+  void ChronoBasis::clear()
+  {
+    for (auto v : p)
+      if (v) delete v;
+    for (auto v : q)
+      if (v) delete v;
+    p.clear();
+    q.clear();
+    fresh.clear();
+    gram.clear();
+  }
+
+  void ChronoBasis::permute(const std::vector<int> &perm)
+  {
+    const int N = p.size();
+    const int n = perm.size();
+
+    std::vector<bool> kept(N, false);
+    for (auto i : perm)
+      if (i >= 0) kept[i] = true;
+    for (int i = 0; i < N; i++) {
+      if (kept[i]) continue;
+      delete p[i];
+      if (q[i]) delete q[i];
+    }
+
+    std::vector<ColorSpinorField *> p_(n, nullptr), q_(n, nullptr);
+    std::vector<bool> fresh_(n, false);
+    std::vector<Complex> gram_(n * n, 0.0);
+    for (int i = 0; i < n; i++) {
+      if (perm[i] < 0) continue;
+      p_[i] = p[perm[i]];
+      q_[i] = q[perm[i]];
+      fresh_[i] = fresh[perm[i]];
+      for (int j = 0; j < n; j++)
+        if (perm[j] >= 0) gram_[i * n + j] = gram[perm[i] * N + perm[j]];
+    }
+
+    p = std::move(p_);
+    q = std::move(q_);
+    fresh = std::move(fresh_);
+    gram = std::move(gram_);
+  }
+
+  void ChronoBasis::push(const ColorSpinorField &x, int max_dim, bool replace_last, QudaPrecision precision)
+  {
+    const int N = p.size();
+
+    if (!replace_last || N == 0) {
+      // move the oldest vector to the front to be overwritten if the
+      // basis is full, else add a new vector at the front
+      std::vector<int> perm(1, N < max_dim ? -1 : N - 1);
+      for (int i = 0; i < std::min(N, max_dim - 1); i++) perm.push_back(i);
+      permute(perm);
+    }
+
+    if (!p[0]) {
+      ColorSpinorParam param(x);
+      param.create = QUDA_NULL_FIELD_CREATE;
+      param.setPrecision(precision);
+      p[0] = ColorSpinorField::Create(param);
+    }
+    *p[0] = x;
+    fresh[0] = false;
+  }
+
+  void ChronoBasis::forecast(ColorSpinorField &x, ColorSpinorField &b, const DiracMatrix &mat, bool hermitian,
+                             uint64_t key, TimeProfile &profile)
+  {
+    using namespace Eigen;
+    typedef Matrix<Complex, Dynamic, Dynamic> matrix;
+    typedef Matrix<Complex, Dynamic, 1> vector;
+
+    bool running = profile.isRunning(QUDA_PROFILE_CHRONO);
+    if (!running) profile.TPSTART(QUDA_PROFILE_CHRONO);
+
+    const int N = p.size();
+    if (N == 0) {
+      blas::zero(x);
+      if (!running) profile.TPSTOP(QUDA_PROFILE_CHRONO);
+      return;
+    }
+
+    // the images and Gram matrix are only valid for the operator they were computed with
+    if (key != this->key || hermitian != this->hermitian) {
+      fresh.assign(N, false);
+      this->key = key;
+      this->hermitian = hermitian;
+    }
 
+    // apply the operator to the vectors added since the last forecast
+    std::vector<int> stale;
+    std::vector<ColorSpinorField *> p_stale, q_stale;
+    for (int i = 0; i < N; i++) {
+      if (fresh[i]) continue;
+      if (!q[i]) {
+        ColorSpinorParam param(*p[i]);
+        param.create = QUDA_NULL_FIELD_CREATE;
+        q[i] = ColorSpinorField::Create(param);
+      }
+      mat(*q[i], *p[i]);
+      stale.push_back(i);
+      p_stale.push_back(p[i]);
+      q_stale.push_back(q[i]);
+    }
+
+    // update the rows and columns of the Gram matrix of those vectors
+    const int M = stale.size();
+    if (M > 0) {
+      std::vector<Complex> col(N * M);
+      if (hermitian) {
+        std::vector<Complex> row(M * N);
+        blas::cDotProduct(col.data(), p, q_stale); // (p_i, q_j)
+        blas::cDotProduct(row.data(), p_stale, q); // (p_j, q_i)
+        for (int i = 0; i < N; i++) {
+          for (int k = 0; k < M; k++) {
+            gram[i * N + stale[k]] = col[i * M + k];
+            gram[stale[k] * N + i] = row[k * N + i];
+          }
+        }
+      } else {
+        blas::cDotProduct(col.data(), q, q_stale); // (q_i, q_j)
+        for (int i = 0; i < N; i++) {
+          for (int k = 0; k < M; k++) {
+            gram[i * N + stale[k]] = col[i * M + k];
+            gram[stale[k] * N + i] = conj(col[i * M + k]);
+          }
+        }
+      }
+      fresh.assign(N, true);
+    }
+
+    // rhs vector phi = P* b if Hermitian else Q* b
+    std::vector<Complex> phi(N);
+    std::vector<ColorSpinorField *> B {&b};
+    blas::cDotProduct(phi.data(), hermitian ? p : q, B);
+
+    profile.TPSTOP(QUDA_PROFILE_CHRONO);
+    profile.TPSTART(QUDA_PROFILE_EIGEN);
+
+    // Successive solutions are close to linearly dependent, so rather
+    // than orthogonalizing the basis we solve the Jacobi-scaled system
+    // with a pseudo-inverse that drops the directions at the level of
+    // the rounding of the basis
+    VectorXd d(N);
+    for (int i = 0; i < N; i++) d(i) = gram[i * N + i].real() > 0.0 ? 1.0 / sqrt(gram[i * N + i].real()) : 0.0;
+
+    matrix A(N, N);
+    vector rhs(N);
+    for (int i = 0; i < N; i++) {
+      rhs(i) = d(i) * phi[i];
+      for (int j = 0; j < N; j++) A(i, j) = 0.5 * d(i) * d(j) * (gram[i * N + j] + conj(gram[j * N + i]));
+    }
+
+    double epsilon;
+    switch (p[0]->Precision()) {
+    case QUDA_DOUBLE_PRECISION: epsilon = std::numeric_limits<double>::epsilon(); break;
+    case QUDA_SINGLE_PRECISION: epsilon = std::numeric_limits<float>::epsilon(); break;
+    case QUDA_HALF_PRECISION: epsilon = 1.0 / std::numeric_limits<short>::max(); break;
+    default: epsilon = 1.0 / std::numeric_limits<char>::max();
+    }
+
+    SelfAdjointEigenSolver<matrix> eigen(A);
+    const double cutoff = N * epsilon * eigen.eigenvalues().maxCoeff();
+    vector y = vector::Zero(N);
+    int rank = 0;
+    for (int k = 0; k < N; k++) {
+      if (eigen.eigenvalues()(k) <= cutoff) continue;
+      y += eigen.eigenvectors().col(k) * (eigen.eigenvectors().col(k).adjoint() * rhs)(0) / eigen.eigenvalues()(k);
+      rank++;
+    }
+
+    profile.TPSTOP(QUDA_PROFILE_EIGEN);
+    profile.TPSTART(QUDA_PROFILE_CHRONO);
+
+    std::vector<Complex> alpha(N);
+    for (int i = 0; i < N; i++) alpha[i] = d(i) * y(i);
+
+    double b2 = getVerbosity() >= QUDA_SUMMARIZE ? blas::norm2(b) : 0.0;
+
+    blas::zero(x);
+    std::vector<ColorSpinorField *> X {&x};
+    blas::caxpy(alpha.data(), p, X);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE) {
+      // compute the residual only if we're going to print it
+      for (int i = 0; i < N; i++) alpha[i] = -alpha[i];
+      blas::caxpy(alpha.data(), q, B);
+
+      double rsd = sqrt(blas::norm2(b) / b2);
+      printfQuda("ChronoBasis: N = %d (rank %d, %d new), |res| / |src| = %e\n", N, rank, M, rsd);
+    }
+
+    if (!running) profile.TPSTOP(QUDA_PROFILE_CHRONO);
+  }
 
 } // namespace quda
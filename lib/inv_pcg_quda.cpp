@@ -321,6 +321,7 @@ namespace quda
 
         copy(rSloppy, r); // copy r to rSloppy
         zero(xSloppy);
+        ReportEvent("PCG", QUDA_SOLVER_EVENT_RELIABLE_UPDATE, k, r2, b2, heavy_quark_res, param.precision);
 
         // break-out check if we have reached the limit of the precision
         if (sqrt(r2) > r0Norm && updateX) {
@@ -0,0 +1,330 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <quda_internal.h>
+#include <color_spinor_field.h>
+#include <gauge_field.h>
+#include <comm_quda.h>
+#include <content_hash.h>
+#include <mg_cache.h>
+
+namespace quda
+{
+
+  namespace mgcache
+  {
+
+    namespace
+    {
+
+      constexpr int32_t cache_version = 1;
+
+      enum RecordKind { RECORD_SPINOR = 1, RECORD_GAUGE = 2 };
+
+      struct FileHeader {
+        char magic[8];
+        int32_t version;
+        int32_t level;
+        int32_t rank;
+        int32_t n_rank;
+        uint64_t key;
+      };
+
+      /**
+         @brief Header of each record, followed by bytes + norm_bytes of raw data
+       */
+      struct RecordHeader {
+        int32_t kind;
+        int32_t precision;
+        int32_t location;
+        int32_t order;
+        int64_t bytes;
+        int64_t norm_bytes;
+        double scale;
+        uint64_t hash;
+      };
+
+      std::string cacheFilename(const std::string &path, uint64_t key, int level)
+      {
+        char name[64];
+        sprintf(name, "/mg_%016llx.%d.%d", (unsigned long long)key, level, comm_rank());
+        return path + name;
+      }
+
+      FileHeader fileHeader(uint64_t key, int level)
+      {
+        FileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "QUDAMGH ", 8);
+        header.version = cache_version;
+        header.level = level;
+        header.rank = comm_rank();
+        header.n_rank = comm_size();
+        header.key = key;
+        return header;
+      }
+
+      /**
+         @brief Return the number of separately allocated link arrays
+         of a host gauge field in QDP order
+       */
+      int siteDim(const GaugeField &field)
+      {
+        switch (field.Geometry()) {
+        case QUDA_SCALAR_GEOMETRY: return 1;
+        case QUDA_VECTOR_GEOMETRY: return field.Ndim();
+        case QUDA_TENSOR_GEOMETRY: return field.Ndim() * (field.Ndim() - 1) / 2;
+        case QUDA_COARSE_GEOMETRY: return 2 * field.Ndim();
+        default: errorQuda("Unknown geometry %d", field.Geometry());
+        }
+        return 0;
+      }
+
+      /**
+         @brief Copy the data of a gauge field to or from a contiguous host buffer
+       */
+      void copyGauge(GaugeField &field, char *buffer, bool to_field)
+      {
+        if (field.Location() == QUDA_CUDA_FIELD_LOCATION) {
+          if (to_field)
+            qudaMemcpy(field.Gauge_p(), buffer, field.Bytes(), cudaMemcpyHostToDevice);
+          else
+            qudaMemcpy(buffer, field.Gauge_p(), field.Bytes(), cudaMemcpyDeviceToHost);
+        } else if (field.Order() == QUDA_QDP_GAUGE_ORDER) {
+          const int n = siteDim(field);
+          const size_t bytes = field.Bytes() / n;
+          void **gauge = static_cast<void **>(field.Gauge_p());
+          for (int d = 0; d < n; d++) {
+            if (to_field)
+              memcpy(gauge[d], buffer + d * bytes, bytes);
+            else
+              memcpy(buffer + d * bytes, gauge[d], bytes);
+          }
+        } else {
+          if (to_field)
+            memcpy(field.Gauge_p(), buffer, field.Bytes());
+          else
+            memcpy(buffer, field.Gauge_p(), field.Bytes());
+        }
+      }
+
+      /**
+         @brief Copy the data and norm of a field to or from a contiguous host buffer
+       */
+      void copySpinor(ColorSpinorField &field, char *buffer, bool to_field)
+      {
+        const size_t bytes = field.Bytes();
+        const size_t norm_bytes = field.NormBytes();
+        if (field.Location() == QUDA_CUDA_FIELD_LOCATION) {
+          if (to_field) {
+            qudaMemcpy(field.V(), buffer, bytes, cudaMemcpyHostToDevice);
+            if (norm_bytes) qudaMemcpy(field.Norm(), buffer + bytes, norm_bytes, cudaMemcpyHostToDevice);
+          } else {
+            qudaMemcpy(buffer, field.V(), bytes, cudaMemcpyDeviceToHost);
+            if (norm_bytes) qudaMemcpy(buffer + bytes, field.Norm(), norm_bytes, cudaMemcpyDeviceToHost);
+          }
+        } else {
+          if (to_field) {
+            memcpy(field.V(), buffer, bytes);
+            if (norm_bytes) memcpy(field.Norm(), buffer + bytes, norm_bytes);
+          } else {
+            memcpy(buffer, field.V(), bytes);
+            if (norm_bytes) memcpy(buffer + bytes, field.Norm(), norm_bytes);
+          }
+        }
+      }
+
+    } // namespace
+
+    bool exists(const std::string &path, uint64_t key, int level)
+    {
+      const FileHeader expected = fileHeader(key, level);
+      FileHeader header;
+      bool found = false;
+
+      FILE *f = fopen(cacheFilename(path, key, level).c_str(), "rb");
+      if (f) {
+        found = fread(&header, sizeof(header), 1, f) == 1 && memcmp(&header, &expected, sizeof(header)) == 0;
+        fclose(f);
+      }
+
+      double all_found = found ? 1.0 : 0.0;
+      comm_allreduce_min(&all_found);
+      return all_found > 0.0;
+    }
+
+    Writer::Writer(const std::string &path, uint64_t key, int level) :
+      filename(cacheFilename(path, key, level)), tmp_filename(filename + ".tmp"), file(nullptr)
+    {
+      file = fopen(tmp_filename.c_str(), "wb");
+      if (!file) {
+        warningQuda("Unable to open %s, level %d of the multigrid hierarchy will not be cached", tmp_filename.c_str(),
+                    level);
+        return;
+      }
+      const FileHeader header = fileHeader(key, level);
+      write(&header, sizeof(header));
+    }
+
+    Writer::~Writer()
+    {
+      if (file) {
+        fclose(file);
+        remove(tmp_filename.c_str());
+      }
+    }
+
+    void Writer::write(const void *data, size_t bytes)
+    {
+      if (!file) return;
+      if (fwrite(data, bytes, 1, file) != 1) {
+        warningQuda("Unable to write %s, discarding the cached level", tmp_filename.c_str());
+        fclose(file);
+        remove(tmp_filename.c_str());
+        file = nullptr;
+      }
+    }
+
+    void Writer::write(const ColorSpinorField &field)
+    {
+      if (!file) return;
+      RecordHeader header;
+      memset(&header, 0, sizeof(header));
+      header.kind = RECORD_SPINOR;
+      header.precision = field.Precision();
+      header.location = field.Location();
+      header.order = field.FieldOrder();
+      header.bytes = field.Bytes();
+      header.norm_bytes = field.NormBytes();
+      header.scale = field.Scale();
+
+      buffer.resize(header.bytes + header.norm_bytes);
+      copySpinor(const_cast<ColorSpinorField &>(field), buffer.data(), false);
+      header.hash = xxhash64(buffer.data(), buffer.size());
+
+      write(&header, sizeof(header));
+      write(buffer.data(), buffer.size());
+    }
+
+    void Writer::write(const GaugeField &field)
+    {
+      if (!file) return;
+      RecordHeader header;
+      memset(&header, 0, sizeof(header));
+      header.kind = RECORD_GAUGE;
+      header.precision = field.Precision();
+      header.location = field.Location();
+      header.order = field.Order();
+      header.bytes = field.Bytes();
+      header.scale = field.Scale();
+
+      buffer.resize(header.bytes);
+      copyGauge(const_cast<GaugeField &>(field), buffer.data(), false);
+      header.hash = xxhash64(buffer.data(), buffer.size());
+
+      write(&header, sizeof(header));
+      write(buffer.data(), buffer.size());
+    }
+
+    void Writer::commit()
+    {
+      if (!file) return;
+      bool ok = fclose(file) == 0;
+      file = nullptr;
+      ok = ok && rename(tmp_filename.c_str(), filename.c_str()) == 0;
+      if (!ok) {
+        warningQuda("Unable to complete %s, discarding the cached level", filename.c_str());
+        remove(tmp_filename.c_str());
+      }
+      std::vector<char>().swap(buffer);
+    }
+
+    Reader::Reader(const std::string &path, uint64_t key, int level) :
+      filename(cacheFilename(path, key, level)), file(nullptr), good(false)
+    {
+      file = fopen(filename.c_str(), "rb");
+      if (!file) {
+        warningQuda("Unable to open multigrid hierarchy cache file %s", filename.c_str());
+        return;
+      }
+      good = true;
+      FileHeader header;
+      const FileHeader expected = fileHeader(key, level);
+      if (read(&header, sizeof(header)) && memcmp(&header, &expected, sizeof(header)) != 0) {
+        warningQuda("%s is not level %d of hierarchy %016llx", filename.c_str(), level, (unsigned long long)key);
+        good = false;
+      }
+    }
+
+    Reader::~Reader()
+    {
+      if (file) fclose(file);
+    }
+
+    bool Reader::read(void *data, size_t bytes)
+    {
+      if (good && fread(data, bytes, 1, file) != 1) {
+        warningQuda("Unable to read multigrid hierarchy cache file %s", filename.c_str());
+        good = false;
+      }
+      return good;
+    }
+
+    bool Reader::agree(bool ok)
+    {
+      double all_ok = ok ? 1.0 : 0.0;
+      comm_allreduce_min(&all_ok);
+      if (all_ok == 0.0) good = false; // the records that follow are not used
+      return all_ok > 0.0;
+    }
+
+    bool Reader::read(ColorSpinorField &field)
+    {
+      RecordHeader header;
+      if (read(&header, sizeof(header))
+          && (header.kind != RECORD_SPINOR || header.precision != field.Precision()
+              || header.location != field.Location() || header.order != field.FieldOrder()
+              || header.bytes != static_cast<int64_t>(field.Bytes())
+              || header.norm_bytes != static_cast<int64_t>(field.NormBytes()))) {
+        warningQuda("Record in %s does not match the field being loaded", filename.c_str());
+        good = false;
+      }
+
+      if (good) buffer.resize(header.bytes + header.norm_bytes);
+      if (read(buffer.data(), buffer.size()) && xxhash64(buffer.data(), buffer.size()) != header.hash) {
+        warningQuda("Checksum of %s failed", filename.c_str());
+        good = false;
+      }
+      if (!agree(good)) return false;
+
+      copySpinor(field, buffer.data(), true);
+      field.Scale(header.scale);
+      return true;
+    }
+
+    bool Reader::read(GaugeField &field)
+    {
+      RecordHeader header;
+      if (read(&header, sizeof(header))
+          && (header.kind != RECORD_GAUGE || header.precision != field.Precision()
+              || header.location != field.Location() || header.order != field.Order()
+              || header.bytes != static_cast<int64_t>(field.Bytes()))) {
+        warningQuda("Record in %s does not match the gauge field being loaded", filename.c_str());
+        good = false;
+      }
+
+      if (good) buffer.resize(header.bytes);
+      if (read(buffer.data(), buffer.size()) && xxhash64(buffer.data(), buffer.size()) != header.hash) {
+        warningQuda("Checksum of %s failed", filename.c_str());
+        good = false;
+      }
+      if (!agree(good)) return false;
+
+      copyGauge(field, buffer.data(), true);
+      field.Scale(header.scale);
+      return true;
+    }
+
+  } // namespace mgcache
+
+} // namespace quda
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <mg_profile.h>
+
+namespace quda
+{
+
+  MGRegion::MGRegion()
+  {
+    if (mgprofile::enabled()) qudaDeviceSynchronize();
+    timer.Start(__func__, __FILE__, __LINE__);
+  }
+
+  double MGRegion::stop()
+  {
+    if (mgprofile::enabled()) qudaDeviceSynchronize();
+    timer.Stop(__func__, __FILE__, __LINE__);
+    return timer.last;
+  }
+
+  void MGRegion::stop(MGCounter &counter, double flops, double bytes)
+  {
+    const double time = stop();
+    if (!mgprofile::recording()) return;
+    counter.time += time;
+    counter.calls++;
+    counter.flops += flops;
+    counter.bytes += bytes;
+  }
+
+  namespace mgprofile
+  {
+
+    namespace
+    {
+
+      int setup_depth = 0;
+
+      void rate(char *str, double amount, double time)
+      {
+        if (amount > 0.0 && time > 0.0)
+          sprintf(str, "%.2f", 1e-9 * amount / time);
+        else
+          strcpy(str, "-");
+      }
+
+      void printComponent(int indent, const std::string &name, const MGCounter &c)
+      {
+        char gflops[32], gbytes[32], intensity[32] = "-";
+        rate(gflops, c.flops, c.time);
+        rate(gbytes, c.bytes, c.time);
+        if (c.flops > 0.0 && c.bytes > 0.0) sprintf(intensity, "%.3f", c.flops / c.bytes);
+        printfQuda("%*s%-14s %10ld %12.6f %10s %10s %10s\n", indent, "", name.c_str(), c.calls, c.time, gflops, gbytes,
+                   intensity);
+      }
+
+      void printLevel(const MGLevelProfile &l)
+      {
+        const int indent = 2 * l.level;
+        const MGCycleStats &s = l.stats;
+        if (l.cycle.empty()) {
+          printfQuda("%*sLevel %d (bottom): %ld solves in %.6f s\n", indent, "", l.level, s.cycles, s.time);
+        } else {
+          char coarse_iter[128] = "";
+          if (s.coarse_iter > 0)
+            sprintf(coarse_iter, ", %.1f iterations per coarse solve, tolerance %.2e to %.2e",
+                    static_cast<double>(s.coarse_iter) / s.coarse_solves, s.coarse_tol_min, s.coarse_tol_max);
+          printfQuda("%*sLevel %d (%s-cycle): %ld cycles in %.6f s, %ld coarse solves in %.6f s%s\n", indent, "",
+                     l.level, l.cycle.c_str(), s.cycles, s.time, s.coarse_solves, s.coarse_time, coarse_iter);
+        }
+        printfQuda("%*s%-14s %10s %12s %10s %10s %10s\n", indent + 2, "", "component", "calls", "time (s)", "GFLOPS",
+                   "GB/s", "flop/byte");
+        for (auto &c : l.components) printComponent(indent + 2, c.first, c.second);
+      }
+
+      void writeCounter(FILE *f, const std::string &name, const MGCounter &c, bool last)
+      {
+        fprintf(f, "        {\"name\": \"%s\", \"calls\": %ld, \"time\": %e, \"flops\": %e, \"bytes\": %e, ", name.c_str(),
+                c.calls, c.time, c.flops, c.bytes);
+        fprintf(f, "\"gflops\": %e, \"gbytes\": %e, \"intensity\": %e}%s\n", c.time > 0.0 ? 1e-9 * c.flops / c.time : 0.0,
+                c.time > 0.0 ? 1e-9 * c.bytes / c.time : 0.0, c.bytes > 0.0 ? c.flops / c.bytes : 0.0, last ? "" : ",");
+      }
+
+      void writeJSON(const std::vector<MGLevelProfile> &levels)
+      {
+        static int count = 0;
+        const int n = count++;
+
+        const char *path = getenv("QUDA_RESOURCE_PATH");
+        struct stat pstat;
+        if (!path || stat(path, &pstat) || !S_ISDIR(pstat.st_mode)) {
+          warningQuda("QUDA_RESOURCE_PATH is not set or is not a directory, the multigrid profile will not be exported");
+          return;
+        }
+        if (comm_rank() != 0) return;
+
+        std::string filename = std::string(path) + "/mg_profile_" + std::to_string(n) + ".json";
+        FILE *f = fopen(filename.c_str(), "w");
+        if (!f) {
+          warningQuda("Unable to open %s, the multigrid profile will not be exported", filename.c_str());
+          return;
+        }
+
+        fprintf(f, "{\n  \"processes\": %d,\n  \"levels\": [\n", comm_size());
+        for (size_t i = 0; i < levels.size(); i++) {
+          const MGLevelProfile &l = levels[i];
+          const MGCycleStats &s = l.stats;
+          fprintf(f, "    {\n      \"level\": %d,\n      \"cycle\": \"%s\",\n", l.level, l.cycle.c_str());
+          fprintf(f, "      \"cycles\": %ld,\n      \"time\": %e,\n", s.cycles, s.time);
+          fprintf(f, "      \"coarse_solves\": %ld,\n      \"coarse_iter\": %ld,\n      \"coarse_time\": %e,\n",
+                  s.coarse_solves, s.coarse_iter, s.coarse_time);
+          fprintf(f, "      \"components\": [\n");
+          for (size_t j = 0; j < l.components.size(); j++)
+            writeCounter(f, l.components[j].first, l.components[j].second, j == l.components.size() - 1);
+          fprintf(f, "      ]\n    }%s\n", i == levels.size() - 1 ? "" : ",");
+        }
+        fprintf(f, "  ]\n}\n");
+
+        if (fclose(f) != 0)
+          warningQuda("Unable to write %s", filename.c_str());
+        else if (getVerbosity() >= QUDA_SUMMARIZE)
+          printfQuda("Multigrid profile written to %s\n", filename.c_str());
+      }
+
+    } // namespace
+
+    bool enabled()
+    {
+      static int enable = -1;
+      if (enable < 0) {
+        char *enable_env = getenv("QUDA_ENABLE_MG_PROFILE");
+        enable = (enable_env && strcmp(enable_env, "1") == 0) ? 1 : 0;
+      }
+      return enable;
+    }
+
+    bool recording() { return setup_depth == 0; }
+
+    SetupScope::SetupScope() { setup_depth++; }
+
+    SetupScope::~SetupScope() { setup_depth--; }
+
+    void report(const std::vector<MGLevelProfile> &levels)
+    {
+      // reduce over processes: flops and bytes are summed, times are the maximum
+      std::vector<MGLevelProfile> global(levels);
+      std::vector<double> sum, max;
+      for (auto &l : global) {
+        max.push_back(l.stats.time);
+        max.push_back(l.stats.coarse_time);
+        for (auto &c : l.components) {
+          max.push_back(c.second.time);
+          sum.push_back(c.second.flops);
+          sum.push_back(c.second.bytes);
+        }
+      }
+      comm_allreduce_array(sum.data(), sum.size());
+      comm_allreduce_max_array(max.data(), max.size());
+
+      auto s = sum.begin();
+      auto m = max.begin();
+      for (auto &l : global) {
+        l.stats.time = *m++;
+        l.stats.coarse_time = *m++;
+        for (auto &c : l.components) {
+          c.second.time = *m++;
+          c.second.flops = *s++;
+          c.second.bytes = *s++;
+        }
+      }
+
+      printfQuda("Multigrid profile on %d processes (%s timing):\n", comm_size(),
+                 enabled() ? "synchronized" : "unsynchronized");
+      for (auto &l : global) printLevel(l);
+
+      if (enabled()) writeJSON(global);
+    }
+
+  } // namespace mgprofile
+
+} // namespace quda
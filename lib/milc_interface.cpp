@@ -1767,6 +1767,8 @@ void milcSetMultigridParam(milcMultigridPack *mg_pack, QudaPrecision host_precis
     mg_param.spin_block_size[i] = 1;
     // change this to refresh fields when mass or links change
     mg_param.setup_maxiter_refresh[i] = 0; // setup_maxiter_refresh[i];
+    mg_param.setup_refresh_tol[i] = 0.0;   // always rebuild on refresh
+    mg_param.setup_block_size[i] = 0;      // relax all null-space vectors together
     mg_param.n_vec[i] = (i == 0) ? 24 : input_struct.nvec[i];
     mg_param.n_block_ortho[i] = 2; // n_block_ortho[i];                    // number of times to Gram-Schmidt
     mg_param.precision_null[i]
@@ -1782,6 +1784,7 @@ void milcSetMultigridParam(milcMultigridPack *mg_pack, QudaPrecision host_precis
     // set the coarse solver wrappers including bottom solver
     mg_param.coarse_solver[i] = input_struct.coarse_solver[i];
     mg_param.coarse_solver_tol[i] = input_struct.coarse_solver_tol[i];
+    mg_param.coarse_solver_tol_max[i] = 0.0; // fixed coarse solver tolerance
     mg_param.coarse_solver_maxiter[i] = input_struct.coarse_solver_maxiter[i];
 
     // Basis to use for CA-CGN(E/R) coarse solver
@@ -1916,6 +1919,7 @@ void milcSetMultigridParam(milcMultigridPack *mg_pack, QudaPrecision host_precis
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
   }
+  strcpy(mg_param.hierarchy_cache, "");
 
   mg_param.coarse_guess = QUDA_BOOLEAN_FALSE; // mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -1,7 +1,9 @@
 #include <cstring>
+#include <algorithm>
 
 #include <multigrid.h>
 #include <vector_io.h>
+#include <mg_cache.h>
 
 namespace quda
 {
@@ -31,6 +33,9 @@ namespace quda
     x_coarse(nullptr),
     tmp_coarse(nullptr),
     tmp2_coarse(nullptr),
+    e_coarse(nullptr),
+    outer_reduction(1.0),
+    cycle_stats(),
     diracResidual(param.matResidual->Expose()),
     diracSmoother(param.matSmooth->Expose()),
     diracSmootherSloppy(param.matSmoothSloppy->Expose()),
@@ -40,10 +45,13 @@ namespace quda
     matCoarseResidual(nullptr),
     matCoarseSmoother(nullptr),
     matCoarseSmootherSloppy(nullptr),
-    rng(nullptr)
+    rng(nullptr),
+    cache_reader(nullptr),
+    cache_loaded(false)
   {
     sprintf(prefix, "MG level %d (%s): ", param.level, param.location == QUDA_CUDA_FIELD_LOCATION ? "GPU" : "CPU");
     pushLevel(param.level);
+    mgprofile::SetupScope setup_scope;
 
     if (param.level >= QUDA_MAX_MG_LEVEL)
       errorQuda("Level=%d is greater than limit of multigrid recursion depth", param.level);
@@ -76,7 +84,15 @@ namespace quda
     rng = new RNG(*param.B[0], 1234);
     rng->Init();
 
-    if (param.level != 0 || !param.is_staggered) {
+    // the top level of a staggered build has no null-space vectors to cache
+    const bool cacheable = param.cache_key && (param.level != 0 || !param.is_staggered) && param.level < param.Nlevel - 1;
+    if (param.cache_key && param.level == 0 && param.is_staggered) cache_loaded = param.cache_load;
+
+    bool cached = cacheable && param.cache_load && openCache();
+    for (int i = 0; cached && i < (int)param.B.size(); i++) cached = cache_reader->read(*param.B[i]);
+    if (cache_reader && !cached) dropCache();
+
+    if (!cached && (param.level != 0 || !param.is_staggered)) {
       if (param.level < param.Nlevel - 1) {
         if (param.mg_global.compute_null_vector == QUDA_COMPUTE_NULL_VECTOR_YES) {
           if (param.mg_global.generate_all_levels == QUDA_BOOLEAN_TRUE || param.level == 0) {
@@ -112,11 +128,15 @@ namespace quda
     // in case of iterative setup with MG the coarse level may be already built
     if (!transfer) reset();
 
+    // a level that was not loaded completely is saved, replacing what was in the cache
+    if (cacheable && !cache_loaded) saveCache();
+
     popLevel(param.level);
   }
 
   void MG::reset(bool refresh) {
     pushLevel(param.level);
+    mgprofile::SetupScope setup_scope;
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("%s level %d\n", transfer ? "Resetting" : "Creating", param.level);
 
@@ -128,11 +148,18 @@ namespace quda
     diracSmoother = param.matSmooth->Expose();
     diracSmootherSloppy = param.matSmoothSloppy->Expose();
 
+    // timers and decisions of a refresh, which are reported at the end
+    Timer relax_timer, transfer_timer, coarse_op_timer;
+    double change = 0.0, deviation = 0.0;
+    bool keep_transfer = false, keep_coarse_op = false;
+
     // Check if we're on the top level of a staggered MG build.
     if (param.level != 0 || !param.is_staggered) {
-      // Refresh the null-space vectors if we need to
+      // Refresh the null-space vectors if we need to, starting from the current ones
       if (refresh && param.level < param.Nlevel - 1) {
+        relax_timer.Start(__func__, __FILE__, __LINE__);
         if (param.mg_global.setup_maxiter_refresh[param.level]) generateNullVectors(param.B, refresh);
+        relax_timer.Stop(__func__, __FILE__, __LINE__);
       }
     }
 
@@ -142,15 +169,53 @@ namespace quda
       if (transfer) {
         // restoring FULL parity in Transfer changed at the end of this procedure
         transfer->setSiteSubset(QUDA_FULL_SITE_SUBSET, QUDA_INVALID_PARITY);
-        if (resetTransfer || refresh) {
+
+        // an incremental refresh keeps the prolongator if the refreshed null space is still in its range,
+        // and then also the coarse operator if it still matches the Galerkin product with the new fine operator
+        const double refresh_tol = param.mg_global.setup_refresh_tol[param.level];
+        if (refresh && !resetTransfer && refresh_tol > 0.0) {
+          transfer_timer.Start(__func__, __FILE__, __LINE__);
+          if (param.level != 0 || !param.is_staggered) change = prolongatorChange();
+          keep_transfer = change < refresh_tol;
+          transfer_timer.Stop(__func__, __FILE__, __LINE__);
+
+          if (keep_transfer) {
+            coarse_op_timer.Start(__func__, __FILE__, __LINE__);
+            ColorSpinorParam csParam(*r);
+            csParam.create = QUDA_NULL_FIELD_CREATE;
+            ColorSpinorField *tmp1 = ColorSpinorField::Create(csParam);
+            ColorSpinorField *tmp2 = ColorSpinorField::Create(csParam);
+            deviation = coarseOperatorDeviation(*tmp_coarse, *tmp1, *tmp2, refresh_tol);
+            keep_coarse_op = deviation < refresh_tol;
+            delete tmp2;
+            delete tmp1;
+            coarse_op_timer.Stop(__func__, __FILE__, __LINE__);
+          }
+        }
+
+        if (resetTransfer || (refresh && !keep_transfer)) {
+          if (refresh) transfer_timer.Start(__func__, __FILE__, __LINE__);
           transfer->reset();
           resetTransfer = false;
+          if (refresh) transfer_timer.Stop(__func__, __FILE__, __LINE__);
         }
       } else {
         // create transfer operator
         if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating transfer operator\n");
         transfer = new Transfer(param.B, param.Nvec, param.NblockOrtho, param.geoBlockSize, param.spinBlockSize,
-                                param.mg_global.precision_null[param.level], profile);
+                                param.mg_global.precision_null[param.level], profile, !cache_reader);
+        if (cache_reader) {
+          ColorSpinorParam csParam(transfer->Vectors());
+          csParam.create = QUDA_NULL_FIELD_CREATE;
+          ColorSpinorField *V = ColorSpinorField::Create(csParam);
+          if (cache_reader->read(*V)) {
+            transfer->setVectors(*V);
+          } else {
+            dropCache();
+            transfer->reset();
+          }
+          delete V;
+        }
         for (int i=0; i<QUDA_MAX_MG_LEVEL; i++) param.mg_global.geo_block_size[param.level][i] = param.geoBlockSize[i];
 
         // create coarse temporary vector if not already created in verify()
@@ -168,6 +233,11 @@ namespace quda
           r_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, r->Precision(),
                                               param.mg_global.location[param.level + 1]);
 
+        // create the second coarse correction of a W-cycle
+        if (!e_coarse && param.cycle_type == QUDA_MG_CYCLE_WCYCLE && param.level < param.Nlevel - 2)
+          e_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, r->Precision(),
+                                              param.mg_global.location[param.level + 1]);
+
         // create coarse solution vector if not already created in verify()
         if (!x_coarse)
           x_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, r->Precision(),
@@ -197,7 +267,19 @@ namespace quda
       // (only if using managed memory and prefetching is enabled, otherwise no-op)
       for (int i = 0; i < param.Nvec; i++) { param.B[i]->prefetch(QUDA_CPU_FIELD_LOCATION); }
 
-      createCoarseDirac();
+      if (!keep_coarse_op) {
+        if (refresh) coarse_op_timer.Start(__func__, __FILE__, __LINE__);
+        createCoarseDirac();
+        if (refresh) coarse_op_timer.Stop(__func__, __FILE__, __LINE__);
+      }
+    }
+
+    if (refresh && param.level < param.Nlevel - 1 && getVerbosity() >= QUDA_SUMMARIZE) {
+      printfQuda("Refresh: null space %.3f s, prolongator %s (change %.2e) %.3f s, coarse operator %s (deviation "
+                 "%.2e) %.3f s\n",
+                 relax_timer.time, keep_transfer ? "kept" : "rebuilt", change, transfer_timer.time,
+                 keep_coarse_op ? "kept" : "rebuilt", deviation, coarse_op_timer.time);
+      if (keep_coarse_op) printfQuda("Refresh: coarser levels are unchanged\n");
     }
 
     // delay allocating smoother until after coarse-links have been created
@@ -215,7 +297,8 @@ namespace quda
         coarse->param.matResidual = matCoarseResidual;
         coarse->param.matSmooth = matCoarseSmoother;
         coarse->param.matSmoothSloppy = matCoarseSmootherSloppy;
-        coarse->reset(refresh);
+        // the coarser levels only change if the coarse operator did
+        if (!keep_coarse_op) coarse->reset(refresh);
       } else {
         // create the next multigrid level
         param_coarse = new MGParam(param, *B_coarse, matCoarseResidual, matCoarseSmoother, matCoarseSmootherSloppy,
@@ -223,6 +306,7 @@ namespace quda
         param_coarse->fine = this;
         param_coarse->delta = 1e-20;
         param_coarse->precision = param.mg_global.invert_param->cuda_prec_precondition;
+        param_coarse->cache_load = cache_loaded;
 
         coarse = new MG(*param_coarse, profile_global);
       }
@@ -381,9 +465,30 @@ namespace quda
     diracParam.halo_precision = param.mg_global.precision_null[param.level];
 
     // use even-odd preconditioning for the coarse grid solver
+    const bool gpu_setup = param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false;
+    const bool mapped = param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false;
     if (diracCoarseResidual) delete diracCoarseResidual;
-    diracCoarseResidual = new DiracCoarse(diracParam, param.setup_location == QUDA_CUDA_FIELD_LOCATION ? true : false,
-                                          param.mg_global.setup_minimize_memory == QUDA_BOOLEAN_TRUE ? true : false);
+    diracCoarseResidual = new DiracCoarse(diracParam, gpu_setup, mapped, !cache_reader);
+
+    if (cache_reader) {
+      // this completes the level, so the cache file can be closed
+      std::vector<GaugeField *> fields = static_cast<DiracCoarse *>(diracCoarseResidual)->CoarseFields();
+      bool loaded = true;
+      for (auto field : fields)
+        if (loaded) loaded = cache_reader->read(*field);
+
+      if (loaded) {
+        fields[0]->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+        fields[3]->exchangeGhost(QUDA_LINK_BIDIRECTIONAL);
+        delete cache_reader;
+        cache_reader = nullptr;
+        cache_loaded = true;
+      } else {
+        dropCache();
+        delete diracCoarseResidual;
+        diracCoarseResidual = new DiracCoarse(diracParam, gpu_setup, mapped);
+      }
+    }
 
     // create smoothing operators
     diracParam.dirac = const_cast<Dirac*>(param.matSmooth->Expose());
@@ -429,7 +534,8 @@ namespace quda
   void MG::destroyCoarseSolver() {
     pushLevel(param.level);
 
-    if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE && param.level < param.Nlevel-2) {
+    if ((param.cycle_type == QUDA_MG_CYCLE_VCYCLE || param.cycle_type == QUDA_MG_CYCLE_WCYCLE)
+        && param.level < param.Nlevel - 2) {
       // nothing to do
     } else if (param.cycle_type == QUDA_MG_CYCLE_RECURSIVE || param.level == param.Nlevel-2) {
       if (coarse_solver) {
@@ -460,7 +566,8 @@ namespace quda
 
     if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Creating coarse solver wrapper\n");
     destroyCoarseSolver();
-    if (param.cycle_type == QUDA_MG_CYCLE_VCYCLE && param.level < param.Nlevel-2) {
+    if ((param.cycle_type == QUDA_MG_CYCLE_VCYCLE || param.cycle_type == QUDA_MG_CYCLE_WCYCLE)
+        && param.level < param.Nlevel - 2) {
       // if coarse solver is not a bottom solver and on the second to bottom level then we can just use the coarse solver as is
       coarse_solver = coarse;
       if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Assigned coarse solver to coarse MG operator\n");
@@ -601,9 +708,11 @@ namespace quda
   {
     pushLevel(param.level);
 
+    if (cache_reader) delete cache_reader;
+
     if (param.level < param.Nlevel - 1) {
       if (coarse) delete coarse;
-      if (param.level == param.Nlevel-1 || param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
+      if (param.level == param.Nlevel - 2 || param.cycle_type == QUDA_MG_CYCLE_RECURSIVE) {
 	if (coarse_solver) delete coarse_solver;
 	if (param_coarse_solver) delete param_coarse_solver;
       }
@@ -639,6 +748,7 @@ namespace quda
     if (x_coarse) delete x_coarse;
     if (tmp_coarse) delete tmp_coarse;
     if (tmp2_coarse) delete tmp2_coarse;
+    if (e_coarse) delete e_coarse;
 
     if (param_coarse) delete param_coarse;
 
@@ -675,12 +785,104 @@ namespace quda
     return flops;
   }
 
+  double MG::coarseOperatorDeviation(ColorSpinorField &eta, ColorSpinorField &tmp1, ColorSpinorField &tmp2, double tol)
+  {
+    zero(eta);
+    zero(*r_coarse);
+
+    spinorNoise(eta, *rng, QUDA_NOISE_UNIFORM);
+    transfer->P(tmp1, eta);
+
+    if (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE) {
+      double kappa = diracResidual->Kappa();
+      double mass = diracResidual->Mass();
+      if (param.level==0) {
+        if (tmp1.Nspin() == 4) {
+          diracSmoother->DslashXpay(tmp2.Even(), tmp1.Odd(), QUDA_EVEN_PARITY, tmp1.Even(), -kappa);
+          diracSmoother->DslashXpay(tmp2.Odd(), tmp1.Even(), QUDA_ODD_PARITY, tmp1.Odd(), -kappa);
+        } else if (tmp1.Nspin() == 2) { // if the coarse op is on top
+          diracSmoother->DslashXpay(tmp2.Even(), tmp1.Odd(), QUDA_EVEN_PARITY, tmp1.Even(), 1.0);
+          diracSmoother->DslashXpay(tmp2.Odd(), tmp1.Even(), QUDA_ODD_PARITY, tmp1.Odd(), 1.0);
+        } else { // staggered
+          diracSmoother->DslashXpay(tmp2.Even(), tmp1.Odd(), QUDA_EVEN_PARITY, tmp1.Even(),
+                                    2.0 * mass); // stag convention
+          diracSmoother->DslashXpay(tmp2.Odd(), tmp1.Even(), QUDA_ODD_PARITY, tmp1.Odd(),
+                                    2.0 * mass); // stag convention
+        }
+      } else { // this is a hack since the coarse Dslash doesn't properly use the same xpay conventions yet
+        diracSmoother->DslashXpay(tmp2.Even(), tmp1.Odd(), QUDA_EVEN_PARITY, tmp1.Even(), 1.0);
+        diracSmoother->DslashXpay(tmp2.Odd(), tmp1.Even(), QUDA_ODD_PARITY, tmp1.Odd(), 1.0);
+      }
+    } else {
+      (*param.matResidual)(tmp2,tmp1);
+    }
+
+    transfer->R(*x_coarse, tmp2);
+    static_cast<DiracCoarse *>(diracCoarseResidual)->M(*r_coarse, eta);
+
+#if 0 // enable to print out emulated and actual coarse-grid operator vectors for debugging
+    setOutputPrefix("");
+
+    for (int i=0; i<comm_rank(); i++) { // this ensures that we print each rank in order
+      if (i==comm_rank()) {
+        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("emulated\n");
+        for (int x=0; x<x_coarse->Volume(); x++) tmp1.PrintVector(x);
+
+        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("actual\n");
+        for (int x=0; x<r_coarse->Volume(); x++) tmp2.PrintVector(x);
+      }
+      comm_barrier();
+    }
+    setOutputPrefix(prefix);
+#endif
+
+    double r_nrm = norm2(*r_coarse);
+    double deviation = sqrt(xmyNorm(*x_coarse, *r_coarse) / norm2(*x_coarse));
+
+    if (diracResidual->Mu() != 0.0) {
+      // When the mu is shifted on the coarse level; we can compute exactly the error we introduce in the check:
+      //  it is given by 2*kappa*delta_mu || eta ||; where eta is the random vector generated for the test
+      double delta_factor = param.mg_global.mu_factor[param.level+1] - param.mg_global.mu_factor[param.level];
+      if(fabs(delta_factor) > tol ) {
+        double delta_a
+          = delta_factor * 2.0 * diracResidual->Kappa() * diracResidual->Mu() * transfer->Vectors().TwistFlavor();
+        deviation -= fabs(delta_a) * sqrt(norm2(eta) / norm2(*x_coarse));
+        deviation = fabs(deviation);
+      }
+    }
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("L2 norms: Emulated = %e, Native = %e, relative deviation = %e\n", norm2(*x_coarse), r_nrm, deviation);
+
+    return deviation;
+  }
+
+  double MG::prolongatorChange()
+  {
+    ColorSpinorParam csParam(*r);
+    csParam.create = QUDA_NULL_FIELD_CREATE;
+    ColorSpinorField *tmp1 = ColorSpinorField::Create(csParam);
+    ColorSpinorField *tmp2 = ColorSpinorField::Create(csParam);
+
+    double change = 0.0;
+    for (int i = 0; i < param.Nvec; i++) {
+      *tmp1 = *param.B[i];
+      transfer->R(*r_coarse, *tmp1);
+      transfer->P(*tmp2, *r_coarse);
+      change = std::max(change, sqrt(xmyNorm(*tmp1, *tmp2) / norm2(*tmp1)));
+    }
+
+    delete tmp2;
+    delete tmp1;
+    return change;
+  }
+
   /**
      Verification that the constructed multigrid operator is valid
   */
   void MG::verify(bool recursively)
   {
     pushLevel(param.level);
+    mgprofile::SetupScope setup_scope;
 
     // temporary fields used for verification
     ColorSpinorParam csParam(*r);
@@ -803,71 +1005,7 @@ namespace quda
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Checking 0 = (D_c - P^\\dagger D P) (native coarse operator to emulated operator)\n");
 
     ColorSpinorField *tmp_coarse = param.B[0]->CreateCoarse(param.geoBlockSize, param.spinBlockSize, param.Nvec, r->Precision(), param.mg_global.location[param.level+1]);
-    zero(*tmp_coarse);
-    zero(*r_coarse);
-
-    spinorNoise(*tmp_coarse, *rng, QUDA_NOISE_UNIFORM);
-    transfer->P(*tmp1, *tmp_coarse);
-
-    if (param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION && param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE) {
-      double kappa = diracResidual->Kappa();
-      double mass = diracResidual->Mass();
-      if (param.level==0) {
-        if (tmp1->Nspin() == 4) {
-          diracSmoother->DslashXpay(tmp2->Even(), tmp1->Odd(), QUDA_EVEN_PARITY, tmp1->Even(), -kappa);
-          diracSmoother->DslashXpay(tmp2->Odd(), tmp1->Even(), QUDA_ODD_PARITY, tmp1->Odd(), -kappa);
-        } else if (tmp1->Nspin() == 2) { // if the coarse op is on top
-          diracSmoother->DslashXpay(tmp2->Even(), tmp1->Odd(), QUDA_EVEN_PARITY, tmp1->Even(), 1.0);
-          diracSmoother->DslashXpay(tmp2->Odd(), tmp1->Even(), QUDA_ODD_PARITY, tmp1->Odd(), 1.0);
-        } else { // staggered
-          diracSmoother->DslashXpay(tmp2->Even(), tmp1->Odd(), QUDA_EVEN_PARITY, tmp1->Even(),
-                                    2.0 * mass); // stag convention
-          diracSmoother->DslashXpay(tmp2->Odd(), tmp1->Even(), QUDA_ODD_PARITY, tmp1->Odd(),
-                                    2.0 * mass); // stag convention
-        }
-      } else { // this is a hack since the coarse Dslash doesn't properly use the same xpay conventions yet
-        diracSmoother->DslashXpay(tmp2->Even(), tmp1->Odd(), QUDA_EVEN_PARITY, tmp1->Even(), 1.0);
-        diracSmoother->DslashXpay(tmp2->Odd(), tmp1->Even(), QUDA_ODD_PARITY, tmp1->Odd(), 1.0);
-      }
-    } else {
-      (*param.matResidual)(*tmp2,*tmp1);
-    }
-
-    transfer->R(*x_coarse, *tmp2);
-    static_cast<DiracCoarse *>(diracCoarseResidual)->M(*r_coarse, *tmp_coarse);
-
-#if 0 // enable to print out emulated and actual coarse-grid operator vectors for debugging
-    setOutputPrefix("");
-
-    for (int i=0; i<comm_rank(); i++) { // this ensures that we print each rank in order
-      if (i==comm_rank()) {
-        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("emulated\n");
-        for (int x=0; x<x_coarse->Volume(); x++) tmp1->PrintVector(x);
-
-        if (getVerbosity() >= QUDA_VERBOSE) printfQuda("actual\n");
-        for (int x=0; x<r_coarse->Volume(); x++) tmp2->PrintVector(x);
-      }
-      comm_barrier();
-    }
-    setOutputPrefix(prefix);
-#endif
-
-    double r_nrm = norm2(*r_coarse);
-    deviation = sqrt( xmyNorm(*x_coarse, *r_coarse) / norm2(*x_coarse) );
-
-    if (diracResidual->Mu() != 0.0) {
-      // When the mu is shifted on the coarse level; we can compute exactly the error we introduce in the check:
-      //  it is given by 2*kappa*delta_mu || tmp_coarse ||; where tmp_coarse is the random vector generated for the test
-      double delta_factor = param.mg_global.mu_factor[param.level+1] - param.mg_global.mu_factor[param.level];
-      if(fabs(delta_factor) > tol ) {
-        double delta_a
-          = delta_factor * 2.0 * diracResidual->Kappa() * diracResidual->Mu() * transfer->Vectors().TwistFlavor();
-        deviation -= fabs(delta_a) * sqrt(norm2(*tmp_coarse) / norm2(*x_coarse));
-        deviation = fabs(deviation);
-      }
-    }
-    if (getVerbosity() >= QUDA_VERBOSE)
-      printfQuda("L2 norms: Emulated = %e, Native = %e, relative deviation = %e\n", norm2(*x_coarse), r_nrm, deviation);
+    deviation = coarseOperatorDeviation(*tmp_coarse, *tmp1, *tmp2, tol);
 
     // FIXME: This check will fail for ASQTAD because we leave out the long links.
     // Need to put in temporary zero links for long links
@@ -885,7 +1023,7 @@ namespace quda
       static_cast<DiracCoarse *>(diracCoarseResidual)->Dslash(r_coarse->Even(), tmp_coarse->Odd(), QUDA_EVEN_PARITY);
       static_cast<DiracCoarse *>(diracCoarseResidual)->CloverInv(x_coarse->Even(), r_coarse->Even(), QUDA_EVEN_PARITY);
       static_cast<DiracCoarsePC *>(diracCoarseSmoother)->Dslash(r_coarse->Even(), tmp_coarse->Odd(), QUDA_EVEN_PARITY);
-      r_nrm = norm2(r_coarse->Even());
+      double r_nrm = norm2(r_coarse->Even());
       deviation = sqrt(xmyNorm(x_coarse->Even(), r_coarse->Even()) / norm2(x_coarse->Even()));
       if (getVerbosity() >= QUDA_VERBOSE)
         printfQuda("L2 norms: Emulated = %e, Native = %e, relative deviation = %e\n", norm2(x_coarse->Even()), r_nrm,
@@ -1004,6 +1142,9 @@ namespace quda
   void MG::operator()(ColorSpinorField &x, ColorSpinorField &b) {
     pushOutputPrefix(prefix);
 
+    MGRegion cycle_region;
+    const bool record = mgprofile::recording();
+
     if (param.level < param.Nlevel - 1) { // set parity for the solver in the transfer operator
       QudaSiteSubset site_subset
         = param.coarse_grid_solution_type == QUDA_MATPC_SOLUTION ? QUDA_PARITY_SITE_SUBSET : QUDA_FULL_SITE_SUBSET;
@@ -1049,7 +1190,15 @@ namespace quda
       if (param.smoother_solve_type == QUDA_DIRECT_PC_SOLVE) *b_tilde = *in;
       else b_tilde = &b;
 
-      if (presmoother) (*presmoother)(*out, *in); else zero(*out);
+      if (presmoother) {
+        MGRegion region;
+        const double gflops = param_presmooth->gflops;
+        const double bytes = smootherBytes();
+        (*presmoother)(*out, *in);
+        region.stop(cycle_stats.presmooth, (param_presmooth->gflops - gflops) * 1e9, smootherBytes() - bytes);
+      } else {
+        zero(*out);
+      }
 
       ColorSpinorField &solution = inner_solution_type == outer_solution_type ? x : x.Even();
       diracSmoother->reconstruct(solution, b, inner_solution_type);
@@ -1082,10 +1231,43 @@ namespace quda
         transfer->R(*r_coarse, residual);
         if ( debug ) printfQuda("after pre-smoothing x2 = %e, r2 = %e, r_coarse2 = %e\n", norm2(x), r2, norm2(*r_coarse));
 
+        // relax the tolerance of a coarse Krylov solver as the solve we are preconditioning converges
+        if (param_coarse_solver) {
+          const double tol = param.mg_global.coarse_solver_tol[param.level + 1];
+          const double tol_max = param.mg_global.coarse_solver_tol_max[param.level + 1];
+          param_coarse_solver->tol = tol_max > tol ? std::min(tol_max, tol / outer_reduction) : tol;
+          if (record && (cycle_stats.coarse_solves == 0 || param_coarse_solver->tol < cycle_stats.coarse_tol_min))
+            cycle_stats.coarse_tol_min = param_coarse_solver->tol;
+          if (record && (cycle_stats.coarse_solves == 0 || param_coarse_solver->tol > cycle_stats.coarse_tol_max))
+            cycle_stats.coarse_tol_max = param_coarse_solver->tol;
+        }
+
+        MGRegion coarse_region;
+        int coarse_solves = 1;
+        // the iteration count of a solver accumulates over its solves
+        const int coarse_iter_start = param_coarse_solver ? param_coarse_solver->iter : 0;
+
         // recurse to the next lower level
         (*coarse_solver)(*x_coarse, *r_coarse);
         if (debug) printfQuda("after coarse solve x_coarse2 = %e r_coarse2 = %e\n", norm2(*x_coarse), norm2(*r_coarse));
 
+        // W-cycle: visit the next level again to correct the remaining coarse residual
+        if (e_coarse) {
+          (*matCoarseResidual)(*e_coarse, *x_coarse);
+          axpy(-1.0, *e_coarse, *r_coarse);
+          (*coarse_solver)(*e_coarse, *r_coarse);
+          xpy(*e_coarse, *x_coarse);
+          coarse_solves++;
+          if (debug) printfQuda("after second coarse solve x_coarse2 = %e\n", norm2(*x_coarse));
+        }
+
+        const double coarse_time = coarse_region.stop();
+        if (record) {
+          cycle_stats.coarse_solves += coarse_solves;
+          cycle_stats.coarse_time += coarse_time;
+          if (param_coarse_solver) cycle_stats.coarse_iter += param_coarse_solver->iter - coarse_iter_start;
+        }
+
         // prolongate back to this grid
         ColorSpinorField &x_coarse_2_fine = inner_solution_type == QUDA_MAT_SOLUTION ? *r : r->Even(); // define according to inner solution type
         transfer->P(x_coarse_2_fine, *x_coarse); // repurpose residual storage
@@ -1110,7 +1292,13 @@ namespace quda
       // we should keep a copy of the prepared right hand side as we've already destroyed it
       //dirac.prepare(in, out, solution, residual, inner_solution_type);
 
-      if (postsmoother) (*postsmoother)(*out, *in); // for inner solve preconditioned, in the should be the original prepared rhs
+      if (postsmoother) { // for inner solve preconditioned, in the should be the original prepared rhs
+        MGRegion region;
+        const double gflops = param_postsmooth->gflops;
+        const double bytes = smootherBytes();
+        (*postsmoother)(*out, *in);
+        region.stop(cycle_stats.postsmooth, (param_postsmooth->gflops - gflops) * 1e9, smootherBytes() - bytes);
+      }
 
       if (debug) printfQuda("exited postsmooth, about to reconstruct\n");
 
@@ -1122,7 +1310,13 @@ namespace quda
 
       ColorSpinorField *out=nullptr, *in=nullptr;
       diracSmoother->prepare(in, out, x, b, outer_solution_type);
-      if (presmoother) (*presmoother)(*out, *in);
+      if (presmoother) {
+        MGRegion region;
+        const double gflops = param_presmooth->gflops;
+        const double bytes = smootherBytes();
+        (*presmoother)(*out, *in);
+        region.stop(cycle_stats.presmooth, (param_presmooth->gflops - gflops) * 1e9, smootherBytes() - bytes);
+      }
       diracSmoother->reconstruct(x, b, outer_solution_type);
     }
 
@@ -1133,9 +1327,96 @@ namespace quda
       printfQuda("leaving V-cycle with x2=%e, r2=%e\n", norm2(x), r2);
     }
 
+    const double cycle_time = cycle_region.stop();
+    if (record) {
+      cycle_stats.cycles++;
+      cycle_stats.time += cycle_time;
+    }
+
     popOutputPrefix();
   }
 
+  double MG::smootherBytes() const
+  {
+    double bytes = blas::bytes;
+    auto smoother = dynamic_cast<const DiracCoarse *>(diracSmoother);
+    auto smoother_sloppy = dynamic_cast<const DiracCoarse *>(diracSmootherSloppy);
+    if (smoother) bytes += smoother->Counter().bytes;
+    if (smoother_sloppy && smoother_sloppy != smoother) bytes += smoother_sloppy->Counter().bytes;
+    return bytes;
+  }
+
+  void MG::collectProfile(std::vector<MGLevelProfile> &levels) const
+  {
+    MGLevelProfile profile;
+    profile.level = param.level;
+    profile.stats = cycle_stats;
+    if (param.level < param.Nlevel - 1) {
+      profile.cycle = param.cycle_type == QUDA_MG_CYCLE_VCYCLE ? "V" : param.cycle_type == QUDA_MG_CYCLE_WCYCLE ? "W" : "K";
+      profile.components.push_back({"presmooth", cycle_stats.presmooth});
+      profile.components.push_back({"restrict", transfer ? transfer->restrictCounter() : MGCounter()});
+      profile.components.push_back({"prolong", transfer ? transfer->prolongCounter() : MGCounter()});
+      profile.components.push_back({"postsmooth", cycle_stats.postsmooth});
+    } else {
+      profile.components.push_back({"smoother", cycle_stats.presmooth});
+    }
+
+    // the coarse operator of this level is shared by the residual and smoother operators
+    if (param.level > 0) {
+      std::vector<const Dirac *> diracs;
+      for (auto dirac : {diracResidual, diracSmoother, diracSmootherSloppy})
+        if (std::find(diracs.begin(), diracs.end(), dirac) == diracs.end()) diracs.push_back(dirac);
+
+      MGCounter op;
+      for (auto dirac : diracs) {
+        auto coarse_dirac = dynamic_cast<const DiracCoarse *>(dirac);
+        if (coarse_dirac) op += coarse_dirac->Counter();
+      }
+      profile.components.push_back({"operator", op});
+    }
+
+    levels.push_back(profile);
+    if (param.level < param.Nlevel - 1 && coarse) coarse->collectProfile(levels);
+  }
+
+  void MG::reportProfile() const
+  {
+    if (!mgprofile::enabled() && getVerbosity() < QUDA_VERBOSE) return;
+    std::vector<MGLevelProfile> levels;
+    collectProfile(levels);
+    mgprofile::report(levels);
+  }
+
+  bool MG::openCache()
+  {
+    if (!mgcache::exists(param.mg_global.hierarchy_cache, param.cache_key, param.level)) return false;
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Loading level %d from the hierarchy cache %s\n", param.level, param.mg_global.hierarchy_cache);
+    cache_reader = new mgcache::Reader(param.mg_global.hierarchy_cache, param.cache_key, param.level);
+    return true;
+  }
+
+  void MG::dropCache()
+  {
+    warningQuda("Level %d could not be loaded from the hierarchy cache %s, rebuilding it", param.level,
+                param.mg_global.hierarchy_cache);
+    delete cache_reader;
+    cache_reader = nullptr;
+  }
+
+  void MG::saveCache() const
+  {
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Saving level %d to the hierarchy cache %s\n", param.level, param.mg_global.hierarchy_cache);
+
+    mgcache::Writer writer(param.mg_global.hierarchy_cache, param.cache_key, param.level);
+    for (int i = 0; i < (int)param.B.size(); i++) writer.write(*param.B[i]);
+    writer.write(transfer->Vectors());
+    for (auto field : static_cast<DiracCoarse *>(diracCoarseResidual)->CoarseFields()) writer.write(*field);
+    writer.commit();
+  }
+
   // supports separate reading or single file read
   void MG::loadVectors(std::vector<ColorSpinorField *> &B)
   {
@@ -1173,7 +1454,8 @@ namespace quda
       vec_outfile += std::to_string(param.level);
       vec_outfile += "_nvec_";
       vec_outfile += std::to_string(param.mg_global.n_vec[param.level]);
-      VectorIO io(vec_outfile);
+      VectorIO io(vec_outfile, false, 0, param.mg_global.vec_compress_prec[param.level],
+                  param.mg_global.vec_compress_lossless == QUDA_BOOLEAN_TRUE);
       io.save(B);
       popLevel(param.level);
       profile_global.TPSTOP(QUDA_PROFILE_IO);
@@ -1191,9 +1473,111 @@ namespace quda
     if (param.level < param.Nlevel - 2) coarse->dumpNullVectors();
   }
 
+  /**
+     @brief Orthonormalize a set of vectors.  On the GPU this is done
+     block_size vectors at a time: each block is projected against the
+     vectors preceding it with two passes of block classical
+     Gram-Schmidt using the multi-blas kernels, and then orthonormalized
+     internally.  The multi-blas kernels are GPU only, so on the CPU
+     this is modified Gram-Schmidt over all vectors.
+     @param B The vectors
+     @param block_size The number of vectors orthonormalized together
+  */
+  static void orthonormalizeVectors(std::vector<ColorSpinorField *> &B, int block_size)
+  {
+    const int n = B.size();
+    if (B[0]->Location() != QUDA_CUDA_FIELD_LOCATION || block_size < 1) block_size = n;
+
+    for (int i0 = 0; i0 < n; i0 += block_size) {
+      const int i1 = std::min(i0 + block_size, n);
+
+      if (i0 > 0) {
+        std::vector<ColorSpinorField *> prev(B.begin(), B.begin() + i0);
+        std::vector<ColorSpinorField *> block(B.begin() + i0, B.begin() + i1);
+        std::vector<Complex> s(prev.size() * block.size());
+        for (int pass = 0; pass < 2; pass++) {
+          cDotProduct(s.data(), prev, block);
+          for (auto &s_ij : s) s_ij = -s_ij;
+          caxpy(s.data(), prev, block);
+        }
+      }
+
+      for (int i = i0; i < i1; i++) {
+        for (int j = i0; j < i; j++) {
+          Complex alpha = cDotProduct(*B[j], *B[i]); // <j,i>
+          caxpy(-alpha, *B[j], *B[i]);               // i-<j,i>j
+        }
+        double nrm2 = norm2(*B[i]);
+        if (sqrt(nrm2) > 1e-16) ax(1.0 / sqrt(nrm2), *B[i]); // i/<i,i>
+        else errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
+      }
+    }
+  }
+
+  void MG::generateNullVectorBlock(std::vector<ColorSpinorField *> &B, const SolverParam &solverParam, DiracMatrix &mat,
+                                   DiracMatrix &matSloppy)
+  {
+    const int n = B.size();
+
+    // each vector needs its own full field since the prepared systems alias them
+    ColorSpinorParam csParam(*B[0]);
+    csParam.setPrecision(r->Precision(), r->Precision(), true); // ensure native ordering
+    csParam.location = QUDA_CUDA_FIELD_LOCATION;
+    csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+    csParam.create = QUDA_ZERO_FIELD_CREATE;
+
+    std::vector<ColorSpinorField *> x(n), b(n), in(n), out(n);
+    for (int i = 0; i < n; i++) {
+      x[i] = ColorSpinorField::Create(csParam);
+      b[i] = ColorSpinorField::Create(csParam);
+      if (param.mg_global.setup_type == QUDA_TEST_VECTOR_SETUP) { // DDalphaAMG test vector idea
+        *b[i] = *B[i];                                             // inverting against the vector
+      } else {
+        *x[i] = *B[i];
+      }
+      diracSmoother->prepare(in[i], out[i], *x[i], *b[i], QUDA_MAT_SOLUTION);
+    }
+
+    // block solve A d = in - A out for the corrections d, since the
+    // block solver starts from a zero initial guess
+    ColorSpinorParam blockParam(*in[0]);
+    blockParam.create = QUDA_ZERO_FIELD_CREATE;
+    blockParam.is_composite = true;
+    blockParam.composite_dim = n;
+    ColorSpinorField *d = ColorSpinorField::Create(blockParam);
+    ColorSpinorField *res = ColorSpinorField::Create(blockParam);
+
+    for (int i = 0; i < n; i++) {
+      mat(res->Component(i), *out[i]);
+      xpay(*in[i], -1.0, res->Component(i));
+    }
+
+    SolverParam blockSolverParam(solverParam);
+    blockSolverParam.num_src = n;
+    blockSolverParam.use_init_guess = QUDA_USE_INIT_GUESS_NO;
+    Solver *solve = Solver::create(blockSolverParam, mat, matSloppy, matSloppy, profile);
+    solve->blocksolve(*d, *res);
+    delete solve;
+
+    for (int i = 0; i < n; i++) {
+      xpy(d->Component(i), *out[i]);
+      diracSmoother->reconstruct(*x[i], *b[i], QUDA_MAT_SOLUTION);
+      if (getVerbosity() >= QUDA_VERBOSE) printfQuda("Solution = %g\n", norm2(*x[i]));
+      *B[i] = *x[i];
+    }
+
+    delete res;
+    delete d;
+    for (int i = 0; i < n; i++) {
+      delete b[i];
+      delete x[i];
+    }
+  }
+
   void MG::generateNullVectors(std::vector<ColorSpinorField *> &B, bool refresh)
   {
     pushLevel(param.level);
+    mgprofile::SetupScope setup_scope;
 
     SolverParam solverParam(param); // Set solver field parameters:
     // set null-space generation options - need to expose these
@@ -1225,13 +1609,14 @@ namespace quda
     }
     solverParam.residual_type = static_cast<QudaResidualType>(QUDA_L2_RELATIVE_RESIDUAL);
     solverParam.compute_null_vector = QUDA_COMPUTE_NULL_VECTOR_YES;
-    ColorSpinorParam csParam(*B[0]);                            // Create spinor field parameters:
-    csParam.setPrecision(r->Precision(), r->Precision(), true); // ensure native ordering
-    csParam.location = QUDA_CUDA_FIELD_LOCATION; // hard code to GPU location for null-space generation for now
-    csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
+    ColorSpinorParam csParam(*B[0]); // Create spinor field parameters:
+    csParam.location = param.location;
+    csParam.setPrecision(r->Precision(), r->Precision(),
+                         csParam.location == QUDA_CUDA_FIELD_LOCATION ? true : false); // ensure native ordering on GPU
+    if (csParam.location == QUDA_CUDA_FIELD_LOCATION) csParam.gammaBasis = QUDA_UKQCD_GAMMA_BASIS;
     csParam.create = QUDA_ZERO_FIELD_CREATE;
-    ColorSpinorField *b = static_cast<ColorSpinorField *>(new cudaColorSpinorField(csParam));
-    ColorSpinorField *x = static_cast<ColorSpinorField *>(new cudaColorSpinorField(csParam));
+    ColorSpinorField *b = ColorSpinorField::Create(csParam);
+    ColorSpinorField *x = ColorSpinorField::Create(csParam);
 
     csParam.create = QUDA_NULL_FIELD_CREATE;
 
@@ -1277,26 +1662,37 @@ namespace quda
       solve = Solver::create(solverParam, *param.matSmooth, *param.matSmoothSloppy, *param.matSmoothSloppy, profile);
     }
 
+    // the number of vectors relaxed and orthonormalized together
+    int block_size = param.mg_global.setup_block_size[param.level];
+    if (block_size <= 0) block_size = B.size();
+    block_size = std::min(block_size, QUDA_MAX_BLOCK_SRC);
+
+    // the vectors are relaxed together with the block CG solver if it is built and the setup is CG on the GPU
+#ifdef BLOCKSOLVER
+    const bool block_solve = block_size > 1 && param.mg_global.setup_inv_type[param.level] == QUDA_CG_INVERTER
+      && param.location == QUDA_CUDA_FIELD_LOCATION;
+#else
+    const bool block_solve = false;
+#endif
+    if (getVerbosity() >= QUDA_VERBOSE && block_solve)
+      printfQuda("Relaxing null-space vectors in blocks of %d\n", block_size);
+
     for (int si = 0; si < param.mg_global.num_setup_iter[param.level]; si++) {
       if (getVerbosity() >= QUDA_VERBOSE)
         printfQuda("Running vectors setup on level %d iter %d of %d\n", param.level, si + 1,
                    param.mg_global.num_setup_iter[param.level]);
 
       // global orthonormalization of the initial null-space vectors
-      if(param.mg_global.pre_orthonormalize) {
-        for(int i=0; i<(int)B.size(); i++) {
-          for (int j=0; j<i; j++) {
-            Complex alpha = cDotProduct(*B[j], *B[i]);// <j,i>
-            caxpy(-alpha, *B[j], *B[i]); // i-<j,i>j
-          }
-          double nrm2 = norm2(*B[i]);
-          if (nrm2 > 1e-16) ax(1.0 /sqrt(nrm2), *B[i]);// i/<i,i>
-          else errorQuda("\nCannot normalize %u vector\n", i);
-        }
+      if (param.mg_global.pre_orthonormalize) orthonormalizeVectors(B, block_size);
+
+      // launch the block solver for each block of sources
+      for (int i = 0; block_solve && i < (int)B.size(); i += block_size) {
+        std::vector<ColorSpinorField *> B_block(B.begin() + i, B.begin() + std::min(i + block_size, (int)B.size()));
+        generateNullVectorBlock(B_block, solverParam, *mdagm, *mdagmSloppy);
       }
 
       // launch solver for each source
-      for (int i=0; i<(int)B.size(); i++) {
+      for (int i = 0; !block_solve && i < (int)B.size(); i++) {
         if (param.mg_global.setup_type == QUDA_TEST_VECTOR_SETUP) { // DDalphaAMG test vector idea
           *b = *B[i];  // inverting against the vector
           zero(*x);    // with zero initial guess
@@ -1318,17 +1714,7 @@ namespace quda
       }
 
       // global orthonormalization of the generated null-space vectors
-      if (param.mg_global.post_orthonormalize) {
-        for(int i=0; i<(int)B.size(); i++) {
-          for (int j=0; j<i; j++) {
-            Complex alpha = cDotProduct(*B[j], *B[i]);// <j,i>
-            caxpy(-alpha, *B[j], *B[i]); // i-<j,i>j
-          }
-          double nrm2 = norm2(*B[i]);
-          if (sqrt(nrm2) > 1e-16) ax(1.0/sqrt(nrm2), *B[i]);// i/<i,i>
-          else errorQuda("\nCannot normalize %u vector (nrm=%e)\n", i, sqrt(nrm2));
-        }
-      }
+      if (param.mg_global.post_orthonormalize) orthonormalizeVectors(B, block_size);
 
       if (solverParam.inv_type == QUDA_MG_INVERTER) {
 
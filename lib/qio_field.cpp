@@ -270,8 +270,7 @@ int read_field(QIO_Reader *infile, int Ninternal, int count, void *field_in[], Q
   return status;
 }
 
-void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
-                       QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+void *open_spinor_reader(const char *filename, const int *X, QudaSiteSubset subset)
 {
   quda_this_node = QMP_get_node_number();
 
@@ -281,14 +280,49 @@ void read_spinor_field(const char *filename, void *V[], QudaPrecision precision,
   QIO_Reader *infile = open_test_input(filename, QIO_UNKNOWN, QIO_PARALLEL);
   if (infile == NULL) { errorQuda("Open file failed\n"); }
 
+  return infile;
+}
+
+int read_spinor_record_count(void *reader)
+{
+  char dummy[100] = "";
+  QIO_RecordInfo *rec_info = QIO_create_record_info(0, NULL, NULL, 0, dummy, dummy, 0, 0, 0, 0);
+  QIO_String *xml_record_in = QIO_string_create();
+
+  // the record info is cached by the reader, so the subsequent read_field call will not advance the file
+  int status = QIO_read_record_info(static_cast<QIO_Reader *>(reader), rec_info, xml_record_in);
+  int count = (status == QIO_SUCCESS) ? QIO_get_datacount(rec_info) : 0;
+
+  QIO_string_destroy(xml_record_in);
+  QIO_destroy_record_info(rec_info);
+
+  if (status != QIO_SUCCESS && status != QIO_EOF) errorQuda("QIO_read_record_info failed with status %d", status);
+  return count;
+}
+
+void read_spinor_record(void *reader, void *V[], QudaPrecision precision, QudaSiteSubset subset, QudaParity parity,
+                        int nColor, int nSpin, int Nvec)
+{
   /* Read the spinor field record */
   printfQuda("%s: reading %d vector fields\n", __func__, Nvec); fflush(stdout);
-  int status = read_field(infile, 2 * nSpin * nColor, Nvec, V, precision, subset, parity, nSpin, nColor);
+  int status = read_field(static_cast<QIO_Reader *>(reader), 2 * nSpin * nColor, Nvec, V, precision, subset, parity,
+                          nSpin, nColor);
   if (status) { errorQuda("read_spinor_fields failed %d\n", status); }
+}
 
+void close_spinor_reader(void *reader)
+{
   /* Close the file */
-  QIO_close_read(infile);
-  printfQuda("%s: Closed file for reading\n",__func__);
+  QIO_close_read(static_cast<QIO_Reader *>(reader));
+  printfQuda("%s: Closed file for reading\n", __func__);
+}
+
+void read_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                       QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+{
+  void *reader = open_spinor_reader(filename, X, subset);
+  read_spinor_record(reader, V, precision, subset, parity, nColor, nSpin, Nvec);
+  close_spinor_reader(reader);
 }
 
 template <int len>
@@ -455,29 +489,45 @@ int write_field(QIO_Writer *outfile, int Ninternal, int count, void *field_out[]
   return status;
 }
 
-void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
-                        QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+void *open_spinor_writer(const char *filename, const int *X, QudaSiteSubset subset)
 {
   quda_this_node = QMP_get_node_number();
 
   set_layout(X, subset);
 
+  /* Open the test file for writing */
+  QIO_Writer *outfile = open_test_output(filename, QIO_SINGLEFILE, QIO_PARALLEL, QIO_ILDGNO);
+  if (outfile == NULL) { errorQuda("Open file failed\n"); }
+
+  return outfile;
+}
+
+void write_spinor_record(void *writer, void *V[], QudaPrecision precision, QudaSiteSubset subset, QudaParity parity,
+                         int nColor, int nSpin, int Nvec)
+{
   QudaPrecision file_prec = precision;
 
   char type[128];
   sprintf(type, "QUDA_%sNs%dNc%d_ColorSpinorField", (file_prec == QUDA_DOUBLE_PRECISION) ? "D" : "F", nSpin, nColor);
 
-  /* Open the test file for reading */
-  QIO_Writer *outfile = open_test_output(filename, QIO_SINGLEFILE, QIO_PARALLEL, QIO_ILDGNO);
-  if (outfile == NULL) { errorQuda("Open file failed\n"); }
-
-  /* Read the spinor field record */
+  /* Write the spinor field record */
   printfQuda("%s: writing %d vector fields\n", __func__, Nvec); fflush(stdout);
-  int status
-    = write_field(outfile, 2 * nSpin * nColor, Nvec, V, precision, precision, subset, parity, nSpin, nColor, type);
+  int status = write_field(static_cast<QIO_Writer *>(writer), 2 * nSpin * nColor, Nvec, V, precision, precision, subset,
+                           parity, nSpin, nColor, type);
   if (status) { errorQuda("write_spinor_fields failed %d\n", status); }
+}
 
+void close_spinor_writer(void *writer)
+{
   /* Close the file */
-  QIO_close_write(outfile);
-  printfQuda("%s: Closed file for writing\n",__func__);
+  QIO_close_write(static_cast<QIO_Writer *>(writer));
+  printfQuda("%s: Closed file for writing\n", __func__);
+}
+
+void write_spinor_field(const char *filename, void *V[], QudaPrecision precision, const int *X, QudaSiteSubset subset,
+                        QudaParity parity, int nColor, int nSpin, int Nvec, int argc, char *argv[])
+{
+  void *writer = open_spinor_writer(filename, X, subset);
+  write_spinor_record(writer, V, precision, subset, parity, nColor, nSpin, Nvec);
+  close_spinor_writer(writer);
 }
@@ -3,6 +3,7 @@
 #include <multigrid.h>
 #include <eigensolve_quda.h>
 #include <cmath>
+#include <chrono>
 
 namespace quda {
 
@@ -135,6 +136,10 @@ namespace quda {
 	solver = new GMResDR(mat, matSloppy, matPrecon, param, profile);
       }
       break;
+    case QUDA_GCRODR_INVERTER:
+      report("GCRODR");
+      solver = new GCRODR(mat, matSloppy, param, profile);
+      break;
     case QUDA_CGNE_INVERTER:
       report("CGNE");
       solver = new CGNE(mat, matSloppy, matPrecon, param, profile);
@@ -204,6 +209,9 @@ namespace quda {
 
         space->evecs.resize(0);
         space->evals.resize(0);
+        for (auto &vec : space->images)
+          if (vec) delete vec;
+        space->images.resize(0);
 
         delete space;
         param.eig_param.preserve_deflation_space = nullptr;
@@ -236,6 +244,9 @@ namespace quda {
           for (auto &vec : space->evecs)
             if (vec) delete vec;
           space->evecs.resize(0);
+          for (auto &vec : space->images)
+            if (vec) delete vec;
+          space->images.resize(0);
           delete space;
         }
 
@@ -366,9 +377,38 @@ namespace quda {
       }
     }
 
+    ReportEvent(name, QUDA_SOLVER_EVENT_ITERATION, k, r2, b2, hq2, param.precision_sloppy);
+
     if (std::isnan(r2)) errorQuda("Solver appears to have diverged");
   }
 
+  void Solver::ReportEvent(const char *name, QudaSolverEventType type, int k, double r2, double b2, double hq2,
+                           QudaPrecision precision)
+  {
+    QudaSolverTelemetry *telemetry = param.telemetry;
+    if (!telemetry) return;
+
+    const double now
+      = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (telemetry->count == 0) telemetry->start = now;
+
+    QudaSolverRecord record;
+    record.type = type;
+    record.solver = name;
+    record.iter = k;
+    record.r2 = r2;
+    record.r2_rel = b2 > 0.0 ? r2 / b2 : 0.0;
+    record.hq = hq2;
+    record.precision = precision;
+    record.time = now - telemetry->start;
+    record.time_preamble = type == QUDA_SOLVER_EVENT_CONVERGED ? profile.Last(QUDA_PROFILE_PREAMBLE) : 0.0;
+    record.time_compute = type == QUDA_SOLVER_EVENT_CONVERGED ? profile.Last(QUDA_PROFILE_COMPUTE) : 0.0;
+
+    if (telemetry->records && telemetry->count < telemetry->capacity) telemetry->records[telemetry->count] = record;
+    telemetry->count++;
+    if (telemetry->callback) telemetry->callback(&record, telemetry->data);
+  }
+
   void Solver::PrintSummary(const char *name, int k, double r2, double b2,
                             double r2_tol, double hq_tol) {
     if (getVerbosity() >= QUDA_SUMMARIZE) {
@@ -392,6 +432,8 @@ namespace quda {
 	}
       }
     }
+
+    ReportEvent(name, QUDA_SOLVER_EVENT_CONVERGED, k, r2, b2, param.true_res_hq, param.precision);
   }
 
   bool MultiShiftSolver::convergence(const double *r2, const double *r2_tol, int n) const {
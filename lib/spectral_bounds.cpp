@@ -0,0 +1,226 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include <quda_internal.h>
+#include <dirac_quda.h>
+#include <color_spinor_field.h>
+#include <content_hash.h>
+#include <arrow_eigensolve.h>
+#include <spectral_bounds.h>
+
+namespace quda
+{
+
+  namespace spectral
+  {
+
+    namespace
+    {
+
+      struct Estimate {
+        bool valid = false;
+        double value = 0.0;
+        uint64_t gauge = 0;
+        Source source = SPECTRAL_POWER;
+      };
+
+      struct Entry {
+        Estimate min;
+        Estimate max;
+        Estimate edge;
+        int edge_rank = 0;
+      };
+
+      uint64_t context_params = 0;
+      uint64_t context_gauge = 0;
+      std::unordered_map<uint64_t, Entry> record;
+
+      bool enabled()
+      {
+        static int enable = -1;
+        if (enable < 0) {
+          char *enable_env = getenv("QUDA_ENABLE_SPECTRAL_BOUNDS");
+          enable = (enable_env && strcmp(enable_env, "0") == 0) ? 0 : 1;
+        }
+        return enable;
+      }
+
+      double drift()
+      {
+        static double margin = -1.0;
+        if (margin < 0.0) {
+          char *drift_env = getenv("QUDA_SPECTRAL_BOUNDS_DRIFT");
+          margin = drift_env ? atof(drift_env) : 0.05;
+          if (margin < 0.0) errorQuda("Invalid QUDA_SPECTRAL_BOUNDS_DRIFT=%s", drift_env);
+        }
+        return margin;
+      }
+
+      bool sameGauge(const Estimate &e, const Key &key) { return key.gauge != 0 && e.gauge == key.gauge; }
+
+      /**
+         @brief Replace an estimate if the new one is from another
+         configuration, a more accurate source, or is the more
+         conservative one from the same source
+       */
+      void update(Estimate &e, const Key &key, double value, Source source, bool larger)
+      {
+        bool replace = !e.valid || !sameGauge(e, key) || source > e.source;
+        if (!replace && source == e.source) replace = larger ? value > e.value : value < e.value;
+        if (!replace) return;
+        e.valid = true;
+        e.value = value;
+        e.gauge = key.gauge;
+        e.source = source;
+      }
+
+      uint64_t stringHash(const std::string &s, uint64_t seed) { return xxhash64(s.data(), s.size(), seed); }
+
+    } // namespace
+
+    void setContext(uint64_t params, uint64_t gauge)
+    {
+      context_params = params;
+      context_gauge = gauge;
+    }
+
+    Key key(const DiracMatrix &mat, const ColorSpinorField &v)
+    {
+      struct {
+        uint64_t params;
+        int matpc_type;
+        int n_color;
+        int n_spin;
+        int site_subset;
+        int x[QUDA_MAX_DIM];
+        double kappa;
+        double mass;
+        double mu;
+        double mu_factor;
+        double shift;
+      } op;
+      memset(&op, 0, sizeof(op)); // zero the padding since it is hashed
+
+      const Dirac *dirac = mat.Expose();
+      op.params = context_params;
+      op.matpc_type = mat.getMatPCType();
+      op.n_color = v.Ncolor();
+      op.n_spin = v.Nspin();
+      op.site_subset = v.SiteSubset();
+      for (int d = 0; d < v.Ndim(); d++) op.x[d] = v.X(d);
+      op.kappa = dirac->Kappa();
+      op.mass = dirac->Mass();
+      op.mu = dirac->Mu();
+      op.mu_factor = dirac->MuFactor();
+      op.shift = mat.shift;
+
+      uint64_t hash = stringHash(typeid(mat).name(), xxhash64(&op, sizeof(op)));
+      return {stringHash(mat.Type(), hash), context_gauge};
+    }
+
+    bool lookup(const Key &key, Bounds &bounds)
+    {
+      bounds = Bounds();
+      if (!enabled()) return false;
+      auto it = record.find(key.op);
+      if (it == record.end()) return false;
+      const Entry &entry = it->second;
+
+      // widen the bounds that were recorded on another configuration
+      const double margin = drift();
+      if (entry.min.valid) {
+        bounds.has_min = true;
+        bounds.lambda_min = entry.min.value;
+        if (!sameGauge(entry.min, key)) {
+          bounds.lambda_min -= margin * fabs(entry.min.value);
+          bounds.exact = false;
+        }
+      }
+      if (entry.max.valid) {
+        bounds.has_max = true;
+        bounds.lambda_max = entry.max.value;
+        if (!sameGauge(entry.max, key)) {
+          bounds.lambda_max += margin * fabs(entry.max.value);
+          bounds.exact = false;
+        }
+      }
+      if (entry.edge.valid) {
+        bounds.has_edge = true;
+        bounds.edge = entry.edge.value;
+        bounds.edge_rank = entry.edge_rank;
+        if (!sameGauge(entry.edge, key)) {
+          bounds.edge += margin * fabs(entry.edge.value);
+          bounds.exact = false;
+        }
+      }
+
+      return bounds.has_min || bounds.has_max || bounds.has_edge;
+    }
+
+    void recordMin(const Key &key, double lambda, Source source)
+    {
+      update(record[key.op].min, key, lambda, source, false);
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("Spectral bounds %016llx: lambda_min estimate %e (source %d)\n", (unsigned long long)key.op, lambda,
+                   source);
+    }
+
+    void recordMax(const Key &key, double lambda, Source source)
+    {
+      update(record[key.op].max, key, lambda, source, true);
+      if (getVerbosity() >= QUDA_DEBUG_VERBOSE)
+        printfQuda("Spectral bounds %016llx: lambda_max estimate %e (source %d)\n", (unsigned long long)key.op, lambda,
+                   source);
+    }
+
+    void recordEdge(const Key &key, double edge, int rank)
+    {
+      Entry &entry = record[key.op];
+      // an edge for a different rank is a different quantity, so it is always replaced
+      if (entry.edge_rank != rank) entry.edge.valid = false;
+      update(entry.edge, key, edge, SPECTRAL_EIGENSOLVE, true);
+      entry.edge_rank = rank;
+    }
+
+    bool lanczosBounds(const std::vector<double> &alpha, const std::vector<double> &beta, double &lambda_min,
+                       double &lambda_max)
+    {
+      const int n = std::min(alpha.size(), beta.size() + 1);
+      if (n < 2) return false;
+
+      // T_00 = 1/alpha_0, T_ii = 1/alpha_i + beta_{i-1}/alpha_{i-1},
+      // T_{i,i+1} = sqrt(beta_i)/alpha_i
+      std::vector<double> diag(n);
+      std::vector<double> off(n - 1);
+      for (int i = 0; i < n; i++) {
+        if (!(alpha[i] > 0.0)) return false;
+        diag[i] = 1.0 / alpha[i] + (i > 0 ? beta[i - 1] / alpha[i - 1] : 0.0);
+        if (i < n - 1) {
+          if (beta[i] < 0.0) return false;
+          off[i] = sqrt(beta[i]) / alpha[i];
+        }
+      }
+
+      ArrowEigensolver eig;
+      eig.compute(diag.data(), off.data(), n, 0);
+      lambda_min = eig.eigenvalues().front();
+      lambda_max = eig.eigenvalues().back();
+      return true;
+    }
+
+    int chebyshevDegree(double lambda, double a_min, double a_max, double gain)
+    {
+      const double theta = 0.5 * (a_max + a_min);
+      const double delta = 0.5 * (a_max - a_min);
+      const double x = (theta - lambda) / delta;
+      if (!(delta > 0.0) || !(x > 1.0)) return 0;
+      // T_d(x) = cosh(d acosh(x)) for x > 1
+      return static_cast<int>(ceil(acosh(gain) / acosh(x)));
+    }
+
+  } // namespace spectral
+
+} // namespace quda
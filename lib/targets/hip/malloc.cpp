@@ -2,6 +2,8 @@
 #include <cstdio>
 #include <string>
 #include <map>
+#include <algorithm>
+#include <vector>
 #include <unistd.h>   // for getpagesize()
 #include <execinfo.h> // for backtrace
 #include <quda_internal.h>
@@ -64,6 +66,9 @@ namespace quda
   static long total_host_bytes, max_total_host_bytes;
   static long total_pinned_bytes, max_total_pinned_bytes;
 
+  // functions registered to report a breakdown of the memory used
+  static std::vector<void (*)()> mem_usage_reports;
+
   long device_allocated_peak() { return max_total_bytes[DEVICE]; }
 
   long pinned_allocated_peak() { return max_total_bytes[PINNED]; }
@@ -447,6 +452,13 @@ namespace quda
     printfQuda("Managed memory used = %.1f MB\n", max_total_bytes[MANAGED] / (double)(1 << 20));
     printfQuda("Page-locked host memory used = %.1f MB\n", max_total_pinned_bytes / (double)(1 << 20));
     printfQuda("Total host memory used >= %.1f MB\n", max_total_host_bytes / (double)(1 << 20));
+    for (auto report : mem_usage_reports) report();
+  }
+
+  void register_mem_usage_report(void (*report)())
+  {
+    if (std::find(mem_usage_reports.begin(), mem_usage_reports.end(), report) == mem_usage_reports.end())
+      mem_usage_reports.push_back(report);
   }
 
   void assertAllMemFree()
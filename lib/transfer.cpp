@@ -10,6 +10,11 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include <map>
+#include <mutex>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace quda {
@@ -19,7 +24,7 @@ namespace quda {
   * however we do even-odd to preserve chirality (that is straightforward)
   */
   Transfer::Transfer(const std::vector<ColorSpinorField *> &B, int Nvec, int n_block_ortho, int *geo_bs, int spin_bs,
-                     QudaPrecision null_precision, TimeProfile &profile) :
+                     QudaPrecision null_precision, TimeProfile &profile, bool orthogonalize) :
     B(B),
     Nvec(Nvec),
     NblockOrtho(n_block_ortho),
@@ -104,7 +109,7 @@ namespace quda {
     for (int s = 0; s < B[0]->Nspin(); s++) spin_map[s] = static_cast<int*>(safe_malloc(2*sizeof(int)));
     createSpinMap(spin_bs);
 
-    reset();
+    if (orthogonalize) reset();
     postTrace();
   }
 
@@ -228,6 +233,26 @@ namespace quda {
     postTrace();
   }
 
+  void Transfer::setVectors(const ColorSpinorField &V)
+  {
+    if (is_staggered) { return; }
+
+    // copy the raw data so that the prolongator is reproduced exactly
+    ColorSpinorField &V_ = B[0]->Location() == QUDA_CUDA_FIELD_LOCATION ? *V_d : *V_h;
+    if (V.Location() != V_.Location() || V.Precision() != V_.Precision() || V.FieldOrder() != V_.FieldOrder()
+        || V.Bytes() != V_.Bytes() || V.NormBytes() != V_.NormBytes())
+      errorQuda("Prolongator does not match the transfer operator");
+    qudaMemcpy(V_.V(), V.V(), V.Bytes(), cudaMemcpyDefault);
+    if (V.NormBytes()) qudaMemcpy(V_.Norm(), V.Norm(), V.NormBytes(), cudaMemcpyDefault);
+    V_.Scale(V.Scale());
+
+    if (B[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
+      if (enable_cpu) *V_h = *V_d;
+    } else {
+      if (enable_gpu) *V_d = *V_h;
+    }
+  }
+
   Transfer::~Transfer() {
     if (spin_map)
     {
@@ -260,48 +285,130 @@ namespace quda {
     site_subset = site_subset_;
   }
 
-  struct Int2 {
-    int x, y;
-    Int2() : x(0), y(0) { } 
-    Int2(int x, int y) : x(x), y(y) { } 
-    
-    bool operator<(const Int2 &a) const {
-      return (x < a.x) ? true : (x==a.x && y<a.y) ? true : false;
+  namespace
+  {
+
+    /**
+       The aggregation maps only depend on the fine geometry and the
+       block size, so they are computed once per geometry and reused
+       by every transfer operator with the same blocking, e.g., on
+       every refresh and every new hierarchy, until endQuda frees
+       them.  They are small compared to the null-space vectors they
+       block.
+    */
+    struct GeoMap {
+      std::vector<int> fine_to_coarse;
+      std::vector<int> coarse_to_fine;
+    };
+
+    std::map<std::vector<int>, GeoMap> geo_map_cache;
+    std::mutex geo_map_mutex;
+
+    std::vector<int> geoMapKey(const ColorSpinorField &fine, const int *geo_bs)
+    {
+      std::vector<int> key = {fine.Ndim(), fine.SiteSubset()};
+      for (int d = 0; d < fine.Ndim(); d++) key.push_back(fine.X(d));
+      for (int d = 0; d < fine.Ndim(); d++) key.push_back(geo_bs[d]);
+      return key;
+    }
+
+    /**
+       Modeled bytes of a transfer between a fine and a coarse field:
+       both fields and, unless it is only a permutation, the
+       null-space vectors on the sites of the fine field
+    */
+    double transferBytes(const ColorSpinorField &fine, const ColorSpinorField &coarse, const ColorSpinorField *V)
+    {
+      double bytes = fine.Bytes() + fine.NormBytes() + coarse.Bytes() + coarse.NormBytes();
+      if (V) bytes += V->SiteSubset() == fine.SiteSubset() ? V->Bytes() : 0.5 * V->Bytes();
+      return bytes;
     }
-  };
+
+  } // namespace
+
+  void Transfer::freeGeoMapCache()
+  {
+    std::lock_guard<std::mutex> lock(geo_map_mutex);
+    geo_map_cache.clear();
+  }
 
   // compute the fine-to-coarse site map
   void Transfer::createGeoMap(int *geo_bs) {
 
-    int x[QUDA_MAX_DIM];
-
     ColorSpinorField &fine(*fine_tmp_h);
     ColorSpinorField &coarse(*coarse_tmp_h);
+    const int n_fine = fine.Volume();
+    const int n_coarse = coarse.Volume();
 
-    // compute the coarse grid point for every site (assuming parity ordering currently)
-    for (size_t i = 0; i < fine.Volume(); i++) {
-      // compute the lattice-site index for this offset index
-      fine.LatticeIndex(x, i);
-      
-      //printfQuda("fine idx %d = fine (%d,%d,%d,%d), ", i, x[0], x[1], x[2], x[3]);
-
-      // compute the corresponding coarse-grid index given the block size
-      for (int d=0; d<fine.Ndim(); d++) x[d] /= geo_bs[d];
+    const std::vector<int> key = geoMapKey(fine, geo_bs);
+    std::lock_guard<std::mutex> lock(geo_map_mutex);
+    auto cached = geo_map_cache.find(key);
 
-      // compute the coarse-offset index and store in fine_to_coarse
-      int k;
-      coarse.OffsetIndex(k, x); // this index is parity ordered
-      fine_to_coarse_h[i] = k;
+    if (cached != geo_map_cache.end()) {
+      memcpy(fine_to_coarse_h, cached->second.fine_to_coarse.data(), n_fine * sizeof(int));
+      memcpy(coarse_to_fine_h, cached->second.coarse_to_fine.data(), n_fine * sizeof(int));
+    } else {
+      // compute the coarse grid point for every site (assuming parity ordering currently)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (int i = 0; i < n_fine; i++) {
+        // compute the lattice-site index for this offset index
+        int x[QUDA_MAX_DIM];
+        fine.LatticeIndex(x, i);
+
+        // compute the corresponding coarse-grid index given the block size
+        for (int d = 0; d < fine.Ndim(); d++) x[d] /= geo_bs[d];
+
+        // compute the coarse-offset index and store in fine_to_coarse
+        int k;
+        coarse.OffsetIndex(k, x); // this index is parity ordered
+        fine_to_coarse_h[i] = k;
+      }
 
-      //printfQuda("coarse after (%d,%d,%d,%d), coarse idx %d\n", x[0], x[1], x[2], x[3], k);
-    }
+      // now create an inverse-like variant of this with a stable
+      // counting sort by coarse site: each chunk of fine sites is
+      // counted per aggregate, and the scan over (aggregate, chunk)
+      // gives where each chunk's sites go, so the fine sites of an
+      // aggregate stay in ascending order
+      int n_chunk = 1;
+#ifdef _OPENMP
+      n_chunk = omp_get_max_threads();
+#endif
+      n_chunk = std::max(1, std::min(n_chunk, n_fine / 1024));
+      std::vector<int> offset(static_cast<size_t>(n_coarse) * n_chunk, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+      for (int c = 0; c < n_chunk; c++) {
+        const int begin = static_cast<int>(static_cast<int64_t>(n_fine) * c / n_chunk);
+        const int end = static_cast<int>(static_cast<int64_t>(n_fine) * (c + 1) / n_chunk);
+        for (int i = begin; i < end; i++) offset[static_cast<size_t>(fine_to_coarse_h[i]) * n_chunk + c]++;
+      }
 
-    // now create an inverse-like variant of this
+      int sum = 0;
+      for (auto &o : offset) {
+        const int count = o;
+        o = sum;
+        sum += count;
+      }
+      if (sum != n_fine) errorQuda("Aggregation map covers %d of %d fine sites", sum, n_fine);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+      for (int c = 0; c < n_chunk; c++) {
+        const int begin = static_cast<int>(static_cast<int64_t>(n_fine) * c / n_chunk);
+        const int end = static_cast<int>(static_cast<int64_t>(n_fine) * (c + 1) / n_chunk);
+        for (int i = begin; i < end; i++)
+          coarse_to_fine_h[offset[static_cast<size_t>(fine_to_coarse_h[i]) * n_chunk + c]++] = i;
+      }
 
-    std::vector<Int2> geo_sort(B[0]->Volume());
-    for (unsigned int i=0; i<geo_sort.size(); i++) geo_sort[i] = Int2(fine_to_coarse_h[i], i);
-    std::sort(geo_sort.begin(), geo_sort.end());
-    for (unsigned int i=0; i<geo_sort.size(); i++) coarse_to_fine_h[i] = geo_sort[i].y;
+      GeoMap &map = geo_map_cache[key];
+      map.fine_to_coarse.assign(fine_to_coarse_h, fine_to_coarse_h + n_fine);
+      map.coarse_to_fine.assign(coarse_to_fine_h, coarse_to_fine_h + n_fine);
+    }
 
     if (enable_gpu) {
       qudaMemcpy(fine_to_coarse_d, fine_to_coarse_h, B[0]->Volume()*sizeof(int), cudaMemcpyHostToDevice);
@@ -330,6 +437,8 @@ namespace quda {
   // apply the prolongator
   void Transfer::P(ColorSpinorField &out, const ColorSpinorField &in) const {
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    MGRegion region;
+    const double flops_start = flops_;
 
     ColorSpinorField *input = const_cast<ColorSpinorField*>(&in);
     ColorSpinorField *output = &out;
@@ -370,6 +479,8 @@ namespace quda {
 
     out = *output; // copy result to out field (aliasing handled automatically)
 
+    region.stop(prolong_counter, flops_ - flops_start,
+                transferBytes(out, in, is_staggered ? nullptr : use_gpu ? V_d : V_h));
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
   }
 
@@ -377,6 +488,8 @@ namespace quda {
   void Transfer::R(ColorSpinorField &out, const ColorSpinorField &in) const
   {
     profile.TPSTART(QUDA_PROFILE_COMPUTE);
+    MGRegion region;
+    const double flops_start = flops_;
 
     ColorSpinorField *input = &const_cast<ColorSpinorField&>(in);
     ColorSpinorField *output = &out;
@@ -426,6 +539,8 @@ namespace quda {
     if (out.Location() == QUDA_CPU_FIELD_LOCATION && in.Location() == QUDA_CUDA_FIELD_LOCATION)
       qudaDeviceSynchronize();
 
+    region.stop(restrict_counter, flops_ - flops_start,
+                transferBytes(in, out, is_staggered ? nullptr : use_gpu ? V_d : V_h));
     profile.TPSTOP(QUDA_PROFILE_COMPUTE);
   }
 
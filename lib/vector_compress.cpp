@@ -0,0 +1,524 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <color_spinor_field.h>
+#include <comm_quda.h>
+#include <vector_compress.h>
+
+namespace quda
+{
+
+  namespace
+  {
+
+    constexpr char file_magic[8] = {'Q', 'U', 'D', 'A', 'V', 'C', 'M', 'P'};
+    constexpr uint32_t byte_order_mark = 0x01020304;
+    constexpr int32_t format_version = 1;
+
+    /**
+       @brief Standard (zlib) CRC32 used for the block checksums
+    */
+    class CRC32
+    {
+      uint32_t table[256];
+
+    public:
+      CRC32()
+      {
+        for (uint32_t i = 0; i < 256; i++) {
+          uint32_t c = i;
+          for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+          table[i] = c;
+        }
+      }
+
+      uint32_t operator()(const char *buf, size_t len) const
+      {
+        uint32_t c = 0xffffffffu;
+        for (size_t i = 0; i < len; i++) c = table[(c ^ static_cast<unsigned char>(buf[i])) & 0xff] ^ (c >> 8);
+        return c ^ 0xffffffffu;
+      }
+    };
+
+    const CRC32 crc32;
+
+    void pread_all(int fd, char *buf, size_t bytes, off_t offset, const char *filename)
+    {
+      while (bytes > 0) {
+        ssize_t n = pread(fd, buf, bytes, offset);
+        if (n <= 0) errorQuda("Failed to read %lu bytes at offset %ld from %s", bytes, (long)offset, filename);
+        buf += n;
+        bytes -= n;
+        offset += n;
+      }
+    }
+
+    void pwrite_all(int fd, const char *buf, size_t bytes, off_t offset, const char *filename)
+    {
+      while (bytes > 0) {
+        ssize_t n = pwrite(fd, buf, bytes, offset);
+        if (n <= 0) errorQuda("Failed to write %lu bytes at offset %ld to %s", bytes, (long)offset, filename);
+        buf += n;
+        bytes -= n;
+        offset += n;
+      }
+    }
+
+    /**
+       @brief Index of the block written by the process at grid
+       coordinates c (lexicographic with x fastest)
+    */
+    int blockIndex(const int c[], const int32_t grid[])
+    {
+      return ((c[3] * grid[2] + c[2]) * grid[1] + c[1]) * grid[0] + c[0];
+    }
+
+    /**
+       @brief Site ordering of a (4-d slice of a) host field: sites
+       are stored in even-odd order, with only the sites of the given
+       parity present for a single-parity field.
+    */
+    struct Layout {
+      int X[4];      // full local dimensions
+      size_t volume; // full local 4-d volume
+      size_t sites;  // number of sites stored per 4-d slice
+      QudaSiteSubset subset;
+      int parity;
+
+      Layout(const int *X_, QudaSiteSubset subset, int parity) : volume(1), subset(subset), parity(parity)
+      {
+        for (int d = 0; d < 4; d++) {
+          X[d] = X_[d];
+          volume *= X[d];
+        }
+        sites = subset == QUDA_FULL_SITE_SUBSET ? volume : volume / 2;
+      }
+
+      /**
+         @brief Compute the coordinates of stored site j
+      */
+      void coords(int x[4], size_t j) const
+      {
+        int p = parity;
+        size_t cb = j;
+        if (subset == QUDA_FULL_SITE_SUBSET) {
+          p = j / (volume / 2);
+          cb = j % (volume / 2);
+        }
+        size_t za = cb / (X[0] / 2);
+        int x0h = cb - za * (X[0] / 2);
+        size_t zb = za / X[1];
+        x[1] = za - zb * X[1];
+        x[3] = zb / X[2];
+        x[2] = zb - x[3] * X[2];
+        x[0] = 2 * x0h + ((x[1] + x[2] + x[3] + p) & 1);
+      }
+
+      /**
+         @brief Return the stored site index of coordinates x (which
+         must be present in this layout)
+      */
+      size_t site(const int x[4]) const
+      {
+        size_t r = ((static_cast<size_t>(x[3]) * X[2] + x[2]) * X[1] + x[1]) * X[0] + x[0];
+        int p = (x[0] + x[1] + x[2] + x[3]) & 1;
+        return subset == QUDA_FULL_SITE_SUBSET ? r / 2 + p * (volume / 2) : r / 2;
+      }
+    };
+
+    /**
+       @brief Byte-plane shuffle of n elements of the given size, so
+       that the (typically more compressible) high-order bytes are
+       contiguous for the entropy stage
+    */
+    void shuffle(char *dst, const char *src, size_t n, size_t size)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < size; b++) dst[b * n + i] = src[i * size + b];
+    }
+
+    void unshuffle(char *dst, const char *src, size_t n, size_t size)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < size; b++) dst[i * size + b] = src[b * n + i];
+    }
+
+    /**
+       @brief Encode sites into block floating point: a per-site norm
+       (the maximum absolute component) and the components scaled to
+       fixed point by this norm
+    */
+    template <typename Fixed, typename Float>
+    void encode(float *norm, Fixed *q, const Float *src, size_t sites, int nreal)
+    {
+      constexpr float max_q = std::numeric_limits<Fixed>::max();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t j = 0; j < sites; j++) {
+        const Float *s = src + j * nreal;
+        Float max = 0.0;
+        for (int c = 0; c < nreal; c++) max = std::max(max, std::abs(s[c]));
+        norm[j] = max;
+        const float scale = norm[j] > 0.0f ? max_q / norm[j] : 0.0f;
+        for (int c = 0; c < nreal; c++) {
+          float v = std::round(static_cast<float>(s[c]) * scale);
+          q[j * nreal + c] = static_cast<Fixed>(std::max(-max_q, std::min(max_q, v)));
+        }
+      }
+    }
+
+    /**
+       @brief Decode the sites of a writer block, storing those that
+       lie in the local sub-lattice directly into the host field
+    */
+    template <typename Fixed, typename Float>
+    void decode(Float *dst, const Layout &local, const int *local_offset, const float *norm, const Fixed *q,
+                const Layout &writer, const int *writer_offset, int nreal)
+    {
+      constexpr float max_q = std::numeric_limits<Fixed>::max();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (size_t j = 0; j < writer.sites; j++) {
+        int x[4];
+        writer.coords(x, j);
+        bool inside = true;
+        for (int d = 0; d < 4; d++) {
+          x[d] += writer_offset[d] - local_offset[d];
+          if (x[d] < 0 || x[d] >= local.X[d]) inside = false;
+        }
+        if (!inside) continue;
+
+        Float *d = dst + local.site(x) * nreal;
+        const float scale = norm[j] / max_q;
+        for (int c = 0; c < nreal; c++) d[c] = scale * q[j * nreal + c];
+      }
+    }
+
+    /**
+       @brief Full local dimensions of a host vector
+    */
+    void fullDims(int X[4], const ColorSpinorField &v)
+    {
+      for (int d = 0; d < 4; d++) X[d] = v.X(d);
+      if (v.SiteSubset() == QUDA_PARITY_SITE_SUBSET) X[0] *= 2;
+    }
+
+  } // namespace
+
+  bool isCompressedVectorFile(const std::string &filename)
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    char magic[sizeof(file_magic)];
+    bool match = pread(fd, magic, sizeof(magic), 0) == sizeof(magic) && memcmp(magic, file_magic, sizeof(magic)) == 0;
+    close(fd);
+    return match;
+  }
+
+  CompressedVectorWriter::CompressedVectorWriter(const std::string &filename, const ColorSpinorField &v, int nvec,
+                                                 QudaPrecision prec, bool lossless) :
+    filename(filename), fd(-1), position(sizeof(CompressedVectorHeader)), raw_bytes(0.0), stored_bytes(0.0)
+  {
+    if (v.Location() != QUDA_CPU_FIELD_LOCATION || v.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Compressed vector I/O requires host fields in space-spin-color order");
+    if (prec != QUDA_HALF_PRECISION && prec != QUDA_QUARTER_PRECISION)
+      errorQuda("Unsupported compression precision %d", prec);
+#ifndef HAVE_ZLIB
+    if (lossless) {
+      warningQuda("Lossless compression requires QUDA_ZLIB, saving %s without the entropy stage", filename.c_str());
+      lossless = false;
+    }
+#endif
+
+    int X[4];
+    fullDims(X, v);
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.byte_order = byte_order_mark;
+    header.version = format_version;
+    for (int d = 0; d < 4; d++) header.L[d] = comm_dim(d) * X[d];
+    header.Ls = v.Ndim() == 5 ? v.X(4) : 1;
+    header.nSpin = v.Nspin();
+    header.nColor = v.Ncolor();
+    header.subset = v.SiteSubset();
+    header.parity = v.SuggestedParity();
+    header.nvec = nvec;
+    header.bytes = prec == QUDA_HALF_PRECISION ? 2 : 1;
+    header.lossless = lossless;
+    for (int d = 0; d < 4; d++) header.grid[d] = comm_dim(d);
+
+    if (comm_rank() == 0) {
+      fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) errorQuda("Failed to open %s for writing", filename.c_str());
+    }
+    comm_barrier();
+    if (comm_rank() != 0) {
+      fd = open(filename.c_str(), O_WRONLY);
+      if (fd < 0) errorQuda("Failed to open %s for writing", filename.c_str());
+    }
+  }
+
+  CompressedVectorWriter::~CompressedVectorWriter()
+  {
+    header.index_offset = position;
+    if (comm_rank() == 0) {
+      pwrite_all(fd, reinterpret_cast<const char *>(index.data()), index.size() * sizeof(CompressedVectorBlock),
+                 position, filename.c_str());
+      pwrite_all(fd, reinterpret_cast<const char *>(&header), sizeof(header), 0, filename.c_str());
+    }
+    comm_barrier();
+    close(fd);
+
+    comm_allreduce(&raw_bytes);
+    comm_allreduce(&stored_bytes);
+    if (getVerbosity() >= QUDA_VERBOSE)
+      printfQuda("Compressed %d vectors to %.3f GB (%d-bit%s, compression ratio %.2f)\n", header.nvec,
+                 stored_bytes / 1e9, 8 * header.bytes, header.lossless ? " + lossless" : "", raw_bytes / stored_bytes);
+  }
+
+  void CompressedVectorWriter::write(const std::vector<ColorSpinorField *> &v, int first, int n)
+  {
+    int X[4];
+    fullDims(X, *v[first]);
+    const Layout layout(X, v[first]->SiteSubset(), v[first]->SuggestedParity());
+    const int nreal = 2 * v[first]->Nspin() * v[first]->Ncolor();
+    const int Ls = header.Ls;
+    const size_t n_site = static_cast<size_t>(n) * Ls * layout.sites;
+    const size_t norm_bytes = n_site * sizeof(float);
+    const size_t value_bytes = n_site * nreal * header.bytes;
+
+    std::vector<char> raw(norm_bytes + value_bytes);
+    for (int i = 0; i < n; i++) {
+      const ColorSpinorField &field = *v[first + i];
+      for (int s = 0; s < Ls; s++) {
+        size_t block = static_cast<size_t>(i) * Ls + s;
+        float *norm = reinterpret_cast<float *>(raw.data()) + block * layout.sites;
+        char *q = raw.data() + norm_bytes + block * layout.sites * nreal * header.bytes;
+        size_t src_offset = s * layout.sites * nreal;
+        if (field.Precision() == QUDA_DOUBLE_PRECISION) {
+          const double *src = static_cast<const double *>(field.V()) + src_offset;
+          if (header.bytes == 2)
+            encode(norm, reinterpret_cast<int16_t *>(q), src, layout.sites, nreal);
+          else
+            encode(norm, reinterpret_cast<int8_t *>(q), src, layout.sites, nreal);
+        } else if (field.Precision() == QUDA_SINGLE_PRECISION) {
+          const float *src = static_cast<const float *>(field.V()) + src_offset;
+          if (header.bytes == 2)
+            encode(norm, reinterpret_cast<int16_t *>(q), src, layout.sites, nreal);
+          else
+            encode(norm, reinterpret_cast<int8_t *>(q), src, layout.sites, nreal);
+        } else {
+          errorQuda("Unsupported host precision %d", field.Precision());
+        }
+      }
+      raw_bytes += field.Bytes();
+    }
+
+    std::vector<char> compressed;
+#ifdef HAVE_ZLIB
+    if (header.lossless) {
+      std::vector<char> shuffled(raw.size());
+      shuffle(shuffled.data(), raw.data(), n_site, sizeof(float));
+      shuffle(shuffled.data() + norm_bytes, raw.data() + norm_bytes, n_site * nreal, header.bytes);
+      uLongf length = compressBound(shuffled.size());
+      compressed.resize(length);
+      int status = compress2(reinterpret_cast<Bytef *>(compressed.data()), &length,
+                             reinterpret_cast<const Bytef *>(shuffled.data()), shuffled.size(), Z_DEFAULT_COMPRESSION);
+      if (status != Z_OK) errorQuda("zlib compression failed with status %d", status);
+      compressed.resize(length);
+    }
+#endif
+    const std::vector<char> &stored = header.lossless ? compressed : raw;
+    stored_bytes += stored.size();
+
+    // gather the block sizes and checksums so that every process can compute its offset
+    int c[4];
+    for (int d = 0; d < 4; d++) c[d] = comm_coord(d);
+    const int n_block = comm_size();
+    std::vector<double> info(2 * n_block, 0.0);
+    info[2 * blockIndex(c, header.grid) + 0] = stored.size();
+    info[2 * blockIndex(c, header.grid) + 1] = crc32(stored.data(), stored.size());
+    comm_allreduce_array(info.data(), info.size());
+
+    int64_t offset = position;
+    for (int b = 0; b < n_block; b++) {
+      CompressedVectorBlock entry;
+      entry.offset = offset;
+      entry.bytes = static_cast<uint64_t>(info[2 * b + 0]);
+      entry.raw_bytes = raw.size();
+      entry.crc = static_cast<uint32_t>(info[2 * b + 1]);
+      entry.nvec = n;
+      index.push_back(entry);
+      if (b == blockIndex(c, header.grid)) pwrite_all(fd, stored.data(), stored.size(), offset, filename.c_str());
+      offset += entry.bytes;
+    }
+    position = offset;
+    header.n_record++;
+  }
+
+  CompressedVectorReader::CompressedVectorReader(const std::string &filename, const ColorSpinorField &v) :
+    filename(filename), fd(-1), record(0)
+  {
+    if (v.Location() != QUDA_CPU_FIELD_LOCATION || v.FieldOrder() != QUDA_SPACE_SPIN_COLOR_FIELD_ORDER)
+      errorQuda("Compressed vector I/O requires host fields in space-spin-color order");
+
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) errorQuda("Failed to open %s for reading", filename.c_str());
+    pread_all(fd, reinterpret_cast<char *>(&header), sizeof(header), 0, filename.c_str());
+
+    if (memcmp(header.magic, file_magic, sizeof(file_magic)) != 0)
+      errorQuda("%s is not a compressed vector file", filename.c_str());
+    if (header.byte_order != byte_order_mark)
+      errorQuda("%s was written on a host with different byte order", filename.c_str());
+    if (header.version != format_version)
+      errorQuda("Unsupported compressed vector file version %d in %s", header.version, filename.c_str());
+#ifndef HAVE_ZLIB
+    if (header.lossless) errorQuda("Reading %s requires QUDA_ZLIB", filename.c_str());
+#endif
+
+    int X[4];
+    fullDims(X, v);
+    const int Ls = v.Ndim() == 5 ? v.X(4) : 1;
+    for (int d = 0; d < 4; d++) {
+      if (header.L[d] != comm_dim(d) * X[d])
+        errorQuda("Lattice dimension %d of %s is %d, expected %d", d, filename.c_str(), header.L[d], comm_dim(d) * X[d]);
+    }
+    if (header.Ls != Ls || header.nSpin != v.Nspin() || header.nColor != v.Ncolor())
+      errorQuda("%s contains vectors with Ls = %d, nSpin = %d, nColor = %d, expected %d, %d, %d", filename.c_str(),
+                header.Ls, header.nSpin, header.nColor, Ls, v.Nspin(), v.Ncolor());
+    if (header.subset != v.SiteSubset()) errorQuda("Site subset of %s does not match that of the vectors", filename.c_str());
+    if (header.subset == QUDA_PARITY_SITE_SUBSET && header.parity != v.SuggestedParity())
+      errorQuda("%s contains parity %d vectors, expected parity %d", filename.c_str(), header.parity,
+                v.SuggestedParity());
+
+    // find the writer blocks that overlap the local sub-lattice
+    int lo[4], hi[4];
+    for (int d = 0; d < 4; d++) {
+      if (header.L[d] % header.grid[d] != 0) errorQuda("Invalid process grid in %s", filename.c_str());
+      const int W = header.L[d] / header.grid[d];
+      lo[d] = comm_coord(d) * X[d] / W;
+      hi[d] = (comm_coord(d) * X[d] + X[d] - 1) / W;
+      if (W != X[d] && header.subset == QUDA_PARITY_SITE_SUBSET && header.parity != QUDA_EVEN_PARITY
+          && header.parity != QUDA_ODD_PARITY)
+        errorQuda("Reading single-parity vectors with a different process grid requires the parity to be set");
+    }
+    int c[4];
+    for (c[3] = lo[3]; c[3] <= hi[3]; c[3]++)
+      for (c[2] = lo[2]; c[2] <= hi[2]; c[2]++)
+        for (c[1] = lo[1]; c[1] <= hi[1]; c[1]++)
+          for (c[0] = lo[0]; c[0] <= hi[0]; c[0]++) blocks.push_back(blockIndex(c, header.grid));
+
+    const int n_block = header.grid[0] * header.grid[1] * header.grid[2] * header.grid[3];
+    index.resize(static_cast<size_t>(header.n_record) * n_block);
+    pread_all(fd, reinterpret_cast<char *>(index.data()), index.size() * sizeof(CompressedVectorBlock),
+              header.index_offset, filename.c_str());
+  }
+
+  CompressedVectorReader::~CompressedVectorReader() { close(fd); }
+
+  int CompressedVectorReader::count() const
+  {
+    if (record == header.n_record) return 0;
+    const int n_block = header.grid[0] * header.grid[1] * header.grid[2] * header.grid[3];
+    return index[static_cast<size_t>(record) * n_block].nvec;
+  }
+
+  void CompressedVectorReader::read(const std::vector<ColorSpinorField *> &v, int first, int n)
+  {
+    if (n != count()) errorQuda("Record %d of %s contains %d vectors, not %d", record, filename.c_str(), count(), n);
+
+    int X[4], local_offset[4], W[4];
+    fullDims(X, *v[first]);
+    for (int d = 0; d < 4; d++) {
+      local_offset[d] = comm_coord(d) * X[d];
+      W[d] = header.L[d] / header.grid[d];
+    }
+    const Layout local(X, static_cast<QudaSiteSubset>(header.subset), header.parity);
+    const Layout writer(W, static_cast<QudaSiteSubset>(header.subset), header.parity);
+    const int nreal = 2 * header.nSpin * header.nColor;
+    const int Ls = header.Ls;
+    const size_t n_site = static_cast<size_t>(n) * Ls * writer.sites;
+    const size_t norm_bytes = n_site * sizeof(float);
+    const int n_block = header.grid[0] * header.grid[1] * header.grid[2] * header.grid[3];
+
+    std::vector<char> stored, raw;
+    for (auto b : blocks) {
+      const CompressedVectorBlock &entry = index[static_cast<size_t>(record) * n_block + b];
+      if (entry.raw_bytes != norm_bytes + n_site * nreal * header.bytes)
+        errorQuda("Unexpected size %lu of block %d in record %d of %s", entry.raw_bytes, b, record, filename.c_str());
+
+      stored.resize(entry.bytes);
+      pread_all(fd, stored.data(), stored.size(), entry.offset, filename.c_str());
+      if (crc32(stored.data(), stored.size()) != entry.crc)
+        errorQuda("Checksum mismatch in block %d of record %d of %s", b, record, filename.c_str());
+
+#ifdef HAVE_ZLIB
+      if (header.lossless) {
+        std::vector<char> shuffled(entry.raw_bytes);
+        uLongf length = shuffled.size();
+        int status = uncompress(reinterpret_cast<Bytef *>(shuffled.data()), &length,
+                                reinterpret_cast<const Bytef *>(stored.data()), stored.size());
+        if (status != Z_OK || length != entry.raw_bytes)
+          errorQuda("zlib decompression of block %d of record %d of %s failed with status %d", b, record,
+                    filename.c_str(), status);
+        raw.resize(entry.raw_bytes);
+        unshuffle(raw.data(), shuffled.data(), n_site, sizeof(float));
+        unshuffle(raw.data() + norm_bytes, shuffled.data() + norm_bytes, n_site * nreal, header.bytes);
+      }
+#endif
+      const std::vector<char> &data = header.lossless ? raw : stored;
+
+      int writer_offset[4];
+      int rem = b;
+      for (int d = 0; d < 4; d++) {
+        writer_offset[d] = (rem % header.grid[d]) * W[d];
+        rem /= header.grid[d];
+      }
+
+      for (int i = 0; i < n; i++) {
+        ColorSpinorField &field = *v[first + i];
+        for (int s = 0; s < Ls; s++) {
+          size_t block = static_cast<size_t>(i) * Ls + s;
+          const float *norm = reinterpret_cast<const float *>(data.data()) + block * writer.sites;
+          const char *q = data.data() + norm_bytes + block * writer.sites * nreal * header.bytes;
+          size_t dst_offset = s * local.sites * nreal;
+          if (field.Precision() == QUDA_DOUBLE_PRECISION) {
+            double *dst = static_cast<double *>(field.V()) + dst_offset;
+            if (header.bytes == 2)
+              decode(dst, local, local_offset, norm, reinterpret_cast<const int16_t *>(q), writer, writer_offset, nreal);
+            else
+              decode(dst, local, local_offset, norm, reinterpret_cast<const int8_t *>(q), writer, writer_offset, nreal);
+          } else if (field.Precision() == QUDA_SINGLE_PRECISION) {
+            float *dst = static_cast<float *>(field.V()) + dst_offset;
+            if (header.bytes == 2)
+              decode(dst, local, local_offset, norm, reinterpret_cast<const int16_t *>(q), writer, writer_offset, nreal);
+            else
+              decode(dst, local, local_offset, norm, reinterpret_cast<const int8_t *>(q), writer, writer_offset, nreal);
+          } else {
+            errorQuda("Unsupported host precision %d", field.Precision());
+          }
+        }
+      }
+    }
+    record++;
+  }
+
+} // namespace quda
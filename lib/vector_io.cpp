@@ -1,215 +1,329 @@
+#include <thread>
 #include <color_spinor_field.h>
 #include <qio_field.h>
 #include <vector_io.h>
+#include <vector_compress.h>
 #include <blas_quda.h>
+#include <timer.h>
 
 namespace quda
 {
 
-  VectorIO::VectorIO(const std::string &filename, bool parity_inflate) :
-#ifdef HAVE_QIO
+  VectorIO::VectorIO(const std::string &filename, bool parity_inflate, int chunk_size, QudaPrecision compress_prec,
+                     bool compress_lossless) :
     filename(filename),
-    parity_inflate(parity_inflate)
-#else
-    filename(filename)
-#endif
+    parity_inflate(parity_inflate),
+    chunk_size(chunk_size),
+    compress_prec(compress_prec),
+    compress_lossless(compress_lossless)
   {
     if (strcmp(filename.c_str(), "") == 0) { errorQuda("No eigenspace input file defined."); }
+    if (this->chunk_size <= 0) {
+      char *chunk_env = getenv("QUDA_VECTOR_IO_CHUNK");
+      this->chunk_size = chunk_env ? atoi(chunk_env) : 32;
+      if (this->chunk_size <= 0) errorQuda("Invalid QUDA_VECTOR_IO_CHUNK=%s", chunk_env);
+    }
   }
 
-  void VectorIO::load(std::vector<ColorSpinorField *> &vecs)
+  namespace
   {
-#ifdef HAVE_QIO
-    const int Nvec = vecs.size();
-    auto spinor_parity = vecs[0]->SuggestedParity();
-    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start loading %04d vectors from %s\n", Nvec, filename.c_str());
 
-    std::vector<ColorSpinorField *> tmp;
-    tmp.reserve(Nvec);
-    if (vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
-      ColorSpinorParam csParam(*vecs[0]);
-      csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
-      csParam.setPrecision(vecs[0]->Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : vecs[0]->Precision());
-      csParam.location = QUDA_CPU_FIELD_LOCATION;
-      csParam.create = QUDA_NULL_FIELD_CREATE;
-      if (csParam.siteSubset == QUDA_PARITY_SITE_SUBSET && parity_inflate) {
-        csParam.x[0] *= 2;
-        csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
+    /**
+       @brief Return the parameters for the host buffers used to stage
+       a vector to or from the file
+       @param[in] v Representative vector being loaded or saved
+       @param[in] inflate Whether the buffer is a parity-inflated full field
+       @param[in] create The create type for the buffer
+     */
+    ColorSpinorParam hostParam(const ColorSpinorField &v, bool inflate, QudaFieldCreate create)
+    {
+      ColorSpinorParam param(v);
+      if (v.Location() == QUDA_CUDA_FIELD_LOCATION) {
+        param.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
+        param.setPrecision(v.Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : v.Precision());
+        param.location = QUDA_CPU_FIELD_LOCATION;
       }
-      for (int i = 0; i < Nvec; i++) { tmp.push_back(ColorSpinorField::Create(csParam)); }
-    } else {
-      ColorSpinorParam csParam(*vecs[0]);
-      if (csParam.siteSubset == QUDA_PARITY_SITE_SUBSET && parity_inflate) {
-        csParam.x[0] *= 2;
-        csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
-        for (int i = 0; i < Nvec; i++) { tmp.push_back(ColorSpinorField::Create(csParam)); }
+      if (inflate) {
+        param.x[0] *= 2;
+        param.siteSubset = QUDA_FULL_SITE_SUBSET;
+      }
+      param.create = create;
+      return param;
+    }
+
+    /**
+       @brief Since the QIO routines presently assume we have 4-d
+       fields, return the array of 4-d field pointers corresponding
+       to a range of vectors.
+       @param[in] v The set of vectors
+       @param[in] first The first vector in the range
+       @param[in] n The number of vectors in the range
+     */
+    std::vector<void *> fieldPointers(const std::vector<ColorSpinorField *> &v, int first, int n)
+    {
+      const int Ls = v[first]->Ndim() == 5 ? v[first]->X(4) : 1;
+      const size_t V4 = v[first]->Volume() / Ls;
+      const size_t stride = V4 * v[first]->Ncolor() * v[first]->Nspin() * 2 * v[first]->Precision();
+      std::vector<void *> V(n * Ls);
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < Ls; j++) { V[i * Ls + j] = static_cast<char *>(v[first + i]->V()) + j * stride; }
+      }
+      return V;
+    }
+
+    /**
+       @brief Copy a vector from its host staging buffer into the
+       destination, deflating it to a single parity if needed
+     */
+    void unstage(ColorSpinorField &dst, ColorSpinorField &buf, ColorSpinorField *intermediate, bool inflate,
+                 QudaParity parity)
+    {
+      if (!inflate) {
+        dst = buf;
+      } else if (intermediate) {
+        blas::copy(*intermediate, parity == QUDA_EVEN_PARITY ? buf.Even() : buf.Odd());
+        dst = *intermediate;
       } else {
-        for (int i = 0; i < Nvec; i++) { tmp.push_back(vecs[i]); }
+        blas::copy(dst, parity == QUDA_EVEN_PARITY ? buf.Even() : buf.Odd());
       }
     }
 
-    if (vecs[0]->Ndim() == 4 || vecs[0]->Ndim() == 5) {
-      // since QIO routines presently assume we have 4-d fields, we need to convert to array of 4-d fields
-      auto Ls = vecs[0]->Ndim() == 5 ? tmp[0]->X(4) : 1;
-      auto V4 = tmp[0]->Volume() / Ls;
-      auto stride = V4 * tmp[0]->Ncolor() * tmp[0]->Nspin() * 2 * tmp[0]->Precision();
-      void **V = static_cast<void **>(safe_malloc(Nvec * Ls * sizeof(void *)));
-      for (int i = 0; i < Nvec; i++) {
-        for (int j = 0; j < Ls; j++) { V[i * Ls + j] = static_cast<char *>(tmp[i]->V()) + j * stride; }
+    /**
+       @brief Copy a vector into its host staging buffer, inflating it
+       to a full field if needed (the other parity of the buffer is
+       left zero)
+     */
+    void stage(ColorSpinorField &buf, const ColorSpinorField &src, ColorSpinorField *intermediate, bool inflate,
+               QudaParity parity)
+    {
+      if (!inflate) {
+        buf = src;
+      } else if (intermediate) {
+        *intermediate = src;
+        blas::copy(parity == QUDA_EVEN_PARITY ? buf.Even() : buf.Odd(), *intermediate);
+      } else {
+        blas::copy(parity == QUDA_EVEN_PARITY ? buf.Even() : buf.Odd(), src);
       }
+    }
 
-      read_spinor_field(filename.c_str(), &V[0], tmp[0]->Precision(), tmp[0]->X(), tmp[0]->SiteSubset(), spinor_parity,
-                        tmp[0]->Ncolor(), tmp[0]->Nspin(), Nvec * Ls, 0, (char **)0);
+  } // namespace
 
-      host_free(V);
-    } else {
-      errorQuda("Unexpected field dimension %d", vecs[0]->Ndim());
+  void VectorIO::load(std::vector<ColorSpinorField *> &vecs)
+  {
+    // compressed files are read natively, everything else goes through QIO
+    const bool compressed = isCompressedVectorFile(filename);
+#ifndef HAVE_QIO
+    if (!compressed) errorQuda("\nQIO library was not built.\n");
+#endif
+
+    const int Nvec = vecs.size();
+    auto spinor_parity = vecs[0]->SuggestedParity();
+    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start loading %04d vectors from %s\n", Nvec, filename.c_str());
+    if (vecs[0]->Ndim() != 4 && vecs[0]->Ndim() != 5) errorQuda("Unexpected field dimension %d", vecs[0]->Ndim());
+
+    const bool cuda = vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION;
+    const bool inflate = vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate && !compressed;
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When loading single parity vectors, the suggested parity must be set.");
+
+    // host vectors that need no inflation are read in place, else we stage through a pair of chunk buffers
+    const bool staged = cuda || inflate;
+    const int Ls = vecs[0]->Ndim() == 5 ? vecs[0]->X(4) : 1;
+
+    ColorSpinorParam param = hostParam(*vecs[0], inflate, QUDA_NULL_FIELD_CREATE);
+    ColorSpinorField *intermediate
+      = (cuda && inflate) ? ColorSpinorField::Create(hostParam(*vecs[0], false, QUDA_NULL_FIELD_CREATE)) : nullptr;
+
+    std::vector<ColorSpinorField *> buffer[2];
+    auto reserve = [&](int slot, int n) {
+      while (static_cast<int>(buffer[slot].size()) < n) buffer[slot].push_back(ColorSpinorField::Create(param));
+    };
+    if (staged) {
+      reserve(0, std::min(chunk_size, Nvec));
+      reserve(1, std::min(chunk_size, Nvec));
     }
 
-    if (vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
+    // the conversion and upload thread must use the same device as the host thread
+    int device = 0;
+    if (cuda) cudaGetDevice(&device);
+
+    Timer read_timer, total_timer;
+    total_timer.Start(__func__, __FILE__, __LINE__);
+    double bytes = 0.0;
 
-      ColorSpinorParam csParam(*vecs[0]);
-      if (csParam.siteSubset == QUDA_FULL_SITE_SUBSET || !parity_inflate) {
-        for (int i = 0; i < Nvec; i++) {
-          *vecs[i] = *tmp[i];
-          delete tmp[i];
-        }
+    void *reader = nullptr;
+    CompressedVectorReader *compressed_reader = nullptr;
+    if (compressed)
+      compressed_reader = new CompressedVectorReader(filename, staged ? *buffer[0][0] : *vecs[0]);
+    else
+      reader = open_spinor_reader(filename.c_str(), param.x, param.siteSubset);
+
+    // read chunk k+1 on this thread while chunk k is converted and uploaded by the worker
+    std::thread worker;
+    int slot = 0;
+    for (int first = 0; first < Nvec;) {
+      const int count = compressed ? compressed_reader->count() * Ls : read_spinor_record_count(reader);
+      if (count == 0) errorQuda("File %s contains only %d of %d vectors", filename.c_str(), first, Nvec);
+      if (count % Ls != 0) errorQuda("Record with %d fields is not a multiple of Ls = %d", count, Ls);
+      const int n = count / Ls;
+      if (first + n > Nvec) errorQuda("File %s contains more than %d vectors", filename.c_str(), Nvec);
+
+      if (staged && n > static_cast<int>(buffer[slot].size())) {
+        // unchunked file: the record must be resident in its entirety
+        warningQuda("Record of %d vectors exceeds the chunk size %d, host memory use is not bounded", n, chunk_size);
+        if (worker.joinable()) worker.join(); // no allocation while the worker is active
+        reserve(slot, n);
+      }
+
+      auto &dst = staged ? buffer[slot] : vecs;
+      const int offset = staged ? 0 : first;
+
+      read_timer.Start(__func__, __FILE__, __LINE__);
+      if (compressed) {
+        compressed_reader->read(dst, offset, n);
       } else {
-        // Create a temporary single-parity CPU field
-        csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
-        csParam.setPrecision(vecs[0]->Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : vecs[0]->Precision());
-        csParam.location = QUDA_CPU_FIELD_LOCATION;
-        csParam.create = QUDA_NULL_FIELD_CREATE;
-
-        ColorSpinorField *tmp_intermediate = ColorSpinorField::Create(csParam);
-
-        for (int i = 0; i < Nvec; i++) {
-          if (spinor_parity == QUDA_EVEN_PARITY)
-            blas::copy(*tmp_intermediate, tmp[i]->Even());
-          else if (spinor_parity == QUDA_ODD_PARITY)
-            blas::copy(*tmp_intermediate, tmp[i]->Odd());
-          else
-            errorQuda("When loading single parity vectors, the suggested parity must be set.");
-
-          *vecs[i] = *tmp_intermediate;
-          delete tmp[i];
-        }
-
-        delete tmp_intermediate;
+        auto V = fieldPointers(dst, offset, n);
+        read_spinor_record(reader, V.data(), dst[offset]->Precision(), param.siteSubset, spinor_parity, param.nColor,
+                           param.nSpin, count);
       }
-    } else if (vecs[0]->Location() == QUDA_CPU_FIELD_LOCATION && vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET) {
-      for (int i = 0; i < Nvec; i++) {
-        if (spinor_parity == QUDA_EVEN_PARITY)
-          blas::copy(*vecs[i], tmp[i]->Even());
-        else if (spinor_parity == QUDA_ODD_PARITY)
-          blas::copy(*vecs[i], tmp[i]->Odd());
-        else
-          errorQuda("When loading single parity vectors, the suggested parity must be set.");
-
-        delete tmp[i];
+      read_timer.Stop(__func__, __FILE__, __LINE__);
+      bytes += static_cast<double>(n) * dst[offset]->Bytes();
+
+      if (worker.joinable()) worker.join();
+      if (staged) {
+        worker = std::thread([&, slot, first, n]() {
+          if (cuda) cudaSetDevice(device);
+          for (int i = 0; i < n; i++)
+            unstage(*vecs[first + i], *buffer[slot][i], intermediate, inflate, spinor_parity);
+        });
+        slot = 1 - slot;
       }
+      first += n;
     }
+    if (worker.joinable()) worker.join();
 
-    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done loading vectors\n");
-#else
-    errorQuda("\nQIO library was not built.\n");
-#endif
+    if (compressed)
+      delete compressed_reader;
+    else
+      close_spinor_reader(reader);
+
+    for (auto &b : buffer)
+      for (auto v : b) delete v;
+    if (intermediate) delete intermediate;
+
+    total_timer.Stop(__func__, __FILE__, __LINE__);
+    comm_allreduce(&bytes);
+    double read_time = read_timer.time;
+    comm_allreduce_max(&read_time);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Done loading vectors: read %.3f GB in %.3f s (%.3f GB/s), total time %.3f s\n", bytes / 1e9,
+                 read_time, bytes / (1e9 * read_time), total_timer.time);
   }
 
   void VectorIO::save(const std::vector<ColorSpinorField *> &vecs)
   {
-#ifdef HAVE_QIO
+    // half and quarter precision select the native compressed format, else we use QIO
+    const bool compressed = compress_prec == QUDA_HALF_PRECISION || compress_prec == QUDA_QUARTER_PRECISION;
+#ifndef HAVE_QIO
+    if (!compressed) errorQuda("\nQIO library was not built.\n");
+#endif
+
     const int Nvec = vecs.size();
-    std::vector<ColorSpinorField *> tmp;
-    tmp.reserve(Nvec);
     auto spinor_parity = vecs[0]->SuggestedParity();
-    if (vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION) {
-      ColorSpinorParam csParam(*vecs[0]);
-      csParam.fieldOrder = QUDA_SPACE_SPIN_COLOR_FIELD_ORDER;
-      csParam.setPrecision(vecs[0]->Precision() < QUDA_SINGLE_PRECISION ? QUDA_SINGLE_PRECISION : vecs[0]->Precision());
-      csParam.location = QUDA_CPU_FIELD_LOCATION;
-
-      if (csParam.siteSubset == QUDA_FULL_SITE_SUBSET || !parity_inflate) {
-        // We're good, copy as is.
-        csParam.create = QUDA_NULL_FIELD_CREATE;
-        for (int i = 0; i < Nvec; i++) {
-          tmp.push_back(ColorSpinorField::Create(csParam));
-          *tmp[i] = *vecs[i];
-        }
-      } else { // QUDA_PARITY_SITE_SUBSET
-        csParam.create = QUDA_NULL_FIELD_CREATE;
-
-        // intermediate host single-parity field
-        ColorSpinorField *tmp_intermediate = ColorSpinorField::Create(csParam);
-
-        csParam.x[0] *= 2;                          // corrects for the factor of two in the X direction
-        csParam.siteSubset = QUDA_FULL_SITE_SUBSET; // create a full-parity field.
-        csParam.create = QUDA_ZERO_FIELD_CREATE;    // to explicitly zero the odd sites.
-        for (int i = 0; i < Nvec; i++) {
-          tmp.push_back(ColorSpinorField::Create(csParam));
-
-          // copy the single parity eigen/singular vector into an
-          // intermediate device-side vector
-          *tmp_intermediate = *vecs[i];
-
-          // copy the single parity only eigen/singular vector into the even components of the full parity vector
-          if (spinor_parity == QUDA_EVEN_PARITY)
-            blas::copy(tmp[i]->Even(), *tmp_intermediate);
-          else if (spinor_parity == QUDA_ODD_PARITY)
-            blas::copy(tmp[i]->Odd(), *tmp_intermediate);
-          else
-            errorQuda("When saving single parity vectors, the suggested parity must be set.");
-        }
-        delete tmp_intermediate;
-      }
-    } else {
-      ColorSpinorParam csParam(*vecs[0]);
-      if (csParam.siteSubset == QUDA_PARITY_SITE_SUBSET && parity_inflate) {
-        csParam.x[0] *= 2;
-        csParam.siteSubset = QUDA_FULL_SITE_SUBSET;
-        csParam.create = QUDA_ZERO_FIELD_CREATE;
-        for (int i = 0; i < Nvec; i++) {
-          tmp.push_back(ColorSpinorField::Create(csParam));
-          if (spinor_parity == QUDA_EVEN_PARITY)
-            blas::copy(tmp[i]->Even(), *vecs[i]);
-          else if (spinor_parity == QUDA_ODD_PARITY)
-            blas::copy(tmp[i]->Odd(), *vecs[i]);
-          else
-            errorQuda("When saving single parity vectors, the suggested parity must be set.");
-        }
-      } else {
-        for (int i = 0; i < Nvec; i++) { tmp.push_back(vecs[i]); }
-      }
+    if (vecs[0]->Ndim() != 4 && vecs[0]->Ndim() != 5) errorQuda("Unexpected field dimension %d", vecs[0]->Ndim());
+
+    const bool cuda = vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION;
+    const bool inflate = vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET && parity_inflate && !compressed;
+    if (inflate && spinor_parity != QUDA_EVEN_PARITY && spinor_parity != QUDA_ODD_PARITY)
+      errorQuda("When saving single parity vectors, the suggested parity must be set.");
+
+    // host vectors that need no inflation are written in place, else we stage through a pair of chunk buffers
+    const bool staged = cuda || inflate;
+    const int Ls = vecs[0]->Ndim() == 5 ? vecs[0]->X(4) : 1;
+
+    // inflated buffers are zeroed since only the one parity is ever written
+    ColorSpinorParam param = hostParam(*vecs[0], inflate, inflate ? QUDA_ZERO_FIELD_CREATE : QUDA_NULL_FIELD_CREATE);
+    ColorSpinorField *intermediate
+      = (cuda && inflate) ? ColorSpinorField::Create(hostParam(*vecs[0], false, QUDA_NULL_FIELD_CREATE)) : nullptr;
+
+    std::vector<ColorSpinorField *> buffer[2];
+    if (staged) {
+      for (auto &b : buffer)
+        for (int i = 0; i < std::min(chunk_size, Nvec); i++) b.push_back(ColorSpinorField::Create(param));
     }
 
+    auto stage_chunk = [&](int slot, int first, int n) {
+      for (int i = 0; i < n; i++) stage(*buffer[slot][i], *vecs[first + i], intermediate, inflate, spinor_parity);
+    };
+
+    int device = 0;
+    if (cuda) cudaGetDevice(&device);
+
     if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Start saving %d vectors to %s\n", Nvec, filename.c_str());
 
-    if (vecs[0]->Ndim() == 4 || vecs[0]->Ndim() == 5) {
-      // since QIO routines presently assume we have 4-d fields, we need to convert to array of 4-d fields
-      auto Ls = vecs[0]->Ndim() == 5 ? tmp[0]->X(4) : 1;
-      auto V4 = tmp[0]->Volume() / Ls;
-      auto stride = V4 * tmp[0]->Ncolor() * tmp[0]->Nspin() * 2 * tmp[0]->Precision();
-      void **V = static_cast<void **>(safe_malloc(Nvec * Ls * sizeof(void *)));
-      for (int i = 0; i < Nvec; i++) {
-        for (int j = 0; j < Ls; j++) { V[i * Ls + j] = static_cast<char *>(tmp[i]->V()) + j * stride; }
+    Timer write_timer, total_timer;
+    total_timer.Start(__func__, __FILE__, __LINE__);
+    double bytes = 0.0;
+
+    void *writer = nullptr;
+    CompressedVectorWriter *compressed_writer = nullptr;
+    if (compressed)
+      compressed_writer = new CompressedVectorWriter(filename, staged ? *buffer[0][0] : *vecs[0], Nvec, compress_prec,
+                                                     compress_lossless);
+    else
+      writer = open_spinor_writer(filename.c_str(), param.x, param.siteSubset);
+
+    // write chunk k on this thread while chunk k+1 is downloaded and converted by the worker
+    if (staged) stage_chunk(0, 0, std::min(chunk_size, Nvec));
+    std::thread worker;
+    int slot = 0;
+    for (int first = 0; first < Nvec;) {
+      const int n = std::min(chunk_size, Nvec - first);
+      const int next = first + n;
+      if (staged && next < Nvec) {
+        worker = std::thread([&, slot, next]() {
+          if (cuda) cudaSetDevice(device);
+          stage_chunk(1 - slot, next, std::min(chunk_size, Nvec - next));
+        });
       }
 
-      write_spinor_field(filename.c_str(), &V[0], tmp[0]->Precision(), tmp[0]->X(), tmp[0]->SiteSubset(), spinor_parity,
-                         tmp[0]->Ncolor(), tmp[0]->Nspin(), Nvec * Ls, 0, (char **)0);
+      auto &src = staged ? buffer[slot] : vecs;
+      const int offset = staged ? 0 : first;
 
-      host_free(V);
-    } else {
-      errorQuda("Unexpected field dimension %d", vecs[0]->Ndim());
-    }
+      write_timer.Start(__func__, __FILE__, __LINE__);
+      if (compressed) {
+        compressed_writer->write(src, offset, n);
+      } else {
+        auto V = fieldPointers(src, offset, n);
+        write_spinor_record(writer, V.data(), src[offset]->Precision(), param.siteSubset, spinor_parity, param.nColor,
+                            param.nSpin, n * Ls);
+      }
+      write_timer.Stop(__func__, __FILE__, __LINE__);
+      bytes += static_cast<double>(n) * src[offset]->Bytes();
 
-    if (getVerbosity() >= QUDA_SUMMARIZE) printfQuda("Done saving vectors\n");
-    if (vecs[0]->Location() == QUDA_CUDA_FIELD_LOCATION
-        || (vecs[0]->Location() == QUDA_CPU_FIELD_LOCATION && vecs[0]->SiteSubset() == QUDA_PARITY_SITE_SUBSET)) {
-      for (int i = 0; i < Nvec; i++) delete tmp[i];
+      if (worker.joinable()) worker.join();
+      if (staged) slot = 1 - slot;
+      first = next;
     }
-#else
-    errorQuda("\nQIO library was not built.\n");
-#endif
+
+    if (compressed)
+      delete compressed_writer;
+    else
+      close_spinor_writer(writer);
+
+    for (auto &b : buffer)
+      for (auto v : b) delete v;
+    if (intermediate) delete intermediate;
+
+    total_timer.Stop(__func__, __FILE__, __LINE__);
+    comm_allreduce(&bytes);
+    double write_time = write_timer.time;
+    comm_allreduce_max(&write_time);
+
+    if (getVerbosity() >= QUDA_SUMMARIZE)
+      printfQuda("Done saving vectors: wrote %.3f GB in %.3f s (%.3f GB/s), total time %.3f s\n", bytes / 1e9,
+                 write_time, bytes / (1e9 * write_time), total_timer.time);
   }
 
 } // namespace quda
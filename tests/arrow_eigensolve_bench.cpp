@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <quda_internal.h>
+#include <arrow_eigensolve.h>
+#include <util_quda.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Dense>
+
+/**
+   @file arrow_eigensolve_bench.cpp
+
+   @brief Host benchmark of the eigensolve of the thick restarted
+   Lanczos restart matrix: a diagonal block of kept Ritz values coupled
+   through an arrow row to a tridiagonal tail.  The structured
+   ArrowEigensolver, computing all eigenvalues and residua but only the
+   kept Ritz vectors, is compared against the dense path it replaced,
+   which forms the full matrix, calls Eigen's SelfAdjointEigenSolver
+   and copies out every eigenvector.  The maximum difference in the
+   eigenvalues and residua between the two is reported as a check.
+   The number of threads is set by OMP_NUM_THREADS.
+*/
+
+using namespace quda;
+using namespace Eigen;
+
+// benchmark specific parameters
+int bench_warmup = 1;
+int arrow_dim = 0;
+double arrow_keep = 0.5;
+
+struct ArrowMat {
+  int dim;
+  int arrow_pos;
+  std::vector<double> alpha;
+  std::vector<double> beta;
+  double beta_last;
+};
+
+/**
+   @brief Create a random restart matrix resembling a TRLM restart:
+   sorted Ritz values in the arrow block with small couplings, and a
+   Lanczos tridiagonal tail
+ */
+static ArrowMat createArrowMat(int dim, int arrow_pos)
+{
+  ArrowMat A {dim, arrow_pos, std::vector<double>(dim), std::vector<double>(dim - 1), drand48()};
+  for (int i = 0; i < dim; i++) A.alpha[i] = 2.0 * drand48() - 1.0;
+  std::sort(A.alpha.begin(), A.alpha.begin() + arrow_pos);
+  for (int i = 0; i < dim - 1; i++) A.beta[i] = i < arrow_pos ? 1e-3 * drand48() : drand48();
+  return A;
+}
+
+static void denseSolve(const ArrowMat &A, std::vector<double> &evals, std::vector<double> &residua,
+                       std::vector<double> &ritz_mat)
+{
+  const int dim = A.dim;
+  MatrixXd M = MatrixXd::Zero(dim, dim);
+  for (int i = 0; i < dim; i++) M(i, i) = A.alpha[i];
+  for (int i = 0; i < A.arrow_pos; i++) M(i, A.arrow_pos) = M(A.arrow_pos, i) = A.beta[i];
+  for (int i = A.arrow_pos; i < dim - 1; i++) M(i, i + 1) = M(i + 1, i) = A.beta[i];
+
+  SelfAdjointEigenSolver<MatrixXd> eigensolver;
+  eigensolver.compute(M);
+
+  ritz_mat.resize(dim * dim);
+  for (int i = 0; i < dim; i++)
+    for (int j = 0; j < dim; j++) ritz_mat[dim * i + j] = eigensolver.eigenvectors().col(i)[j];
+
+  for (int i = 0; i < dim; i++) {
+    residua[i] = fabs(A.beta_last * eigensolver.eigenvectors().col(i)[dim - 1]);
+    evals[i] = eigensolver.eigenvalues()[i];
+  }
+}
+
+static void arrowSolve(const ArrowMat &A, int n_keep, std::vector<double> &evals, std::vector<double> &residua,
+                       std::vector<double> &ritz_mat)
+{
+  const int dim = A.dim;
+  ArrowEigensolver arrow_eig;
+  arrow_eig.compute(A.alpha.data(), A.beta.data(), dim, A.arrow_pos);
+
+  std::vector<double> unit(dim, 0.0);
+  std::vector<double> last(dim);
+  unit[dim - 1] = 1.0;
+  arrow_eig.project(last.data(), unit.data());
+  for (int i = 0; i < dim; i++) {
+    residua[i] = fabs(A.beta_last * last[i]);
+    evals[i] = arrow_eig.eigenvalues()[i];
+  }
+
+  ritz_mat.resize(dim * n_keep);
+  arrow_eig.eigenvectors(ritz_mat.data(), n_keep);
+}
+
+template <typename Solve> static double benchmark(Solve solve)
+{
+  for (int i = 0; i < bench_warmup; i++) solve();
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) solve();
+  return stopwatchReadSeconds() / niter;
+}
+
+int main(int argc, char **argv)
+{
+  niter = 10;
+  auto app = make_app();
+  app->add_option("--bench-warmup", bench_warmup, "Number of untimed warmup iterations per measurement (default 1)");
+  app->add_option("--arrow-dim", arrow_dim,
+                  "Dimension of the restart matrix (default 0, sweeping over 128, 256, 512, 1024 and 2048)");
+  app->add_option("--arrow-keep", arrow_keep,
+                  "Fraction of the dimension in the arrow block and of Ritz vectors kept (default 0.5)");
+
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  setVerbosity(verbosity);
+
+  std::vector<int> dims = {128, 256, 512, 1024, 2048};
+  if (arrow_dim > 0) dims = {arrow_dim};
+
+  printfQuda("\nTRLM arrow matrix eigensolve, %.2f of the dimension kept (%d iterations)\n", arrow_keep, niter);
+  printfQuda("%8s %8s %14s %14s %10s %12s %12s\n", "dim", "keep", "dense (ms)", "arrow (ms)", "speedup", "eval diff",
+             "resid diff");
+
+  for (auto dim : dims) {
+    int n_keep = std::min(std::max(1, static_cast<int>(arrow_keep * dim)), dim - 1);
+    ArrowMat A = createArrowMat(dim, n_keep);
+
+    std::vector<double> evals_dense(dim), residua_dense(dim), ritz_dense;
+    std::vector<double> evals_arrow(dim), residua_arrow(dim), ritz_arrow;
+
+    double t_dense = benchmark([&]() { denseSolve(A, evals_dense, residua_dense, ritz_dense); });
+    double t_arrow = benchmark([&]() { arrowSolve(A, n_keep, evals_arrow, residua_arrow, ritz_arrow); });
+
+    double eval_diff = 0.0, resid_diff = 0.0;
+    for (int i = 0; i < dim; i++) {
+      eval_diff = std::max(eval_diff, fabs(evals_dense[i] - evals_arrow[i]));
+      resid_diff = std::max(resid_diff, fabs(residua_dense[i] - residua_arrow[i]));
+    }
+
+    printfQuda("%8d %8d %14.3f %14.3f %10.2f %12.3e %12.3e\n", dim, n_keep, 1e3 * t_dense, 1e3 * t_arrow,
+               t_dense / t_arrow, eval_diff, resid_diff);
+  }
+
+  finalizeComms();
+  return 0;
+}
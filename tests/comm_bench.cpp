@@ -0,0 +1,323 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include <quda_internal.h>
+#include <comm_quda.h>
+#include <malloc_quda.h>
+#include <color_spinor_field.h>
+#include <util_quda.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+/**
+   @file comm_bench.cpp
+
+   @brief Microbenchmark for the QUDA communications layer.  This
+   measures point-to-point latency and bandwidth (per dimension and
+   direction), the fraction of the message time that can be hidden
+   behind host work, collective reduction and broadcast costs, and the
+   halo-exchange-only cost of exchangeGhost.  The message sizes are
+   derived from the actual face sizes of the Wilson (nFace=1),
+   staggered (nFace=3) and coarse (nFace=1) operators for the local
+   volume given by --dim.  With the single-process backend all message
+   handles are null, and the point-to-point exchange is emulated with
+   a local loopback copy so that a node can be baselined in isolation.
+*/
+
+using namespace quda;
+
+// benchmark specific parameters
+int bench_warmup = 10;
+int bench_coarse_nvec = 24;
+int bench_coarse_block = 4;
+bool bench_exchange_ghost = true;
+
+// sink for the host work so that it is not optimized away
+volatile double work_sink = 0.0;
+
+struct MessageSize {
+  const char *name;
+  int nFace;
+  size_t bytes[QUDA_MAX_DIM]; // message size in each dimension
+};
+
+/**
+   @brief Return the number of bytes per site of a ghost zone for a
+   given number of real numbers per site and precision, including the
+   per-site norm for fixed-point fields.
+ */
+static size_t ghostSiteBytes(int reals, QudaPrecision precision)
+{
+  size_t bytes = reals * precision;
+  if (precision < QUDA_SINGLE_PRECISION) bytes += sizeof(float);
+  return bytes;
+}
+
+static std::vector<MessageSize> faceSizes()
+{
+  std::vector<MessageSize> sizes;
+
+  int X[4] = {xdim, ydim, zdim, tdim};
+  int volumeCB = X[0] * X[1] * X[2] * X[3] / 2;
+
+  // Wilson: spin-projected half spinor, single face
+  MessageSize wilson = {"wilson", 1, {}};
+  for (int d = 0; d < 4; d++) wilson.bytes[d] = wilson.nFace * (volumeCB / X[d]) * ghostSiteBytes(12, prec);
+  sizes.push_back(wilson);
+
+  // staggered: full color vector, three faces for the Naik term
+  MessageSize staggered = {"staggered", 3, {}};
+  for (int d = 0; d < 4; d++) staggered.bytes[d] = staggered.nFace * (volumeCB / X[d]) * ghostSiteBytes(6, prec);
+  sizes.push_back(staggered);
+
+  // coarse: chirality x nvec color vector on the coarse lattice, no spin projection
+  int Xc[4];
+  for (int d = 0; d < 4; d++) Xc[d] = std::max(X[d] / bench_coarse_block, 1);
+  int coarseVolumeCB = std::max(Xc[0] * Xc[1] * Xc[2] * Xc[3] / 2, 1);
+  MessageSize coarse = {"coarse", 1, {}};
+  for (int d = 0; d < 4; d++)
+    coarse.bytes[d] = coarse.nFace * std::max(coarseVolumeCB / Xc[d], 1) * ghostSiteBytes(2 * 2 * bench_coarse_nvec, prec);
+  sizes.push_back(coarse);
+
+  return sizes;
+}
+
+/**
+   @brief Host work used to measure how much of a message can be
+   overlapped.  The result is accumulated into work_sink to prevent
+   the compiler from eliding the loop.
+ */
+static double hostWork(double *buf, size_t n, int reps)
+{
+  double sum = 0.0;
+  for (int r = 0; r < reps; r++) {
+    for (size_t i = 0; i < n; i++) {
+      buf[i] = 1.000001 * buf[i] + 1e-9;
+      sum += buf[i];
+    }
+  }
+  return sum;
+}
+
+struct P2PResult {
+  double time;    // seconds per exchange (send + receive)
+  double overlap; // fraction of the message time hidden behind host work
+};
+
+/**
+   @brief Measure the exchange of a message of size nbytes in a given
+   dimension and direction: each rank sends to the neighbor in
+   direction dir and receives from the neighbor in direction -dir.
+ */
+static P2PResult benchP2P(int dim, int dir, size_t nbytes, double *work, size_t work_n)
+{
+  void *send = pinned_malloc(nbytes);
+  void *recv = pinned_malloc(nbytes);
+  memset(send, 0, nbytes);
+  memset(recv, 0, nbytes);
+
+  MsgHandle *mh_send = comm_declare_send_relative(send, dim, dir, nbytes);
+  MsgHandle *mh_recv = comm_declare_receive_relative(recv, dim, -dir, nbytes);
+
+  // null handles correspond to the single-process backend: emulate with a loopback copy
+  auto exchange_start = [&]() {
+    if (mh_recv) comm_start(mh_recv);
+    if (mh_send) comm_start(mh_send);
+  };
+  auto exchange_wait = [&]() {
+    if (mh_send) comm_wait(mh_send);
+    if (mh_recv) comm_wait(mh_recv);
+    if (!mh_send || !mh_recv) memcpy(recv, send, nbytes);
+  };
+
+  for (int i = 0; i < bench_warmup; i++) {
+    exchange_start();
+    exchange_wait();
+  }
+
+  comm_barrier();
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) {
+    exchange_start();
+    exchange_wait();
+  }
+  double t_comm = stopwatchReadSeconds() / niter;
+
+  // calibrate host work to take roughly as long as the exchange
+  stopwatchStart();
+  work_sink += hostWork(work, work_n, 1);
+  double t_unit = std::max(stopwatchReadSeconds(), 1e-7);
+  int reps = std::max(static_cast<int>(t_comm / t_unit), 1);
+
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) work_sink += hostWork(work, work_n, reps);
+  double t_work = stopwatchReadSeconds() / niter;
+
+  comm_barrier();
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) {
+    exchange_start();
+    work_sink += hostWork(work, work_n, reps);
+    exchange_wait();
+  }
+  double t_both = stopwatchReadSeconds() / niter;
+
+  // overlap is the fraction of the shorter phase that was hidden
+  double hidden = t_comm + t_work - t_both;
+  double overlap = std::min(std::max(hidden / std::min(t_comm, t_work), 0.0), 1.0);
+
+  // report the slowest rank
+  comm_allreduce_max(&t_comm);
+  comm_allreduce_min(&overlap);
+
+  if (mh_send) comm_free(mh_send);
+  if (mh_recv) comm_free(mh_recv);
+  host_free(recv);
+  host_free(send);
+
+  return {t_comm, overlap};
+}
+
+static void pointToPointBench(const std::vector<MessageSize> &sizes)
+{
+  const size_t work_n = 4096;
+  double *work = static_cast<double *>(safe_malloc(work_n * sizeof(double)));
+  for (size_t i = 0; i < work_n; i++) work[i] = 1.0;
+
+  printfQuda("\nPoint-to-point exchange (%s, %d iterations, slowest rank)\n",
+             comm_size() > 1 ? "inter-process" : "single-process loopback", niter);
+  printfQuda("%-10s %3s %4s %12s %12s %12s %10s\n", "operator", "dim", "dir", "bytes", "time (us)", "GB/s", "overlap");
+
+  for (auto &size : sizes) {
+    for (int d = 0; d < 4; d++) {
+      if (comm_size() > 1 && !comm_dim_partitioned(d)) continue;
+      for (int dir = -1; dir <= 1; dir += 2) {
+        auto r = benchP2P(d, dir, size.bytes[d], work, work_n);
+        printfQuda("%-10s %3d %4s %12lu %12.3f %12.3f %10.3f\n", size.name, d, dir > 0 ? "fwd" : "back", size.bytes[d],
+                   1e6 * r.time, size.bytes[d] / (1e9 * r.time), r.overlap);
+      }
+    }
+  }
+
+  // small message latency
+  printfQuda("\nLatency (8 byte message)\n");
+  for (int d = 0; d < 4; d++) {
+    if (comm_size() > 1 && !comm_dim_partitioned(d)) continue;
+    for (int dir = -1; dir <= 1; dir += 2) {
+      auto r = benchP2P(d, dir, sizeof(double), work, work_n);
+      printfQuda("dim = %d dir = %4s latency = %8.3f us\n", d, dir > 0 ? "fwd" : "back", 1e6 * r.time);
+    }
+  }
+
+  host_free(work);
+}
+
+static void collectiveBench()
+{
+  printfQuda("\nCollectives (%d iterations, slowest rank)\n", niter);
+  printfQuda("%-22s %12s %12s\n", "operation", "bytes", "time (us)");
+
+  // reduction lengths used by blas (1), multi-reduce (up to 16x16) and the eigensolvers
+  for (size_t n : {1, 2, 3, 16, 256, 4096}) {
+    std::vector<double> data(n, 1.0);
+    for (int i = 0; i < bench_warmup; i++) comm_allreduce_array(data.data(), n);
+    comm_barrier();
+    stopwatchStart();
+    for (int i = 0; i < niter; i++) comm_allreduce_array(data.data(), n);
+    double t = stopwatchReadSeconds() / niter;
+    comm_allreduce_max(&t);
+    printfQuda("%-22s %12lu %12.3f\n", "comm_allreduce_array", n * sizeof(double), 1e6 * t);
+  }
+
+  for (size_t nbytes : {8, 1024, 65536, 1048576}) {
+    std::vector<char> data(nbytes, 0);
+    for (int i = 0; i < bench_warmup; i++) comm_broadcast(data.data(), nbytes);
+    comm_barrier();
+    stopwatchStart();
+    for (int i = 0; i < niter; i++) comm_broadcast(data.data(), nbytes);
+    double t = stopwatchReadSeconds() / niter;
+    comm_allreduce_max(&t);
+    printfQuda("%-22s %12lu %12.3f\n", "comm_broadcast", nbytes, 1e6 * t);
+  }
+}
+
+static void exchangeGhostBench(const char *name, int nSpin, int nColor, int nFace, int block)
+{
+  ColorSpinorParam param;
+  param.nColor = nColor;
+  param.nSpin = nSpin;
+  param.nDim = 4;
+  int X[4] = {xdim, ydim, zdim, tdim};
+  for (int d = 0; d < 4; d++) param.x[d] = std::max(X[d] / block, 2);
+  param.x[0] /= 2; // single parity
+  param.siteSubset = QUDA_PARITY_SITE_SUBSET;
+  param.siteOrder = QUDA_EVEN_ODD_SITE_ORDER;
+  param.setPrecision(prec, prec, true);
+  param.pad = 0;
+  param.gammaBasis = nSpin == 4 ? QUDA_UKQCD_GAMMA_BASIS : QUDA_DEGRAND_ROSSI_GAMMA_BASIS;
+  param.create = QUDA_ZERO_FIELD_CREATE;
+
+  cudaColorSpinorField x(param);
+
+  for (int i = 0; i < bench_warmup; i++) x.exchangeGhost(QUDA_EVEN_PARITY, nFace, 0);
+  qudaDeviceSynchronize();
+  comm_barrier();
+
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) x.exchangeGhost(QUDA_EVEN_PARITY, nFace, 0);
+  qudaDeviceSynchronize();
+  double t = stopwatchReadSeconds() / niter;
+  comm_allreduce_max(&t);
+
+  printfQuda("%-10s %12lu %12.3f %12.3f\n", name, x.GhostBytes(), 1e6 * t, x.GhostBytes() / (1e9 * t));
+}
+
+static void haloBench()
+{
+  printfQuda("\nHalo exchange only: exchangeGhost (%d iterations, slowest rank)\n", niter);
+  printfQuda("%-10s %12s %12s %12s\n", "operator", "ghost bytes", "time (us)", "GB/s");
+  exchangeGhostBench("wilson", 4, 3, 1, 1);
+  exchangeGhostBench("staggered", 1, 3, 3, 1);
+#ifdef GPU_MULTIGRID
+  exchangeGhostBench("coarse", 2, bench_coarse_nvec, 1, bench_coarse_block);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  auto app = make_app();
+  app->add_option("--bench-warmup", bench_warmup, "Number of untimed warmup iterations per measurement (default 10)");
+  app->add_option("--bench-coarse-nvec", bench_coarse_nvec, "Number of null vectors defining the coarse face size (default 24)");
+  app->add_option("--bench-coarse-block", bench_coarse_block, "Aggregate size defining the coarse lattice (default 4)");
+  app->add_option("--bench-exchange-ghost", bench_exchange_ghost, "Time exchangeGhost on device fields (default true)");
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+
+  initQuda(device);
+  setVerbosity(verbosity);
+
+  printfQuda("Running comm_bench on %d process(es), local volume %d x %d x %d x %d, precision %d bytes\n", comm_size(),
+             xdim, ydim, zdim, tdim, prec);
+  printfQuda("Process grid %d x %d x %d x %d, partitioned %d %d %d %d\n", comm_dim(0), comm_dim(1), comm_dim(2),
+             comm_dim(3), comm_dim_partitioned(0), comm_dim_partitioned(1), comm_dim_partitioned(2),
+             comm_dim_partitioned(3));
+
+  auto sizes = faceSizes();
+  pointToPointBench(sizes);
+  collectiveBench();
+  if (bench_exchange_ghost) haloBench();
+
+  endQuda();
+  finalizeComms();
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <quda_internal.h>
+#include <gauge_field.h>
+#include <util_quda.h>
+
+#include <host_utils.h>
+#include <command_line_params.h>
+
+/**
+   @file gauge_copy_bench.cpp
+
+   @brief Benchmark for the CPU gauge field reordering done by
+   copyGenericGauge when gauge fields are loaded from, or saved to,
+   an application.  For every pair of host gauge orders that are
+   built (QDP, MILC, CPS, BQCD, TIFR and padded TIFR) this reports the
+   time and bandwidth of the reorder, where the bytes counted are
+   those read plus those written.  Each destination order is also
+   converted back to QDP order and compared against the source to
+   check the reorder.  The number of threads is set by OMP_NUM_THREADS.
+*/
+
+using namespace quda;
+
+// benchmark specific parameters
+int bench_warmup = 2;
+
+struct Order {
+  QudaGaugeFieldOrder order;
+  const char *name;
+};
+
+static std::vector<Order> hostOrders()
+{
+  std::vector<Order> orders;
+#ifdef BUILD_QDP_INTERFACE
+  orders.push_back({QUDA_QDP_GAUGE_ORDER, "qdp"});
+#endif
+#ifdef BUILD_MILC_INTERFACE
+  orders.push_back({QUDA_MILC_GAUGE_ORDER, "milc"});
+#endif
+#ifdef BUILD_CPS_INTERFACE
+  orders.push_back({QUDA_CPS_WILSON_GAUGE_ORDER, "cps"});
+#endif
+#ifdef BUILD_BQCD_INTERFACE
+  orders.push_back({QUDA_BQCD_GAUGE_ORDER, "bqcd"});
+#endif
+#ifdef BUILD_TIFR_INTERFACE
+  orders.push_back({QUDA_TIFR_GAUGE_ORDER, "tifr"});
+  orders.push_back({QUDA_TIFR_PADDED_GAUGE_ORDER, "tifr-padded"});
+#endif
+  return orders;
+}
+
+static cpuGaugeField *createField(QudaGaugeFieldOrder order, QudaPrecision precision)
+{
+  QudaGaugeParam gauge_param = newQudaGaugeParam();
+  setWilsonGaugeParam(gauge_param);
+  gauge_param.cpu_prec = precision;
+  gauge_param.gauge_order = order;
+  gauge_param.anisotropy = 1.0;
+
+  GaugeFieldParam param(nullptr, gauge_param);
+  param.create = QUDA_ZERO_FIELD_CREATE;
+  param.ghostExchange = QUDA_GHOST_EXCHANGE_NO;
+  return new cpuGaugeField(param);
+}
+
+/**
+   @brief Return the maximum absolute difference between two QDP-order fields
+ */
+template <typename Float> static double maxDiff(const cpuGaugeField &a, const cpuGaugeField &b)
+{
+  double diff = 0.0;
+  for (int d = 0; d < 4; d++) {
+    const Float *u = static_cast<const Float *const *>(a.Gauge_p())[d];
+    const Float *v = static_cast<const Float *const *>(b.Gauge_p())[d];
+    for (size_t i = 0; i < a.Volume() * gauge_site_size; i++) diff = std::max(diff, std::fabs((double)u[i] - v[i]));
+  }
+  return diff;
+}
+
+/**
+   @brief Reorder the body of a host field (the fields have no ghost zones)
+ */
+static void copyBody(cpuGaugeField &out, const cpuGaugeField &in)
+{
+  copyGenericGauge(out, in, QUDA_CPU_FIELD_LOCATION, out.Gauge_p(), const_cast<void *>(in.Gauge_p()), 0, 0, 2);
+}
+
+static double reorder(cpuGaugeField &out, const cpuGaugeField &in)
+{
+  for (int i = 0; i < bench_warmup; i++) copyBody(out, in);
+
+  stopwatchStart();
+  for (int i = 0; i < niter; i++) copyBody(out, in);
+  double t = stopwatchReadSeconds() / niter;
+  comm_allreduce_max(&t);
+  return t;
+}
+
+int main(int argc, char **argv)
+{
+  auto app = make_app();
+  app->add_option("--bench-warmup", bench_warmup, "Number of untimed warmup iterations per measurement (default 2)");
+
+  try {
+    app->parse(argc, argv);
+  } catch (const CLI::ParseError &e) {
+    return app->exit(e);
+  }
+
+  initComms(argc, argv, gridsize_from_cmdline);
+  initQuda(device);
+  setVerbosity(verbosity);
+
+  int X[4] = {xdim, ydim, zdim, tdim};
+  setDims(X);
+
+  auto orders = hostOrders();
+  if (orders.size() == 0 || orders[0].order != QUDA_QDP_GAUGE_ORDER)
+    errorQuda("The QDP interface is needed for the reference field");
+
+  for (auto precision : {QUDA_DOUBLE_PRECISION, QUDA_SINGLE_PRECISION}) {
+    printfQuda("\nHost gauge reorder, local volume %d x %d x %d x %d, %d-byte precision (%d iterations, slowest rank)\n",
+               xdim, ydim, zdim, tdim, precision, niter);
+    printfQuda("%-12s %-12s %12s %12s %12s\n", "source", "destination", "time (ms)", "GB/s", "max diff");
+
+    // random QDP-order reference field that each source is generated from
+    cpuGaugeField *reference = createField(QUDA_QDP_GAUGE_ORDER, precision);
+    for (int d = 0; d < 4; d++) {
+      for (size_t i = 0; i < reference->Volume() * gauge_site_size; i++) {
+        if (precision == QUDA_DOUBLE_PRECISION)
+          static_cast<double **>(reference->Gauge_p())[d][i] = 2.0 * drand48() - 1.0;
+        else
+          static_cast<float **>(reference->Gauge_p())[d][i] = 2.0 * drand48() - 1.0;
+      }
+    }
+    cpuGaugeField *check = createField(QUDA_QDP_GAUGE_ORDER, precision);
+
+    for (auto &src : orders) {
+      cpuGaugeField *in = createField(src.order, precision);
+      copyBody(*in, *reference);
+
+      for (auto &dst : orders) {
+        cpuGaugeField *out = createField(dst.order, precision);
+        double t = reorder(*out, *in);
+
+        copyBody(*check, *out);
+        double diff = precision == QUDA_DOUBLE_PRECISION ? maxDiff<double>(*check, *reference) :
+                                                           maxDiff<float>(*check, *reference);
+        comm_allreduce_max(&diff);
+
+        printfQuda("%-12s %-12s %12.3f %12.3f %12.3e\n", src.name, dst.name, 1e3 * t,
+                   (in->Bytes() + out->Bytes()) / (1e9 * t), diff);
+        delete out;
+      }
+      delete in;
+    }
+
+    delete check;
+    delete reference;
+  }
+
+  endQuda();
+  finalizeComms();
+  return 0;
+}
@@ -109,6 +109,8 @@ quda::mgarray<int> num_setup_iter = {};
 quda::mgarray<double> setup_tol = {};
 quda::mgarray<int> setup_maxiter = {};
 quda::mgarray<int> setup_maxiter_refresh = {};
+quda::mgarray<double> setup_refresh_tol = {};
+quda::mgarray<int> setup_block_size = {};
 quda::mgarray<QudaCABasis> setup_ca_basis = {};
 quda::mgarray<int> setup_ca_basis_size = {};
 quda::mgarray<double> setup_ca_lambda_min = {};
@@ -119,6 +121,7 @@ bool post_orthonormalize = true;
 double omega = 0.85;
 quda::mgarray<QudaInverterType> coarse_solver = {};
 quda::mgarray<double> coarse_solver_tol = {};
+quda::mgarray<double> coarse_solver_tol_max = {};
 quda::mgarray<QudaInverterType> smoother_type = {};
 QudaPrecision smoother_halo_prec = QUDA_INVALID_PRECISION;
 quda::mgarray<double> smoother_tol = {};
@@ -130,6 +133,7 @@ quda::mgarray<double> coarse_solver_ca_lambda_max = {};
 bool generate_nullspace = true;
 bool generate_all_levels = true;
 quda::mgarray<QudaSchwarzType> mg_schwarz_type = {};
+quda::mgarray<QudaMultigridCycleType> mg_cycle_type = {};
 quda::mgarray<int> mg_schwarz_cycle = {};
 bool mg_evolve_thin_updates = false;
 
@@ -177,6 +181,11 @@ char eig_vec_infile[256] = "";
 char eig_vec_outfile[256] = "";
 bool eig_io_parity_inflate = false;
 QudaPrecision eig_save_prec = QUDA_DOUBLE_PRECISION;
+QudaPrecision eig_io_compress_prec = QUDA_INVALID_PRECISION;
+bool eig_io_compress_lossless = false;
+char eig_checkpoint_file[256] = "";
+int eig_checkpoint_interval = 1;
+bool eig_resume = false;
 
 // Parameters for the MG eigensolver.
 // The coarsest grid params are for deflation,
@@ -200,6 +209,9 @@ quda::mgarray<bool> mg_eig_use_dagger = {};
 quda::mgarray<QudaEigSpectrumType> mg_eig_spectrum = {};
 quda::mgarray<QudaEigType> mg_eig_type = {};
 quda::mgarray<QudaPrecision> mg_eig_save_prec = {};
+quda::mgarray<QudaPrecision> mg_vec_compress_prec = {};
+bool mg_vec_compress_lossless = false;
+char mg_hierarchy_cache[256] = "";
 
 bool mg_eig_coarse_guess = false;
 bool mg_eig_preserve_deflation = false;
@@ -278,7 +290,8 @@ namespace
                                                            {"ca-cg", QUDA_CA_CG_INVERTER},
                                                            {"ca-cgne", QUDA_CA_CGNE_INVERTER},
                                                            {"ca-cgnr", QUDA_CA_CGNR_INVERTER},
-                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER}};
+                                                           {"ca-gcr", QUDA_CA_GCR_INVERTER},
+                                                           {"gcrodr", QUDA_GCRODR_INVERTER}};
 
   CLI::TransformPairs<QudaPrecision> precision_map {{"double", QUDA_DOUBLE_PRECISION},
                                                     {"single", QUDA_SINGLE_PRECISION},
@@ -343,6 +356,11 @@ namespace
 
   CLI::TransformPairs<QudaSetupType> setup_type_map {{"test", QUDA_TEST_VECTOR_SETUP}, {"null", QUDA_TEST_VECTOR_SETUP}};
 
+  CLI::TransformPairs<QudaMultigridCycleType> cycle_type_map {{"vcycle", QUDA_MG_CYCLE_VCYCLE},
+                                                              {"wcycle", QUDA_MG_CYCLE_WCYCLE},
+                                                              {"kcycle", QUDA_MG_CYCLE_RECURSIVE},
+                                                              {"recursive", QUDA_MG_CYCLE_RECURSIVE}};
+
   CLI::TransformPairs<QudaExtLibType> extlib_map {{"eigen", QUDA_EIGEN_EXTLIB}, {"magma", QUDA_MAGMA_EXTLIB}};
 
 } // namespace
@@ -411,7 +429,7 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
   quda_app->add_option(
     "--laplace3D", laplace3D,
     "Restrict laplace operator to omit the t dimension (n=3), or include all dims (n=4) (default 4)");
-  quda_app->add_option("--load-gauge", latfile, "Load gauge field \" file \" for the test (requires QIO)");
+  quda_app->add_option("--load-gauge", latfile, "Load gauge field \" file \" for the test (ILDG, SciDAC or NERSC format; uses QIO if enabled)");
   quda_app->add_option("--Lsdim", Lsdim, "Set Ls dimension size(default 16)");
   quda_app->add_option("--mass", mass, "Mass of Dirac operator (default 0.1)");
 
@@ -484,7 +502,7 @@ std::shared_ptr<QUDAApp> make_app(std::string app_description, std::string app_n
 
   quda_app->add_option("--reliable-delta", reliable_delta, "Set reliable update delta factor");
   quda_app->add_option("--save-gauge", gauge_outfile,
-                       "Save gauge field \" file \" for the test (requires QIO, heatbath test only)");
+                       "Save gauge field \" file \" for the test (ILDG format, heatbath test only)");
 
   quda_app->add_option("--solution-pipeline", solution_accumulator_pipeline,
                        "The pipeline length for fused solution accumulation (default 0, no pipelining)");
@@ -623,6 +641,19 @@ void add_eigen_option_group(std::shared_ptr<QUDAApp> quda_app)
 
   opgroup->add_option("--eig-io-parity-inflate", eig_io_parity_inflate,
                       "Whether to inflate single-parity eigenvectors onto dual parity full fields for file I/O (default = false)");
+  opgroup
+    ->add_option("--eig-io-compress-prec", eig_io_compress_prec,
+                 "If half or quarter, save eigenvectors in the compressed vector format with this precision (default "
+                 "= no compression)")
+    ->transform(prec_transform);
+  opgroup->add_option("--eig-io-compress-lossless", eig_io_compress_lossless,
+                      "Whether to apply lossless compression when saving compressed eigenvectors (default = false)");
+  opgroup->add_option("--eig-checkpoint-file", eig_checkpoint_file,
+                      "Checkpoint the Lanczos restart state to files with this prefix (default = no checkpointing)");
+  opgroup->add_option("--eig-checkpoint-interval", eig_checkpoint_interval,
+                      "Number of thick restarts between checkpoints (default = 1)");
+  opgroup->add_option("--eig-resume", eig_resume,
+                      "Whether to resume the eigensolve from the checkpoint given by --eig-checkpoint-file (default = false)");
 
   opgroup
     ->add_option("--eig-spectrum", eig_spectrum,
@@ -708,6 +739,11 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "The coarse solver maxiter for each level (default 100)");
   quda_app->add_mgoption(opgroup, "--mg-coarse-solver-tol", coarse_solver_tol, CLI::PositiveNumber,
                          "The coarse solver tolerance for each level (default 0.25, only for levels 1+)");
+  quda_app->add_mgoption(opgroup, "--mg-coarse-solver-tol-max", coarse_solver_tol_max, CLI::Range(0.0, 1.0),
+                         "The loosest coarse solver tolerance when adapting it to the outer residual reduction, "
+                         "0 for a fixed tolerance (default 0, only for levels 1+)");
+  quda_app->add_mgoption(opgroup, "--mg-cycle-type", mg_cycle_type, CLI::QUDACheckedTransformer(cycle_type_map),
+                         "The multigrid cycle applied from this level, vcycle, wcycle or kcycle (default kcycle)");
   quda_app->add_mgoption(opgroup, "--mg-eig", mg_eig, CLI::Validator(),
                          "Use the eigensolver on this level (default false)");
   quda_app->add_mgoption(opgroup, "--mg-eig-amax", mg_eig_amax, CLI::PositiveNumber,
@@ -768,6 +804,14 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
                          "Load the vectors <file> for the multigrid_test (requires QIO)");
   quda_app->add_mgoption(opgroup, "--mg-save-vec", mg_vec_outfile, CLI::Validator(),
                          "Save the generated null-space vectors <file> from the multigrid_test (requires QIO)");
+  quda_app->add_mgoption(opgroup, "--mg-save-vec-compress-prec", mg_vec_compress_prec, prec_transform,
+                         "If half or quarter, save the null-space vectors in the compressed vector format with this "
+                         "precision (default = no compression)");
+  opgroup->add_option("--mg-save-vec-compress-lossless", mg_vec_compress_lossless,
+                      "Whether to apply lossless compression when saving compressed null-space vectors (default false)");
+  opgroup->add_option("--mg-hierarchy-cache", mg_hierarchy_cache,
+                      "Persist the setup hierarchy per gauge configuration in <directory> and load it when it matches "
+                      "(default = no caching)");
 
   quda_app
     ->add_mgoption("--mg-eig-save-prec", mg_eig_save_prec, CLI::Validator(),
@@ -826,6 +870,10 @@ void add_multigrid_option_group(std::shared_ptr<QUDAApp> quda_app)
   quda_app->add_mgoption(
     opgroup, "--mg-setup-maxiter-refresh", setup_maxiter_refresh, CLI::Validator(),
     "The maximum number of solver iterations to use when refreshing the pre-existing null space vectors (default 100)");
+  quda_app->add_mgoption(opgroup, "--mg-setup-refresh-tol", setup_refresh_tol, CLI::Validator(),
+                         "The deviation below which a refresh keeps the prolongator and coarse operator (default 0)");
+  quda_app->add_mgoption(opgroup, "--mg-setup-block-size", setup_block_size, CLI::Validator(),
+                         "The number of null space vectors relaxed together in the setup, 0 for all (default 0)");
   quda_app->add_mgoption(opgroup, "--mg-setup-tol", setup_tol, CLI::Validator(),
                          "The tolerance to use for the setup of multigrid (default 5e-6)");
 
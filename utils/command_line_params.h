@@ -242,6 +242,8 @@ extern quda::mgarray<int> num_setup_iter;
 extern quda::mgarray<double> setup_tol;
 extern quda::mgarray<int> setup_maxiter;
 extern quda::mgarray<int> setup_maxiter_refresh;
+extern quda::mgarray<double> setup_refresh_tol;
+extern quda::mgarray<int> setup_block_size;
 extern quda::mgarray<QudaCABasis> setup_ca_basis;
 extern quda::mgarray<int> setup_ca_basis_size;
 extern quda::mgarray<double> setup_ca_lambda_min;
@@ -252,6 +254,7 @@ extern bool post_orthonormalize;
 extern double omega;
 extern quda::mgarray<QudaInverterType> coarse_solver;
 extern quda::mgarray<double> coarse_solver_tol;
+extern quda::mgarray<double> coarse_solver_tol_max;
 extern quda::mgarray<QudaInverterType> smoother_type;
 extern QudaPrecision smoother_halo_prec;
 extern quda::mgarray<double> smoother_tol;
@@ -263,6 +266,7 @@ extern quda::mgarray<double> coarse_solver_ca_lambda_max;
 extern bool generate_nullspace;
 extern bool generate_all_levels;
 extern quda::mgarray<QudaSchwarzType> mg_schwarz_type;
+extern quda::mgarray<QudaMultigridCycleType> mg_cycle_type;
 extern quda::mgarray<int> mg_schwarz_cycle;
 extern bool mg_evolve_thin_updates;
 
@@ -309,6 +313,11 @@ extern char eig_vec_infile[256];
 extern char eig_vec_outfile[256];
 extern bool eig_io_parity_inflate;
 extern QudaPrecision eig_save_prec;
+extern QudaPrecision eig_io_compress_prec;
+extern bool eig_io_compress_lossless;
+extern char eig_checkpoint_file[256];
+extern int eig_checkpoint_interval;
+extern bool eig_resume;
 
 // Parameters for the MG eigensolver.
 // The coarsest grid params are for deflation,
@@ -332,6 +341,9 @@ extern quda::mgarray<bool> mg_eig_use_dagger;
 extern quda::mgarray<QudaEigSpectrumType> mg_eig_spectrum;
 extern quda::mgarray<QudaEigType> mg_eig_type;
 extern quda::mgarray<QudaPrecision> mg_eig_save_prec;
+extern quda::mgarray<QudaPrecision> mg_vec_compress_prec;
+extern bool mg_vec_compress_lossless;
+extern char mg_hierarchy_cache[256];
 
 extern bool mg_eig_coarse_guess;
 extern bool mg_eig_preserve_deflation;
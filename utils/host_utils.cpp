@@ -94,6 +94,8 @@ void setQudaDefaultMgTestParams()
     setup_tol[i] = 5e-6;
     setup_maxiter[i] = 500;
     setup_maxiter_refresh[i] = 20;
+    setup_refresh_tol[i] = 0.0;
+    setup_block_size[i] = 0;
     mu_factor[i] = 1.;
     coarse_solve_type[i] = QUDA_INVALID_SOLVE;
     smoother_solve_type[i] = QUDA_INVALID_SOLVE;
@@ -103,6 +105,8 @@ void setQudaDefaultMgTestParams()
     smoother_tol[i] = 0.25;
     coarse_solver[i] = QUDA_GCR_INVERTER;
     coarse_solver_tol[i] = 0.25;
+    coarse_solver_tol_max[i] = 0.0;
+    mg_cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
     coarse_solver_maxiter[i] = 100;
     solver_location[i] = QUDA_CUDA_FIELD_LOCATION;
     setup_location[i] = QUDA_CUDA_FIELD_LOCATION;
@@ -140,6 +144,7 @@ void setQudaDefaultMgTestParams()
 
     strcpy(mg_vec_infile[i], "");
     strcpy(mg_vec_outfile[i], "");
+    mg_vec_compress_prec[i] = QUDA_INVALID_PRECISION;
   }
 }
 
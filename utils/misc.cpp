@@ -289,6 +289,7 @@ const char *get_solver_str(QudaInverterType type)
   case QUDA_CA_CGNE_INVERTER: ret = "ca-cgne"; break;
   case QUDA_CA_CGNR_INVERTER: ret = "ca-cgnr"; break;
   case QUDA_CA_GCR_INVERTER: ret = "ca-gcr"; break;
+  case QUDA_GCRODR_INVERTER: ret = "gcrodr"; break;
   default:
     ret = "unknown";
     errorQuda("Error: invalid solver type %d\n", type);
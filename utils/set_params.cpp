@@ -296,6 +296,11 @@ void setEigParam(QudaEigParam &eig_param)
   strcpy(eig_param.vec_outfile, eig_vec_outfile);
   eig_param.save_prec = eig_save_prec;
   eig_param.io_parity_inflate = eig_io_parity_inflate ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  eig_param.io_compress_prec = eig_io_compress_prec;
+  eig_param.io_compress_lossless = eig_io_compress_lossless ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  strcpy(eig_param.checkpoint_file, eig_checkpoint_file);
+  eig_param.checkpoint_interval = eig_checkpoint_interval;
+  eig_param.resume = eig_resume ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 }
 
 void setMultigridParam(QudaMultigridParam &mg_param)
@@ -376,6 +381,8 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
     mg_param.setup_maxiter_refresh[i] = setup_maxiter_refresh[i];
+    mg_param.setup_refresh_tol[i] = setup_refresh_tol[i];
+    mg_param.setup_block_size[i] = setup_block_size[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -396,11 +403,12 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     mg_param.nu_post[i] = nu_post[i];
     mg_param.mu_factor[i] = mu_factor[i];
 
-    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.cycle_type[i] = mg_cycle_type[i];
 
     // set the coarse solver wrappers including bottom solver
     mg_param.coarse_solver[i] = coarse_solver[i];
     mg_param.coarse_solver_tol[i] = coarse_solver_tol[i];
+    mg_param.coarse_solver_tol_max[i] = coarse_solver_tol_max[i];
     mg_param.coarse_solver_maxiter[i] = coarse_solver_maxiter[i];
 
     // Basis to use for CA-CGN(E/R) coarse solver
@@ -535,7 +543,10 @@ void setMultigridParam(QudaMultigridParam &mg_param)
     strcpy(mg_param.vec_outfile[i], mg_vec_outfile[i]);
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
+    mg_param.vec_compress_prec[i] = mg_vec_compress_prec[i];
   }
+  mg_param.vec_compress_lossless = mg_vec_compress_lossless ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  strcpy(mg_param.hierarchy_cache, mg_hierarchy_cache);
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -696,6 +707,9 @@ void setMultigridEigParam(QudaEigParam &mg_eig_param, int level)
   // Give empty strings, Multigrid will handle IO.
   strcpy(mg_eig_param.vec_infile, "");
   strcpy(mg_eig_param.vec_outfile, "");
+  strcpy(mg_eig_param.checkpoint_file, "");
+  mg_eig_param.checkpoint_interval = 1;
+  mg_eig_param.resume = QUDA_BOOLEAN_FALSE;
   mg_eig_param.save_prec = mg_eig_save_prec[level];
   mg_eig_param.io_parity_inflate = QUDA_BOOLEAN_FALSE;
   strcpy(mg_eig_param.QUDA_logfile, eig_QUDA_logfile);
@@ -927,6 +941,8 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     mg_param.num_setup_iter[i] = num_setup_iter[i];
     mg_param.setup_tol[i] = setup_tol[i];
     mg_param.setup_maxiter[i] = setup_maxiter[i];
+    mg_param.setup_refresh_tol[i] = setup_refresh_tol[i];
+    mg_param.setup_block_size[i] = setup_block_size[i];
 
     // Basis to use for CA-CGN(E/R) setup
     mg_param.setup_ca_basis[i] = setup_ca_basis[i];
@@ -947,11 +963,12 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     mg_param.nu_post[i] = nu_post[i];
     mg_param.mu_factor[i] = mu_factor[i];
 
-    mg_param.cycle_type[i] = QUDA_MG_CYCLE_RECURSIVE;
+    mg_param.cycle_type[i] = mg_cycle_type[i];
 
     // set the coarse solver wrappers including bottom solver
     mg_param.coarse_solver[i] = coarse_solver[i];
     mg_param.coarse_solver_tol[i] = coarse_solver_tol[i];
+    mg_param.coarse_solver_tol_max[i] = coarse_solver_tol_max[i];
     mg_param.coarse_solver_maxiter[i] = coarse_solver_maxiter[i];
 
     // Basis to use for CA-CGN(E/R) coarse solver
@@ -1082,7 +1099,10 @@ void setStaggeredMultigridParam(QudaMultigridParam &mg_param)
     strcpy(mg_param.vec_outfile[i], mg_vec_outfile[i]);
     if (strcmp(mg_param.vec_infile[i], "") != 0) mg_param.vec_load[i] = QUDA_BOOLEAN_TRUE;
     if (strcmp(mg_param.vec_outfile[i], "") != 0) mg_param.vec_store[i] = QUDA_BOOLEAN_TRUE;
+    mg_param.vec_compress_prec[i] = mg_vec_compress_prec[i];
   }
+  mg_param.vec_compress_lossless = mg_vec_compress_lossless ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  strcpy(mg_param.hierarchy_cache, mg_hierarchy_cache);
 
   mg_param.coarse_guess = mg_eig_coarse_guess ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 
@@ -1160,7 +1180,8 @@ void setDeflatedInvertParam(QudaInvertParam &inv_param)
   inv_param.solve_type = solve_type;
   inv_param.matpc_type = matpc_type;
 
-  if (inv_type != QUDA_EIGCG_INVERTER && inv_type != QUDA_INC_EIGCG_INVERTER && inv_type != QUDA_GMRESDR_INVERTER)
+  if (inv_type != QUDA_EIGCG_INVERTER && inv_type != QUDA_INC_EIGCG_INVERTER && inv_type != QUDA_GMRESDR_INVERTER
+      && inv_type != QUDA_GCRODR_INVERTER)
     errorQuda("Requested solver %s is not a deflated solver type", get_solver_str(inv_type));
 
   //! For deflated solvers only:
@@ -1181,7 +1202,7 @@ void setDeflatedInvertParam(QudaInvertParam &inv_param)
 
   if (inv_param.inv_type == QUDA_EIGCG_INVERTER || inv_param.inv_type == QUDA_INC_EIGCG_INVERTER) {
     inv_param.solve_type = QUDA_NORMOP_PC_SOLVE;
-  } else if (inv_param.inv_type == QUDA_GMRESDR_INVERTER) {
+  } else if (inv_param.inv_type == QUDA_GMRESDR_INVERTER || inv_param.inv_type == QUDA_GCRODR_INVERTER) {
     inv_param.solve_type = QUDA_DIRECT_PC_SOLVE;
     inv_param.tol_restart = 0.0; // restart is not requested...
   }
@@ -1237,6 +1258,8 @@ void setDeflationParam(QudaEigParam &df_param)
   strcpy(df_param.vec_infile, eig_vec_infile);
   strcpy(df_param.vec_outfile, eig_vec_outfile);
   df_param.io_parity_inflate = eig_io_parity_inflate ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
+  df_param.io_compress_prec = eig_io_compress_prec;
+  df_param.io_compress_lossless = eig_io_compress_lossless ? QUDA_BOOLEAN_TRUE : QUDA_BOOLEAN_FALSE;
 }
 
 void setQudaStaggeredInvTestParams()